@@ -0,0 +1,133 @@
+/**
+ * @file boilerplate_table.h
+ * @brief JavaScript 对象字面量样板管理
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件定义了对象字面量样板（boilerplate）及其所属的样板表。
+ * 编译期确定全部静态键的对象字面量会生成一个样板，运行时据此
+ * 直接以最终形状分配对象，避免逐个属性走形状过渡。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <mjs/constant.h>
+#include <mjs/gc/allocation_site.h>
+
+namespace mjs {
+
+class Shape;
+
+/**
+ * @class ObjectBoilerplate
+ * @brief 对象字面量样板类
+ *
+ * 记录对象字面量按声明顺序排列的属性键，并缓存该键序列对应的最终形状。
+ * 形状由所在 Context 的 ShapeManager 持有，这里只保存一个非拥有的快速缓存，
+ * 通过 ShapeManager 的唯一 id 判断缓存是否属于当前 Context。
+ *
+ * @see ShapeManager::GetBoilerplateShape 获取样板对应的形状
+ */
+class ObjectBoilerplate {
+public:
+	explicit ObjectBoilerplate(std::vector<ConstIndex>&& keys)
+		: id_(next_id_.fetch_add(1, std::memory_order_relaxed))
+		, keys_(std::move(keys)) {}
+
+	/**
+	 * @brief 获取样板唯一 id
+	 * @return 样板 id（不会复用，可作为跨 Context 的缓存键）
+	 */
+	uint64_t id() const { return id_; }
+
+	/**
+	 * @brief 获取按声明顺序排列的属性键
+	 * @return 属性键常量索引向量
+	 */
+	const auto& keys() const { return keys_; }
+
+	/**
+	 * @brief 获取属性数量
+	 * @return 属性数量
+	 */
+	uint32_t property_count() const { return static_cast<uint32_t>(keys_.size()); }
+
+	/**
+	 * @brief 获取由该样板创建的对象的分配点
+	 * @return 分配点引用（统计信息不属于样板内容，常量样板也可更新）
+	 */
+	AllocationSite& allocation_site() const { return allocation_site_; }
+
+	/**
+	 * @brief 查找缓存的形状
+	 * @param shape_manager_id 当前 ShapeManager 的 id
+	 * @return 缓存命中返回形状指针，否则返回 nullptr
+	 */
+	Shape* FindCachedShape(uint64_t shape_manager_id) const {
+		if (cached_shape_manager_id_ != shape_manager_id) return nullptr;
+		return cached_shape_;
+	}
+
+	/**
+	 * @brief 更新缓存的形状
+	 * @param shape_manager_id 持有该形状的 ShapeManager 的 id
+	 * @param shape 形状指针（不增加引用计数）
+	 */
+	void UpdateCachedShape(uint64_t shape_manager_id, Shape* shape) const {
+		cached_shape_manager_id_ = shape_manager_id;
+		cached_shape_ = shape;
+	}
+
+private:
+	static inline std::atomic<uint64_t> next_id_ = 1;
+
+	uint64_t id_;                                   ///< 样板唯一 id
+	std::vector<ConstIndex> keys_;                  ///< 属性键（声明顺序）
+
+	mutable uint64_t cached_shape_manager_id_ = 0;  ///< 缓存形状所属的 ShapeManager id，0 表示无缓存
+	mutable Shape* cached_shape_ = nullptr;         ///< 缓存的最终形状（非拥有）
+	mutable AllocationSite allocation_site_;        ///< 由该样板创建的对象的分配点
+};
+
+/**
+ * @class BoilerplateTable
+ * @brief 对象字面量样板表类
+ *
+ * 每个函数定义持有一张样板表，kNewObjectFromBoilerplate 指令的操作数即为表中的下标。
+ */
+class BoilerplateTable {
+public:
+	/**
+	 * @brief 添加样板
+	 * @param keys 按声明顺序排列的属性键
+	 * @return 样板下标
+	 */
+	uint32_t AddObjectBoilerplate(std::vector<ConstIndex>&& keys) {
+		object_boilerplates_.emplace_back(std::move(keys));
+		return static_cast<uint32_t>(object_boilerplates_.size() - 1);
+	}
+
+	/**
+	 * @brief 获取样板
+	 * @param idx 样板下标
+	 * @return 样板常量引用
+	 */
+	const ObjectBoilerplate& GetObjectBoilerplate(uint32_t idx) const {
+		return object_boilerplates_[idx];
+	}
+
+	/**
+	 * @brief 获取样板数量
+	 * @return 样板数量
+	 */
+	size_t object_boilerplate_count() const { return object_boilerplates_.size(); }
+
+private:
+	std::vector<ObjectBoilerplate> object_boilerplates_; ///< 对象字面量样板向量
+};
+
+} // namespace mjs
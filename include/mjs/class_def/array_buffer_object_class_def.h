@@ -0,0 +1,17 @@
+#pragma once
+
+#include <mjs/class_def/class_def.h>
+
+namespace mjs {
+
+class ArrayBufferObjectClassDef : public ClassDef {
+public:
+	ArrayBufferObjectClassDef(Runtime* runtime);
+
+	Value NewConstructor(Context* context, uint32_t par_count, const StackFrame& stack) const override;
+
+	// 将参数转换为非负整数下标/长度，失败返回 false
+	static bool ToIndex(const Value& value, size_t* out);
+};
+
+} // namespace mjs
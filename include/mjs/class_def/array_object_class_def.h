@@ -13,6 +13,24 @@ public:
 	static Value Of(Context* context, uint32_t par_count, const StackFrame& stack);
 
 	static Value LiteralNew(Context* context, uint32_t par_count, const StackFrame& stack);
+
+	static Value Sort(Context* context, uint32_t par_count, const StackFrame& stack);
+
+	static Value ToSorted(Context* context, uint32_t par_count, const StackFrame& stack);
+
+	static Value Join(Context* context, uint32_t par_count, const StackFrame& stack);
+
+	static Value Slice(Context* context, uint32_t par_count, const StackFrame& stack);
+
+	static Value Concat(Context* context, uint32_t par_count, const StackFrame& stack);
+
+	static Value Splice(Context* context, uint32_t par_count, const StackFrame& stack);
+
+	static Value IndexOf(Context* context, uint32_t par_count, const StackFrame& stack);
+
+	static Value Includes(Context* context, uint32_t par_count, const StackFrame& stack);
+
+	static Value Fill(Context* context, uint32_t par_count, const StackFrame& stack);
 };
 
 } // namespace mjs
\ No newline at end of file
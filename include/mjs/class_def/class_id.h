@@ -31,6 +31,11 @@ enum class ClassId : uint16_t {
 	kModuleObject,         ///< 模块对象类
 	kCppModuleObject,      ///< C++ 模块对象类
 	kSymbol,               ///< Symbol 类
+	kArrayBufferObject,    ///< ArrayBuffer 类
+	kUint8ArrayObject,     ///< Uint8Array 类
+	kInt32ArrayObject,     ///< Int32Array 类
+	kFloat64ArrayObject,   ///< Float64Array 类
+	kDataViewObject,       ///< DataView 类
 
 	kCustom,               ///< 自定义类标识符
 };
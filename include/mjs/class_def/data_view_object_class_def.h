@@ -0,0 +1,14 @@
+#pragma once
+
+#include <mjs/class_def/class_def.h>
+
+namespace mjs {
+
+class DataViewObjectClassDef : public ClassDef {
+public:
+	DataViewObjectClassDef(Runtime* runtime);
+
+	Value NewConstructor(Context* context, uint32_t par_count, const StackFrame& stack) const override;
+};
+
+} // namespace mjs
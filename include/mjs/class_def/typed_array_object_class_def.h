@@ -0,0 +1,18 @@
+#pragma once
+
+#include <mjs/class_def/class_def.h>
+#include <mjs/value/object/typed_array_object.h>
+
+namespace mjs {
+
+class TypedArrayObjectClassDef : public ClassDef {
+public:
+	TypedArrayObjectClassDef(Runtime* runtime, TypedArrayKind kind, const char* name);
+
+	Value NewConstructor(Context* context, uint32_t par_count, const StackFrame& stack) const override;
+
+private:
+	TypedArrayKind kind_;
+};
+
+} // namespace mjs
@@ -44,6 +44,23 @@ public:
         kMap,           // map
         kFilter,        // filter
         kReduce,        // reduce
+        kSort,          // sort
+        kToSorted,      // toSorted
+        kJoin,          // join
+        kSlice,         // slice
+        kConcat,        // concat
+        kSplice,        // splice
+        kIncludes,      // includes
+        kFill,          // fill
+        kByteLength,    // byteLength
+        kByteOffset,    // byteOffset
+        kBuffer,        // buffer
+        kGetUint8,      // getUint8
+        kSetUint8,      // setUint8
+        kGetInt32,      // getInt32
+        kSetInt32,      // setInt32
+        kGetFloat64,    // getFloat64
+        kSetFloat64,    // setFloat64
 
         kEnd,
     };
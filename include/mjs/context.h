@@ -50,9 +50,10 @@ public:
 	/**
 	 * @brief 构造函数
 	 * @param runtime 运行时环境指针
+	 * @param gc_config GC堆配置，每个 Context 的堆几何参数可以不同
 	 * @throw std::invalid_argument 当 runtime 为 nullptr 时抛出
 	 */
-	Context(Runtime* runtime);
+	Context(Runtime* runtime, const GCHeapConfig& gc_config = GCHeapConfig());
 
 	/**
 	 * @brief 析构函数
@@ -123,6 +124,21 @@ public:
 		}
 	}
 
+    /**
+     * @brief 通知当前处于空闲时间
+     *
+     * 嵌入方在一帧或一次请求处理结束、距下一个期限还有空余时间时调用，
+     * 在预算内执行一项GC工作（Scavenge、增量标记、惰性清除或完整GC），
+     * 使GC工作离开对延迟敏感的请求处理过程。
+     *
+     * @param budget 时间预算
+     * @return 执行的工作及用时，more_work 为 true 时可以在之后的空闲时间再次调用
+     * @see GCHeap::NotifyIdle 工作的选择策略
+     */
+    GCIdleResult NotifyIdle(std::chrono::nanoseconds budget) {
+        return gc_manager_.NotifyIdle(budget);
+    }
+
     /**
      * @brief 增加常量引用计数
      * @param const_index 常量索引
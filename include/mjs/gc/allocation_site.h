@@ -0,0 +1,86 @@
+/**
+ * @file allocation_site.h
+ * @brief 分配点定义
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件定义了分配点（AllocationSite），用于预先晋升（pretenuring）：
+ * 记录在同一位置（构造函数、对象字面量等）分配的对象在第一次 Scavenge 中的存活率，
+ * 存活率高的分配点之后直接在老年代分配，避免长寿对象在新生代中被反复复制。
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace mjs {
+
+/**
+ * @brief 分配点做出决策前至少需要观察到的分配次数
+ */
+constexpr uint32_t kPretenureMinAllocations = 100;
+
+/**
+ * @brief 存活率达到该值的分配点改为直接在老年代分配
+ */
+constexpr double kPretenureSurvivalRate = 0.85;
+
+/**
+ * @class AllocationSite
+ * @brief 分配点的存活统计与预先晋升决策
+ *
+ * 分配点由持有分配位置的结构（函数定义、对象字面量样板）保存，在新生代分配时传给 GCHeap::Allocate。
+ * 堆记录本轮在新生代分配的对象及其分配点，Scavenge 时统计其中被复制（存活）的对象，
+ * 之后调用 Decide 决定是否预先晋升。
+ *
+ * @note 预先晋升后该分配点的对象不再经过新生代，决策不再改变
+ */
+class AllocationSite {
+public:
+    /**
+     * @brief 是否直接在老年代分配
+     */
+    bool pretenured() const { return pretenured_; }
+
+    /**
+     * @brief 获取本轮统计的分配次数
+     */
+    uint32_t allocated_count() const { return allocated_count_; }
+
+    /**
+     * @brief 获取本轮统计的存活次数
+     */
+    uint32_t survived_count() const { return survived_count_; }
+
+    /**
+     * @brief 记录一次新生代分配
+     */
+    void RecordAllocation() { ++allocated_count_; }
+
+    /**
+     * @brief 记录一个对象在 Scavenge 中存活
+     */
+    void RecordSurvival() { ++survived_count_; }
+
+    /**
+     * @brief Scavenge 后根据存活率决定是否预先晋升
+     *
+     * 分配次数不足时继续累计，否则做出决策并开始新一轮统计。
+     */
+    void Decide() {
+        if (allocated_count_ < kPretenureMinAllocations) {
+            return;
+        }
+        pretenured_ = survived_count_ >= allocated_count_ * kPretenureSurvivalRate;
+        allocated_count_ = 0;
+        survived_count_ = 0;
+    }
+
+private:
+    uint32_t allocated_count_ = 0;  ///< 本轮统计的分配次数
+    uint32_t survived_count_ = 0;   ///< 本轮统计的存活次数
+    bool pretenured_ = false;       ///< 是否直接在老年代分配
+};
+
+} // namespace mjs
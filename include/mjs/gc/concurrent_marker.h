@@ -0,0 +1,170 @@
+/**
+ * @file concurrent_marker.h
+ * @brief 老年代并发标记
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件定义了老年代的并发标记器，标记工作在后台线程上进行，主线程继续执行
+ * （也可以不启动后台线程，由主线程分步增量标记）：
+ * - 初始标记停顿中将根集合以及新生代对象引用的老年代对象置灰
+ * - 后台线程逐批扫描灰色对象，扫描完成的对象设置扫描标记（黑色）
+ * - 起始快照（SATB）写屏障：主线程修改尚未扫描的老年代对象前，先在屏障中扫描该对象，
+ *   保证标记开始时存在的引用都会被追踪
+ * - 标记期间新分配和晋升到老年代的对象直接置黑
+ * - 最终标记停顿中由主线程处理剩余的灰色对象，之后执行压缩
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <mjs/noncopyable.h>
+#include <mjs/gc/gc_object.h>
+
+namespace mjs {
+
+class GCHeap;
+class Value;
+
+/**
+ * @brief 后台线程每次持锁扫描的对象数量
+ *
+ * 每批结束后释放锁，主线程的写屏障和Scavenge最多等待一批对象的扫描时间。
+ */
+constexpr size_t kConcurrentMarkingBatchSize = 64;
+
+/**
+ * @brief 增量标记时每扫描多少个对象检查一次是否超过期限
+ */
+constexpr size_t kIncrementalMarkingCheckInterval = 16;
+
+/**
+ * @class ConcurrentMarker
+ * @brief 老年代并发标记器
+ *
+ * 后台线程常驻，只在标记期间工作；增量模式下不启动后台线程，由主线程调用 Step 分步标记。
+ * 标记器只追踪老年代对象：新生代对象在初始标记时全部扫描一遍，
+ * 之后新生代的变化不影响标记结果（新生代引用的老年代对象要么在快照中可达，要么是标记期间分配的黑色对象）。
+ *
+ * 主线程通过 mutex() 暂停标记：持有该锁期间后台线程不会访问任何对象，
+ * Scavenge 在持锁时进行；老年代按页扩容不移动对象，不需要暂停标记。
+ *
+ * @see GCHeap::StartConcurrentMarking
+ * @see GCHeap::FinishConcurrentMarking
+ */
+class ConcurrentMarker : public noncopyable {
+public:
+    /**
+     * @brief 构造函数
+     * @param heap 所属的GC堆
+     * @param background 是否启动后台线程，为false时只能通过 Step 增量标记
+     */
+    explicit ConcurrentMarker(GCHeap* heap, bool background = true);
+
+    /**
+     * @brief 析构函数，停止后台线程
+     */
+    ~ConcurrentMarker();
+
+    /**
+     * @brief 是否处于标记期间（由主线程读写）
+     */
+    bool is_marking() const { return marking_; }
+
+    /**
+     * @brief 暂停后台线程使用的锁（可重入）
+     */
+    std::recursive_mutex& mutex() { return mutex_; }
+
+    /**
+     * @brief 开始标记，调用者需持有 mutex() 并随后通过 Grey 放入初始的灰色对象
+     */
+    void Begin();
+
+    /**
+     * @brief 唤醒后台线程处理灰色对象
+     */
+    void Resume();
+
+    /**
+     * @brief 将老年代对象置灰（未标记时标记并放入工作表），调用者需持有 mutex()
+     */
+    void Grey(GCObject* obj);
+
+    /**
+     * @brief 写屏障慢路径：在主线程修改尚未扫描的老年代对象前扫描该对象
+     *
+     * 对象此时必然存活，未标记时直接标记。扫描后对象变为黑色，之后的修改不再影响标记。
+     *
+     * @param obj 即将被修改的老年代对象
+     */
+    void ScanBeforeWrite(GCObject* obj);
+
+    /**
+     * @brief 工作表是否已空（后台线程已处理完所有灰色对象）
+     */
+    bool IsComplete();
+
+    /**
+     * @brief 增量标记一步：在主线程处理灰色对象，直到工作表为空或超过期限
+     * @param deadline 期限
+     * @return 工作表是否已空
+     */
+    bool Step(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief 最终标记：在主线程处理剩余的灰色对象并结束标记，调用者需持有 mutex()
+     */
+    void Finish();
+
+    /**
+     * @brief 本次标记中后台线程扫描的对象数量
+     */
+    size_t background_scanned() const { return background_scanned_; }
+
+    /**
+     * @brief 本次标记中标记的老年代对象字节数（不包括标记期间分配的黑色对象）
+     */
+    size_t marked_size() const { return marked_size_; }
+
+    /**
+     * @brief 是否启动了后台线程
+     */
+    bool background() const { return thread_.joinable(); }
+
+private:
+    void ThreadMain();
+
+    /**
+     * @brief 扫描对象的子引用，将未标记的老年代子对象置灰，之后将对象置黑
+     */
+    void ScanObject(GCObject* obj);
+
+    /**
+     * @brief 处理工作表中的灰色对象
+     * @param max_count 最多处理的数量
+     * @return 实际扫描的对象数量
+     */
+    size_t Drain(size_t max_count);
+
+    static void GreyCallback(Context* context, Value* child);
+
+private:
+    GCHeap* heap_;                          ///< 所属的GC堆
+    std::recursive_mutex mutex_;            ///< 保护工作表和对象访问
+    std::condition_variable_any cv_;        ///< 唤醒后台线程
+    std::thread thread_;                    ///< 后台标记线程
+    std::vector<GCObject*> worklist_;       ///< 灰色对象
+    bool marking_ = false;                  ///< 是否处于标记期间
+    bool shutdown_ = false;                 ///< 是否停止后台线程
+    size_t background_scanned_ = 0;         ///< 后台线程扫描的对象数量
+    size_t marked_size_ = 0;                ///< 标记的老年代对象字节数
+};
+
+} // namespace mjs
@@ -9,23 +9,42 @@
  * - 统一管理新生代和老年代
  * - 对象分配和晋升
  * - GC触发和调度
+ * - 记忆集（老年代到新生代的引用）
+ * - 堆布局配置与新生代大小自适应
+ * - 老年代并发标记、增量标记（可选）与停顿时间统计
+ * - 老年代标记后惰性清除，碎片率超过阈值时压缩
+ * - 大对象单独映射，不随老年代压缩移动
+ * - 按分配点的存活率预先晋升
+ * - 嵌入方空闲时间内的GC调度
+ * - 堆大小的软限制与硬限制
+ * - GC事件追踪与停顿时间分位数
  */
 
 #pragma once
 
+#include <chrono>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <ostream>
 #include <unordered_set>
 
 #include <mjs/noncopyable.h>
 #include <mjs/gc/gc_object.h>
 #include <mjs/gc/new_space.h>
 #include <mjs/gc/old_space.h>
+#include <mjs/gc/large_object_space.h>
+#include <mjs/gc/allocation_site.h>
+#include <mjs/gc/parallel_scavenger.h>
+#include <mjs/gc/concurrent_marker.h>
+#include <mjs/gc/sampling_heap_profiler.h>
+#include <mjs/gc/gc_tracer.h>
 #include <mjs/value/value.h>
 
 namespace mjs {
 
 class Context;
+class Shape;
 
 /**
  * @brief 对象晋升年龄阈值
@@ -33,10 +52,170 @@ class Context;
 constexpr uint8_t kTenureAgeThreshold = 3;
 
 /**
- * @brief 大对象阈值（直接在老年代分配）
+ * @brief 大对象阈值（在大对象空间中分配）
  */
 constexpr size_t kLargeObjectThreshold = kEdenSpaceSize / 64;
 
+/**
+ * @brief 老年代清除期间每分配多少字节执行一次惰性清除
+ */
+constexpr size_t kLazySweepInterval = 16 * 1024;
+
+/**
+ * @brief 每次惰性清除的老年代字节数
+ *
+ * 大于 kLazySweepInterval，保证清除先于分配消耗完空闲内存完成。
+ */
+constexpr size_t kLazySweepStepSize = 64 * 1024;
+
+/**
+ * @brief 停顿时间直方图的区间数
+ */
+constexpr size_t kGCPauseHistogramBuckets = 16;
+
+/**
+ * @brief 停顿时间直方图第 bucket 个区间的上限（微秒，不含）
+ *
+ * 第0个区间为 [0, 100us)，之后每个区间的上限翻倍，最后一个区间没有上限。
+ */
+constexpr uint64_t GCPauseBucketLimitUs(size_t bucket) {
+    return uint64_t(100) << bucket;
+}
+
+/**
+ * @enum HeapLimitAction
+ * @brief 超过堆硬限制时的处理方式
+ */
+enum class HeapLimitAction : uint8_t {
+    kThrow = 0,     ///< 抛出可以被捕获的 RangeError
+    kTerminate,     ///< 终止执行：异常不能被脚本捕获，直接返回到宿主
+};
+
+/**
+ * @brief 接近堆限制的回调函数类型
+ *
+ * 堆大小在完整GC后仍超过软限制时调用，宿主可以在回调中释放外部资源或通过 GCManager::SetHeapLimits 调整限制。
+ * 堆大小回落到软限制以下之前不会再次调用。
+ *
+ * @param context 堆所属的上下文
+ * @param heap_size 当前堆大小
+ * @param soft_limit 软限制
+ * @param data 用户数据
+ */
+using NearHeapLimitCallback = void (*)(Context* context, size_t heap_size, size_t soft_limit, void* data);
+
+/**
+ * @struct GCHeapConfig
+ * @brief 堆布局配置
+ *
+ * 每个Context独立配置，通过 GCManager::Initialize 传入。
+ */
+struct GCHeapConfig {
+    size_t new_space_size = kNewSpaceTotalSize;           ///< 新生代初始总大小
+    size_t eden_ratio = kEdenSpaceRatio;                  ///< Eden区比例份数
+    size_t survivor_ratio = kSurvivorSpaceRatio;          ///< 每个Survivor区比例份数
+    size_t old_space_initial_size = kOldSpaceInitialSize; ///< 老年代初始大小
+
+    bool adaptive_new_space = true;                       ///< 是否根据存活率自动调整新生代大小
+    size_t min_new_space_size = kNewSpaceTotalSize;       ///< 自动调整的下限
+    size_t max_new_space_size = 8 * 1024 * 1024;          ///< 自动调整的上限
+    double low_survival_rate = 0.1;                       ///< 存活率低于该值时扩大新生代
+    size_t memory_pressure_threshold = 0;                 ///< 堆总容量超过该值时视为内存压力，缩小新生代（0表示不限制）
+
+    uint32_t scavenge_threads = 1;                        ///< 并行Scavenge的线程数（1表示串行）
+
+    bool concurrent_marking = false;                      ///< 老年代是否在后台线程并发标记
+    double concurrent_marking_start_ratio = 0.5;          ///< Scavenge后老年代使用率超过该值时开始并发或增量标记
+
+    bool incremental_marking = false;                     ///< 老年代是否在主线程分步增量标记
+    uint32_t incremental_step_budget_us = 1000;           ///< 分配触发的每步标记时间预算（微秒）
+    size_t incremental_step_bytes = 64 * 1024;            ///< 标记期间每分配多少字节执行一步
+
+    bool old_space_sweeping = true;                       ///< 老年代标记后是否清除而不移动对象
+    double compaction_threshold = 0.5;                    ///< 标记后碎片率（非存活字节占比）超过该值时改为压缩
+
+    double idle_scavenge_ratio = 0.5;                     ///< 空闲时Eden区使用率超过该值时提前执行Scavenge
+
+    size_t heap_soft_limit = 0;                           ///< 堆大小软限制，超过时执行完整GC并调用接近上限回调（0表示不限制）
+    size_t heap_hard_limit = 0;                           ///< 堆大小硬限制，完整GC后仍超过时中断脚本（0表示不限制）
+    HeapLimitAction heap_limit_action = HeapLimitAction::kThrow; ///< 超过硬限制时的处理方式
+};
+
+/**
+ * @enum NewSpaceResizeDecision
+ * @brief 新生代大小自适应策略的决策
+ */
+enum class NewSpaceResizeDecision : uint8_t {
+    kKeep = 0,      ///< 保持不变
+    kGrow,          ///< 存活率低，扩大新生代以减少Scavenge次数
+    kShrink,        ///< 内存压力，缩小新生代
+};
+
+/**
+ * @enum GCIdleAction
+ * @brief 空闲通知中执行的GC工作
+ */
+enum class GCIdleAction : uint8_t {
+    kNone = 0,              ///< 没有需要做的工作，或预计用时超出预算
+    kScavenge,              ///< 提前执行Scavenge，避免在之后的分配中触发
+    kIncrementalMarking,    ///< 开始或推进老年代增量标记，标记完成时同时结束标记
+    kSweep,                 ///< 推进老年代惰性清除
+    kFullGC,                ///< 执行完整GC（标记后清除或压缩老年代）
+};
+
+/**
+ * @struct GCIdleResult
+ * @brief 空闲通知的结果
+ */
+struct GCIdleResult {
+    GCIdleAction action = GCIdleAction::kNone;  ///< 执行的工作
+    std::chrono::nanoseconds elapsed{};         ///< 实际用时
+    bool more_work = false;                     ///< 是否还有可以在之后的空闲时间完成的工作
+};
+
+/**
+ * @struct GCHeapStats
+ * @brief 堆统计信息
+ */
+struct GCHeapStats {
+    size_t new_space_used = 0;          ///< 新生代已使用大小
+    size_t new_space_capacity = 0;      ///< 新生代容量
+    size_t eden_size = 0;               ///< Eden区大小
+    size_t survivor_size = 0;           ///< Survivor区大小
+    size_t old_space_used = 0;          ///< 老年代已使用大小
+    size_t old_space_capacity = 0;      ///< 老年代容量
+    size_t old_space_free = 0;          ///< 老年代空闲链表中的字节数
+    size_t large_object_space_used = 0; ///< 大对象空间已使用大小
+    size_t large_object_count = 0;      ///< 大对象数量
+
+    double last_survival_rate = 0;                                      ///< 最近一次Scavenge的存活率
+    NewSpaceResizeDecision last_decision = NewSpaceResizeDecision::kKeep; ///< 最近一次Scavenge后的决策
+    uint32_t new_space_grow_count = 0;      ///< 新生代扩大次数
+    uint32_t new_space_shrink_count = 0;    ///< 新生代缩小次数
+
+    uint32_t pause_count = 0;                                   ///< GC停顿次数
+    uint32_t pause_histogram[kGCPauseHistogramBuckets] = {};    ///< 停顿时间直方图，区间见 GCPauseBucketLimitUs
+    double total_pause_ms = 0;                                  ///< 停顿总时间
+    double max_pause_ms = 0;                                    ///< 最长停顿时间
+    double pause_p50_ms = 0;                                    ///< 停顿时间的中位数
+    double pause_p90_ms = 0;                                    ///< 停顿时间的90分位数
+    double pause_p99_ms = 0;                                    ///< 停顿时间的99分位数
+    double pause_p999_ms = 0;                                   ///< 停顿时间的99.9分位数
+    uint32_t concurrent_marking_count = 0;                      ///< 完成的并发（增量）标记次数
+    uint32_t incremental_step_count = 0;                        ///< 增量标记的步数
+    uint32_t mark_sweep_count = 0;                              ///< 标记后清除老年代的次数
+    uint32_t compaction_count = 0;                              ///< 标记后压缩老年代的次数
+    size_t scavenge_copied_bytes = 0;                           ///< Scavenge复制和晋升的总字节数
+    size_t pretenured_bytes = 0;                                ///< 预先晋升的分配点直接在老年代分配的字节数
+    uint32_t idle_task_count = 0;                               ///< 空闲通知中执行了GC工作的次数
+
+    size_t heap_size = 0;                                       ///< 计入堆限制的大小，见 GCHeap::heap_size
+    size_t external_memory = 0;                                 ///< 宿主报告的外部内存（如 ArrayBuffer 的缓冲区）
+    size_t native_memory = 0;                                   ///< 引用计数原生对象（String、ClosureVar）的内存，进程内共享
+    uint32_t near_heap_limit_count = 0;                         ///< 调用接近上限回调的次数
+    uint32_t heap_limit_exceeded_count = 0;                     ///< 超过硬限制中断脚本的次数
+};
+
 /**
  * @struct GCRootSet
  * @brief GC根集合
@@ -70,18 +249,20 @@ public:
 
     /**
      * @brief 初始化堆
+     * @param config 堆布局配置
      * @return 是否初始化成功
      */
-    bool Initialize();
+    bool Initialize(const GCHeapConfig& config = GCHeapConfig());
 
     /**
      * @brief 分配原始内存（不构造GCObject）
      * @param total_size 总大小（包含头部）
      * @param generation 输出代际信息
+     * @param site 分配点，为nullptr时不统计；已预先晋升的分配点直接在老年代分配
      * @return 原始内存指针，失败返回nullptr
      * @note 调用者负责使用placement new构造对象
      */
-    void* Allocate(size_t* total_size, GCGeneration* generation);
+    void* Allocate(size_t* total_size, GCGeneration* generation, AllocationSite* site = nullptr);
 
     /**
      * @brief 触发垃圾回收
@@ -98,11 +279,149 @@ public:
      */
     void GetStats(size_t& total_allocated, size_t& total_collected, uint32_t& gc_count) const;
 
+    /**
+     * @brief 获取堆统计信息（空间大小及新生代自适应策略的决策）
+     * @param stats 输出统计信息
+     */
+    void GetHeapStats(GCHeapStats* stats) const;
+
+    /**
+     * @brief 通知内存压力，下一次Scavenge后缩小新生代
+     */
+    void NotifyMemoryPressure() { memory_pressure_ = true; }
+
     /**
      * @brief 强制触发完整GC
      */
     void ForceFullGC();
 
+    /**
+     * @brief 写出堆快照（V8 .heapsnapshot 格式）
+     *
+     * 先执行完整GC并完成惰性清除，使堆中只剩存活对象，再流式写出对象图。
+     *
+     * @param out 输出流
+     * @return 是否写出成功（正在GC时返回 false）
+     */
+    bool WriteHeapSnapshot(std::ostream& out);
+
+    /**
+     * @brief 开始采样分配分析（已开始时重新开始）
+     * @param sample_interval 平均采样间隔（字节）
+     * @param stack_depth 最大采集的栈深度
+     * @param seed 随机数种子，为0时随机选取
+     */
+    void StartSamplingHeapProfiler(uint64_t sample_interval = kDefaultHeapSampleInterval,
+        uint32_t stack_depth = kDefaultHeapSampleStackDepth, uint64_t seed = 0);
+
+    /**
+     * @brief 停止采样分配分析，丢弃已采集的数据
+     */
+    void StopSamplingHeapProfiler() { sampling_heap_profiler_.reset(); }
+
+    /**
+     * @brief 获取采样分配分析器
+     * @return 未开始时返回 nullptr
+     */
+    SamplingHeapProfiler* sampling_heap_profiler() const { return sampling_heap_profiler_.get(); }
+
+    /**
+     * @brief 设置GC事件回调
+     * @param callback 回调，为nullptr时取消
+     * @param data 传给回调的用户数据
+     */
+    void SetGCEventCallback(GCEventCallback callback, void* data) { tracer_.SetEventCallback(callback, data); }
+
+    /**
+     * @brief 开始以 Chrome trace-event 格式记录GC事件
+     */
+    void StartGCTracing() { tracer_.StartTracing(); }
+
+    /**
+     * @brief 停止记录GC事件，写出 Chrome trace-event JSON
+     * @param out 输出流
+     * @return 是否写出成功（未开始记录时返回 false）
+     */
+    bool StopGCTracing(std::ostream& out) { return tracer_.StopTracing(out); }
+
+    /**
+     * @brief 获取GC事件追踪器
+     */
+    const GCTracer& tracer() const { return tracer_; }
+
+    /**
+     * @brief 空闲通知：在预算内执行一项GC工作
+     *
+     * 按以下顺序选择工作：正在标记时推进标记；正在清除时推进惰性清除；
+     * Eden区使用率超过 idle_scavenge_ratio 时提前执行Scavenge；老年代使用率超过
+     * concurrent_marking_start_ratio 且自上次完整GC以来有足够增长时开始标记（未启用并发或增量标记时
+     * 执行完整GC，由碎片率决定清除或压缩）。
+     * Scavenge 和完整GC 不可分段，按上一次的用时和当前大小估计，超出预算时不执行。
+     *
+     * @param budget 时间预算
+     * @return 执行的工作及用时
+     */
+    GCIdleResult NotifyIdle(std::chrono::nanoseconds budget);
+
+    /**
+     * @brief 设置堆大小限制
+     * @param soft_limit 软限制，0表示不限制
+     * @param hard_limit 硬限制，0表示不限制
+     */
+    void SetHeapLimits(size_t soft_limit, size_t hard_limit) {
+        config_.heap_soft_limit = soft_limit;
+        config_.heap_hard_limit = hard_limit;
+        near_heap_limit_notified_ = false;
+    }
+
+    /**
+     * @brief 设置接近堆限制的回调
+     * @param callback 回调，为nullptr时取消
+     * @param data 传给回调的用户数据
+     */
+    void SetNearHeapLimitCallback(NearHeapLimitCallback callback, void* data) {
+        near_heap_limit_callback_ = callback;
+        near_heap_limit_data_ = data;
+    }
+
+    /**
+     * @brief 调整外部内存的大小
+     *
+     * 由GC对象持有、但不在GC堆中分配的内存（如 ArrayBuffer 的缓冲区）通过该接口计入堆限制。
+     *
+     * @param delta 增加的字节数，释放时为负数
+     */
+    void AdjustExternalMemory(int64_t delta) {
+        external_memory_ = static_cast<size_t>(static_cast<int64_t>(external_memory_) + delta);
+    }
+
+    /**
+     * @brief 获取计入堆限制的大小
+     *
+     * 包括新生代、老年代和大对象空间的已使用大小、外部内存以及引用计数原生对象的内存。
+     */
+    size_t heap_size() const;
+
+    /**
+     * @brief 检查堆限制（由虚拟机在循环回边和函数调用处调用）
+     *
+     * 未设置限制时直接返回。超过限制且自上次检查以来堆有增长时先执行完整GC，
+     * 之后仍超过软限制时调用接近上限回调，仍超过硬限制时返回false，由调用方中断脚本。
+     *
+     * @return 是否未超过硬限制
+     */
+    bool CheckHeapLimit() {
+        if (!config_.heap_soft_limit && !config_.heap_hard_limit) {
+            return true;
+        }
+        return CheckHeapLimitSlow();
+    }
+
+    /**
+     * @brief 获取超过硬限制时的处理方式
+     */
+    HeapLimitAction heap_limit_action() const { return config_.heap_limit_action; }
+
     /**
      * @brief 添加根引用
      * @param value 值指针
@@ -121,6 +440,138 @@ public:
      */
     void set_gc_threshold(uint8_t threshold) { gc_threshold_ = threshold; }
 
+    /**
+     * @brief 设置Scavenge的线程数
+     * @param thread_count 线程数（包括调用线程），1表示串行Scavenge
+     */
+    void set_scavenge_threads(uint32_t thread_count);
+
+    /**
+     * @brief 获取Scavenge的线程数
+     */
+    uint32_t scavenge_threads() const {
+        return parallel_scavenger_ ? parallel_scavenger_->thread_count() : 1;
+    }
+
+    /**
+     * @brief 开始老年代并发标记（初始标记停顿）
+     *
+     * 需要在配置中启用并发标记或增量标记。初始标记前先执行一次Scavenge；标记完成后在之后的Scavenge中
+     * 自动执行最终标记和压缩，也可以通过 CollectGarbage(true) 立即完成。
+     *
+     * @return 是否开始标记，未启用、已在标记或正在GC时返回false
+     */
+    bool StartConcurrentMarking();
+
+    /**
+     * @brief 增量标记一步
+     *
+     * 在期限之前处理灰色对象；灰色对象全部处理完后执行最终标记和压缩，结束本次标记。
+     * 嵌入方可以在空闲时间（如游戏循环的帧末尾）调用，未在标记时直接返回。
+     *
+     * @param deadline 期限
+     * @return 本次调用后是否已不在标记期间
+     */
+    bool Step(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief 是否处于并发标记期间
+     */
+    bool is_marking() const { return concurrent_marker_ && concurrent_marker_->is_marking(); }
+
+    /**
+     * @brief 后台线程是否已处理完所有灰色对象，此时最终标记停顿很短
+     */
+    bool IsConcurrentMarkingComplete() const {
+        return !is_marking() || concurrent_marker_->IsComplete();
+    }
+
+    /**
+     * @brief 获取并发标记器（未启用时返回nullptr）
+     */
+    ConcurrentMarker* concurrent_marker() const { return concurrent_marker_.get(); }
+
+    /**
+     * @brief 标记屏障：并发标记期间修改老年代对象前调用
+     *
+     * 对象尚未被扫描时先扫描它，保证标记开始时对象持有的引用不会因修改而丢失。
+     *
+     * @param obj 即将被修改的对象，新生代对象会被忽略
+     */
+    void MarkingBarrier(GCObject* obj) {
+        if (obj->header()->generation() == GCGeneration::kOld && !obj->header()->IsScanned() && is_marking()) {
+            concurrent_marker_->ScanBeforeWrite(obj);
+        }
+    }
+
+    /**
+     * @brief 老年代中新分配的对象在并发标记期间直接置黑
+     * @param obj 新分配的老年代对象
+     */
+    void MarkAllocatedObject(GCObject* obj) {
+        if (is_marking()) {
+            obj->header()->SetMarked(true);
+            obj->header()->SetScanned(true);
+        }
+    }
+
+    /**
+     * @brief 记录可能引用新生代对象的老年代对象（写屏障慢路径）
+     *
+     * 记忆集以对象为粒度，每个对象最多记录一次；Scavenge 只扫描记忆集中的对象，
+     * 不遍历整个老年代，扫描后仍引用新生代对象的才会保留在记忆集中。
+     *
+     * @param obj 被写入的对象，新生代对象会被忽略
+     */
+    void RecordWrite(GCObject* obj) {
+        if (obj->header()->generation() != GCGeneration::kOld || obj->header()->IsRemembered()) {
+            return;
+        }
+        obj->header()->SetRemembered(true);
+        remembered_set_.push_back(obj);
+    }
+
+    /**
+     * @brief 获取记忆集中的对象数量
+     */
+    size_t remembered_set_size() const { return remembered_set_.size(); }
+
+    /**
+     * @brief 登记新生代对象在死亡时调用析构函数
+     *
+     * Scavenge 不遍历死亡对象，只为登记的死亡对象调用析构函数，其余的随Eden区一起丢弃；
+     * 存活的对象复制后保持登记，晋升后由老年代的清除负责析构。
+     *
+     * @param obj 新生代对象，老年代对象和已登记的对象会被忽略
+     */
+    void RegisterFinalizer(GCObject* obj) {
+        if (obj->header()->generation() != GCGeneration::kNew || obj->header()->IsFinalizable()) {
+            return;
+        }
+        obj->header()->SetFinalizable(true);
+        young_finalizers_.push_back(obj);
+    }
+
+    /**
+     * @brief 获取登记了析构的新生代对象数量
+     */
+    size_t young_finalizer_count() const { return young_finalizers_.size(); }
+
+    /**
+     * @brief 为新生代对象持有形状的引用
+     *
+     * 新生代对象不增加形状的引用计数，而是由GC堆为它们使用的每个形状持有一个引用，
+     * 对象死亡时不需要析构；每次Scavenge后按存活的对象重新持有。
+     *
+     * @param shape 新生代对象使用的形状
+     */
+    void PinYoungShape(Shape* shape);
+
+    /**
+     * @brief 获取GC堆为新生代对象持有引用的形状数量
+     */
+    size_t young_shape_count() const { return young_shapes_.size(); }
+
 private:
     /**
      * @brief 新生代GC（复制算法）
@@ -129,20 +580,106 @@ private:
     bool Scavenge();
 
     /**
-     * @brief 老年代GC（标记-压缩算法）
+     * @brief 老年代GC（标记后清除或压缩）
      * @return 是否回收成功
      */
     bool MarkCompact();
 
     /**
-     * @brief 标记阶段
+     * @brief 标记结束后回收老年代：碎片率不超过阈值时开始惰性清除，否则压缩
+     * @param live_size 标记得到的老年代存活字节数
+     * @param event 当前的GC事件，记录事件种类及压缩和清除阶段的用时
+     */
+    void SweepOrCompact(size_t live_size, GCEvent* event);
+
+    /**
+     * @brief 分配时推进惰性清除
+     * @param size 本次分配的字节数
+     */
+    void LazySweepOnAllocation(size_t size);
+
+    /**
+     * @brief 标记阶段（暂停主线程）
      */
     void MarkPhase();
 
+    /**
+     * @brief 清除老年代对象的标记，clear_young 为true时同时清除新生代对象的标记
+     */
+    void ClearMarks(bool clear_young);
+
+    /**
+     * @brief 初始标记：将根集合及新生代对象引用的老年代对象置灰，之后由后台线程继续标记
+     * @note 需要在Scavenge之后调用，此时新生代中只有存活对象
+     */
+    void BeginConcurrentMarking();
+
+    /**
+     * @brief 并发标记结束：最终标记停顿中处理剩余的灰色对象，之后压缩老年代
+     */
+    void FinishConcurrentMarking();
+
+    /**
+     * @brief Scavenge后根据老年代使用率开始并发标记，或在标记完成时结束标记
+     */
+    void ScheduleConcurrentMarking();
+
+    /**
+     * @brief 标记期间暂停后台标记线程，未在标记时返回空锁
+     */
+    std::unique_lock<std::recursive_mutex> PauseConcurrentMarker();
+
+    /**
+     * @brief 分配时推进增量标记：累计分配量达到配置值后执行一步，只标记不结束
+     * @param size 本次分配的字节数
+     */
+    void IncrementalMarkingOnAllocation(size_t size);
+
+    /**
+     * @brief 为预先晋升的分配点在老年代分配，空间不足时扩容
+     * @param size 分配大小，输出实际分配的大小
+     */
+    void* AllocatePretenured(size_t* size);
+
+    /**
+     * @brief Scavenge 复制完成后统计本轮新生代分配的对象中存活的对象，更新各分配点的决策
+     * @note 需要在清空Eden区之前调用，此时存活对象的原位置上仍保留转发地址
+     */
+    void UpdateAllocationSites();
+
+    /**
+     * @brief 检查堆限制的慢路径
+     * @return 是否未超过硬限制
+     */
+    bool CheckHeapLimitSlow();
+
+    /**
+     * @brief 按上一次Scavenge的用时和新生代已使用大小估计本次Scavenge的用时
+     */
+    std::chrono::nanoseconds EstimateScavengeTime() const;
+
+    /**
+     * @brief 按上一次完整GC的用时和老年代已使用大小估计本次完整GC的用时
+     */
+    std::chrono::nanoseconds EstimateFullGCTime() const;
+
+    /**
+     * @brief 空闲通知中选择并执行GC工作
+     * @param deadline 期限
+     * @param result 输出执行的工作
+     */
+    void PerformIdleWork(std::chrono::steady_clock::time_point deadline, GCIdleResult* result);
+
+    /**
+     * @brief 记录一次停顿
+     */
+    void RecordPause(std::chrono::steady_clock::duration pause);
+
     /**
      * @brief 压缩阶段
+     * @param event 当前的GC事件，记录析构死亡对象和移动对象的用时
      */
-    void CompactPhase();
+    void CompactPhase(GCEvent* event);
 
     /**
      * @brief 复制对象到To空间
@@ -159,18 +696,11 @@ private:
     GCObject* PromoteObject(GCObject* obj);
 
     /**
-     * @brief 标记一个对象及其子对象
+     * @brief 标记一个对象，首次标记时放入标记工作表，由 MarkPhase 扫描其子对象
      * @param obj 要标记的对象
      */
     void MarkObject(GCObject* obj);
 
-    /**
-     * @brief 处理写屏障（跨代引用）
-     * @param parent 父对象
-     * @param child 子对象
-     */
-    void WriteBarrier(GCObject* parent, GCObject* child);
-
     /**
      * @brief 处理对象拷贝（Scavenge时使用）
      * @param value 值指针
@@ -178,7 +708,46 @@ private:
     void ProcessCopyOrReference(Value* value);
 
     /**
-     * @brief 扩展老年代空间
+     * @brief 扫描老年代对象的子对象（Scavenge时使用）
+     *
+     * 复制或晋升其引用的新生代对象，扫描后仍引用新生代对象时重新记录到记忆集。
+     *
+     * @param obj 记忆集中的对象或本次晋升的对象
+     */
+    void ScavengeOldObject(GCObject* obj);
+
+    /**
+     * @brief 根据本次Scavenge的存活率调整新生代大小
+     * @param survived 复制和晋升的字节数
+     * @param collected 回收的字节数
+     */
+    void AdjustNewSpace(size_t survived, size_t collected);
+
+    /**
+     * @brief 按配置的比例将新生代总大小划分为Eden区和Survivor区
+     */
+    void SplitNewSpace(size_t new_space_size, size_t* eden_size, size_t* survivor_size) const;
+
+    /**
+     * @brief 标记结束后更新记忆集：丢弃未标记（死亡）的对象，压缩时换成转发后的新地址
+     */
+    void UpdateRememberedSet();
+
+    /**
+     * @brief Scavenge后调用登记了析构的死亡对象的析构函数，存活的对象更新为复制后的地址
+     */
+    void SweepYoungFinalizers();
+
+    /**
+     * @brief Scavenge后更新GC堆持有的形状
+     *
+     * 晋升的对象改为增加形状的引用计数，按仍在新生代的对象重新持有形状，
+     * 之后释放之前持有的引用，只被死亡对象使用的形状随之释放。
+     */
+    void UpdateYoungShapes();
+
+    /**
+     * @brief 扩展老年代空间（增加空页，不移动对象）
      * @param min_size 最小需要的额外空间
      * @return 是否扩容成功
      */
@@ -202,18 +771,89 @@ private:
     Context* context_ = nullptr;           ///< 所属上下文
     std::unique_ptr<NewSpace> new_space_;  ///< 新生代空间
     std::unique_ptr<OldSpace> old_space_;  ///< 老年代空间
+    std::unique_ptr<LargeObjectSpace> large_object_space_; ///< 大对象空间
+    size_t large_object_limit_ = 0;        ///< 大对象空间超过该大小时触发完整GC
 
     GCRootSet root_set_;                   ///< GC根集合
 
+    std::vector<GCObject*> remembered_set_;    ///< 记忆集：可能引用新生代对象的老年代对象
+    std::vector<GCObject*> promoted_worklist_; ///< 本次Scavenge中晋升、尚未扫描的对象
+    std::vector<GCObject*> promoted_objects_;  ///< 本次Scavenge中晋升的对象，结束后改为持有形状的引用计数
+    std::vector<GCObject*> young_finalizers_;  ///< 登记了析构的新生代对象
+    std::vector<Shape*> young_shapes_;         ///< GC堆为新生代对象持有引用的形状
+    std::unique_ptr<ParallelScavenger> parallel_scavenger_; ///< 并行Scavenge（线程数为1时不创建）
+    std::unique_ptr<ConcurrentMarker> concurrent_marker_;   ///< 并发标记（未启用时不创建）
+    std::vector<GCObject*> marking_worklist_;  ///< 暂停式标记的工作表
+    size_t allocated_since_step_ = 0;          ///< 上一步增量标记后分配的字节数
+    size_t allocated_since_sweep_ = 0;         ///< 上一次惰性清除后分配的字节数
+    size_t marked_size_ = 0;                   ///< 暂停式标记得到的老年代存活字节数
+    size_t marking_start_allocated_ = 0;       ///< 开始并发标记时老年代累计分配的字节数
+    bool scavenge_found_young_ = false;        ///< 当前扫描的老年代对象是否仍引用新生代对象
+    size_t promoted_bytes_ = 0;                ///< 本次Scavenge晋升的字节数
+
+    /**
+     * @brief 新生代中带分配点的对象
+     */
+    struct AllocationSiteRecord {
+        GCObject* object;       ///< 对象（Scavenge前的地址）
+        AllocationSite* site;   ///< 分配点
+    };
+    std::vector<AllocationSiteRecord> allocation_site_records_; ///< 本轮新生代分配的带分配点的对象
+    std::unique_ptr<SamplingHeapProfiler> sampling_heap_profiler_; ///< 采样分配分析器（未开始时为空）
+
+    // 新生代自适应
+    size_t new_space_size_ = 0;            ///< 当前新生代总大小（目标值）
+    bool memory_pressure_ = false;         ///< 是否收到内存压力通知
+    double last_survival_rate_ = 0;        ///< 最近一次Scavenge的存活率
+    NewSpaceResizeDecision last_decision_ = NewSpaceResizeDecision::kKeep; ///< 最近一次决策
+    uint32_t new_space_grow_count_ = 0;    ///< 新生代扩大次数
+    uint32_t new_space_shrink_count_ = 0;  ///< 新生代缩小次数
+
+    // 空闲调度的用时估计
+    std::chrono::steady_clock::duration last_scavenge_time_{}; ///< 上一次Scavenge的用时
+    size_t last_scavenge_size_ = 0;        ///< 上一次Scavenge开始时新生代已使用大小
+    std::chrono::steady_clock::duration last_full_gc_time_{};  ///< 上一次完整GC的用时
+    size_t last_full_gc_size_ = 0;         ///< 上一次完整GC开始时老年代已使用大小
+    size_t last_full_gc_live_ = 0;         ///< 上一次完整GC后老年代存活字节数
+    size_t last_full_gc_allocated_ = 0;    ///< 上一次完整GC后老年代累计分配的字节数
+
     // GC统计
     size_t total_allocated_ = 0;           ///< 总分配字节数
     size_t total_collected_ = 0;           ///< 总回收字节数
     uint32_t gc_count_ = 0;                ///< GC次数
     uint32_t full_gc_count_ = 0;           ///< 完整GC次数
+    uint32_t concurrent_marking_count_ = 0; ///< 完成的并发标记次数
+    uint32_t incremental_step_count_ = 0;  ///< 增量标记的步数
+    uint32_t mark_sweep_count_ = 0;        ///< 标记后清除老年代的次数
+    uint32_t compaction_count_ = 0;        ///< 标记后压缩老年代的次数
+    size_t scavenge_copied_bytes_ = 0;     ///< Scavenge复制和晋升的总字节数
+    size_t pretenured_bytes_ = 0;          ///< 预先晋升直接在老年代分配的字节数
+    uint32_t idle_task_count_ = 0;         ///< 空闲通知中执行了GC工作的次数
+
+    // 堆限制
+    size_t external_memory_ = 0;           ///< 宿主报告的外部内存
+    size_t heap_limit_gc_size_ = 0;        ///< 因超过限制执行完整GC后的堆大小，堆未增长时不再重复回收
+    bool near_heap_limit_notified_ = false; ///< 是否已调用接近上限回调
+    NearHeapLimitCallback near_heap_limit_callback_ = nullptr; ///< 接近上限回调
+    void* near_heap_limit_data_ = nullptr; ///< 接近上限回调的用户数据
+    uint32_t near_heap_limit_count_ = 0;   ///< 调用接近上限回调的次数
+    uint32_t heap_limit_exceeded_count_ = 0; ///< 超过硬限制的次数
+
+    // 停顿统计
+    uint32_t pause_count_ = 0;                                  ///< 停顿次数
+    uint32_t pause_histogram_[kGCPauseHistogramBuckets] = {};   ///< 停顿时间直方图
+    std::chrono::steady_clock::duration total_pause_{};         ///< 停顿总时间
+    std::chrono::steady_clock::duration max_pause_{};           ///< 最长停顿时间
+    GCTracer tracer_;                                           ///< GC事件追踪及停顿时间分位数
 
     // GC配置
+    GCHeapConfig config_;                  ///< 堆布局配置
     uint8_t gc_threshold_ = 80;            ///< GC触发阈值（百分比）
     bool in_gc_ = false;                   ///< 是否正在进行GC
+
+    friend class ParallelScavenger;
+    friend class ConcurrentMarker;
+    friend class HeapSnapshotWriter;
 };
 
 } // namespace mjs
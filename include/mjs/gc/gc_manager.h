@@ -19,6 +19,8 @@
 
 #include <iostream>
 #include <memory>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 #include <mjs/noncopyable.h>
@@ -59,9 +61,10 @@ public:
 
     /**
      * @brief 初始化GC管理器
+     * @param config 堆配置（空间大小、新生代自适应策略等）
      * @return 是否初始化成功
      */
-    bool Initialize();
+    bool Initialize(const GCHeapConfig& config = GCHeapConfig());
 
     /**
      * @brief 执行垃圾回收
@@ -85,6 +88,17 @@ public:
     void GetHeapStats(size_t& new_space_used, size_t& new_space_capacity,
                       size_t& old_space_used, size_t& old_space_capacity) const;
 
+    /**
+     * @brief 获取GC堆详细统计信息，包括新生代自适应策略的决策
+     * @param stats 输出的统计信息
+     */
+    void GetHeapStats(GCHeapStats* stats) const;
+
+    /**
+     * @brief 通知GC当前存在内存压力，下一次Scavenge后收缩新生代
+     */
+    void NotifyMemoryPressure();
+
     /**
      * @brief 获取GC统计信息
      * @param total_allocated 总分配字节数
@@ -104,6 +118,55 @@ public:
      */
     void SetGCThreshold(uint8_t threshold);
 
+    /**
+     * @brief 设置Scavenge的线程数
+     * @param thread_count 线程数（包括调用线程），1表示串行Scavenge
+     */
+    void SetScavengeThreads(uint32_t thread_count);
+
+    /**
+     * @brief 开始老年代并发标记（需要在堆配置中启用）
+     * @return 是否开始标记
+     */
+    bool StartConcurrentMarking();
+
+    /**
+     * @brief 增量标记一步，在期限之前处理灰色对象，全部处理完后结束本次标记
+     * @param deadline 期限
+     * @return 本次调用后是否已不在标记期间
+     * @see GCHeap::Step
+     */
+    bool Step(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief 设置堆大小限制
+     * @param soft_limit 软限制，超过时执行完整GC并调用接近上限回调，0表示不限制
+     * @param hard_limit 硬限制，完整GC后仍超过时中断脚本，0表示不限制
+     */
+    void SetHeapLimits(size_t soft_limit, size_t hard_limit);
+
+    /**
+     * @brief 设置接近堆限制的回调
+     * @param callback 回调，为nullptr时取消
+     * @param data 传给回调的用户数据
+     */
+    void SetNearHeapLimitCallback(NearHeapLimitCallback callback, void* data = nullptr);
+
+    /**
+     * @brief 调整外部内存的大小，计入堆限制
+     * @param delta 增加的字节数，释放时为负数
+     * @see GCHeap::AdjustExternalMemory
+     */
+    void AdjustExternalMemory(int64_t delta);
+
+    /**
+     * @brief 空闲通知，在预算内执行一项GC工作
+     * @param budget 时间预算
+     * @return 执行的工作及用时
+     * @see GCHeap::NotifyIdle
+     */
+    GCIdleResult NotifyIdle(std::chrono::nanoseconds budget);
+
     /**
      * @brief 分配指定大小的内存（用于特定类型）
      * @param type 对象类型
@@ -112,13 +175,40 @@ public:
      */
     template <typename ObjectT, typename...Args>
     ObjectT* AllocateObject(Args&&... args) {
+        return AllocateObjectForSite<ObjectT>(nullptr, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 在分配点分配对象，统计分配点的存活率，已预先晋升的分配点直接在老年代分配
+     * @param site 分配点，为nullptr时等同于 AllocateObject
+     * @param args 构造参数
+     * @return 对象指针
+     */
+    template <typename ObjectT, typename...Args>
+    ObjectT* AllocateObjectForSite(AllocationSite* site, Args&&... args) {
         GCGeneration generation;
-        auto size = sizeof(ObjectT);
-        auto* mem = heap_->Allocate(&size, &generation);
+        auto size = sizeof(ObjectT) + GCObjectTraits<ObjectT>::kInObjectSize;
+        auto* mem = heap_->Allocate(&size, &generation, site);
         ObjectT* obj = new (mem) ObjectT(context_, std::forward<Args>(args)...);
-        obj->header()->set_type(GCObjectType::kObject);
         obj->header()->set_generation(generation);
         obj->header()->set_size(size);
+        if constexpr (std::is_base_of_v<Object, ObjectT>) {
+            obj->header()->set_type(GCObjectType::kObject);
+            obj->InitializeGCAllocated(heap_.get(), GCObjectTraits<ObjectT>::kInObjectSize);
+        }
+        else {
+            obj->header()->set_type(GCObjectType::kOther);
+        }
+        if (generation == GCGeneration::kOld) {
+            // 直接分配在老年代的是大对象和预先晋升的对象
+            obj->header()->SetLarge(size >= kLargeObjectThreshold);
+            // 构造时写入的引用没有经过写屏障
+            heap_->RecordWrite(obj);
+            heap_->MarkAllocatedObject(obj);
+        }
+        else if (GCObjectTraits<ObjectT>::kNeedsFinalization) {
+            heap_->RegisterFinalizer(obj);
+        }
         return obj;
     }
 
@@ -146,6 +236,73 @@ public:
      */
     void PrintObjectTree(Context* context);
 
+    /**
+     * @brief 写出堆快照（V8 .heapsnapshot 格式，可载入 Chrome DevTools 查看保留路径）
+     * @param out 输出流
+     * @return 是否写出成功
+     */
+    bool WriteHeapSnapshot(std::ostream& out);
+
+    /**
+     * @brief 写出堆快照到文件
+     * @param path 文件路径
+     * @return 是否写出成功
+     */
+    bool WriteHeapSnapshot(const std::string& path);
+
+    /**
+     * @brief 开始采样分配分析
+     * @param sample_interval 平均采样间隔（字节）
+     * @param stack_depth 最大采集的栈深度
+     */
+    void StartSamplingHeapProfiler(uint64_t sample_interval = kDefaultHeapSampleInterval,
+        uint32_t stack_depth = kDefaultHeapSampleStackDepth);
+
+    /**
+     * @brief 停止采样分配分析，丢弃已采集的数据
+     */
+    void StopSamplingHeapProfiler();
+
+    /**
+     * @brief 写出采样分配分析结果（.heapprofile 格式，可载入 Chrome DevTools）
+     * @param out 输出流
+     * @return 是否写出成功（未开始分析时返回 false）
+     */
+    bool WriteSamplingHeapProfile(std::ostream& out);
+
+    /**
+     * @brief 写出采样分配分析结果到文件
+     * @param path 文件路径
+     * @return 是否写出成功
+     */
+    bool WriteSamplingHeapProfile(const std::string& path);
+
+    /**
+     * @brief 设置GC事件回调，每次Scavenge、完整GC和老年代扩容结束时调用
+     * @param callback 回调，为nullptr时取消
+     * @param data 传给回调的用户数据
+     */
+    void SetGCEventCallback(GCEventCallback callback, void* data = nullptr);
+
+    /**
+     * @brief 开始记录GC事件
+     */
+    void StartGCTracing();
+
+    /**
+     * @brief 停止记录GC事件，写出 Chrome trace-event JSON（可载入 chrome://tracing 或 Perfetto）
+     * @param out 输出流
+     * @return 是否写出成功（未开始记录时返回 false）
+     */
+    bool StopGCTracing(std::ostream& out);
+
+    /**
+     * @brief 停止记录GC事件，写出到文件
+     * @param path 文件路径
+     * @return 是否写出成功
+     */
+    bool StopGCTracing(const std::string& path);
+
 private:
     Context* context_ = nullptr;               ///< 所属上下文
     std::unique_ptr<GCHeap> heap_ = nullptr;   ///< GC堆
@@ -11,12 +11,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <functional>
 
 #include <mjs/noncopyable.h>
 #include <mjs/intrusive_list.hpp>
+#include <mjs/gc/heap_cage.h>
 
 namespace mjs {
 
@@ -50,7 +52,8 @@ enum class GCObjectType : uint8_t {
  * @struct GCObjectHeader
  * @brief GC对象头部结构
  *
- * 每个GC对象在内存中的头部信息，用于GC管理和追踪
+ * 每个GC对象在内存中的头部信息，用于GC管理和追踪。
+ * 启用指针压缩时转发地址为32位偏移，头部为12字节。
  */
 class GCObjectHeader {
 public:
@@ -91,9 +94,9 @@ public:
     /**
      * @brief 检查是否已转发（复制算法中使用）
      * @return 如果已转发返回true
-     * @note 直接通过 forwarding_address_ != nullptr 判断
+     * @note 直接通过转发地址是否为空判断
      */
-    bool IsForwarded() const { return forwarding_address_ != nullptr; }
+    bool IsForwarded() const { return forwarding_ != 0; }
 
     /**
      * @brief 获取转发地址（Scavenge时使用）
@@ -101,7 +104,7 @@ public:
      * @note 使用内联转发指针，避免哈希表查找，提升性能
      */
     GCObject* GetForwardingAddress() const {
-        return forwarding_address_;
+        return DecodeForwarding(forwarding_);
     }
 
     /**
@@ -109,7 +112,42 @@ public:
      * @param addr 转发后的新地址
      */
     void SetForwardingAddress(GCObject* addr) {
-        forwarding_address_ = addr;
+        forwarding_ = EncodeForwarding(addr);
+    }
+
+    /**
+     * @brief 转发地址占位值，表示对象正在被某个线程复制
+     */
+    static GCObject* ForwardingBusy() { return reinterpret_cast<GCObject*>(uintptr_t(1)); }
+
+    /**
+     * @brief 原子读取转发地址（并行Scavenge时使用）
+     * @return 转发地址，未转发返回nullptr，正在复制返回 ForwardingBusy()
+     */
+    GCObject* LoadForwardingAddress() const {
+        return DecodeForwarding(std::atomic_ref<ForwardingWord>(const_cast<ForwardingWord&>(forwarding_)).load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief 尝试取得复制权（并行Scavenge时使用）
+     *
+     * 通过CAS将转发地址从nullptr改为 ForwardingBusy()，成功的线程负责复制对象，
+     * 复制完成后调用 PublishForwardingAddress 发布新地址。
+     *
+     * @return 是否取得复制权
+     */
+    bool TryClaimForwarding() {
+        ForwardingWord expected = 0;
+        return std::atomic_ref<ForwardingWord>(forwarding_).compare_exchange_strong(
+            expected, kForwardingBusyWord, std::memory_order_acq_rel, std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 发布转发地址（并行Scavenge时使用）
+     * @param addr 复制后的新地址，复制失败时传入nullptr释放复制权
+     */
+    void PublishForwardingAddress(GCObject* addr) {
+        std::atomic_ref<ForwardingWord>(forwarding_).store(EncodeForwarding(addr), std::memory_order_release);
     }
 
     /**
@@ -147,9 +185,96 @@ public:
      */
     void SetDestructed(bool d) { destructed_ = d; }
 
+    /**
+     * @brief 检查是否位于大对象空间
+     */
+    bool IsLarge() const { return large_; }
+
+    /**
+     * @brief 设置大对象标记
+     */
+    void SetLarge(bool l) { large_ = l; }
+
+    /**
+     * @brief 获取大小类别（老年代空闲块所在的空闲链表）
+     */
+    uint8_t size_class() const { return static_cast<uint8_t>(size_class_); }
+
+    /**
+     * @brief 设置大小类别
+     */
+    void set_size_class(uint8_t size_class) { size_class_ = size_class; }
+
+    /**
+     * @brief 检查是否已记录到记忆集
+     */
+    bool IsRemembered() const { return remembered_; }
+
+    /**
+     * @brief 设置记忆集标记
+     */
+    void SetRemembered(bool r) { remembered_ = r; }
+
+    /**
+     * @brief 检查并发标记是否已扫描过该对象的子引用
+     * @note 已标记但未扫描的对象是灰色对象，已扫描的对象是黑色对象
+     */
+    bool IsScanned() const { return scanned_; }
+
+    /**
+     * @brief 设置扫描标记
+     */
+    void SetScanned(bool s) { scanned_ = s; }
+
+    /**
+     * @brief 检查是否已登记到新生代析构列表
+     */
+    bool IsFinalizable() const { return finalizable_; }
+
+    /**
+     * @brief 设置析构登记标记
+     */
+    void SetFinalizable(bool f) { finalizable_ = f; }
+
 private:
+#ifdef ENABLE_POINTER_COMPRESSION
+    using ForwardingWord = uint32_t;    ///< 转发地址保存为堆笼内的32位偏移
+#else
+    using ForwardingWord = uintptr_t;
+#endif
+
+    static constexpr ForwardingWord kForwardingBusyWord = 1;   ///< ForwardingBusy() 的编码
+
+    /**
+     * @brief 将转发地址编码为转发字
+     */
+    static ForwardingWord EncodeForwarding(GCObject* addr) {
+        if (addr == ForwardingBusy()) {
+            return kForwardingBusyWord;
+        }
+#ifdef ENABLE_POINTER_COMPRESSION
+        return CompressHeapPointer(addr);
+#else
+        return reinterpret_cast<ForwardingWord>(addr);
+#endif
+    }
+
+    /**
+     * @brief 将转发字解码为转发地址
+     */
+    static GCObject* DecodeForwarding(ForwardingWord word) {
+#ifdef ENABLE_POINTER_COMPRESSION
+        if (word == kForwardingBusyWord) {
+            return ForwardingBusy();
+        }
+        return static_cast<GCObject*>(DecompressHeapPointer(word));
+#else
+        return reinterpret_cast<GCObject*>(word);
+#endif
+    }
+
     union {
-        uint64_t word_ = 0;     ///< 完整32位值
+        uint32_t word_ = 0;     ///< 完整32位值
         struct {
             uint32_t type_ : 8;          ///< 对象类型 (GCObjectType)
             uint32_t generation_ : 1;    ///< 所在代际 (0=新生代, 1=老年代)
@@ -157,12 +282,16 @@ private:
             uint32_t pinned_ : 1;        ///< 固定标记（不移动）
             uint32_t destructed_ : 1;    ///< 析构标记（析构函数已调用）
             uint32_t age_ : 4;           ///< 年龄（用于晋升判断）
-            uint32_t size_class_ : 8;    ///< 大小类别（用于快速分配）
-            uint32_t reserved_ : 8;      ///< 保留位
-            uint32_t size_;          ///< 对象总大小（包含头部）
+            uint32_t size_class_ : 8;    ///< 大小类别（老年代空闲链表）
+            uint32_t remembered_ : 1;    ///< 记忆集标记（老年代对象可能引用新生代对象）
+            uint32_t scanned_ : 1;       ///< 扫描标记（并发标记时子引用已扫描）
+            uint32_t large_ : 1;         ///< 大对象标记（位于大对象空间，不会移动）
+            uint32_t finalizable_ : 1;   ///< 析构登记标记（新生代对象死亡时需要调用析构函数）
+            uint32_t reserved_ : 4;      ///< 保留位
         };
     };
-    GCObject* forwarding_address_ = nullptr;   ///< 转发地址（Scavenge期间使用，避免哈希表查找）
+    uint32_t size_ = 0;                 ///< 对象总大小（包含头部）
+    ForwardingWord forwarding_ = 0;     ///< 转发地址（Scavenge期间使用，避免哈希表查找），启用指针压缩时为32位偏移
 };
 
 /**
@@ -215,6 +344,22 @@ protected:
     GCObjectHeader header_;     ///< 对象头部
 };
 
+/**
+ * @struct GCObjectTraits
+ * @brief GC对象类型特征
+ *
+ * Scavenge 不遍历死亡对象，新生代对象只有登记了析构才会调用析构函数。
+ * 默认所有类型在分配时登记；不持有堆外资源的类型可以特化为不登记，
+ * 之后获得堆外资源时再自行登记（见 GCHeap::RegisterFinalizer）。
+ *
+ * @tparam ObjectT 对象类型，特化只对该类型本身生效，不会被派生类继承
+ */
+template <typename ObjectT>
+struct GCObjectTraits {
+    static constexpr size_t kInObjectSize = 0;          ///< 分配时在对象之后额外预留的字节数
+    static constexpr bool kNeedsFinalization = true;    ///< 分配时是否登记析构
+};
+
 /**
  * @brief GC对象最小对齐大小
  */
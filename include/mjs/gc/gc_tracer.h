@@ -0,0 +1,243 @@
+/**
+ * @file gc_tracer.h
+ * @brief GC事件追踪与停顿时间直方图
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件定义了GC事件追踪器：
+ * - 每次Scavenge、完整GC（标记后清除或压缩）和老年代扩容生成一个结构化事件，
+ *   记录起止时间、晋升和回收的字节数及各阶段用时
+ * - 事件通过宿主注册的回调逐个交付
+ * - HDR 风格（对数分段、段内线性）的停顿时间直方图，用于计算 p99 等分位数
+ * - 可选地以 Chrome trace-event JSON 格式记录事件，载入 chrome://tracing 或 Perfetto 查看
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include <mjs/noncopyable.h>
+
+namespace mjs {
+
+class Context;
+
+/**
+ * @enum GCEventKind
+ * @brief GC事件的种类
+ */
+enum class GCEventKind : uint8_t {
+    kScavenge = 0,  ///< 新生代复制GC
+    kMarkSweep,     ///< 老年代标记后惰性清除
+    kMarkCompact,   ///< 老年代标记后压缩
+    kExpand,        ///< 老年代扩容（并行Scavenge的工作线程扩容时不生成事件）
+};
+
+/**
+ * @enum GCPhase
+ * @brief GC事件中的阶段
+ */
+enum class GCPhase : uint8_t {
+    kRoots = 0,     ///< 扫描根集合和记忆集（并行Scavenge时计入复制阶段）
+    kCopy,          ///< 复制和晋升存活对象
+    kMark,          ///< 标记（并发标记时为最终标记）
+    kCompact,       ///< 计算转发地址、更新引用并移动对象
+    kSweep,         ///< 调用死亡对象的析构函数（惰性清除时只包括开始清除和大对象的回收）
+    kCount,
+};
+
+/**
+ * @brief GC阶段的数量
+ */
+constexpr size_t kGCPhaseCount = static_cast<size_t>(GCPhase::kCount);
+
+/**
+ * @brief 获取GC事件种类的名称
+ */
+const char* GCEventKindName(GCEventKind kind);
+
+/**
+ * @brief 获取GC阶段的名称
+ */
+const char* GCPhaseName(GCPhase phase);
+
+/**
+ * @struct GCEvent
+ * @brief 一次GC事件
+ */
+struct GCEvent {
+    GCEventKind kind = GCEventKind::kScavenge;          ///< 事件种类
+    std::chrono::steady_clock::time_point start{};      ///< 开始时间
+    std::chrono::steady_clock::time_point end{};        ///< 结束时间
+    size_t promoted_bytes = 0;                          ///< 晋升到老年代的字节数
+    size_t freed_bytes = 0;                             ///< 回收的字节数
+    size_t expanded_bytes = 0;                          ///< 老年代扩容的字节数
+    std::array<std::chrono::steady_clock::duration, kGCPhaseCount> phases{};  ///< 各阶段用时
+
+    /**
+     * @brief 记录一个阶段的用时（同一阶段多次记录时累加）
+     * @param phase 阶段
+     * @param phase_start 阶段开始时间
+     * @return 当前时间，作为下一个阶段的开始时间
+     */
+    std::chrono::steady_clock::time_point RecordPhase(GCPhase phase, std::chrono::steady_clock::time_point phase_start) {
+        auto now = std::chrono::steady_clock::now();
+        phases[static_cast<size_t>(phase)] += now - phase_start;
+        return now;
+    }
+
+    /**
+     * @brief 获取阶段用时
+     */
+    std::chrono::steady_clock::duration phase(GCPhase phase) const { return phases[static_cast<size_t>(phase)]; }
+
+    /**
+     * @brief 获取事件总用时
+     */
+    std::chrono::steady_clock::duration elapsed() const { return end - start; }
+};
+
+/**
+ * @brief GC事件回调函数类型
+ *
+ * 在GC结束前调用，回调中不能分配GC对象或触发GC。
+ *
+ * @param context 堆所属的上下文
+ * @param event GC事件
+ * @param data 用户数据
+ */
+using GCEventCallback = void (*)(Context* context, const GCEvent& event, void* data);
+
+/**
+ * @class GCPauseHistogram
+ * @brief HDR 风格的停顿时间直方图（微秒）
+ *
+ * 小于 kSubBucketCount 的值逐个计数；更大的值按最高位分段，每段再线性划分为 kSubBucketCount / 2 个区间，
+ * 相对误差不超过 2 / kSubBucketCount。直方图大小固定，记录为 O(1)。
+ */
+class GCPauseHistogram {
+public:
+    static constexpr uint32_t kSubBucketBits = 7;                       ///< 段内区间数的位数
+    static constexpr uint64_t kSubBucketCount = uint64_t(1) << kSubBucketBits;
+    static constexpr uint64_t kSubBucketHalfCount = kSubBucketCount / 2;
+    static constexpr uint32_t kMaxValueBits = 40;                       ///< 可记录的最大值的位数（约12天）
+    static constexpr uint64_t kMaxValue = (uint64_t(1) << kMaxValueBits) - 1;
+    static constexpr size_t kBucketCount = kSubBucketCount + (kMaxValueBits - kSubBucketBits) * kSubBucketHalfCount;
+
+    /**
+     * @brief 记录一个值，超过 kMaxValue 时按 kMaxValue 记录
+     * @param value 停顿时间（微秒）
+     */
+    void Record(uint64_t value);
+
+    /**
+     * @brief 获取分位数
+     * @param percentile 百分位（0 - 100）
+     * @return 不小于该比例记录值的最小区间上限（微秒），没有记录时返回0
+     */
+    uint64_t Percentile(double percentile) const;
+
+    /**
+     * @brief 清空直方图
+     */
+    void Reset();
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(total_) / count_ : 0; }
+
+private:
+    /**
+     * @brief 获取值所在区间的下标
+     */
+    static size_t IndexOf(uint64_t value);
+
+    /**
+     * @brief 获取区间内的最大值
+     */
+    static uint64_t HighestValueOf(size_t index);
+
+    std::array<uint32_t, kBucketCount> counts_{};
+    uint64_t count_ = 0;
+    uint64_t total_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+};
+
+/**
+ * @class GCTracer
+ * @brief GC事件追踪器
+ *
+ * 由 GCHeap 持有，每个Context一个。GCHeap 在每次GC结束时调用 RecordEvent，在每次停顿结束时调用 RecordPause。
+ */
+class GCTracer : public noncopyable {
+public:
+    /**
+     * @brief 设置GC事件回调
+     * @param callback 回调，为nullptr时取消
+     * @param data 传给回调的用户数据
+     */
+    void SetEventCallback(GCEventCallback callback, void* data) {
+        event_callback_ = callback;
+        event_data_ = data;
+    }
+
+    /**
+     * @brief 结束并记录一次GC事件：设置结束时间，追踪时保存事件，之后调用回调
+     * @param context 堆所属的上下文
+     * @param event GC事件
+     */
+    void RecordEvent(Context* context, GCEvent* event);
+
+    /**
+     * @brief 记录一次停顿
+     */
+    void RecordPause(std::chrono::steady_clock::duration pause) {
+        pause_histogram_.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(pause).count()));
+    }
+
+    /**
+     * @brief 获取停顿时间直方图
+     */
+    const GCPauseHistogram& pause_histogram() const { return pause_histogram_; }
+
+    /**
+     * @brief 开始以 Chrome trace-event 格式记录事件（已开始时丢弃之前的事件）
+     */
+    void StartTracing();
+
+    /**
+     * @brief 停止记录，以 Chrome trace-event JSON 格式写出记录的事件
+     * @param out 输出流
+     * @return 是否写出成功（未开始记录时返回 false）
+     */
+    bool StopTracing(std::ostream& out);
+
+    /**
+     * @brief 是否正在记录事件
+     */
+    bool tracing() const { return tracing_; }
+
+    /**
+     * @brief 获取累计的GC事件数
+     */
+    uint64_t event_count() const { return event_count_; }
+
+private:
+    GCEventCallback event_callback_ = nullptr;  ///< GC事件回调
+    void* event_data_ = nullptr;                ///< GC事件回调的用户数据
+    uint64_t event_count_ = 0;                  ///< 累计的GC事件数
+    GCPauseHistogram pause_histogram_;          ///< 停顿时间直方图
+
+    bool tracing_ = false;                                  ///< 是否正在记录事件
+    std::chrono::steady_clock::time_point trace_start_{};  ///< 开始记录的时间，作为时间戳的零点
+    std::vector<GCEvent> trace_events_;                     ///< 记录的事件
+};
+
+} // namespace mjs
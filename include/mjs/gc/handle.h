@@ -26,6 +26,7 @@ namespace mjs {
 
 class Context;
 class GCManager;
+class AllocationSite;
 
 /**
  * @class HandleScopeBase
@@ -232,6 +233,24 @@ public:
         return GCHandle<T>(gc_obj);
     }
 
+    /**
+     * @brief 在分配点创建新对象并返回句柄
+     * @param site 分配点
+     * @param args 构造参数
+     * @see GCManager::AllocateObjectForSite
+     */
+    template<typename T, typename... Args>
+    GCHandle<T> NewForSite(AllocationSite* site, Args&&... args) {
+        assert(size_ < Capacity && "HandleScope capacity exceeded");
+
+        GCManager& gc_mgr = context_->gc_manager();
+        T* ptr = gc_mgr.template AllocateObjectForSite<T>(site, std::forward<Args>(args)...);
+
+        GCObject* gc_obj = static_cast<GCObject*>(ptr);
+        handles_[size_++] = gc_obj;
+        return GCHandle<T>(gc_obj);
+    }
+
     /**
      * @brief 创建一个新句柄（从已有对象）
      * @tparam T 对象类型
@@ -0,0 +1,208 @@
+/**
+ * @file heap_cage.h
+ * @brief 指针压缩的堆笼
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件定义了堆笼（heap cage）：进程内唯一的一段 4GB 保留地址空间，按需提交。
+ * 笼内的地址可以表示为相对于起始地址的32位偏移（压缩指针），偏移0表示空指针。
+ *
+ * 启用 ENABLE_POINTER_COMPRESSION 构建选项时：
+ * - GC堆的内存（新生代、老年代的页、大对象）和形状都从堆笼中分配
+ * - GCObjectHeader 的转发地址和 Object 的形状指针保存为压缩指针
+ * 所有上下文共享同一个堆笼，GC堆的总大小不能超过 4GB。
+ * 未启用时GC堆直接向操作系统映射内存，HeapPointer 即为普通指针。
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+#include <mjs/noncopyable.h>
+
+namespace mjs {
+
+/**
+ * @brief 堆笼的大小，压缩指针为32位偏移
+ */
+constexpr size_t kHeapCageSize = size_t(1) << 32;
+
+/**
+ * @class HeapCage
+ * @brief 堆笼
+ *
+ * 页级内存按首次适应从空闲区间中分配，释放时取消提交并与相邻的空闲区间合并；
+ * 小块内存（形状等）从按大小分级的空闲链表中分配。
+ * 第一页始终保留不提交，笼内有效对象的偏移不会是0或1（见 GCObjectHeader 的转发地址占位值）。
+ */
+class HeapCage : public noncopyable {
+public:
+    static constexpr size_t kCellAlignment = 16;                ///< 小块的对齐大小
+    static constexpr size_t kMaxCellSize = 256;                 ///< 小块的最大大小
+    static constexpr size_t kCellChunkSize = 64 * 1024;         ///< 每次为小块提交的内存大小
+
+    /**
+     * @brief 获取进程内唯一的堆笼，首次调用时保留地址空间
+     */
+    static HeapCage& Instance();
+
+    /**
+     * @brief 分配并提交一段内存
+     * @param size 大小，向上对齐到页大小
+     * @return 起始地址（按页对齐，内容为0），地址空间耗尽时返回nullptr
+     */
+    void* Allocate(size_t size);
+
+    /**
+     * @brief 释放 Allocate 分配的内存
+     * @param address 起始地址
+     * @param size 分配时的大小
+     */
+    void Free(void* address, size_t size);
+
+    /**
+     * @brief 分配一个小块
+     * @param size 大小，超过 kMaxCellSize 时按页分配
+     * @return 起始地址（按 kCellAlignment 对齐），失败时抛出 std::bad_alloc
+     */
+    void* AllocateCell(size_t size);
+
+    /**
+     * @brief 释放 AllocateCell 分配的小块
+     * @param address 起始地址
+     * @param size 分配时的大小
+     */
+    void FreeCell(void* address, size_t size);
+
+    /**
+     * @brief 检查地址是否位于堆笼内
+     */
+    bool Contains(const void* address) const {
+        auto* ptr = static_cast<const uint8_t*>(address);
+        return ptr >= base_ && ptr < base_ + kHeapCageSize;
+    }
+
+    /**
+     * @brief 获取已提交的字节数
+     */
+    size_t committed_size() const;
+
+    /**
+     * @brief 获取堆笼的起始地址，未创建时返回nullptr
+     */
+    static uint8_t* base() { return base_; }
+
+private:
+    HeapCage();
+
+    /**
+     * @brief 分配并提交一段内存（调用者持有锁）
+     */
+    void* AllocateLocked(size_t size);
+
+    /**
+     * @brief 获取小块的大小类别
+     */
+    static size_t CellClassOf(size_t size) { return (size + kCellAlignment - 1) / kCellAlignment - 1; }
+
+    struct FreeCellNode {
+        FreeCellNode* next;
+    };
+
+    static inline uint8_t* base_ = nullptr;     ///< 堆笼的起始地址
+
+    mutable std::mutex mutex_;
+    size_t top_ = 0;                            ///< 从未分配过的区域的起始偏移
+    size_t committed_size_ = 0;                 ///< 已提交的字节数
+    std::map<size_t, size_t> free_ranges_;      ///< 空闲区间（偏移 -> 大小），按偏移排序以便合并
+    FreeCellNode* free_cells_[kMaxCellSize / kCellAlignment] = {};  ///< 各大小类别的空闲小块链表
+    uint8_t* cell_top_ = nullptr;               ///< 当前小块内存的分配位置
+    uint8_t* cell_end_ = nullptr;               ///< 当前小块内存的结束位置
+};
+
+/**
+ * @brief 将堆笼内的地址压缩为32位偏移
+ * @param address 堆笼内的地址，或nullptr
+ * @return 偏移，nullptr为0
+ */
+inline uint32_t CompressHeapPointer(const void* address) {
+    if (!address) {
+        return 0;
+    }
+    assert(HeapCage::Instance().Contains(address));
+    return static_cast<uint32_t>(static_cast<const uint8_t*>(address) - HeapCage::base());
+}
+
+/**
+ * @brief 将32位偏移解压为地址
+ * @param offset CompressHeapPointer 返回的偏移
+ * @return 地址，偏移为0时返回nullptr
+ */
+inline void* DecompressHeapPointer(uint32_t offset) {
+    return offset ? HeapCage::base() + offset : nullptr;
+}
+
+/**
+ * @class CompressedPointer
+ * @brief 指向堆笼内对象的32位压缩指针
+ * @tparam T 指向的类型
+ */
+template <typename T>
+class CompressedPointer {
+public:
+    CompressedPointer() = default;
+    CompressedPointer(T* pointer) : offset_(CompressHeapPointer(pointer)) {}
+
+    CompressedPointer& operator=(T* pointer) {
+        offset_ = CompressHeapPointer(pointer);
+        return *this;
+    }
+
+    T* get() const { return static_cast<T*>(DecompressHeapPointer(offset_)); }
+
+    operator T*() const { return get(); }
+
+    T* operator->() const { return get(); }
+
+    T& operator*() const { return *get(); }
+
+    /**
+     * @brief 获取偏移
+     */
+    uint32_t offset() const { return offset_; }
+
+private:
+    uint32_t offset_ = 0;   ///< 相对于堆笼起始地址的偏移
+};
+
+/**
+ * @brief GC堆内的引用：启用指针压缩时为32位压缩指针，否则为普通指针
+ */
+#ifdef ENABLE_POINTER_COMPRESSION
+template <typename T>
+using HeapPointer = CompressedPointer<T>;
+#else
+template <typename T>
+using HeapPointer = T*;
+#endif
+
+/**
+ * @brief 为GC堆分配一段内存：启用指针压缩时从堆笼中分配，否则直接向操作系统映射
+ * @param size 大小，向上对齐到页大小
+ * @return 起始地址（按页对齐，内容为0），失败返回nullptr
+ */
+void* AllocateHeapMemory(size_t size);
+
+/**
+ * @brief 释放 AllocateHeapMemory 分配的内存
+ * @param address 起始地址
+ * @param size 分配时的大小
+ */
+void FreeHeapMemory(void* address, size_t size);
+
+} // namespace mjs
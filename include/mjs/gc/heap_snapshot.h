@@ -0,0 +1,180 @@
+/**
+ * @file heap_snapshot.h
+ * @brief 堆快照
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件定义了堆快照写入器，以 V8 的 .heapsnapshot JSON 格式输出GC堆中的对象图，
+ * 可以直接载入 Chrome DevTools 的 Memory 面板查看对象的大小和保留路径：
+ * - 节点：GC根（合成节点）、GC堆中的每个存活对象、对象引用的形状
+ * - 边：属性名（来自常量池）、数组下标、形状以及其他内部引用
+ * - 节点和边在遍历堆的同时直接写出，节点序号临时存放在对象头的转发地址中，
+ *   额外内存只与不同形状和字符串的数量有关，与对象数量无关
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <mjs/noncopyable.h>
+#include <mjs/constant.h>
+
+namespace mjs {
+
+class Context;
+class GCHeap;
+class GCObject;
+class Object;
+class Shape;
+class Value;
+
+/**
+ * @brief 写出转义后的 JSON 字符串（含引号）
+ * @param out 输出流
+ * @param str 字符串
+ */
+void WriteJsonString(std::ostream& out, std::string_view str);
+
+/**
+ * @class HeapSnapshotWriter
+ * @brief 以 V8 .heapsnapshot 格式流式写出堆快照
+ *
+ * 写入前堆中只能剩下存活对象（由 GCHeap::WriteHeapSnapshot 先执行完整GC并完成清除），
+ * 写入期间不能分配GC对象。
+ */
+class HeapSnapshotWriter : public noncopyable {
+public:
+    /**
+     * @brief 构造函数
+     * @param heap GC堆
+     * @param out 输出流
+     */
+    HeapSnapshotWriter(GCHeap* heap, std::ostream& out);
+
+    /**
+     * @brief 写出快照
+     * @return 输出流是否仍然有效
+     */
+    bool Write();
+
+private:
+    /**
+     * @brief 遍历子引用时的处理方式
+     */
+    enum class VisitMode {
+        kCount,     ///< 只统计边数
+        kWrite,     ///< 写出边
+    };
+
+    /**
+     * @brief 遍历GC堆中的所有对象（跳过空闲块和填充对象）
+     */
+    template <typename Func>
+    void ForEachObject(Func func);
+
+    /**
+     * @brief 为存活对象分配节点序号，并收集对象引用的形状
+     */
+    void AssignNodeIndices();
+
+    /**
+     * @brief 清除临时存放在转发地址中的节点序号
+     */
+    void ClearNodeIndices();
+
+    /**
+     * @brief 统计边的总数
+     */
+    void CountEdges();
+
+    void WriteHeader();
+    void WriteNodes();
+    void WriteEdges();
+    void WriteStrings();
+
+    /**
+     * @brief 写出一个节点
+     */
+    void WriteNode(uint32_t type, std::string_view name, uint32_t index, size_t self_size, uint32_t edge_count);
+
+    /**
+     * @brief 写出一条边
+     * @param name_or_index 属性名在字符串表中的下标，或元素下标
+     */
+    void WriteEdge(uint32_t type, uint32_t name_or_index, uint32_t to_index);
+
+    /**
+     * @brief 获取对象的边数（子引用 + 形状）
+     */
+    uint32_t ObjectEdgeCount(Object* obj);
+
+    /**
+     * @brief 写出对象的所有边
+     */
+    void WriteObjectEdges(Object* obj);
+
+    /**
+     * @brief 处理对象的一个子引用
+     */
+    void VisitChild(Value* child);
+
+    /**
+     * @brief GCTraverse 回调，转发到当前线程正在写出的快照
+     */
+    static void TraverseCallback(Context* context, Value* child);
+
+    /**
+     * @brief 获取对象的节点类型和名称
+     */
+    void DescribeObject(Object* obj, uint32_t* type, std::string* name);
+
+    /**
+     * @brief 获取常量池中属性名的字符串
+     */
+    std::string PropertyName(ConstIndex const_index);
+
+    /**
+     * @brief 获取已分配节点序号的对象的序号
+     * @return 对象不在GC堆中时返回 false
+     */
+    static bool NodeIndex(GCObject* obj, uint32_t* index);
+
+    /**
+     * @brief 获取形状的节点序号
+     */
+    uint32_t ShapeIndex(Shape* shape) const;
+
+    /**
+     * @brief 将字符串加入字符串表
+     * @return 字符串在表中的下标
+     */
+    uint32_t InternString(std::string_view str);
+
+    GCHeap* heap_;
+    Context* context_;
+    std::ostream& out_;
+
+    uint32_t object_count_ = 0;    ///< 存活对象数量（节点序号 1 ~ object_count_）
+    uint32_t root_count_ = 0;      ///< 根引用数量
+    size_t edge_count_ = 0;        ///< 边的总数
+    bool first_item_ = true;       ///< 当前数组是否尚未写出元素
+
+    std::vector<Shape*> shapes_;                           ///< 对象引用的形状及其祖先
+    std::unordered_map<Shape*, uint32_t> shape_indices_;   ///< 形状在 shapes_ 中的下标
+
+    std::vector<std::string> strings_;                             ///< 字符串表
+    std::unordered_map<std::string, uint32_t> string_indices_;     ///< 字符串在表中的下标
+
+    // 遍历当前对象子引用时的状态
+    VisitMode visit_mode_ = VisitMode::kCount;
+    Object* visit_object_ = nullptr;   ///< 当前对象
+    uint32_t visit_edges_ = 0;         ///< 当前对象已处理的边数
+};
+
+} // namespace mjs
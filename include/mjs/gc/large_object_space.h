@@ -0,0 +1,125 @@
+/**
+ * @file large_object_space.h
+ * @brief 大对象空间定义
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件定义了大对象空间（LargeObjectSpace）。大小超过 kLargeObjectThreshold 的对象各自占用
+ * 一段单独映射的内存，属于老年代但从不移动：老年代压缩不会复制它们，死亡后直接解除映射。
+ */
+
+#pragma once
+
+#include <mjs/noncopyable.h>
+#include <mjs/intrusive_list.hpp>
+#include <mjs/gc/gc_object.h>
+
+namespace mjs {
+
+/**
+ * @class LargeObjectChunk
+ * @brief 大对象所在的映射内存块头部，对象紧随其后
+ */
+class LargeObjectChunk : public intrusive_list<LargeObjectChunk>::node {
+public:
+    LargeObjectChunk(size_t mapped_size, size_t object_size)
+        : mapped_size_(mapped_size), object_size_(object_size) {}
+
+    /**
+     * @brief 获取块中的对象
+     */
+    GCObject* object() {
+        return reinterpret_cast<GCObject*>(reinterpret_cast<uint8_t*>(this) + kHeaderSize);
+    }
+
+    /**
+     * @brief 获取映射的内存大小（包括块头部）
+     */
+    size_t mapped_size() const { return mapped_size_; }
+
+    /**
+     * @brief 获取分配给对象的大小
+     */
+    size_t object_size() const { return object_size_; }
+
+    /**
+     * @brief 块头部大小，保证对象按 kGCObjectAlignment 对齐
+     */
+    static const size_t kHeaderSize;
+
+private:
+    size_t mapped_size_;    ///< 映射的内存大小
+    size_t object_size_;    ///< 分配给对象的大小
+};
+
+/**
+ * @class LargeObjectSpace
+ * @brief 大对象空间
+ *
+ * 每个大对象单独映射一段内存，块通过侵入式链表串联。
+ * 对象的代际为老年代，参与老年代的标记；标记结束后由 Sweep 回收未标记的对象。
+ */
+class LargeObjectSpace : public noncopyable {
+public:
+    LargeObjectSpace() = default;
+
+    /**
+     * @brief 析构函数，解除所有块的映射
+     */
+    ~LargeObjectSpace();
+
+    /**
+     * @brief 分配内存
+     * @param size 分配大小，输出对齐后的大小
+     * @return 对象内存地址，失败返回nullptr
+     */
+    void* Allocate(size_t* size);
+
+    /**
+     * @brief 回收未标记的对象：调用析构函数并解除映射
+     * @return 回收的字节数
+     */
+    size_t Sweep();
+
+    /**
+     * @brief 对象回调函数类型
+     */
+    using ObjectCallback = void (*)(GCObject* obj, void* data);
+
+    /**
+     * @brief 遍历所有对象
+     */
+    void IterateObjects(ObjectCallback callback, void* data);
+
+    /**
+     * @brief 遍历所有存活对象（已标记）
+     */
+    void IterateLiveObjects(ObjectCallback callback, void* data);
+
+    /**
+     * @brief 获取对象占用的总字节数
+     */
+    size_t used_size() const { return used_size_; }
+
+    /**
+     * @brief 获取映射的总字节数
+     */
+    size_t mapped_size() const { return mapped_size_; }
+
+    /**
+     * @brief 获取对象数量
+     */
+    size_t object_count() const { return object_count_; }
+
+private:
+    void FreeChunk(LargeObjectChunk* chunk);
+
+private:
+    intrusive_list<LargeObjectChunk> chunks_;   ///< 所有块
+    size_t used_size_ = 0;                      ///< 对象占用的总字节数
+    size_t mapped_size_ = 0;                    ///< 映射的总字节数
+    size_t object_count_ = 0;                   ///< 对象数量
+};
+
+} // namespace mjs
@@ -0,0 +1,55 @@
+/**
+ * @file native_memory.h
+ * @brief 原生对象内存统计
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件定义了引用计数管理的原生对象（String、ClosureVar）的内存统计。
+ * 这些对象不在GC堆中分配，创建时不知道所属的 Context，因此按进程统计，
+ * 由 GCHeap 计入堆大小以执行堆限制。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace mjs {
+
+/**
+ * @class NativeMemory
+ * @brief 引用计数原生对象占用的字节数（进程内共享）
+ *
+ * @note 同一进程中的所有 Context 共享该统计，多个 Context 并存时堆限制会偏保守
+ */
+class NativeMemory {
+public:
+    /**
+     * @brief 记录分配
+     * @param size 分配的字节数
+     */
+    static void Allocate(size_t size) {
+        bytes_.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 记录释放
+     * @param size 释放的字节数
+     */
+    static void Free(size_t size) {
+        bytes_.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 获取当前占用的字节数
+     */
+    static size_t bytes() {
+        return bytes_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static inline std::atomic<size_t> bytes_ = 0;
+};
+
+} // namespace mjs
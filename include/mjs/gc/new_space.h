@@ -16,17 +16,17 @@
 namespace mjs {
 
 /**
- * @brief 新生代总大小（512KB）
+ * @brief 新生代默认总大小（512KB），可通过 GCHeapConfig 按 Context 配置
  */
 constexpr size_t kNewSpaceTotalSize = 512 * 1024;
 
 /**
- * @brief Eden区大小比例（80%）
+ * @brief Eden区默认大小比例（80%）
  */
 constexpr size_t kEdenSpaceRatio = 8;
 
 /**
- * @brief Survivor区大小比例（各10%）
+ * @brief Survivor区默认大小比例（各10%）
  */
 constexpr size_t kSurvivorSpaceRatio = 1;
 
@@ -36,12 +36,12 @@ constexpr size_t kSurvivorSpaceRatio = 1;
 constexpr size_t kTotalSpaceRatio = 10;
 
 /**
- * @brief Eden区大小
+ * @brief Eden区默认大小
  */
 constexpr size_t kEdenSpaceSize = kNewSpaceTotalSize * kEdenSpaceRatio / kTotalSpaceRatio;
 
 /**
- * @brief Survivor区大小（每个）
+ * @brief Survivor区默认大小（每个）
  */
 constexpr size_t kSurvivorSpaceSize = kNewSpaceTotalSize * kSurvivorSpaceRatio / kTotalSpaceRatio;
 
@@ -70,9 +70,23 @@ public:
 
     /**
      * @brief 初始化新生代空间
+     * @param eden_size Eden区大小
+     * @param survivor_size 每个Survivor区的大小
      * @return 是否初始化成功
      */
-    bool Initialize();
+    bool Initialize(size_t eden_size = kEdenSpaceSize, size_t survivor_size = kSurvivorSpaceSize);
+
+    /**
+     * @brief 调整新生代大小（Scavenge结束后调用）
+     *
+     * Eden区此时为空，Survivor To区中只剩交换前的死对象，二者直接重新分配；
+     * Survivor From区中还有存活对象，保持原大小，等下一次Scavenge交换成To区后再调整。
+     *
+     * @param eden_size 新的Eden区大小
+     * @param survivor_size 新的Survivor区大小
+     * @return 是否调整成功，失败时保持原大小
+     */
+    bool Resize(size_t eden_size, size_t survivor_size);
 
     /**
      * @brief 分配内存（在Eden区）
@@ -108,7 +122,7 @@ public:
     /**
      * @brief 获取Eden区结束地址
      */
-    uint8_t* eden_space_end() const { return eden_space_ + kEdenSpaceSize; }
+    uint8_t* eden_space_end() const { return eden_space_ + eden_size_; }
 
     /**
      * @brief 获取Survivor From区起始地址
@@ -118,7 +132,7 @@ public:
     /**
      * @brief 获取Survivor From区结束地址
      */
-    uint8_t* survivor_from_end() const { return survivor_from_ + kSurvivorSpaceSize; }
+    uint8_t* survivor_from_end() const { return survivor_from_ + survivor_from_size_; }
 
     /**
      * @brief 获取Survivor From区当前分配位置
@@ -133,13 +147,21 @@ public:
     /**
      * @brief 获取Survivor To区结束地址
      */
-    uint8_t* survivor_to_end() const { return survivor_to_ + kSurvivorSpaceSize; }
+    uint8_t* survivor_to_end() const { return survivor_to_ + survivor_to_size_; }
 
     /**
      * @brief 获取Survivor To区当前分配位置
      */
     uint8_t* survivor_to_top() const { return survivor_to_top_; }
 
+    /**
+     * @brief 检查地址是否位于Survivor To区（即本次Scavenge中已复制的对象）
+     */
+    bool InToSpace(const void* ptr) const {
+        auto* p = static_cast<const uint8_t*>(ptr);
+        return p >= survivor_to_ && p < survivor_to_ + survivor_to_size_;
+    }
+
     /**
      * @brief 交换Survivor From和To区
      */
@@ -181,10 +203,20 @@ public:
                static_cast<size_t>(survivor_from_top_ - survivor_from_);
     }
 
+    /**
+     * @brief 获取Eden区大小
+     */
+    size_t eden_size() const { return eden_size_; }
+
+    /**
+     * @brief 获取Survivor区大小（To区调整后的目标大小）
+     */
+    size_t survivor_size() const { return survivor_to_size_; }
+
     /**
      * @brief 获取总容量
      */
-    static constexpr size_t capacity() { return kNewSpaceTotalSize; }
+    size_t capacity() const { return eden_size_ + survivor_from_size_ + survivor_to_size_; }
 
 private:
     uint8_t* eden_space_ = nullptr;         ///< Eden区（新对象分配）
@@ -193,6 +225,9 @@ private:
     uint8_t* eden_top_ = nullptr;           ///< Eden区当前分配位置
     uint8_t* survivor_from_top_ = nullptr;  ///< Survivor From区当前分配位置
     uint8_t* survivor_to_top_ = nullptr;    ///< Survivor To区当前分配位置（GC时使用）
+    size_t eden_size_ = 0;                  ///< Eden区大小
+    size_t survivor_from_size_ = 0;         ///< Survivor From区大小
+    size_t survivor_to_size_ = 0;           ///< Survivor To区大小
 };
 
 } // namespace mjs
@@ -5,11 +5,18 @@
  * @copyright Copyright (c) 2025 yuyuaqwq
  * @license MIT License
  *
- * 本文件定义了老年代内存空间（OldSpace），使用标记-压缩算法进行GC。
+ * 本文件定义了老年代内存空间（OldSpace）。老年代由固定大小的页组成，扩容只需映射新的页，
+ * 不会移动已有对象。支持两种回收方式：
+ * - 标记-清除：死亡对象在之后的分配中惰性清除，相邻的死亡对象合并为空闲块，
+ *   按大小类别放入空闲链表，存活对象不移动，完全空闲的页归还给操作系统
+ * - 标记-压缩：碎片过多时按页顺序移动存活对象，消除所有空闲块，之后空出的页归还给操作系统
  */
 
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include <mjs/noncopyable.h>
 #include <mjs/gc/gc_object.h>
 
@@ -20,15 +27,92 @@ namespace mjs {
  */
 constexpr size_t kOldSpaceInitialSize = 1024 * 1024;
 
+/**
+ * @brief 老年代页大小（256KB），也是老年代中单个对象的最大大小
+ */
+constexpr size_t kOldSpacePageSize = 256 * 1024;
+
+/**
+ * @brief 精确大小类别覆盖的最大大小，之内每 kGCObjectAlignment 字节一个类别
+ */
+constexpr size_t kOldSpaceExactSizeLimit = 256;
+
+/**
+ * @brief 空闲链表的大小类别数量
+ *
+ * 超过 kOldSpaceExactSizeLimit 后每个类别的上限翻倍，最后一个类别没有上限。
+ */
+constexpr size_t kOldSpaceSizeClassCount = 64;
+
+/**
+ * @brief 空闲块的最小大小，更小的剩余空间分配给相邻的对象
+ */
+constexpr size_t kOldSpaceMinFreeBlockSize = sizeof(GCObject);
+
+/**
+ * @brief 计算大小所属的大小类别
+ * @param size 对齐后的大小
+ */
+inline uint8_t OldSpaceSizeClass(size_t size) {
+    if (size <= kOldSpaceExactSizeLimit) {
+        return static_cast<uint8_t>(size / kGCObjectAlignment);
+    }
+    size_t size_class = kOldSpaceExactSizeLimit / kGCObjectAlignment;
+    size_t limit = kOldSpaceExactSizeLimit;
+    while (size > limit && size_class < kOldSpaceSizeClassCount - 1) {
+        limit *= 2;
+        ++size_class;
+    }
+    return static_cast<uint8_t>(size_class);
+}
+
+/**
+ * @class OldSpacePage
+ * @brief 老年代页，记录页的地址和页内分配位置
+ *
+ * 页内对象从起始地址开始连续排列，直到 top；top 之后的内存未使用。
+ */
+class OldSpacePage {
+public:
+    explicit OldSpacePage(uint8_t* start) : start_(start), top_(start) {}
+
+    /**
+     * @brief 获取页起始地址
+     */
+    uint8_t* start() const { return start_; }
+
+    /**
+     * @brief 获取页结束地址
+     */
+    uint8_t* end() const { return start_ + kOldSpacePageSize; }
+
+    /**
+     * @brief 获取页内分配位置
+     */
+    uint8_t* top() const { return top_; }
+
+    /**
+     * @brief 设置页内分配位置
+     */
+    void set_top(uint8_t* top) { top_ = top; }
+
+private:
+    uint8_t* start_;    ///< 页起始地址
+    uint8_t* top_;      ///< 页内分配位置
+};
+
 /**
  * @class OldSpace
- * @brief 老年代内存空间（使用标记-压缩算法）
+ * @brief 老年代内存空间（标记-清除，必要时标记-压缩）
  *
- * 老年代使用标记-压缩算法进行GC，减少内存碎片。
+ * 分配时先查找空闲链表，找不到合适的空闲块时在最后一页（当前页）的 top 之后顺序分配，
+ * 当前页放不下时换到一个空页。空闲块是已析构的填充对象，遍历对象时和死亡对象一样被跳过。
  *
- * @note 老年代不支持动态扩容，因为标记-压缩算法假设内存是连续的，
- *       扩容会导致对象移动和指针失效。如果空间不足，应触发 GC 或
- *       在初始化时指定更大的 initial_size。
+ * 标记结束后调用 StartSweeping 开始清除，之后由 Sweep 按页分段完成：
+ * 清除只处理开始时已有的页中 top 之前的对象，清除期间分配的对象要么位于已清除的空闲块中，
+ * 要么位于原来的 top 之后，都不会被误认为死亡对象。
+ *
+ * 空页通过 DiscardVirtualMemory 归还给操作系统，但仍保留映射，之后分配时直接重新使用。
  */
 class OldSpace : public noncopyable {
 public:
@@ -38,43 +122,65 @@ public:
     OldSpace();
 
     /**
-     * @brief 析构函数
+     * @brief 析构函数，解除所有页的映射
      */
     ~OldSpace();
 
     /**
      * @brief 初始化老年代空间
-     * @param initial_size 初始大小（也是最大大小，不支持扩容）
+     * @param initial_size 初始大小，向上取整到页大小的整数倍
      * @return 是否初始化成功
      */
     bool Initialize(size_t initial_size = kOldSpaceInitialSize);
 
     /**
      * @brief 分配内存
-     * @param size 分配大小
+     * @param size 分配大小，输出实际分配的大小（空闲块剩余部分过小时会一并分配）
      * @return 分配的内存地址，失败返回nullptr
      */
     void* Allocate(size_t* size);
 
     /**
-     * @brief 扩展老年代空间（会移动所有对象）
-     * @param min_size 最小需要的额外空间
-     * @return 是否扩容成功
-     * @note 扩容后会设置转发地址，调用者需要：
-     *       1. 遍历所有根和对象，调用UpdateRefs更新引用
-     *       2. 调用FinishExpand清除转发标记并释放旧内存
+     * @brief 开始清除：丢弃当前的空闲链表，之后由 Sweep 重新生成
+     * @param live_size 标记得到的存活字节数，作为清除后的已使用大小
+     * @note 调用前需要完成标记，死亡对象的标记位为false
      */
-    bool Expand(size_t min_size);
+    void StartSweeping(size_t live_size);
+
+    /**
+     * @brief 清除一段内存：调用死亡对象的析构函数，将页内相邻的死亡对象和空闲块合并后放入空闲链表，
+     *        整页都是死亡对象时归还该页
+     * @param max_size 本次最多清除的字节数
+     * @return 清除是否已全部完成
+     */
+    bool Sweep(size_t max_size);
+
+    /**
+     * @brief 完成剩余的清除
+     */
+    void FinishSweeping() { Sweep(SIZE_MAX); }
 
     /**
-     * @brief 完成扩容（清除转发标记并释放旧内存）
+     * @brief 是否有尚未清除的内存
      */
-    void FinishExpand();
+    bool sweeping() const { return sweep_page_ < sweep_page_count_; }
 
     /**
-     * @brief 获取旧内存地址（扩容期间使用）
+     * @brief 获取空闲链表中的总字节数
      */
-    uint8_t* old_space_start() const { return old_space_start_; }
+    size_t free_size() const { return free_size_; }
+
+    /**
+     * @brief 获取累计分配的字节数
+     */
+    size_t allocated_size() const { return allocated_size_; }
+
+    /**
+     * @brief 扩展老年代空间：映射新的空页，不移动任何对象
+     * @param min_size 最小需要的额外空间
+     * @return 是否扩容成功
+     */
+    bool Expand(size_t min_size);
 
     /**
      * @brief 对象回调函数类型
@@ -84,55 +190,59 @@ public:
     using ObjectCallback = void (*)(GCObject* obj, void* data);
 
     /**
-     * @brief 遍历所有对象
+     * @brief 按页顺序遍历所有对象
      * @param callback 回调函数
      * @param data 用户数据
      */
     void IterateObjects(ObjectCallback callback, void* data);
 
     /**
-     * @brief 遍历所有存活对象（已标记）
+     * @brief 按页顺序遍历所有存活对象（已标记）
      * @param callback 回调函数
      * @param data 用户数据
      */
     void IterateLiveObjects(ObjectCallback callback, void* data);
 
     /**
-     * @brief 获取已使用内存大小
+     * @brief 获取已使用内存大小（存活对象及之后分配的对象，不包括空闲块）
      */
     size_t used_size() const { return used_size_; }
 
     /**
-     * @brief 获取总容量
+     * @brief 获取总容量（所有页，包括已归还给操作系统的空页）
      */
-    size_t capacity() const { return capacity_; }
+    size_t capacity() const { return (pages_.size() + empty_pages_.size()) * kOldSpacePageSize; }
 
     /**
-     * @brief 获取空间起始地址
+     * @brief 获取各页中 top 之前的总字节数（存活对象、死亡对象和空闲块）
      */
-    uint8_t* space_start() const { return space_start_; }
+    size_t area_size() const;
 
     /**
-     * @brief 获取空间结束地址
+     * @brief 获取顺序分配还能使用的字节数（当前页剩余部分和空页，不包括空闲链表）
      */
-    uint8_t* space_end() const { return space_start_ + capacity_; }
+    size_t available_size() const;
 
     /**
-     * @brief 获取当前分配位置
+     * @brief 获取正在使用的页（最后一页为当前页）
      */
-    uint8_t* top() const { return top_; }
+    const std::vector<OldSpacePage>& pages() const { return pages_; }
 
     /**
-     * @brief 设置新的分配位置（压缩后使用）
-     * @param new_top 新的top位置
+     * @brief 获取空页数量
      */
-    void set_top(uint8_t* new_top) { top_ = new_top; }
+    size_t empty_page_count() const { return empty_pages_.size(); }
 
     /**
-     * @brief 计算压缩后的新位置
-     * @return 新的top位置
+     * @brief 压缩第一步：按页顺序为存活对象计算新位置，写入转发地址
+     * @note 调用前需要完成标记；之后由调用者用转发地址更新所有引用，再调用 Compact
      */
-    uint8_t* ComputeCompactTop();
+    void ComputeForwardingAddresses();
+
+    /**
+     * @brief 压缩第二步：移动存活对象，更新各页的 top，归还空出的页，丢弃所有空闲块
+     */
+    void Compact();
 
     /**
      * @brief 更新引用
@@ -140,29 +250,51 @@ public:
      */
     static void UpdateReference(Value* value);
 
-    // 移动对象
-    struct MoveObjectData {
-        GCHeap* heap;
-    };
+private:
+    /**
+     * @brief 从空闲链表中分配
+     * @param size 对齐后的大小，输出实际分配的大小
+     * @return 分配的内存地址，没有合适的空闲块时返回nullptr
+     */
+    void* AllocateFromFreeList(size_t* size);
+
+    /**
+     * @brief 在内存中构造空闲块并放入对应的空闲链表
+     */
+    void AddFreeBlock(uint8_t* start, size_t size);
 
-    static void MoveObject(GCObject* obj, void* data);
+    /**
+     * @brief 丢弃所有空闲链表
+     */
+    void ResetFreeLists();
 
-    // 计算转发地址
-    struct CompactForwardData {
-        uint8_t* new_pos;
-    };
+    /**
+     * @brief 取出一个空页作为新的当前页，当前页的剩余部分放入空闲链表
+     * @return 没有空页时返回false
+     */
+    bool AddPage();
 
-    static void ComputeForwardingAddr(GCObject* obj, void* data);
+    /**
+     * @brief 将页归还给操作系统并放入空页
+     */
+    void ReleasePage(uint8_t* start);
 
 private:
-    uint8_t* space_start_ = nullptr;    ///< 空间起始地址
-    uint8_t* top_ = nullptr;            ///< 当前分配位置
-    size_t capacity_ = 0;               ///< 总容量
+    std::vector<OldSpacePage> pages_;   ///< 正在使用的页，最后一页为当前页
+    std::vector<uint8_t*> empty_pages_; ///< 空页
     size_t used_size_ = 0;              ///< 已使用大小
+    size_t allocated_size_ = 0;         ///< 累计分配的字节数
+
+    std::vector<GCObject*> free_lists_[kOldSpaceSizeClassCount]; ///< 按大小类别划分的空闲链表
+    uint64_t free_list_mask_ = 0;       ///< 非空的空闲链表
+    size_t free_size_ = 0;              ///< 空闲链表中的总字节数
+
+    size_t sweep_page_ = 0;             ///< 正在清除的页
+    size_t sweep_page_count_ = 0;       ///< 需要清除的页数（开始清除时已有的页）
+    uint8_t* sweep_cursor_ = nullptr;   ///< 正在清除的页中下一个待清除的位置
+    uint8_t* sweep_top_ = nullptr;      ///< 开始清除时当前页的top，之后的对象不需要清除
 
-    // 扩容期间使用的临时变量
-    uint8_t* old_space_start_ = nullptr;  ///< 旧内存地址（扩容期间保留）
-    uint8_t* old_top_ = nullptr;          ///< 旧内存的top位置
+    std::vector<uint8_t*> compact_tops_; ///< 压缩后各页的top（压缩期间使用）
 };
 
 } // namespace mjs
@@ -0,0 +1,204 @@
+/**
+ * @file parallel_scavenger.h
+ * @brief 并行Scavenge
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件定义了新生代的并行复制回收器，由多个线程共同完成一次Scavenge的复制阶段：
+ * - 主线程处理根集合，所有线程按块分摊记忆集
+ * - 每个线程从Survivor To区申请本地分配缓冲区（LAB），在缓冲区内无锁复制对象
+ * - 通过CAS安装转发地址，保证每个对象只被一个线程复制
+ * - 待扫描对象放入线程自己的双端队列，空闲线程从其他线程的队列头部窃取
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <mjs/noncopyable.h>
+#include <mjs/gc/gc_object.h>
+
+namespace mjs {
+
+class GCHeap;
+class Value;
+
+/**
+ * @brief 线程本地分配缓冲区大小
+ *
+ * 大于一半的对象直接在Survivor To区分配，保证缓冲区剩余空间总能放下填充对象。
+ */
+constexpr size_t kScavengeLabSize = 1024;
+
+/**
+ * @brief 记忆集分块大小，线程每次领取的对象数量
+ */
+constexpr size_t kScavengeRememberedChunk = 64;
+
+/**
+ * @class GCWorkStealingDeque
+ * @brief 待扫描对象的工作窃取双端队列
+ *
+ * 所属线程在尾部压入和弹出（后进先出，局部性更好），其他线程从头部窃取。
+ */
+class GCWorkStealingDeque : public noncopyable {
+public:
+    /**
+     * @brief 压入待扫描对象（所属线程调用）
+     */
+    void Push(GCObject* obj);
+
+    /**
+     * @brief 弹出最近压入的对象（所属线程调用）
+     * @return 队列为空时返回false
+     */
+    bool Pop(GCObject** obj);
+
+    /**
+     * @brief 从头部窃取对象（其他线程调用）
+     * @return 队列为空时返回false
+     */
+    bool Steal(GCObject** obj);
+
+    /**
+     * @brief 队列是否为空（无锁读取，结果仅作参考）
+     */
+    bool empty() const { return size_.load(std::memory_order_acquire) == 0; }
+
+private:
+    std::mutex mutex_;                  ///< 保护队列
+    std::deque<GCObject*> items_;       ///< 待扫描对象
+    std::atomic<size_t> size_ = 0;      ///< 队列长度
+};
+
+/**
+ * @class ParallelScavenger
+ * @brief 并行Scavenge的复制阶段
+ *
+ * 辅助线程常驻，在每次Scavenge时唤醒；调用线程作为0号线程参与工作。
+ * 复制阶段结束后由 GCHeap 继续执行析构死亡对象、交换Survivor区等串行步骤。
+ *
+ * @see GCHeap::Scavenge
+ */
+class ParallelScavenger : public noncopyable {
+public:
+    /**
+     * @brief 构造函数
+     * @param heap 所属的GC堆
+     */
+    explicit ParallelScavenger(GCHeap* heap);
+
+    /**
+     * @brief 析构函数，停止辅助线程
+     */
+    ~ParallelScavenger();
+
+    /**
+     * @brief 设置参与Scavenge的线程数（包括调用线程）
+     * @param thread_count 线程数，0视为1
+     */
+    void set_thread_count(uint32_t thread_count);
+
+    /**
+     * @brief 获取参与Scavenge的线程数
+     */
+    uint32_t thread_count() const { return thread_count_; }
+
+    /**
+     * @brief 执行复制阶段：复制根集合和记忆集可达的新生代对象
+     * @param remembered 本次需要扫描的记忆集，扫描后仍引用新生代对象的对象会重新记录到堆的记忆集
+     * @return 晋升到老年代的字节数
+     */
+    size_t Scavenge(std::vector<GCObject*>* remembered);
+
+private:
+    /**
+     * @struct Worker
+     * @brief 单个线程在一次Scavenge中的状态
+     */
+    struct Worker {
+        uint32_t id = 0;                        ///< 线程编号，0为调用线程
+        ParallelScavenger* scavenger = nullptr; ///< 所属回收器
+        GCWorkStealingDeque deque;              ///< 待扫描对象
+        uint8_t* lab_top = nullptr;             ///< 本地分配缓冲区当前位置
+        uint8_t* lab_end = nullptr;             ///< 本地分配缓冲区结束位置
+        size_t promoted_bytes = 0;              ///< 晋升的字节数
+        bool found_young = false;               ///< 当前扫描的对象是否仍引用新生代对象
+        std::vector<GCObject*> remembered;      ///< 需要重新记录到记忆集的老年代对象
+        std::vector<GCObject*> promoted;        ///< 晋升的对象（形状的引用计数不是线程安全的，由调用线程在结束后处理）
+    };
+
+    void StartThreads();
+    void StopThreads();
+    void ThreadMain(Worker* worker);
+
+    /**
+     * @brief 单个线程的工作：处理根或记忆集，之后扫描队列并窃取，直到所有线程都空闲
+     */
+    void Run(Worker* worker);
+
+    /**
+     * @brief 扫描对象的子引用，老年代对象仍引用新生代对象时记录到记忆集
+     */
+    void ScanObject(Worker* worker, GCObject* obj);
+
+    /**
+     * @brief 处理一个引用：复制或晋升新生代对象并更新引用
+     */
+    void ProcessSlot(Worker* worker, Value* value);
+
+    /**
+     * @brief 取得对象的新地址，未复制时由当前线程复制
+     * @return 新地址，晋升失败时返回nullptr
+     */
+    GCObject* Evacuate(Worker* worker, GCObject* obj);
+
+    GCObject* CopyToSurvivor(Worker* worker, GCObject* obj);
+    GCObject* PromoteToOld(Worker* worker, GCObject* obj);
+
+    /**
+     * @brief 在线程本地分配缓冲区中分配，不足时申请新的缓冲区
+     */
+    void* AllocateInLab(Worker* worker, size_t size);
+
+    /**
+     * @brief 放弃当前缓冲区，剩余空间写入填充对象以便线性遍历Survivor区
+     */
+    void RetireLab(Worker* worker);
+
+    bool StealWork(Worker* worker, GCObject** obj);
+    bool HasWork() const;
+
+    static void SlotCallback(Context* context, Value* child);
+
+private:
+    GCHeap* heap_;                                  ///< 所属的GC堆
+    uint32_t thread_count_ = 1;                     ///< 参与的线程数
+    std::vector<std::unique_ptr<Worker>> workers_;  ///< 各线程状态
+    std::vector<std::thread> threads_;              ///< 辅助线程
+
+    // 线程池同步
+    std::mutex pool_mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    uint64_t epoch_ = 0;            ///< 每次Scavenge递增，唤醒辅助线程
+    uint32_t running_ = 0;          ///< 尚未完成的辅助线程数
+    bool shutdown_ = false;         ///< 是否停止辅助线程
+
+    // 单次Scavenge的共享状态
+    std::vector<GCObject*>* remembered_ = nullptr;  ///< 待扫描的记忆集
+    std::atomic<size_t> next_remembered_ = 0;       ///< 下一个待领取的记忆集下标
+    std::atomic<uint32_t> idle_workers_ = 0;        ///< 空闲线程数，等于线程数时复制阶段结束
+    std::mutex to_space_mutex_;                     ///< 保护Survivor To区的分配
+    std::mutex old_space_mutex_;                    ///< 保护老年代的分配
+};
+
+} // namespace mjs
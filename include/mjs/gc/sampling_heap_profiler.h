@@ -0,0 +1,189 @@
+/**
+ * @file sampling_heap_profiler.h
+ * @brief 采样分配分析器
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件定义了采样分配分析器，开销低，可以在生产环境中长期开启：
+ * - 分配间隔服从指数分布（泊松采样），平均每分配 sample_interval 字节采样一次，
+ *   未采样的分配只需一次减法和比较
+ * - 采样时沿 StackFrame::upper_stack_frame_ 遍历 JS 调用栈，通过调试表将 pc 映射到源代码行号，
+ *   并累积到调用树中
+ * - 采样的对象随GC更新：死亡时从调用树中移除，移动时更新地址，调用树只反映仍存活的分配
+ * - 以 Chrome DevTools 的 .heapprofile JSON 格式导出
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <mjs/noncopyable.h>
+#include <mjs/source_define.h>
+
+namespace mjs {
+
+class Context;
+class FunctionDefBase;
+class GCObject;
+
+/**
+ * @brief 默认平均采样间隔（字节）
+ */
+constexpr uint64_t kDefaultHeapSampleInterval = 512 * 1024;
+
+/**
+ * @brief 默认最大采集的栈深度
+ */
+constexpr uint32_t kDefaultHeapSampleStackDepth = 128;
+
+/**
+ * @struct SamplingHeapProfileNode
+ * @brief 调用树节点，对应调用栈中的一个位置（函数 + 行号）
+ */
+struct SamplingHeapProfileNode {
+    uint32_t id = 0;                               ///< 节点id（从1开始）
+    const FunctionDefBase* function_def = nullptr; ///< 函数定义（仅用于查找子节点）
+    SourceLine line = kSourceLineInvalid;          ///< 源代码行号
+    std::string function_name;                     ///< 函数名称
+    std::string url;                               ///< 所属模块名称
+    std::vector<std::unique_ptr<SamplingHeapProfileNode>> children;  ///< 被调用位置
+};
+
+/**
+ * @struct SamplingHeapSample
+ * @brief 一次采样的分配
+ */
+struct SamplingHeapSample {
+    GCObject* object;               ///< 采样的对象（随GC更新）
+    size_t size;                    ///< 对象大小
+    SamplingHeapProfileNode* node;  ///< 分配时的调用栈
+    uint64_t ordinal;               ///< 采样序号
+};
+
+/**
+ * @class SamplingHeapProfiler
+ * @brief 采样分配分析器
+ *
+ * 由 GCHeap 持有，在分配成功后调用 OnAllocation，在对象移动或回收时调用
+ * UpdateAfterScavenge / UpdateAfterMark。
+ */
+class SamplingHeapProfiler : public noncopyable {
+public:
+    /**
+     * @brief 构造函数
+     * @param context 执行上下文
+     * @param sample_interval 平均采样间隔（字节）
+     * @param stack_depth 最大采集的栈深度
+     * @param seed 随机数种子
+     */
+    SamplingHeapProfiler(Context* context, uint64_t sample_interval, uint32_t stack_depth, uint64_t seed);
+
+    /**
+     * @brief 记录一次分配，距离下一次采样的字节数用完时采样
+     * @param obj 分配的对象
+     * @param size 对象大小
+     */
+    void OnAllocation(GCObject* obj, size_t size) {
+        bytes_until_sample_ -= static_cast<int64_t>(size);
+        if (bytes_until_sample_ <= 0) {
+            Sample(obj, size);
+        }
+    }
+
+    /**
+     * @brief Scavenge 后更新采样：新生代对象被转发说明存活，否则已死亡
+     * @note 在死亡对象析构前调用，此时对象头部的转发地址仍然有效
+     */
+    void UpdateAfterScavenge();
+
+    /**
+     * @brief 完整GC标记后更新采样：未标记的老年代对象已死亡，压缩时换成转发后的新地址
+     * @note 与记忆集同时更新，此时标记和转发地址仍然有效
+     */
+    void UpdateAfterMark();
+
+    /**
+     * @brief 以 .heapprofile JSON 格式写出当前存活的采样
+     * @param out 输出流
+     * @return 输出流是否仍然有效
+     */
+    bool WriteHeapProfile(std::ostream& out) const;
+
+    /**
+     * @brief 获取调用树的根节点
+     */
+    const SamplingHeapProfileNode& root() const { return root_; }
+
+    /**
+     * @brief 获取当前存活的采样
+     */
+    const std::vector<SamplingHeapSample>& samples() const { return samples_; }
+
+    /**
+     * @brief 获取累计采样次数（包括已死亡的采样）
+     */
+    uint64_t sample_count() const { return next_ordinal_; }
+
+    /**
+     * @brief 获取平均采样间隔
+     */
+    uint64_t sample_interval() const { return sample_interval_; }
+
+    /**
+     * @brief 按采样概率估计采样代表的字节数
+     *
+     * 大小为 size 的分配被采样的概率为 1 - exp(-size / interval)，
+     * 每次采样代表 size / (1 - exp(-size / interval)) 字节。
+     */
+    uint64_t ScaledSize(size_t size) const;
+
+private:
+    /**
+     * @brief 采样一次分配
+     */
+    void Sample(GCObject* obj, size_t size);
+
+    /**
+     * @brief 抽取下一次采样前的分配字节数
+     */
+    int64_t NextSampleInterval();
+
+    /**
+     * @brief 采集当前调用栈，返回对应的调用树节点
+     */
+    SamplingHeapProfileNode* CaptureStack();
+
+    /**
+     * @brief 查找或创建子节点
+     */
+    SamplingHeapProfileNode* FindOrAddChild(SamplingHeapProfileNode* parent,
+        const FunctionDefBase* function_def, SourceLine line);
+
+    /**
+     * @brief 写出节点及其子节点
+     */
+    void WriteNode(std::ostream& out, const SamplingHeapProfileNode& node,
+        const std::vector<uint64_t>& self_sizes) const;
+
+    Context* context_;
+    uint64_t sample_interval_;
+    uint32_t stack_depth_;
+    int64_t bytes_until_sample_ = 0;        ///< 距离下一次采样还需分配的字节数
+    std::mt19937_64 random_;
+    std::exponential_distribution<double> distribution_;
+
+    SamplingHeapProfileNode root_;          ///< 调用树根节点（"(root)"）
+    uint32_t next_node_id_ = 1;
+    std::vector<SamplingHeapSample> samples_;   ///< 存活的采样
+    uint64_t next_ordinal_ = 0;
+
+    std::vector<std::pair<const FunctionDefBase*, SourceLine>> stack_buffer_;  ///< 采集调用栈时复用的缓冲区
+};
+
+} // namespace mjs
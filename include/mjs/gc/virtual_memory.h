@@ -0,0 +1,76 @@
+/**
+ * @file virtual_memory.h
+ * @brief 虚拟内存分配
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件封装了直接向操作系统申请和归还内存的接口（Windows 使用 VirtualAlloc，其他平台使用 mmap），
+ * 供老年代的页和大对象空间等需要整块映射、单独归还的内存空间使用。
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace mjs {
+
+/**
+ * @brief 获取操作系统的内存页大小
+ */
+size_t VirtualMemoryPageSize();
+
+/**
+ * @brief 映射一段可读写的内存
+ * @param size 大小，需要是页大小的整数倍
+ * @return 内存起始地址（按页对齐，内容为0），失败返回nullptr
+ */
+void* AllocateVirtualMemory(size_t size);
+
+/**
+ * @brief 解除映射
+ * @param address AllocateVirtualMemory 返回的地址
+ * @param size 映射时的大小
+ */
+void FreeVirtualMemory(void* address, size_t size);
+
+/**
+ * @brief 将一段内存归还给操作系统，保留映射（Linux 使用 madvise(MADV_DONTNEED)）
+ * @param address 起始地址，需要按页对齐
+ * @param size 大小，需要是页大小的整数倍
+ * @note 之后仍可直接访问，内容不确定（Linux 上为0）
+ */
+void DiscardVirtualMemory(void* address, size_t size);
+
+/**
+ * @brief 保留一段地址空间，不可访问，不占用物理内存
+ * @param size 大小，需要是页大小的整数倍
+ * @return 起始地址（按页对齐），失败返回nullptr
+ * @note 使用 CommitVirtualMemory 提交后才能访问，使用 FreeVirtualMemory 释放
+ */
+void* ReserveVirtualMemory(size_t size);
+
+/**
+ * @brief 将保留的地址空间提交为可读写的内存
+ * @param address 起始地址，需要按页对齐
+ * @param size 大小，需要是页大小的整数倍
+ * @return 是否成功，提交的内存内容为0
+ */
+bool CommitVirtualMemory(void* address, size_t size);
+
+/**
+ * @brief 取消提交，将内存归还给操作系统并恢复为不可访问的保留状态
+ * @param address 起始地址，需要按页对齐
+ * @param size 大小，需要是页大小的整数倍
+ */
+void DecommitVirtualMemory(void* address, size_t size);
+
+/**
+ * @brief 将大小向上对齐到页大小
+ */
+inline size_t AlignVirtualMemorySize(size_t size) {
+    size_t page_size = VirtualMemoryPageSize();
+    return (size + page_size - 1) / page_size * page_size;
+}
+
+} // namespace mjs
@@ -0,0 +1,82 @@
+/**
+ * @file prepared_call.h
+ * @brief 预备调用，用于原生代码反复调用同一个回调函数
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件定义了 PreparedCall 类。Array.prototype.map 等原生方法需要对每个元素调用一次回调，
+ * 通过 Context::CallFunction 调用时每次都会构造新的栈帧和参数数组；PreparedCall 在构造时
+ * 检查回调类型，字节码函数复用同一个栈帧，参数直接写入栈帧的参数槽。
+ */
+
+#pragma once
+
+#include <array>
+#include <utility>
+
+#include <mjs/noncopyable.h>
+#include <mjs/stack_frame.h>
+#include <mjs/value/value.h>
+
+namespace mjs {
+
+class Context;
+
+/**
+ * @class PreparedCall
+ * @brief 预备调用类
+ *
+ * 仅对普通的字节码函数（FunctionDef/FunctionObject，非生成器、非异步）启用快速路径，
+ * 其他可调用类型（原生函数、生成器等）回退到 Context::CallFunction。
+ *
+ * @note 调用期间不能有其他代码向运行时栈压入值，否则复用的栈帧栈底会失效
+ */
+class PreparedCall : public noncopyable {
+public:
+	/**
+	 * @brief 构造函数
+	 * @param context 执行上下文指针
+	 * @param func_val 被调用的函数
+	 * @param this_val this值
+	 */
+	PreparedCall(Context* context, const Value& func_val, Value this_val);
+
+	/**
+	 * @brief 调用函数
+	 * @tparam Args 参数类型
+	 * @param args 参数列表，超出被调函数形参数量的参数不会入栈
+	 * @return 函数返回值，异常时返回异常值
+	 */
+	template<typename... Args>
+	Value Call(Args&&... args) {
+		if (!prepared_ || param_count_ > sizeof...(Args)) {
+			// 参数不足时也回退，由通用路径报告错误
+			std::array<Value, sizeof...(Args)> argv = { Value(std::forward<Args>(args))... };
+			return CallSlow(argv.data(), argv.size());
+		}
+		// 参数正序直接写入栈帧的参数槽
+		uint32_t index = 0;
+		((index < param_count_ ? (stack_frame_.push(std::forward<Args>(args)), ++index) : index), ...);
+		return Invoke();
+	}
+
+	/**
+	 * @brief 是否启用了栈帧复用的快速路径
+	 */
+	bool prepared() const { return prepared_; }
+
+private:
+	Value Invoke();
+	Value CallSlow(Value* argv, size_t argc);
+
+private:
+	Context* context_;            ///< 执行上下文指针
+	Value func_val_;              ///< 被调用的函数
+	Value this_val_;              ///< this值
+	StackFrame stack_frame_;      ///< 复用的栈帧
+	uint32_t param_count_ = 0;    ///< 被调函数的形参数量
+	bool prepared_ = false;       ///< 是否启用快速路径
+};
+
+} // namespace mjs
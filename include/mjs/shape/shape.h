@@ -11,6 +11,7 @@
 #pragma once
 
 #include <mjs/reference_counter.h>
+#include <mjs/gc/heap_cage.h>
 #include <mjs/class_def/class_def.h>
 #include <mjs/shape/shape_property_hash_table.h>
 #include <mjs/shape/transition_table.h>
@@ -35,6 +36,13 @@ public:
 
     ~Shape();
 
+#ifdef ENABLE_POINTER_COMPRESSION
+    // 对象通过32位偏移引用形状，形状需要分配在堆笼中
+    static void* operator new(size_t size) { return HeapCage::Instance().AllocateCell(size); }
+
+    static void operator delete(void* address, size_t size) { HeapCage::Instance().FreeCell(address, size); }
+#endif
+
     const PropertySlotIndex Find(ConstIndex const_index) const;
 
     void Add(ShapeProperty&& prop);
@@ -57,6 +65,10 @@ public:
 
     uint32_t property_size() const { return property_size_; }
 
+    bool young_pinned() const { return young_pinned_; }
+
+    void set_young_pinned(bool young_pinned) { young_pinned_ = young_pinned; }
+
 private:
     ShapeManager* shape_manager_;
     Shape* parent_shape_;
@@ -65,6 +77,8 @@ private:
     ShapePropertyHashTable* property_map_;
 
     TransitionTable transtion_table_;
+
+    bool young_pinned_ = false;     ///< GC堆是否已为新生代对象持有该形状的引用（见 GCHeap::PinYoungShape）
 };
 
 } // namespace mjs
\ No newline at end of file
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <mjs/unordered_dense.h>
+#include <mjs/boilerplate_table.h>
 #include <mjs/shape/shape.h>
 
 namespace mjs {
@@ -35,13 +37,52 @@ public:
 
 	PropertySlotIndex AddProperty(Shape** base_shape, ShapeProperty&& property);
 
+	/**
+	 * @brief 获取对象字面量样板对应的最终形状
+	 *
+	 * 首次访问时从空形状沿过渡表逐个添加样板中的键，得到最终形状并由管理器持有，
+	 * 之后直接命中样板内的缓存。
+	 *
+	 * @param boilerplate 对象字面量样板
+	 * @return 最终形状指针（由 ShapeManager 持有引用）
+	 */
+	Shape* GetBoilerplateShape(const ObjectBoilerplate& boilerplate) {
+		auto shape = boilerplate.FindCachedShape(id_);
+		if (shape) return shape;
+		return CreateBoilerplateShape(boilerplate);
+	}
+
 	auto& context() { return *context_; }
 
 	Shape& empty_shape() { return *empty_shape_; }
 
+	/**
+	 * @brief 获取只包含 __proto__ 属性的形状
+	 *
+	 * 构造函数创建的实例总是先设置原型，直接从该形状开始可以省去一次过渡查找。
+	 *
+	 * @return 原型形状引用（由 ShapeManager 持有引用）
+	 */
+	Shape& prototype_shape() {
+		if (!prototype_shape_) {
+			prototype_shape_ = CreatePrototypeShape();
+		}
+		return *prototype_shape_;
+	}
+
+private:
+	Shape* CreateBoilerplateShape(const ObjectBoilerplate& boilerplate);
+
+	Shape* CreatePrototypeShape();
+
 private:
+	static inline std::atomic<uint64_t> next_id_ = 1;
+
 	Context* context_;
+	uint64_t id_;                                                    ///< 唯一 id，用于校验样板中缓存的形状
 	Shape* empty_shape_;
+	Shape* prototype_shape_ = nullptr;                                ///< 只包含 __proto__ 的形状（持有引用）
+	ankerl::unordered_dense::map<uint64_t, Shape*> boilerplate_shapes_; ///< 样板 id -> 最终形状（持有引用）
 };
 
 } // namespace mjs
\ No newline at end of file
@@ -26,8 +26,13 @@ constexpr PropertySlotIndex kPropertySlotIndexInvalid = -1;
  * shape 链下的所有 shape 都指向一个哈希表，每个 Shape 控制 size 来限制查找范围。
  * 提供属性查找、添加和常量值引用计数管理功能。
  *
+ * 查找结构分两级：
+ * - 属性数量不超过 kPropertiesMaxSize 时，直接在紧凑排列的 ConstIndex 键数组上做 SIMD 比较
+ * - 超过后额外建立开放寻址哈希表，槽位内联保存键的副本，探测时无需回访键数组
+ *
  * @note shape 链下的所有 shape 都指向一个哈希表
  * @note 每个 Shape 控制 size 来限制查找范围
+ * @note 同一张表内的键不会重复（分支时会复制出新表）
  */
 class ShapePropertyHashTable {
 public:
@@ -39,21 +44,34 @@ public:
 	void DereferenceConstValue(Context* context);
 
 private:
-	uint32_t GetPower2(uint32_t n);
-	double CalcLoadingFactor() const;
+	/**
+	 * @brief 开放寻址哈希表槽位（内联键副本）
+	 */
+	struct HashEntry {
+		ConstIndex key;                  ///< 键副本
+		PropertySlotIndex slot_index;    ///< 属性槽索引，kPropertySlotIndexInvalid 表示空槽
+	};
+
+	PropertySlotIndex FindInKeys(ConstIndex const_index, uint32_t property_size) const;
+	PropertySlotIndex FindInHashTable(ConstIndex const_index, uint32_t property_size) const;
+
+	uint32_t HashIndex(ConstIndex const_index) const;
+	void InsertToHashTable(ConstIndex const_index, PropertySlotIndex slot_index);
 	void Rehash(uint32_t new_capacity);
 
 private:
-	static constexpr uint32_t kPropertiesMaxSize = 4;
-	static constexpr double kLoadingFactor = 0.75f;
+	static constexpr uint32_t kPropertiesMaxSize = 16;  ///< 不超过该数量时只扫描键数组
+	static constexpr uint32_t kKeyBlockSize = 4;        ///< 键数组按 SIMD 宽度对齐的块大小
+	static constexpr uint32_t kHashCapacityFactor = 2;  ///< 哈希表容量至少为属性数量的倍数（负载因子不超过 0.5）
 
 	uint32_t property_size_ = 0;
 	uint32_t property_capacity_ = 0;
-	ShapeProperty* properties_ = nullptr;
+	ShapeProperty* properties_ = nullptr;       ///< 紧凑的键数组（ShapeProperty 只包含 ConstIndex）
 
 	uint32_t hash_mask_ = 0;
+	uint32_t hash_shift_ = 0;
 	uint32_t hash_capacity_ = 0;
-	PropertySlotIndex* slot_indices_ = nullptr;
+	HashEntry* hash_entries_ = nullptr;
 };
 
 } // namespace mjs
\ No newline at end of file
@@ -0,0 +1,333 @@
+/**
+ * @file sort.h
+ * @brief 排序算法定义
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件定义了 Array.prototype.sort 使用的排序算法：
+ * - PdqSort：模式消除快速排序（pattern-defeating quicksort），不稳定，
+ *   用于比较结果只取决于键、相等元素不可区分的场景
+ * - MergeSort：自底向上的稳定归并排序，用于用户提供的比较函数
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace mjs {
+
+namespace sort_internal {
+
+constexpr ptrdiff_t kInsertionSortThreshold = 24;   ///< 小于该长度的区间使用插入排序
+constexpr ptrdiff_t kNintherThreshold = 128;        ///< 大于该长度的区间使用九数取中选择枢轴
+constexpr size_t kPartialInsertionSortLimit = 8;    ///< 部分插入排序允许的最大移动次数
+constexpr ptrdiff_t kMergeSortRun = 16;             ///< 归并排序初始有序段长度
+
+/**
+ * @brief 插入排序（稳定）
+ */
+template<typename Iter, typename Compare>
+void InsertionSort(Iter begin, Iter end, Compare& comp) {
+	if (begin == end) {
+		return;
+	}
+	for (Iter cur = begin + 1; cur != end; ++cur) {
+		Iter sift = cur;
+		Iter sift_1 = cur - 1;
+		if (comp(*sift, *sift_1)) {
+			auto tmp = std::move(*sift);
+			do {
+				*sift-- = std::move(*sift_1);
+			} while (sift != begin && comp(tmp, *--sift_1));
+			*sift = std::move(tmp);
+		}
+	}
+}
+
+/**
+ * @brief 无边界检查的插入排序，要求 *(begin - 1) 不大于区间内任何元素
+ */
+template<typename Iter, typename Compare>
+void UnguardedInsertionSort(Iter begin, Iter end, Compare& comp) {
+	if (begin == end) {
+		return;
+	}
+	for (Iter cur = begin + 1; cur != end; ++cur) {
+		Iter sift = cur;
+		Iter sift_1 = cur - 1;
+		if (comp(*sift, *sift_1)) {
+			auto tmp = std::move(*sift);
+			do {
+				*sift-- = std::move(*sift_1);
+			} while (comp(tmp, *--sift_1));
+			*sift = std::move(tmp);
+		}
+	}
+}
+
+/**
+ * @brief 尝试插入排序，移动次数超过限制时放弃
+ * @return 区间是否已经排好序
+ */
+template<typename Iter, typename Compare>
+bool PartialInsertionSort(Iter begin, Iter end, Compare& comp) {
+	if (begin == end) {
+		return true;
+	}
+	size_t limit = 0;
+	for (Iter cur = begin + 1; cur != end; ++cur) {
+		Iter sift = cur;
+		Iter sift_1 = cur - 1;
+		if (comp(*sift, *sift_1)) {
+			auto tmp = std::move(*sift);
+			do {
+				*sift-- = std::move(*sift_1);
+			} while (sift != begin && comp(tmp, *--sift_1));
+			*sift = std::move(tmp);
+			limit += cur - sift;
+		}
+		if (limit > kPartialInsertionSortLimit) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template<typename Iter, typename Compare>
+void Sort2(Iter a, Iter b, Compare& comp) {
+	if (comp(*b, *a)) {
+		std::iter_swap(a, b);
+	}
+}
+
+template<typename Iter, typename Compare>
+void Sort3(Iter a, Iter b, Iter c, Compare& comp) {
+	Sort2(a, b, comp);
+	Sort2(b, c, comp);
+	Sort2(a, b, comp);
+}
+
+/**
+ * @brief 以 *begin 为枢轴划分，等于枢轴的元素放在右侧
+ * @return 枢轴的最终位置，以及划分前区间是否已经有序划分
+ */
+template<typename Iter, typename Compare>
+std::pair<Iter, bool> PartitionRight(Iter begin, Iter end, Compare& comp) {
+	auto pivot = std::move(*begin);
+	Iter first = begin;
+	Iter last = end;
+
+	// 三数取中保证 end - 1 处的元素不小于枢轴，作为哨兵
+	while (comp(*++first, pivot));
+	if (first - 1 == begin) {
+		while (first < last && !comp(*--last, pivot));
+	}
+	else {
+		while (!comp(*--last, pivot));
+	}
+
+	bool already_partitioned = first >= last;
+	while (first < last) {
+		std::iter_swap(first, last);
+		while (comp(*++first, pivot));
+		while (!comp(*--last, pivot));
+	}
+
+	Iter pivot_pos = first - 1;
+	*begin = std::move(*pivot_pos);
+	*pivot_pos = std::move(pivot);
+	return { pivot_pos, already_partitioned };
+}
+
+/**
+ * @brief 以 *begin 为枢轴划分，等于枢轴的元素放在左侧
+ *
+ * 用于枢轴与左侧已排序区间的最大值相等的情况，一次划分即可排除所有相等元素。
+ */
+template<typename Iter, typename Compare>
+Iter PartitionLeft(Iter begin, Iter end, Compare& comp) {
+	auto pivot = std::move(*begin);
+	Iter first = begin;
+	Iter last = end;
+
+	while (comp(pivot, *--last));
+	if (last + 1 == end) {
+		while (first < last && !comp(pivot, *++first));
+	}
+	else {
+		while (!comp(pivot, *++first));
+	}
+
+	while (first < last) {
+		std::iter_swap(first, last);
+		while (comp(pivot, *--last));
+		while (!comp(pivot, *++first));
+	}
+
+	Iter pivot_pos = last;
+	*begin = std::move(*pivot_pos);
+	*pivot_pos = std::move(pivot);
+	return pivot_pos;
+}
+
+template<typename Iter, typename Compare>
+void PdqSortLoop(Iter begin, Iter end, Compare& comp, int bad_allowed, bool leftmost) {
+	while (true) {
+		auto size = end - begin;
+		if (size < kInsertionSortThreshold) {
+			if (leftmost) {
+				InsertionSort(begin, end, comp);
+			}
+			else {
+				UnguardedInsertionSort(begin, end, comp);
+			}
+			return;
+		}
+
+		// 选择枢轴并放到 begin
+		auto half = size / 2;
+		if (size > kNintherThreshold) {
+			Sort3(begin, begin + half, end - 1, comp);
+			Sort3(begin + 1, begin + (half - 1), end - 2, comp);
+			Sort3(begin + 2, begin + (half + 1), end - 3, comp);
+			Sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+			std::iter_swap(begin, begin + half);
+		}
+		else {
+			Sort3(begin + half, begin, end - 1, comp);
+		}
+
+		// 枢轴等于左侧区间的最大值，说明存在大量相等元素
+		if (!leftmost && !comp(*(begin - 1), *begin)) {
+			begin = PartitionLeft(begin, end, comp) + 1;
+			continue;
+		}
+
+		auto [pivot_pos, already_partitioned] = PartitionRight(begin, end, comp);
+		auto left_size = pivot_pos - begin;
+		auto right_size = end - (pivot_pos + 1);
+
+		if (left_size < size / 8 || right_size < size / 8) {
+			// 划分严重失衡，次数过多时退化为堆排序保证 O(n log n)
+			if (--bad_allowed == 0) {
+				std::make_heap(begin, end, comp);
+				std::sort_heap(begin, end, comp);
+				return;
+			}
+
+			// 打乱两侧的元素，破坏导致失衡的模式
+			if (left_size >= kInsertionSortThreshold) {
+				std::iter_swap(begin, begin + left_size / 4);
+				std::iter_swap(pivot_pos - 1, pivot_pos - left_size / 4);
+				if (left_size > kNintherThreshold) {
+					std::iter_swap(begin + 1, begin + (left_size / 4 + 1));
+					std::iter_swap(begin + 2, begin + (left_size / 4 + 2));
+					std::iter_swap(pivot_pos - 2, pivot_pos - (left_size / 4 + 1));
+					std::iter_swap(pivot_pos - 3, pivot_pos - (left_size / 4 + 2));
+				}
+			}
+			if (right_size >= kInsertionSortThreshold) {
+				std::iter_swap(pivot_pos + 1, pivot_pos + (1 + right_size / 4));
+				std::iter_swap(end - 1, end - right_size / 4);
+				if (right_size > kNintherThreshold) {
+					std::iter_swap(pivot_pos + 2, pivot_pos + (2 + right_size / 4));
+					std::iter_swap(pivot_pos + 3, pivot_pos + (3 + right_size / 4));
+					std::iter_swap(end - 2, end - (1 + right_size / 4));
+					std::iter_swap(end - 3, end - (2 + right_size / 4));
+				}
+			}
+		}
+		else if (already_partitioned
+			&& PartialInsertionSort(begin, pivot_pos, comp)
+			&& PartialInsertionSort(pivot_pos + 1, end, comp)) {
+			// 划分前已经有序划分，两侧插入排序很快完成，说明区间基本有序
+			return;
+		}
+
+		PdqSortLoop(begin, pivot_pos, comp, bad_allowed, leftmost);
+		begin = pivot_pos + 1;
+		leftmost = false;
+	}
+}
+
+} // namespace sort_internal
+
+/**
+ * @brief 模式消除快速排序（不稳定）
+ *
+ * 平均 O(n log n)，对已排序、逆序、大量重复元素的输入接近 O(n)，最坏情况退化为堆排序。
+ *
+ * @param begin 起始迭代器（随机访问）
+ * @param end 结束迭代器
+ * @param comp 严格弱序的小于比较
+ */
+template<typename Iter, typename Compare>
+void PdqSort(Iter begin, Iter end, Compare comp) {
+	if (begin == end) {
+		return;
+	}
+	int log2 = 0;
+	for (auto size = end - begin; size > 1; size >>= 1) {
+		++log2;
+	}
+	sort_internal::PdqSortLoop(begin, end, comp, log2, true);
+}
+
+/**
+ * @brief 稳定归并排序
+ *
+ * 先对长度为 kMergeSortRun 的段做插入排序，再自底向上两两归并；
+ * 相邻两段已经有序时直接复制，已排序的输入只需要 O(n) 次比较。
+ *
+ * @param begin 起始指针
+ * @param end 结束指针
+ * @param buffer 临时缓冲区，长度不小于 end - begin
+ * @param comp 小于比较，相等的元素保持原有顺序
+ */
+template<typename T, typename Compare>
+void MergeSort(T* begin, T* end, T* buffer, Compare comp) {
+	auto size = end - begin;
+	for (T* run = begin; run < end; run += std::min(sort_internal::kMergeSortRun, end - run)) {
+		sort_internal::InsertionSort(run, run + std::min(sort_internal::kMergeSortRun, end - run), comp);
+	}
+
+	T* from = begin;
+	T* to = buffer;
+	for (ptrdiff_t width = sort_internal::kMergeSortRun; width < size; width *= 2) {
+		for (ptrdiff_t low = 0; low < size; low += 2 * width) {
+			T* left = from + low;
+			T* mid = from + std::min(low + width, size);
+			T* right_end = from + std::min(low + 2 * width, size);
+			T* out = to + low;
+
+			if (mid < right_end && !comp(*mid, *(mid - 1))) {
+				std::move(left, right_end, out);
+				continue;
+			}
+
+			T* right = mid;
+			while (left < mid && right < right_end) {
+				// 只有右侧严格小于左侧时才先取右侧，保证稳定
+				if (comp(*right, *left)) {
+					*out++ = std::move(*right++);
+				}
+				else {
+					*out++ = std::move(*left++);
+				}
+			}
+			out = std::move(left, mid, out);
+			std::move(right, right_end, out);
+		}
+		std::swap(from, to);
+	}
+
+	if (from != begin) {
+		std::move(from, from + size, begin);
+	}
+}
+
+} // namespace mjs
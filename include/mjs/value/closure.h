@@ -14,6 +14,7 @@
 #include <functional>
 
 #include <mjs/reference_counter.h>
+#include <mjs/gc/native_memory.h>
 #include <mjs/value/value.h>
 #include <mjs/value/object/object.h>
 
@@ -39,12 +40,15 @@ public:
 		: value_(std::move(value))
 	{
 		assert(!value_.IsClosureVar());
+		NativeMemory::Allocate(sizeof(ClosureVar));
 	}
 
 	/**
-	 * @brief 析构函数
+	 * @brief 析构函数，从原生内存统计中扣除
 	 */
-	~ClosureVar() = default;
+	~ClosureVar() {
+		NativeMemory::Free(sizeof(ClosureVar));
+	}
 
 	/**
 	 * @brief 获取变量值引用
@@ -19,6 +19,8 @@
 #include <mjs/variable.h>
 #include <mjs/bytecode_table.h>
 #include <mjs/debug.h>
+#include <mjs/boilerplate_table.h>
+#include <mjs/gc/allocation_site.h>
 #include <mjs/value/closure.h>
 #include <mjs/value/exception.h>
 #include <mjs/jit/hotness_counter.h>
@@ -32,6 +34,47 @@ namespace mjs {
 
 class ModuleDef;
 
+/**
+ * @class InstanceSlackTracker
+ * @brief 实例松弛追踪类
+ *
+ * 函数作为构造函数（kNew）使用时，记录前若干次构造结束后实例的属性槽数量，
+ * 之后创建的实例按观察到的最大槽数一次性预分配属性向量，避免构造过程中反复扩容。
+ */
+class InstanceSlackTracker {
+public:
+	static constexpr uint32_t kTrackingConstructions = 8; ///< 追踪的构造次数
+
+	/**
+	 * @brief 检查是否仍处于追踪阶段
+	 * @return 是否仍在追踪
+	 */
+	bool is_tracking() const { return remaining_constructions_ > 0; }
+
+	/**
+	 * @brief 获取观察到的实例槽数量
+	 * @return 实例槽数量（追踪阶段为目前为止的最大值）
+	 */
+	uint32_t slot_count() const { return slot_count_; }
+
+	/**
+	 * @brief 记录一次构造完成后的实例槽数量
+	 * @param slot_count 实例槽数量
+	 * @note 追踪结束后不再更新，槽数量固定
+	 */
+	void Record(uint32_t slot_count) {
+		if (!is_tracking()) return;
+		--remaining_constructions_;
+		if (slot_count > slot_count_) {
+			slot_count_ = slot_count;
+		}
+	}
+
+private:
+	uint32_t remaining_constructions_ = kTrackingConstructions; ///< 剩余追踪次数
+	uint32_t slot_count_ = 0;                                    ///< 观察到的最大实例槽数量
+};
+
 /**
  * @class FunctionDefBase
  * @brief 函数定义基类
@@ -234,6 +277,30 @@ public:
 	 */
     auto& debug_table() { return debug_table_; }
 
+	/**
+	 * @brief 获取对象字面量样板表常量引用
+	 * @return 样板表常量引用
+	 */
+	const auto& boilerplate_table() const { return boilerplate_table_; }
+
+	/**
+	 * @brief 获取对象字面量样板表引用
+	 * @return 样板表引用
+	 */
+	auto& boilerplate_table() { return boilerplate_table_; }
+
+	/**
+	 * @brief 获取实例松弛追踪信息
+	 * @return 实例松弛追踪信息引用
+	 */
+	auto& instance_slack_tracker() { return instance_slack_tracker_; }
+
+	/**
+	 * @brief 获取实例的分配点
+	 * @return 分配点引用
+	 */
+	auto& allocation_site() { return allocation_site_; }
+
 protected:
 	/**
 	 * @brief 受保护构造函数
@@ -271,6 +338,11 @@ protected:
 
 	DebugTable debug_table_;               ///< 调试信息表
 
+	BoilerplateTable boilerplate_table_;   ///< 对象字面量样板表
+
+	InstanceSlackTracker instance_slack_tracker_; ///< 实例松弛追踪信息（作为构造函数时使用）
+	AllocationSite allocation_site_; ///< 实例的分配点（作为构造函数时使用）
+
 	// JIT相关成员（仅在启用JIT时包含）
 #ifdef ENABLE_JIT
 public:
@@ -0,0 +1,81 @@
+/**
+ * @file array_buffer_object.h
+ * @brief JavaScript ArrayBuffer 对象定义
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * ArrayBuffer 持有一段原始字节缓冲区。缓冲区位于 GC 堆之外，对象被 GC 移动后
+ * 数据指针保持不变，因此 TypedArray/DataView 可以缓存数据指针。
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <mjs/value/object/object.h>
+
+namespace mjs {
+
+/**
+ * @brief 外部缓冲区释放回调
+ * @param data 缓冲区指针
+ * @param byte_length 缓冲区字节长度
+ * @param opaque 宿主传入的用户数据
+ */
+using ExternalReleaseCallback = void(*)(void* data, size_t byte_length, void* opaque);
+
+/**
+ * @class ArrayBufferObject
+ * @brief ArrayBuffer 对象类
+ *
+ * 宿主可以直接包装已有的缓冲区而不复制：
+ * @code
+ *   GCHandleScope<1> scope(context);
+ *   auto buffer = scope.New<ArrayBufferObject>(frame->data, frame->size,
+ *       [](void* data, size_t byte_length, void* opaque) { ReleaseFrame(opaque); }, frame);
+ * @endcode
+ * 对象被回收时调用释放回调，回调为空则表示缓冲区由宿主自行管理。
+ * 无论缓冲区由谁分配，其大小都作为外部内存计入所属 Context 的堆限制。
+ */
+class ArrayBufferObject : public Object {
+private:
+	/**
+	 * @brief 分配指定长度、初始化为 0 的缓冲区
+	 */
+	ArrayBufferObject(Context* context, size_t byte_length);
+
+	/**
+	 * @brief 包装外部缓冲区（零拷贝）
+	 * @param data 外部缓冲区指针
+	 * @param byte_length 缓冲区字节长度
+	 * @param release 释放回调，可以为 nullptr
+	 * @param opaque 传给释放回调的用户数据
+	 */
+	ArrayBufferObject(Context* context, void* data, size_t byte_length, ExternalReleaseCallback release, void* opaque);
+
+public:
+	~ArrayBufferObject() override;
+
+	bool GetProperty(Context* context, ConstIndex key, Value* value) override;
+
+	uint8_t* data() const { return data_; }
+
+	size_t byte_length() const { return byte_length_; }
+
+	bool is_external() const { return external_; }
+
+private:
+	friend class GCManager;
+
+	static void FreeInternal(void* data, size_t byte_length, void* opaque);
+
+	Context* context_ = nullptr;                  ///< 所属上下文（析构时扣除外部内存）
+	uint8_t* data_ = nullptr;                     ///< 缓冲区指针
+	size_t byte_length_ = 0;                      ///< 缓冲区字节长度
+	ExternalReleaseCallback release_ = nullptr;   ///< 释放回调
+	void* opaque_ = nullptr;                      ///< 释放回调的用户数据
+	bool external_ = false;                       ///< 是否为宿主提供的外部缓冲区
+};
+
+} // namespace mjs
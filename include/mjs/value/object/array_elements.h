@@ -0,0 +1,274 @@
+/**
+ * @file array_elements.h
+ * @brief JavaScript 数组元素存储定义
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * 本文件定义了数组的稠密元素存储，按元素种类（ElementsKind）选择紧凑的
+ * int64_t / double 缓冲区或通用 Value 缓冲区，并用位图记录空洞。
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include <mjs/noncopyable.h>
+#include <mjs/value/value.h>
+#include <mjs/gc/gc_object.h>
+
+namespace mjs {
+
+/**
+ * @enum ElementsKind
+ * @brief 数组元素种类
+ *
+ * 低 2 位表示元素表示方式，第 3 位表示是否含空洞。
+ * 只会朝更通用的方向过渡：Int64/Float64 -> Value，Packed -> Holey。
+ *
+ * @note 引擎中 int64 与 float64 是可区分的两种 Value，因此不提供 Int64 -> Float64 的过渡，
+ *       否则已有整数元素读回时会变成浮点数
+ */
+enum class ElementsKind : uint8_t {
+	kPackedInt64 = 0,    ///< 连续的 int64_t 缓冲区
+	kPackedFloat64 = 1,  ///< 连续的 double 缓冲区
+	kPackedValue = 2,    ///< 连续的 Value 缓冲区
+	kHoleyInt64 = 4,     ///< 含空洞的 int64_t 缓冲区
+	kHoleyFloat64 = 5,   ///< 含空洞的 double 缓冲区
+	kHoleyValue = 6,     ///< 含空洞的 Value 缓冲区
+};
+
+/**
+ * @class ArrayElements
+ * @brief 数组稠密元素存储类
+ *
+ * 与命名属性（Object 的属性槽）分离存储，元素按下标连续排列：
+ * - Int64/Float64 种类直接保存原始数值，数值循环可以直接遍历缓冲区
+ * - Value 种类保存完整的 Value
+ * - Holey 种类额外维护空洞位图，位为 1 表示该下标是空洞
+ *
+ * @note 对象会被 GC 以 memcpy 方式移动，这里只持有外部缓冲区指针，移动后仍然有效
+ */
+class ArrayElements : public noncopyable {
+public:
+	ArrayElements() = default;
+	~ArrayElements();
+
+	/**
+	 * @brief 获取元素种类
+	 */
+	ElementsKind kind() const { return kind_; }
+
+	/**
+	 * @brief 是否含空洞种类
+	 */
+	bool is_holey() const { return IsHoley(kind_); }
+
+	/**
+	 * @brief 是否为 int64_t 缓冲区
+	 */
+	bool is_int64() const { return Representation(kind_) == ElementsKind::kPackedInt64; }
+
+	/**
+	 * @brief 是否为 double 缓冲区
+	 */
+	bool is_float64() const { return Representation(kind_) == ElementsKind::kPackedFloat64; }
+
+	/**
+	 * @brief 是否为 Value 缓冲区
+	 */
+	bool is_value() const { return Representation(kind_) == ElementsKind::kPackedValue; }
+
+	/**
+	 * @brief 获取元素数量（包含空洞）
+	 */
+	uint32_t size() const { return size_; }
+
+	/**
+	 * @brief 获取缓冲区容量
+	 */
+	uint32_t capacity() const { return capacity_; }
+
+	/**
+	 * @brief 获取 int64_t 缓冲区（仅 Int64 种类有效）
+	 */
+	int64_t* int64_data() const { assert(is_int64()); return data_.i64_; }
+
+	/**
+	 * @brief 获取 double 缓冲区（仅 Float64 种类有效）
+	 */
+	double* float64_data() const { assert(is_float64()); return data_.f64_; }
+
+	/**
+	 * @brief 获取 Value 缓冲区（仅 Value 种类有效）
+	 */
+	Value* value_data() const { assert(is_value()); return data_.values_; }
+
+	/**
+	 * @brief 检查下标是否为空洞
+	 * @param index 元素下标，必须小于 size()
+	 */
+	bool IsHole(uint32_t index) const {
+		assert(index < size_);
+		return is_holey() && (hole_bitmap_[index / 64] >> (index % 64)) & 1;
+	}
+
+	/**
+	 * @brief 读取元素
+	 * @param index 元素下标
+	 * @param value 输出参数，空洞或越界时为 undefined
+	 * @return 元素是否存在
+	 */
+	bool Get(uint32_t index, Value* value) const {
+		if (index >= size_ || IsHole(index)) {
+			*value = Value();
+			return false;
+		}
+		switch (Representation(kind_)) {
+		case ElementsKind::kPackedInt64:
+			*value = Value(data_.i64_[index]);
+			break;
+		case ElementsKind::kPackedFloat64:
+			*value = Value(data_.f64_[index]);
+			break;
+		default:
+			*value = data_.values_[index];
+			break;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief 写入元素，必要时过渡元素种类
+	 * @param index 元素下标，必须小于 size()
+	 * @param value 元素值
+	 */
+	void Set(uint32_t index, Value&& value);
+
+	/**
+	 * @brief 在末尾追加元素
+	 * @param value 元素值
+	 */
+	void Push(Value&& value);
+
+	/**
+	 * @brief 移除末尾元素
+	 * @param value 输出参数，末尾为空洞时为 undefined
+	 * @return 末尾元素是否存在
+	 */
+	bool Pop(Value* value);
+
+	/**
+	 * @brief 将下标处的元素变为空洞
+	 * @param index 元素下标，必须小于 size()
+	 */
+	void Delete(uint32_t index);
+
+	/**
+	 * @brief 调整元素数量，新增的位置均为空洞
+	 * @param new_size 新的元素数量
+	 */
+	void Resize(uint32_t new_size);
+
+	/**
+	 * @brief 预留容量
+	 * @param new_capacity 期望的容量
+	 */
+	void Reserve(uint32_t new_capacity);
+
+	/**
+	 * @brief 清空所有元素并释放缓冲区，种类重置为 kPackedInt64
+	 */
+	void Clear();
+
+	/**
+	 * @brief 追加另一个元素存储中 [begin, end) 范围的元素，空洞保持为空洞
+	 * @param source 源元素存储，不能是自身
+	 * @param begin 起始下标
+	 * @param end 结束下标（不包含），必须不大于 source.size()
+	 * @note 数值表示相同时按字节整块复制，Value 表示逐个复制构造（每个元素只增加一次引用计数）
+	 */
+	void AppendRange(const ArrayElements& source, uint32_t begin, uint32_t end);
+
+	/**
+	 * @brief 删除 start 起的 delete_count 个元素，并在 start 处腾出 insert_count 个位置
+	 *
+	 * 之后的元素整块移动。腾出的位置暂为 0/undefined 且不是空洞，调用方需随后通过 Set 写入。
+	 *
+	 * @param start 起始下标
+	 * @param delete_count 删除数量，start + delete_count 必须不大于 size()
+	 * @param insert_count 腾出的位置数量
+	 */
+	void Splice(uint32_t start, uint32_t delete_count, uint32_t insert_count);
+
+	/**
+	 * @brief 将 [begin, end) 范围填充为同一个值，必要时过渡元素种类
+	 * @param begin 起始下标
+	 * @param end 结束下标（不包含），必须不大于 size()
+	 * @param value 填充值
+	 */
+	void Fill(uint32_t begin, uint32_t end, const Value& value);
+
+	/**
+	 * @brief 从 from 开始查找第一个与 value 相等的元素，空洞不参与比较
+	 * @param value 查找的值
+	 * @param from 起始下标
+	 * @param same_value_zero 为 true 时 NaN 与 NaN 相等（includes 语义），否则为严格相等（indexOf 语义）
+	 * @return 元素下标，找不到时返回 -1
+	 * @note 数值缓冲区使用 SIMD 整块比较
+	 */
+	int64_t IndexOf(const Value& value, uint32_t from, bool same_value_zero) const;
+
+	/**
+	 * @brief 按 indexOf/includes 的语义比较两个元素
+	 *
+	 * 数值按数学值比较（int64 与 float64 可以相等），对象按引用比较，字符串按内容比较。
+	 */
+	static bool ElementEquals(const Value& element, const Value& value, bool same_value_zero);
+
+	/**
+	 * @brief 统计空洞数量
+	 */
+	uint32_t CountHoles() const;
+
+	/**
+	 * @brief 垃圾回收遍历（仅 Value 种类含有子对象）
+	 */
+	void GCTraverse(Context* context, GCTraverseCallback callback);
+
+	static constexpr bool IsHoley(ElementsKind kind) {
+		return (static_cast<uint8_t>(kind) & 4) != 0;
+	}
+
+	static constexpr ElementsKind Representation(ElementsKind kind) {
+		return static_cast<ElementsKind>(static_cast<uint8_t>(kind) & 3);
+	}
+
+private:
+	static constexpr uint32_t kInitialCapacity = 4;
+
+	static uint32_t BitmapWords(uint32_t capacity) { return (capacity + 63) / 64; }
+
+	bool CanStore(const Value& value) const;
+	void TransitionForValue(const Value& value);
+	void TransitionToValueRepresentation();
+	void TransitionToHoley();
+	void Reallocate(uint32_t new_capacity);
+	void SetHoleBit(uint32_t index, bool hole);
+
+private:
+	ElementsKind kind_ = ElementsKind::kPackedInt64;  ///< 元素种类
+	uint32_t size_ = 0;                               ///< 元素数量（包含空洞）
+	uint32_t capacity_ = 0;                           ///< 缓冲区容量
+	union {
+		int64_t* i64_;
+		double* f64_;
+		Value* values_;
+		void* raw_ = nullptr;
+	} data_;                                          ///< 元素缓冲区
+	std::vector<uint64_t> hole_bitmap_;               ///< 空洞位图（仅 Holey 种类使用）
+};
+
+} // namespace mjs
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mjs/value/object/object.h>
+#include <mjs/value/object/array_elements.h>
 #include <mjs/class_def/array_object_class_def.h>
 #include <vector>
 
@@ -14,9 +15,6 @@ private:
 
     ArrayObject(Context* context, std::initializer_list<Value> values);
 
-    // 初始哈希表容量（用于非数组索引属性）
-    static constexpr size_t kInitialHashTableCapacity = 2;
-
     // JS规范：最大数组索引是 2^32 - 1
     static constexpr uint64_t kMaxArrayIndex = 4294967295ULL;
 
@@ -33,10 +31,8 @@ private:
     static bool TryStringToArrayIndex(std::string_view str, uint64_t* out_index);
 
     uint32_t length_ = 0;                // 数组长度
-    struct {
-        uint32_t slow_property_count_ : 31;   // 哈希表属性数量
-        uint32_t is_sparse_ : 1;             // 是否为稀疏数组模式
-    };
+    bool is_sparse_ = false;             // 是否为稀疏数组模式
+    ArrayElements elements_;             // 稠密元素存储，与命名属性分离
 
     // 检查是否应该转换为稀疏模式
     bool ShouldConvertToSparse(size_t deleted_index) const;
@@ -49,10 +45,16 @@ private:
         return index < length_;
     }
 
-    // 确保哈希表有足够空间
-    void EnsureHashTableCapacity(Context* context);
+    // 按数组下标写入/删除元素
+    void SetIndexedElement(Context* context, uint64_t index, Value&& value);
+    bool DelIndexedElement(Context* context, uint64_t index, Value* value);
+
+    // 将键解析为数组下标
+    static bool TryKeyToArrayIndex(const Value& key, uint64_t* out_index);
 
 public:
+    void GCTraverse(Context* context, GCTraverseCallback callback) override;
+
     bool GetProperty(Context* context, ConstIndex key, Value* value) override;
 
     void SetProperty(Context* context, ConstIndex key, Value&& value) override;
@@ -69,11 +71,38 @@ public:
 
     Value Pop(Context* context);
 
+    // 按下标读取元素，空洞或越界时返回 false
+    bool GetElement(Context* context, size_t index, Value* value);
+
+    // 按下标写入元素，必要时更新 length
+    void SetElement(Context* context, size_t index, Value&& value);
+
     void ForEach(Context* context, Value callback);
 
     // 获取数组长度
     size_t GetLength() const;
 
+    // 是否为稀疏数组模式（稀疏模式下元素存放在命名属性中，elements() 为空）
+    bool is_sparse() const { return is_sparse_; }
+
+    // 稠密元素存储，供数值循环直接遍历连续缓冲区
+    const ArrayElements& elements() const { return elements_; }
+
+    // 预留稠密元素容量
+    void ReserveElements(Context* context, size_t capacity);
+
+    // 追加 source 中 [begin, end) 范围的元素，空洞保持为空洞；双方均为稠密模式时整块复制
+    void AppendElements(Context* context, ArrayObject& source, size_t begin, size_t end);
+
+    // 删除 start 起的 delete_count 个元素并在原位置插入 items，之后的元素整块移动
+    void SpliceElements(Context* context, size_t start, size_t delete_count, const Value* items, size_t item_count);
+
+    // 将 [begin, end) 范围填充为 value，end 不能超过数组长度
+    void FillElements(Context* context, size_t begin, size_t end, const Value& value);
+
+    // 从 from 开始查找与 value 相等的元素下标，找不到时返回 -1（空洞不参与比较）
+    int64_t IndexOfElement(Context* context, const Value& value, size_t from, bool same_value_zero);
+
 private:
     friend class GCManager;
 };
@@ -0,0 +1,90 @@
+/**
+ * @file data_view_object.h
+ * @brief JavaScript DataView 对象定义
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include <mjs/value/object/object.h>
+#include <mjs/value/object/array_buffer_object.h>
+
+namespace mjs {
+
+/**
+ * @class DataViewObject
+ * @brief DataView 对象类
+ *
+ * 以任意字节偏移和字节序读写 ArrayBuffer，默认大端序（与 JS 标准一致）。
+ */
+class DataViewObject : public Object {
+private:
+	/**
+	 * @brief 构造函数
+	 * @param buffer ArrayBuffer 对象
+	 * @param byte_offset 视图在缓冲区中的起始字节偏移
+	 * @param byte_length 视图字节长度，视图不能超出缓冲区
+	 */
+	DataViewObject(Context* context, Value buffer, size_t byte_offset, size_t byte_length);
+
+public:
+	void GCTraverse(Context* context, GCTraverseCallback callback) override;
+
+	bool GetProperty(Context* context, ConstIndex key, Value* value) override;
+
+	/**
+	 * @brief 读取 sizeof(T) 个字节
+	 * @return 越界时返回 false
+	 */
+	template<typename T>
+	bool Load(size_t byte_index, bool little_endian, T* out) const {
+		if (byte_index > byte_length_ || byte_length_ - byte_index < sizeof(T)) {
+			return false;
+		}
+		uint8_t bytes[sizeof(T)];
+		CopyBytes(bytes, data_ + byte_index, sizeof(T), little_endian);
+		std::memcpy(out, bytes, sizeof(T));
+		return true;
+	}
+
+	/**
+	 * @brief 写入 sizeof(T) 个字节
+	 * @return 越界时返回 false
+	 */
+	template<typename T>
+	bool Store(size_t byte_index, bool little_endian, T in) {
+		if (byte_index > byte_length_ || byte_length_ - byte_index < sizeof(T)) {
+			return false;
+		}
+		uint8_t bytes[sizeof(T)];
+		std::memcpy(bytes, &in, sizeof(T));
+		CopyBytes(data_ + byte_index, bytes, sizeof(T), little_endian);
+		return true;
+	}
+
+	size_t byte_offset() const { return byte_offset_; }
+
+	size_t byte_length() const { return byte_length_; }
+
+	const Value& buffer() const { return buffer_; }
+
+private:
+	friend class GCManager;
+
+	/**
+	 * @brief 按指定字节序复制，与本机字节序不同时逆序
+	 */
+	static void CopyBytes(uint8_t* dst, const uint8_t* src, size_t size, bool little_endian);
+
+	Value buffer_;             ///< 所属的 ArrayBuffer
+	uint8_t* data_;            ///< 缓存的数据指针（缓冲区 + 字节偏移）
+	size_t byte_offset_;       ///< 起始字节偏移
+	size_t byte_length_;       ///< 视图字节长度
+};
+
+} // namespace mjs
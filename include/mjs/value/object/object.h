@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <new>
 #include <string_view>
 #include <map>
 #include <unordered_map>
@@ -178,6 +179,48 @@ public:
 	 */
 	void SetPrototype(Context* context, Value prototype);
 
+	/**
+	 * @brief 以预先计算的最终形状初始化属性
+	 *
+	 * 用于对象字面量样板：直接切换到最终形状并按槽位顺序一次性填充属性值，
+	 * 不再逐个属性查找过渡表。
+	 *
+	 * @param shape 最终形状，属性数量必须等于 count
+	 * @param values 按槽位顺序排列的属性值（会被移动）
+	 * @param count 属性数量
+	 * @warning 只能用于刚创建、尚未添加任何属性的对象
+	 */
+	void InitializeWithShape(Shape* shape, Value* values, uint32_t count);
+
+	/**
+	 * @brief 以原型初始化新实例
+	 *
+	 * 直接切换到只包含 __proto__ 的预过渡形状，并按预期槽数预分配属性槽。
+	 *
+	 * @param context 执行上下文指针
+	 * @param prototype 原型对象
+	 * @param slot_capacity 预期的属性槽数量（包含 __proto__）
+	 * @warning 只能用于刚创建、尚未添加任何属性的对象
+	 */
+	void InitializeWithPrototype(Context* context, Value prototype, uint32_t slot_capacity);
+
+	/**
+	 * @brief 获取类标识符
+	 * @return 类标识符
+	 */
+	ClassId class_id() const { return static_cast<ClassId>(tag_.class_id_); }
+
+	/**
+	 * @brief 获取属性槽数量
+	 * @return 属性槽数量
+	 */
+	uint32_t property_slot_count() const { return property_count_; }
+
+	/**
+	 * @brief 获取对象的形状
+	 */
+	Shape* shape() const { return shape_; }
+
 	/**
 	 * @brief 获取指定类型的对象常量引用
 	 * @tparam ObjectT 对象类型
@@ -255,8 +298,8 @@ public:
 	 * @return 属性标志
 	 */
 	uint32_t GetPropertyFlags(PropertySlotIndex index) const {
-		if (index >= 0 && index < static_cast<PropertySlotIndex>(properties_.size())) {
-			return properties_[index].flags;
+		if (index >= 0 && index < static_cast<PropertySlotIndex>(property_count_)) {
+			return property_slots()[index].flags;
 		}
 		return ShapeProperty::kDefault;
 	}
@@ -267,12 +310,90 @@ public:
 	 * @param flags 新的属性标志
 	 */
 	void SetPropertyFlags(PropertySlotIndex index, uint32_t flags) {
-		if (index >= 0 && index < static_cast<PropertySlotIndex>(properties_.size())) {
-			properties_[index].flags = flags;
+		if (index >= 0 && index < static_cast<PropertySlotIndex>(property_count_)) {
+			property_slots()[index].flags = flags;
+		}
+	}
+
+	/**
+	 * @brief 写屏障
+	 *
+	 * 向对象写入引用前调用：老年代对象写入新生代对象的引用时，将对象记录到记忆集，
+	 * 使 Scavenge 不必扫描整个老年代就能找到跨代引用。
+	 *
+	 * @param context 执行上下文指针
+	 * @param value 将要写入的值
+	 */
+	void WriteBarrier(Context* context, const Value& value) {
+		if (header_.generation() == GCGeneration::kOld && !header_.IsRemembered()
+			&& value.IsObject() && value.object().header()->generation() == GCGeneration::kNew) {
+			RecordWrite(context);
+		}
+	}
+
+	/**
+	 * @brief 将老年代对象记录到记忆集
+	 *
+	 * 用于一次写入多个值、不便逐个检查的场景（如批量复制元素、保存生成器栈帧）。
+	 *
+	 * @param context 执行上下文指针
+	 */
+	void RecordWrite(Context* context);
+
+	/**
+	 * @brief 析构屏障
+	 *
+	 * 向对象写入值前调用：Scavenge 不会为未登记的死亡新生代对象调用析构函数，
+	 * 写入引用计数的值（字符串、闭包变量等）时需要登记，使其在对象死亡时得到释放。
+	 *
+	 * @param value 将要写入的值
+	 */
+	void FinalizerBarrier(const Value& value) {
+		if (tag_.young_managed_ && !header_.IsFinalizable() && value.IsReferenceCounter()) {
+			RegisterFinalizer();
+		}
+	}
+
+	/**
+	 * @brief 登记对象在新生代中死亡时调用析构函数
+	 */
+	void RegisterFinalizer();
+
+	/**
+	 * @brief 由GC分配对象后调用
+	 *
+	 * 设置对象内属性槽的容量；新生代对象改由GC堆持有形状的引用（见 GCHeap::PinYoungShape）。
+	 *
+	 * @param heap 分配对象的GC堆
+	 * @param in_object_size 对象之后预留给属性槽的字节数
+	 */
+	void InitializeGCAllocated(GCHeap* heap, size_t in_object_size);
+
+	/**
+	 * @brief 晋升到老年代后调用，改为持有形状的引用计数
+	 */
+	void ReferenceShapeOnPromotion();
+
+	/**
+	 * @brief 标记屏障
+	 *
+	 * 修改对象中的任何引用（包括覆盖、删除和重新分配存储）前调用：并发标记期间，
+	 * 老年代对象尚未被扫描时先扫描它，使标记开始时对象持有的引用不会丢失。
+	 *
+	 * @param context 执行上下文指针
+	 */
+	void MarkingBarrier(Context* context) {
+		if (header_.generation() == GCGeneration::kOld && !header_.IsScanned()) {
+			MarkingBarrierSlow(context);
 		}
 	}
 
 protected:
+	/**
+	 * @brief 标记屏障慢路径，由GC堆判断是否处于并发标记期间
+	 */
+	void MarkingBarrierSlow(Context* context);
+
 	/**
 	 * @brief 属性存储结构（值 + 标志）
 	 *
@@ -287,44 +408,98 @@ protected:
 		PropertySlot(Value&& v, uint32_t f) : value(std::move(v)), flags(f) {}
 	};
 
+	/**
+	 * @brief 获取属性槽数组
+	 *
+	 * 属性槽不超过对象内容量时存放在对象之后（只有 Object 本身在分配时预留，见 GCObjectTraits<Object>），
+	 * 对象移动后按新地址计算，不需要修正指针；超出时改为存放在对象外分配的数组中。
+	 */
+	PropertySlot* property_slots() {
+		return out_of_line_properties_ ? out_of_line_properties_ : in_object_properties();
+	}
+
+	const PropertySlot* property_slots() const {
+		return const_cast<Object*>(this)->property_slots();
+	}
+
+	PropertySlot* in_object_properties() {
+		return reinterpret_cast<PropertySlot*>(reinterpret_cast<uint8_t*>(this) + sizeof(Object));
+	}
+
+	/**
+	 * @brief 预留属性槽，超出当前容量时转移到对象外的数组
+	 * @param capacity 需要的属性槽数量
+	 */
+	void ReservePropertySlots(uint32_t capacity);
+
+	/**
+	 * @brief 更换形状（新生代对象由GC堆持有新形状的引用）
+	 */
+	void ReplaceShape(Shape* shape);
+
+	/**
+	 * @brief 沿过渡表为形状添加属性，返回属性的槽位
+	 */
+	PropertySlotIndex AddShapeProperty(ShapeProperty&& property);
+
+	/**
+	 * @brief 获取新生代对象所在的GC堆
+	 *
+	 * 对象的形状总是来自分配它的上下文，不依赖调用方传入的上下文。
+	 */
+	GCHeap* young_heap() const;
+
 	/**
 	 * @brief 获取属性值引用
 	 */
 	Value& GetPropertyValue(PropertySlotIndex index) {
-		return properties_[index].value;
+		return property_slots()[index].value;
 	}
 
 	/**
 	 * @brief 获取属性值引用
 	 */
 	const Value& GetPropertyValue(PropertySlotIndex index) const {
-		return properties_[index].value;
+		return property_slots()[index].value;
 	}
 
 	/**
 	 * @brief 设置属性值
 	 */
-	void SetPropertyValue(PropertySlotIndex index, Value&& value) {
-		properties_[index].value = std::move(value);
+	void SetPropertyValue(Context* context, PropertySlotIndex index, Value&& value) {
+		MarkingBarrier(context);
+		WriteBarrier(context, value);
+		FinalizerBarrier(value);
+		property_slots()[index].value = std::move(value);
 	}
 
 	/**
 	 * @brief 添加新属性槽
 	 */
-	void AddPropertySlot(PropertySlotIndex index, Value&& value, uint32_t flags) {
-		if (index < static_cast<PropertySlotIndex>(properties_.size())) {
-			properties_[index] = PropertySlot(std::move(value), flags);
+	void AddPropertySlot(Context* context, PropertySlotIndex index, Value&& value, uint32_t flags) {
+		MarkingBarrier(context);
+		WriteBarrier(context, value);
+		FinalizerBarrier(value);
+		if (index < static_cast<PropertySlotIndex>(property_count_)) {
+			property_slots()[index] = PropertySlot(std::move(value), flags);
 		} else {
-			assert(index == static_cast<PropertySlotIndex>(properties_.size()));
-			properties_.emplace_back(std::move(value), flags);
+			assert(index == static_cast<PropertySlotIndex>(property_count_));
+			if (property_count_ == property_capacity_) {
+				ReservePropertySlots(property_count_ + 1);
+			}
+			new (&property_slots()[property_count_]) PropertySlot(std::move(value), flags);
+			++property_count_;
 		}
 	}
 
 protected:
 	friend class GCManager;
+	friend class HeapSnapshotWriter;
+	template <typename ObjectT> friend struct GCObjectTraits;
 
+	HeapPointer<Shape> shape_;              ///< 形状指针（对象布局描述，包含原型信息），启用指针压缩时为32位偏移
 	union {
-		uint64_t full_ = 0;                   ///< 完整64位值
+		uint32_t full_ = 0;                   ///< 完整32位值
 		struct {
 			static_assert(sizeof(uint16_t) == sizeof(ClassId));
 			uint32_t class_id_ : 16;			///< 类id
@@ -332,11 +507,27 @@ protected:
 			uint32_t is_frozen_ : 1;            ///< 是否已冻结（JS 标准）
 			uint32_t is_sealed_ : 1;            ///< 是否已密封（JS 标准）
 			uint32_t set_proto_ : 1;			/// < 是否设置了__proto__
-			uint32_t reserved_ : 12;            ///< 保留位
+			uint32_t young_managed_ : 1;        ///< 由GC分配在新生代（形状的引用由GC堆持有，按需登记析构）
+			uint32_t reserved_ : 11;            ///< 保留位
 		};
 	} tag_;
-	Shape* shape_;                          ///< 形状指针（对象布局描述，包含原型信息）
-	std::vector<PropertySlot> properties_;  ///< 属性槽向量（每个对象独立）
+	PropertySlot* out_of_line_properties_ = nullptr;  ///< 对象外的属性槽数组（属性槽在对象内时为空）
+	uint32_t property_count_ = 0;           ///< 属性槽数量（每个对象独立）
+	uint32_t property_capacity_ = 0;        ///< 属性槽容量
+};
+
+/**
+ * @brief 对象内属性槽数量
+ */
+constexpr uint32_t kInObjectPropertySlots = 4;
+
+/**
+ * @brief 普通对象在对象之后预留属性槽，不持有堆外资源时不需要析构
+ */
+template <>
+struct GCObjectTraits<Object> {
+	static constexpr size_t kInObjectSize = kInObjectPropertySlots * sizeof(Object::PropertySlot);
+	static constexpr bool kNeedsFinalization = false;
 };
 
 } // namespace mjs
\ No newline at end of file
@@ -0,0 +1,188 @@
+/**
+ * @file typed_array_object.h
+ * @brief JavaScript TypedArray 对象定义
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ *
+ * TypedArray 是 ArrayBuffer 上的定长数值视图，元素直接以原始字节存储，
+ * 虚拟机的下标读写指令对其有专门的快速路径。
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+#include <mjs/value/object/object.h>
+#include <mjs/value/object/array_buffer_object.h>
+
+namespace mjs {
+
+/**
+ * @enum TypedArrayKind
+ * @brief TypedArray 元素类型
+ */
+enum class TypedArrayKind : uint8_t {
+	kUint8,     ///< Uint8Array
+	kInt32,     ///< Int32Array
+	kFloat64,   ///< Float64Array
+};
+
+/**
+ * @class TypedArrayObject
+ * @brief TypedArray 对象类
+ *
+ * 宿主包装外部缓冲区后，可以直接在其上创建视图：
+ * @code
+ *   GCHandleScope<2> scope(context);
+ *   auto buffer = scope.New<ArrayBufferObject>(data, byte_length, release, opaque);
+ *   auto view = scope.New<TypedArrayObject>(TypedArrayKind::kFloat64, buffer.ToValue(), 0, byte_length / 8);
+ * @endcode
+ */
+class TypedArrayObject : public Object {
+private:
+	/**
+	 * @brief 构造函数
+	 * @param kind 元素类型
+	 * @param buffer ArrayBuffer 对象
+	 * @param byte_offset 视图在缓冲区中的起始字节偏移，必须按元素大小对齐
+	 * @param length 元素数量，视图不能超出缓冲区
+	 */
+	TypedArrayObject(Context* context, TypedArrayKind kind, Value buffer, size_t byte_offset, size_t length);
+
+public:
+	void GCTraverse(Context* context, GCTraverseCallback callback) override;
+
+	bool GetProperty(Context* context, ConstIndex key, Value* value) override;
+
+	void SetProperty(Context* context, ConstIndex key, Value&& value) override;
+
+	bool GetComputedProperty(Context* context, const Value& key, Value* value) override;
+
+	void SetComputedProperty(Context* context, const Value& key, Value&& value) override;
+
+	/**
+	 * @brief 按下标读取元素
+	 * @return 下标越界时返回 false
+	 */
+	bool GetElement(int64_t index, Value* value) const {
+		if (index < 0 || static_cast<uint64_t>(index) >= length_) {
+			return false;
+		}
+		switch (kind_) {
+		case TypedArrayKind::kUint8:
+			*value = Value(static_cast<int64_t>(data_[index]));
+			break;
+		case TypedArrayKind::kInt32: {
+			int32_t element;
+			std::memcpy(&element, data_ + index * sizeof(int32_t), sizeof(element));
+			*value = Value(static_cast<int64_t>(element));
+			break;
+		}
+		case TypedArrayKind::kFloat64: {
+			double element;
+			std::memcpy(&element, data_ + index * sizeof(double), sizeof(element));
+			*value = Value(element);
+			break;
+		}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief 按下标写入元素，值按元素类型截断
+	 * @note 下标越界时静默忽略，与 JS 标准一致
+	 */
+	void SetElement(int64_t index, const Value& value) {
+		if (index < 0 || static_cast<uint64_t>(index) >= length_) {
+			return;
+		}
+		switch (kind_) {
+		case TypedArrayKind::kUint8:
+			data_[index] = static_cast<uint8_t>(ToInt32Bits(value));
+			break;
+		case TypedArrayKind::kInt32: {
+			auto element = static_cast<int32_t>(ToInt32Bits(value));
+			std::memcpy(data_ + index * sizeof(int32_t), &element, sizeof(element));
+			break;
+		}
+		case TypedArrayKind::kFloat64: {
+			auto element = ToDouble(value);
+			std::memcpy(data_ + index * sizeof(double), &element, sizeof(element));
+			break;
+		}
+		}
+	}
+
+	TypedArrayKind kind() const { return kind_; }
+
+	size_t length() const { return length_; }
+
+	size_t byte_offset() const { return byte_offset_; }
+
+	size_t byte_length() const { return length_ * ElementSize(kind_); }
+
+	uint8_t* data() const { return data_; }
+
+	const Value& buffer() const { return buffer_; }
+
+	static size_t ElementSize(TypedArrayKind kind) {
+		switch (kind) {
+		case TypedArrayKind::kUint8: return sizeof(uint8_t);
+		case TypedArrayKind::kInt32: return sizeof(int32_t);
+		default: return sizeof(double);
+		}
+	}
+
+	static ClassId KindToClassId(TypedArrayKind kind) {
+		switch (kind) {
+		case TypedArrayKind::kUint8: return ClassId::kUint8ArrayObject;
+		case TypedArrayKind::kInt32: return ClassId::kInt32ArrayObject;
+		default: return ClassId::kFloat64ArrayObject;
+		}
+	}
+
+	static bool IsTypedArrayClassId(ClassId class_id) {
+		return class_id >= ClassId::kUint8ArrayObject && class_id <= ClassId::kFloat64ArrayObject;
+	}
+
+	/**
+	 * @brief 数值转 double，非数值视为 NaN
+	 */
+	static double ToDouble(const Value& value) {
+		if (value.IsInt64()) return static_cast<double>(value.i64());
+		if (value.IsFloat()) return value.f64();
+		if (value.IsUInt64()) return static_cast<double>(value.u64());
+		if (value.IsBoolean()) return value.boolean() ? 1.0 : 0.0;
+		return std::nan("");
+	}
+
+	/**
+	 * @brief 按 JS ToInt32 语义取低 32 位（NaN/Infinity 为 0）
+	 */
+	static uint32_t ToInt32Bits(const Value& value) {
+		if (value.IsInt64()) {
+			return static_cast<uint32_t>(value.i64());
+		}
+		auto number = ToDouble(value);
+		if (!std::isfinite(number)) {
+			return 0;
+		}
+		return static_cast<uint32_t>(static_cast<int64_t>(std::fmod(std::trunc(number), 4294967296.0)));
+	}
+
+private:
+	friend class GCManager;
+
+	static bool TryKeyToIndex(const Value& key, int64_t* index);
+
+	Value buffer_;             ///< 所属的 ArrayBuffer
+	uint8_t* data_;            ///< 缓存的数据指针（缓冲区 + 字节偏移），缓冲区不随 GC 移动
+	size_t byte_offset_;       ///< 起始字节偏移
+	size_t length_;            ///< 元素数量
+	TypedArrayKind kind_;      ///< 元素类型
+};
+
+} // namespace mjs
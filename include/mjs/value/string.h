@@ -15,6 +15,7 @@
 #include <format>
 
 #include <mjs/reference_counter.h>
+#include <mjs/gc/native_memory.h>
 
 namespace mjs {
 
@@ -41,9 +42,18 @@ private:
 	 * @param size 字符串长度
 	 */
 	String(size_t size)
-		: size_(size) {}
+		: size_(size) {
+		NativeMemory::Allocate(sizeof(String) + size + 1);
+	}
 
 public:
+	/**
+	 * @brief 析构函数，从原生内存统计中扣除
+	 */
+	~String() {
+		NativeMemory::Free(sizeof(String) + size_ + 1);
+	}
+
 	/**
 	 * @brief 获取字符串哈希值
 	 * @return 字符串哈希值
@@ -60,6 +70,14 @@ public:
 		return data_;
 	}
 
+	/**
+	 * @brief 获取字符串长度（字节数）
+	 * @return 字符串长度
+	 */
+	size_t size() const {
+		return size_;
+	}
+
 	/**
 	 * @brief 检查字符串是否为空
 	 * @return 是否为空字符串
@@ -121,6 +139,26 @@ public:
 		return s;
 	}
 
+	/**
+	 * @brief 创建指定长度的字符串，内容由 writer 直接写入
+	 *
+	 * 用于预先计算好总长度的拼接（如 Array.prototype.join），只分配一次内存。
+	 *
+	 * @tparam Writer 写入函数类型，签名为 void(char* data)
+	 * @param size 字符串长度
+	 * @param writer 写入函数，必须恰好写入 size 个字节
+	 * @return 新创建的字符串指针
+	 */
+	template<typename Writer>
+	static String* New(size_t size, Writer&& writer) {
+		String* s = static_cast<String*>(::operator new(sizeof(String) + size + 1));
+		new (s) String(size);
+		writer(s->data_);
+		s->data_[size] = '\0';
+		s->hash_ = std::hash<std::string_view>()(std::string_view(s->data_, size));
+		return s;
+	}
+
 	/**
 	 * @brief 从迭代器范围创建字符串
 	 * @tparam Iterator 迭代器类型
@@ -376,6 +376,9 @@ public:
 	/** @brief 获取对象引用 */
 	Object& object() const;
 
+	/** @brief 替换对象指针并保留值类型（GC 移动对象后更新引用） */
+	void set_object(Object* object) { value_.object_ = object; }
+
 	/**
 	 * @brief 获取指定类型的对象引用
 	 * @tparam ObjectT 对象类型
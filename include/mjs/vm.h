@@ -58,6 +58,7 @@ struct JitStubs;
 class VM : public noncopyable {
 public:
 	friend class CodeGenerator;
+	friend class PreparedCall;
 	friend struct jit::JitStubs;
 	friend class ::mjs::test::VMTest;
 	friend class ::mjs::test::VMModuleTest;
@@ -107,6 +108,12 @@ public:
 		return stack_frame->pop();
 }
 
+	/**
+	 * @brief 获取正在执行的栈帧，沿 upper_stack_frame 可以遍历整个调用栈
+	 * @return 栈帧指针，没有正在执行的函数时返回 nullptr
+	 */
+	const StackFrame* current_stack_frame() const { return current_stack_frame_; }
+
 private:
 	/**
 	 * @brief 获取变量值
@@ -168,6 +175,12 @@ private:
 	 */
 	bool ThrowException(StackFrame* stack_frame, std::optional<Value>* error_val, bool need_inc_pc = false);
 
+	/**
+	 * @brief 超过堆硬限制：按配置进入终止状态，返回要抛出的 RangeError
+	 * @return 异常值
+	 */
+	Value HeapLimitExceeded();
+
 private:
 	/**
 	 * @brief 保存生成器上下文
@@ -191,6 +204,9 @@ private:
 
 private:
 	Context* context_; ///< 执行上下文指针
+	uint32_t call_depth_ = 0; ///< 正在执行的字节码函数层数，返回到宿主时为0
+	bool terminating_ = false; ///< 是否正在终止执行（异常不能被捕获）
+	const StackFrame* current_stack_frame_ = nullptr; ///< 正在执行的栈帧
 	// StackFrame stack_frame_; ///< 栈帧（已注释）
 };
 
@@ -93,6 +93,7 @@ const std::unordered_map<OpcodeType, OpcodeInfo>& BytecodeTable::opcode_type_map
 
         {OpcodeType::kNew, {"new", {}}},
         {OpcodeType::kGetSuper, {"get_super", {}}},
+        {OpcodeType::kNewObjectFromBoilerplate, {"new_object_from_boilerplate", {2}}},
 
         {OpcodeType::kTryBegin, {"try_begin", {}}},
         {OpcodeType::kThrow, {"throw", {}}},
@@ -0,0 +1,54 @@
+#include <mjs/class_def/array_buffer_object_class_def.h>
+
+#include <cmath>
+
+#include <mjs/stack_frame.h>
+#include <mjs/context.h>
+#include <mjs/runtime.h>
+#include <mjs/gc/handle.h>
+#include <mjs/value/object/array_buffer_object.h>
+
+namespace mjs {
+
+ArrayBufferObjectClassDef::ArrayBufferObjectClassDef(Runtime* runtime)
+	: ClassDef(runtime, ClassId::kArrayBufferObject, "ArrayBuffer")
+{
+	prototype_.object().SetPrototype(&runtime->default_context(), runtime->class_def_table()[ClassId::kObject].prototype());
+	constructor_.object().SetPrototype(&runtime->default_context(), runtime->class_def_table()[ClassId::kFunctionObject].prototype());
+}
+
+Value ArrayBufferObjectClassDef::NewConstructor(Context* context, uint32_t par_count, const StackFrame& stack) const {
+	// new ArrayBuffer(byteLength)
+	size_t byte_length = 0;
+	if (par_count >= 1 && !ToIndex(stack.get(0), &byte_length)) {
+		return RangeError::Throw(context, "Invalid array buffer length");
+	}
+	GCHandleScope<1> scope(context);
+	auto buffer = scope.New<ArrayBufferObject>(byte_length);
+	return scope.Close(buffer);
+}
+
+bool ArrayBufferObjectClassDef::ToIndex(const Value& value, size_t* out) {
+	if (value.IsInt64()) {
+		if (value.i64() < 0) {
+			return false;
+		}
+		*out = static_cast<size_t>(value.i64());
+		return true;
+	}
+	if (value.IsFloat()) {
+		auto number = value.f64();
+		if (!(number >= 0) || !std::isfinite(number)) {
+			return false;
+		}
+		*out = static_cast<size_t>(number);
+		return true;
+	}
+	if (value.IsUndefined()) {
+		*out = 0;
+		return true;
+	}
+	return false;
+}
+
+} // namespace mjs
@@ -1,14 +1,282 @@
 #include <mjs/class_def/array_object_class_def.h>
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
 #include <mjs/stack_frame.h>
 #include <mjs/context.h>
 #include <mjs/runtime.h>
 #include <mjs/gc/handle.h>
+#include <mjs/prepared_call.h>
+#include <mjs/sort.h>
 #include <mjs/value/object/array_object.h>
 #include <mjs/value/object/function_object.h>
+#include <mjs/value/string.h>
 
 namespace mjs {
 
+namespace {
+
+constexpr uint64_t kPow10[] = {
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+	1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+	100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+	1000000000000000000ULL,
+};
+
+// 默认比较按元素的字符串形式排序，整数不生成字符串即可得到相同的顺序：
+// '-' 小于任何数字字符，负数排在前面；绝对值的十进制数字右侧补 0 到 19 位后比较，
+// 相等时位数少的（即前缀）排在前面
+struct Int64SortKey {
+	uint64_t scaled;
+	int64_t value;
+	uint8_t digits;
+	bool non_negative;
+
+	bool operator<(const Int64SortKey& rhs) const {
+		if (non_negative != rhs.non_negative) {
+			return !non_negative;
+		}
+		if (scaled != rhs.scaled) {
+			return scaled < rhs.scaled;
+		}
+		return digits < rhs.digits;
+	}
+};
+
+Int64SortKey MakeInt64SortKey(int64_t value) {
+	Int64SortKey key;
+	key.value = value;
+	key.non_negative = value >= 0;
+	uint64_t abs = key.non_negative ? static_cast<uint64_t>(value) : 0 - static_cast<uint64_t>(value);
+	uint8_t digits = 1;
+	for (uint64_t n = abs; n >= 10; n /= 10) {
+		++digits;
+	}
+	key.digits = digits;
+	key.scaled = abs * kPow10[19 - digits];
+	return key;
+}
+
+struct StringSortKey {
+	std::string_view key;
+	uint32_t index;
+};
+
+std::string_view StringValueView(const Value& value) {
+	if (value.type() == ValueType::kString) {
+		return std::string_view(value.string().data(), value.string().size());
+	}
+	return value.string_view();
+}
+
+bool IsAllStrings(const ArrayElements& elements) {
+	for (uint32_t i = 0; i < elements.size(); ++i) {
+		if (!elements.IsHole(i) && !elements.value_data()[i].IsString()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// 比较函数返回值小于 0 表示 a 排在 b 前面，非数值视为 0
+bool IsNegativeCompareResult(const Value& result) {
+	if (result.IsInt64()) {
+		return result.i64() < 0;
+	}
+	if (result.IsFloat()) {
+		return result.f64() < 0;
+	}
+	return false;
+}
+
+// 按 ToIntegerOrInfinity 转换为整数，NaN 和非数值视为 0
+int64_t ToIntegerOrZero(const Value& value) {
+	if (value.IsInt64()) {
+		return value.i64();
+	}
+	if (value.IsFloat()) {
+		auto number = value.f64();
+		if (std::isnan(number)) {
+			return 0;
+		}
+		if (number >= 9223372036854775807.0) {
+			return INT64_MAX;
+		}
+		if (number <= -9223372036854775808.0) {
+			return INT64_MIN;
+		}
+		return static_cast<int64_t>(number);
+	}
+	return 0;
+}
+
+// 将相对下标参数转换为 [0, length] 范围内的下标，负数从末尾开始计算
+size_t ToRelativeIndex(const Value& value, size_t length, size_t default_index) {
+	if (value.IsUndefined()) {
+		return default_index;
+	}
+	auto relative = ToIntegerOrZero(value);
+	auto signed_length = static_cast<int64_t>(length);
+	if (relative < 0) {
+		return static_cast<size_t>(std::max<int64_t>(signed_length + relative, 0));
+	}
+	return static_cast<size_t>(std::min(relative, signed_length));
+}
+
+const Value& ArgumentOrUndefined(uint32_t par_count, const StackFrame& stack, uint32_t index) {
+	static const Value undefined;
+	return index < par_count ? stack.get(index) : undefined;
+}
+
+// 整数的十进制字符串长度（含负号）
+size_t Int64DecimalLength(int64_t value) {
+	uint64_t abs = value >= 0 ? static_cast<uint64_t>(value) : 0 - static_cast<uint64_t>(value);
+	size_t length = value < 0 ? 2 : 1;
+	for (; abs >= 10; abs /= 10) {
+		++length;
+	}
+	return length;
+}
+
+// 按 JS 标准收集 this 数组中除 undefined 和空洞以外的元素，排序后依次追加到 sorted，
+// undefined 的数量通过 undefined_count 返回，由调用方补到末尾
+Value CollectSorted(Context* context, uint32_t par_count, const StackFrame& stack, GCHandle<ArrayObject> sorted, size_t* undefined_count) {
+	*undefined_count = 0;
+	Value comparator;
+	if (par_count >= 1) {
+		comparator = stack.get(0);
+	}
+	if (!comparator.IsUndefined() && !comparator.IsFunctionObject() && !comparator.IsFunctionDef()) {
+		return TypeError::Throw(context, "The comparison function must be either a function or undefined");
+	}
+
+	auto length = stack.this_val().array().GetLength();
+
+	// 默认比较的特化路径：直接读取稠密元素缓冲区，排序过程中不会调用脚本，也不会触发 GC
+	if (comparator.IsUndefined() && !stack.this_val().array().is_sparse()) {
+		auto& elements = stack.this_val().array().elements();
+		if (elements.is_int64()) {
+			std::vector<Int64SortKey> keys;
+			keys.reserve(elements.size());
+			for (uint32_t i = 0; i < elements.size(); ++i) {
+				if (!elements.IsHole(i)) {
+					keys.push_back(MakeInt64SortKey(elements.int64_data()[i]));
+				}
+			}
+			// 键相等时整数值也相等，无需稳定排序
+			PdqSort(keys.begin(), keys.end(), std::less<>());
+			sorted->ReserveElements(context, keys.size());
+			for (auto& key : keys) {
+				sorted->Push(context, Value(key.value));
+			}
+			return Value();
+		}
+		if (elements.is_value() && IsAllStrings(elements)) {
+			std::vector<StringSortKey> keys;
+			keys.reserve(elements.size());
+			for (uint32_t i = 0; i < elements.size(); ++i) {
+				if (!elements.IsHole(i)) {
+					keys.push_back({ StringValueView(elements.value_data()[i]), i });
+				}
+			}
+			// 内容相同的字符串不可区分，无需稳定排序
+			PdqSort(keys.begin(), keys.end(), [](const StringSortKey& lhs, const StringSortKey& rhs) {
+				return lhs.key < rhs.key;
+			});
+			sorted->ReserveElements(context, keys.size());
+			for (auto& key : keys) {
+				sorted->Push(context, stack.this_val().array().elements().value_data()[key.index]);
+			}
+			return Value();
+		}
+	}
+
+	// 通用路径：元素快照到临时数组中，临时数组在根集中，比较函数触发 GC 时元素会被更新
+	GCHandleScope<1> scope(context);
+	auto snapshot = scope.New<ArrayObject>();
+	for (size_t i = 0; i < length; ++i) {
+		Value element;
+		if (!stack.this_val().array().GetElement(context, i, &element)) {
+			continue;
+		}
+		if (element.IsUndefined()) {
+			++*undefined_count;
+			continue;
+		}
+		snapshot->Push(context, std::move(element));
+	}
+
+	auto count = snapshot->GetLength();
+	std::vector<uint32_t> order(count);
+	std::iota(order.begin(), order.end(), 0);
+
+	if (comparator.IsUndefined()) {
+		// 按字符串形式排序，字符串相同的元素（如 0 与 -0）按下标保持原有顺序
+		std::vector<Value> strings;
+		strings.reserve(count);
+		std::vector<StringSortKey> keys;
+		keys.reserve(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			Value element;
+			snapshot->GetElement(context, i, &element);
+			auto str = element.ToString(context);
+			if (str.IsException()) {
+				return str;
+			}
+			strings.push_back(std::move(str));
+			keys.push_back({ StringValueView(strings.back()), i });
+		}
+		PdqSort(keys.begin(), keys.end(), [](const StringSortKey& lhs, const StringSortKey& rhs) {
+			auto result = lhs.key.compare(rhs.key);
+			return result < 0 || (result == 0 && lhs.index < rhs.index);
+		});
+		for (uint32_t i = 0; i < count; ++i) {
+			order[i] = keys[i].index;
+		}
+	}
+	else {
+		// 用户比较函数：稳定归并排序，通过复用的栈帧调用比较函数
+		std::vector<uint32_t> buffer(count);
+		PreparedCall call(context, comparator, Value());
+		Value exception;
+		MergeSort(order.data(), order.data() + count, buffer.data(), [&](uint32_t lhs, uint32_t rhs) {
+			if (!exception.IsUndefined()) {
+				return false;
+			}
+			Value a, b;
+			snapshot->GetElement(context, lhs, &a);
+			snapshot->GetElement(context, rhs, &b);
+			auto result = call.Call(std::move(a), std::move(b));
+			if (result.IsException()) {
+				// 记录异常，剩余的比较直接返回，排序结束后抛出
+				exception = std::move(result);
+				return false;
+			}
+			return IsNegativeCompareResult(result);
+		});
+		if (!exception.IsUndefined()) {
+			return exception;
+		}
+	}
+
+	sorted->ReserveElements(context, count);
+	for (auto index : order) {
+		Value element;
+		snapshot->GetElement(context, index, &element);
+		sorted->Push(context, std::move(element));
+	}
+	return Value();
+}
+
+} // namespace
+
 ArrayObjectClassDef::ArrayObjectClassDef(Runtime* runtime)
 	: ClassDef(runtime, ClassId::kArrayObject, "Array")
 {
@@ -44,25 +312,23 @@ ArrayObjectClassDef::ArrayObjectClassDef(Runtime* runtime)
 		if (par_count < 1) {
 			return TypeError::Throw(context, "forEach requires a callback function");
 		}
-		auto& arr = stack.this_val().array();
-		auto callback = stack.get(0);
+		auto& callback = stack.get(0);
 		if (!callback.IsFunctionObject() && !callback.IsFunctionDef()) {
 			return TypeError::Throw(context, "forEach callback must be a function");
 		}
 
-		for (size_t i = 0; i < arr.GetLength(); ++i) {
+		PreparedCall call(context, callback, Value());
+		// 回调可能修改数组或触发 GC 移动数组对象，每次迭代都从 this 重新获取
+		for (size_t i = 0; i < stack.this_val().array().GetLength(); ++i) {
 			Value elem;
-			bool exists = arr.GetComputedProperty(context, Value(static_cast<int64_t>(i)), &elem);
 			// JS标准：跳过空洞元素（不存在的属性）
-			if (!exists) {
+			if (!stack.this_val().array().GetElement(context, i, &elem)) {
 				continue;
 			}
-			std::array<Value, 3> args = {
-				elem,
-				Value(static_cast<int64_t>(i)),
-				stack.this_val()
-			};
-			context->CallFunction(&callback, Value(), args.begin(), args.end());
+			auto ret = call.Call(std::move(elem), Value(static_cast<int64_t>(i)), stack.this_val());
+			if (ret.IsException()) {
+				return ret;
+			}
 		}
 		return Value();
 	}));
@@ -72,28 +338,33 @@ ArrayObjectClassDef::ArrayObjectClassDef(Runtime* runtime)
 		if (par_count < 1) {
 			return TypeError::Throw(context, "map requires a callback function");
 		}
-		auto& arr = stack.this_val().array();
-		auto callback = stack.get(0);
+		auto& callback = stack.get(0);
 		if (!callback.IsFunctionObject() && !callback.IsFunctionDef()) {
 			return TypeError::Throw(context, "map callback must be a function");
 		}
 
+		auto length = stack.this_val().array().GetLength();
 		GCHandleScope<1> scope(context);
-		auto result = scope.New<ArrayObject>(arr.GetLength());
-		for (size_t i = 0; i < arr.GetLength(); ++i) {
+		// 预留结果容量，按下标依次写入，源数组无空洞时结果保持 packed
+		auto result = scope.New<ArrayObject>();
+		result->ReserveElements(context, length);
+
+		PreparedCall call(context, callback, Value());
+		for (size_t i = 0; i < length && i < stack.this_val().array().GetLength(); ++i) {
 			Value elem;
-			bool exists = arr.GetComputedProperty(context, Value(static_cast<int64_t>(i)), &elem);
 			// JS标准：跳过空洞元素，但保持索引位置（创建稀疏数组）
-			if (!exists) {
+			if (!stack.this_val().array().GetElement(context, i, &elem)) {
 				continue;
 			}
-			std::array<Value, 3> args = {
-				elem,
-				Value(static_cast<int64_t>(i)),
-				stack.this_val()
-			};
-			auto mapped_value = context->CallFunction(&callback, Value(), args.begin(), args.end());
-			result->SetComputedProperty(context, Value(static_cast<int64_t>(i)), std::move(mapped_value));
+			auto mapped_value = call.Call(std::move(elem), Value(static_cast<int64_t>(i)), stack.this_val());
+			if (mapped_value.IsException()) {
+				return mapped_value;
+			}
+			result->SetElement(context, i, std::move(mapped_value));
+		}
+		// 末尾的空洞同样计入 length
+		if (result->GetLength() < length) {
+			result->SetProperty(context, ConstIndexEmbedded::kLength, Value(static_cast<int64_t>(length)));
 		}
 		return scope.Close(result);
 	}));
@@ -103,29 +374,26 @@ ArrayObjectClassDef::ArrayObjectClassDef(Runtime* runtime)
 		if (par_count < 1) {
 			return TypeError::Throw(context, "filter requires a callback function");
 		}
-		auto& arr = stack.this_val().array();
-		auto callback = stack.get(0);
-		if (!callback.IsFunctionObject()) {
+		auto& callback = stack.get(0);
+		if (!callback.IsFunctionObject() && !callback.IsFunctionDef()) {
 			return TypeError::Throw(context, "filter callback must be a function");
 		}
 
 		GCHandleScope<1> scope(context);
 		auto result = scope.New<ArrayObject>();
-		for (size_t i = 0; i < arr.GetLength(); ++i) {
+		PreparedCall call(context, callback, Value());
+		for (size_t i = 0; i < stack.this_val().array().GetLength(); ++i) {
 			Value elem;
-			bool exists = arr.GetComputedProperty(context, Value(static_cast<int64_t>(i)), &elem);
 			// JS标准：跳过空洞元素
-			if (!exists) {
+			if (!stack.this_val().array().GetElement(context, i, &elem)) {
 				continue;
 			}
-			std::array<Value, 3> args = {
-				elem,
-				Value(static_cast<int64_t>(i)),
-				stack.this_val()
-			};
-			auto callback_result = context->CallFunction(&callback, Value(), args.begin(), args.end());
+			auto callback_result = call.Call(elem, Value(static_cast<int64_t>(i)), stack.this_val());
+			if (callback_result.IsException()) {
+				return callback_result;
+			}
 			if (callback_result.ToBoolean().boolean()) {
-				result->Push(context, elem);
+				result->Push(context, std::move(elem));
 			}
 		}
 		return scope.Close(result);
@@ -136,8 +404,7 @@ ArrayObjectClassDef::ArrayObjectClassDef(Runtime* runtime)
 		if (par_count < 1) {
 			return TypeError::Throw(context, "reduce requires a callback function");
 		}
-		auto& arr = stack.this_val().array();
-		auto callback = stack.get(0);
+		auto& callback = stack.get(0);
 		if (!callback.IsFunctionObject() && !callback.IsFunctionDef()) {
 			return TypeError::Throw(context, "reduce callback must be a function");
 		}
@@ -150,11 +417,10 @@ ArrayObjectClassDef::ArrayObjectClassDef(Runtime* runtime)
 			accumulator = stack.get(1);
 		} else {
 			// 没有提供初始值，使用数组第一个非空洞元素作为初始值
+			auto& arr = stack.this_val().array();
 			bool found = false;
 			for (size_t i = 0; i < arr.GetLength(); ++i) {
-				Value elem;
-				if (arr.GetComputedProperty(context, Value(static_cast<int64_t>(i)), &elem)) {
-					accumulator = elem;
+				if (arr.GetElement(context, i, &accumulator)) {
 					start_index = i + 1;
 					found = true;
 					break;
@@ -165,23 +431,67 @@ ArrayObjectClassDef::ArrayObjectClassDef(Runtime* runtime)
 			}
 		}
 
-		for (size_t i = start_index; i < arr.GetLength(); ++i) {
+		PreparedCall call(context, callback, Value());
+		// 回调可能修改数组或触发 GC 移动数组对象，每次迭代都从 this 重新获取
+		for (size_t i = start_index; i < stack.this_val().array().GetLength(); ++i) {
 			Value elem;
-			bool exists = arr.GetComputedProperty(context, Value(static_cast<int64_t>(i)), &elem);
+			// 稠密数组直接读取连续的 int64_t / double / Value 缓冲区
 			// JS标准：跳过空洞元素
-			if (!exists) {
+			if (!stack.this_val().array().GetElement(context, i, &elem)) {
 				continue;
 			}
-			std::array<Value, 4> args = {
-				accumulator,
-				elem,
-				Value(static_cast<int64_t>(i)),
-				stack.this_val()
-			};
-			accumulator = context->CallFunction(&callback, Value(), args.begin(), args.end());
+			accumulator = call.Call(std::move(accumulator), std::move(elem), Value(static_cast<int64_t>(i)), stack.this_val());
+			if (accumulator.IsException()) {
+				return accumulator;
+			}
 		}
 		return accumulator;
 	}));
+
+	// Sort method
+	prototype_.object().SetProperty(&runtime->default_context(), ConstIndexEmbedded::kSort, Value([](Context* context, uint32_t par_count, const StackFrame& stack) -> Value {
+		return ArrayObjectClassDef::Sort(context, par_count, stack);
+	}));
+
+	// ToSorted method
+	prototype_.object().SetProperty(&runtime->default_context(), ConstIndexEmbedded::kToSorted, Value([](Context* context, uint32_t par_count, const StackFrame& stack) -> Value {
+		return ArrayObjectClassDef::ToSorted(context, par_count, stack);
+	}));
+
+	// Join method
+	prototype_.object().SetProperty(&runtime->default_context(), ConstIndexEmbedded::kJoin, Value([](Context* context, uint32_t par_count, const StackFrame& stack) -> Value {
+		return ArrayObjectClassDef::Join(context, par_count, stack);
+	}));
+
+	// Slice method
+	prototype_.object().SetProperty(&runtime->default_context(), ConstIndexEmbedded::kSlice, Value([](Context* context, uint32_t par_count, const StackFrame& stack) -> Value {
+		return ArrayObjectClassDef::Slice(context, par_count, stack);
+	}));
+
+	// Concat method
+	prototype_.object().SetProperty(&runtime->default_context(), ConstIndexEmbedded::kConcat, Value([](Context* context, uint32_t par_count, const StackFrame& stack) -> Value {
+		return ArrayObjectClassDef::Concat(context, par_count, stack);
+	}));
+
+	// Splice method
+	prototype_.object().SetProperty(&runtime->default_context(), ConstIndexEmbedded::kSplice, Value([](Context* context, uint32_t par_count, const StackFrame& stack) -> Value {
+		return ArrayObjectClassDef::Splice(context, par_count, stack);
+	}));
+
+	// IndexOf method
+	prototype_.object().SetProperty(&runtime->default_context(), ConstIndexEmbedded::kIndexOf, Value([](Context* context, uint32_t par_count, const StackFrame& stack) -> Value {
+		return ArrayObjectClassDef::IndexOf(context, par_count, stack);
+	}));
+
+	// Includes method
+	prototype_.object().SetProperty(&runtime->default_context(), ConstIndexEmbedded::kIncludes, Value([](Context* context, uint32_t par_count, const StackFrame& stack) -> Value {
+		return ArrayObjectClassDef::Includes(context, par_count, stack);
+	}));
+
+	// Fill method
+	prototype_.object().SetProperty(&runtime->default_context(), ConstIndexEmbedded::kFill, Value([](Context* context, uint32_t par_count, const StackFrame& stack) -> Value {
+		return ArrayObjectClassDef::Fill(context, par_count, stack);
+	}));
 }
 
 Value ArrayObjectClassDef::NewConstructor(Context* context, uint32_t par_count, const StackFrame& stack) const {
@@ -236,11 +546,234 @@ Value ArrayObjectClassDef::Of(Context* context, uint32_t par_count, const StackF
 
 Value ArrayObjectClassDef::LiteralNew(Context* context, uint32_t par_count, const StackFrame& stack) {
 	GCHandleScope<1> scope(context);
-	auto arr = scope.New<ArrayObject>(par_count);
+	// 逐个追加，元素种类按实际值确定，保持 packed
+	auto arr = scope.New<ArrayObject>();
+	arr->ReserveElements(context, par_count);
 	for (size_t i = 0; i < par_count; ++i) {
-		arr->SetComputedProperty(context, Value(static_cast<int64_t>(i)), std::move(stack.get(i)));
+		arr->Push(context, std::move(stack.get(i)));
 	}
 	return scope.Close(arr);
 }
 
+Value ArrayObjectClassDef::Sort(Context* context, uint32_t par_count, const StackFrame& stack) {
+	GCHandleScope<1> scope(context);
+	auto sorted = scope.New<ArrayObject>();
+	size_t undefined_count;
+	auto error = CollectSorted(context, par_count, stack, sorted, &undefined_count);
+	if (error.IsException()) {
+		return error;
+	}
+
+	// 依次写回排序后的元素和 undefined，剩余位置（原来的空洞）保持为空洞
+	auto& arr = stack.this_val().array();
+	auto length = arr.GetLength();
+	size_t index = 0;
+	for (; index < sorted->GetLength(); ++index) {
+		Value element;
+		sorted->GetElement(context, index, &element);
+		arr.SetElement(context, index, std::move(element));
+	}
+	for (size_t i = 0; i < undefined_count; ++i, ++index) {
+		arr.SetElement(context, index, Value());
+	}
+	for (; index < length; ++index) {
+		Value deleted;
+		arr.DelComputedProperty(context, Value(static_cast<int64_t>(index)), &deleted);
+	}
+	return stack.this_val();
+}
+
+Value ArrayObjectClassDef::ToSorted(Context* context, uint32_t par_count, const StackFrame& stack) {
+	GCHandleScope<1> scope(context);
+	auto sorted = scope.New<ArrayObject>();
+	size_t undefined_count;
+	auto error = CollectSorted(context, par_count, stack, sorted, &undefined_count);
+	if (error.IsException()) {
+		return error;
+	}
+
+	// 返回新数组，undefined 和空洞都以 undefined 补在末尾
+	auto length = stack.this_val().array().GetLength();
+	while (sorted->GetLength() < length) {
+		sorted->Push(context, Value());
+	}
+	return scope.Close(sorted);
+}
+
+Value ArrayObjectClassDef::Join(Context* context, uint32_t par_count, const StackFrame& stack) {
+	Value separator(",");
+	if (par_count >= 1 && !stack.get(0).IsUndefined()) {
+		separator = stack.get(0).ToString(context);
+		if (separator.IsException()) {
+			return separator;
+		}
+	}
+	auto separator_view = StringValueView(separator);
+
+	auto& arr = stack.this_val().array();
+	auto length = arr.GetLength();
+	if (length == 0) {
+		return Value("");
+	}
+
+	// 两遍拼接：第一遍计算总长度，第二遍直接写入一次分配的字符串
+	size_t total = separator_view.size() * (length - 1);
+	auto write_separator = [&](char*& out, size_t index) {
+		if (index > 0 && !separator_view.empty()) {
+			std::memcpy(out, separator_view.data(), separator_view.size());
+			out += separator_view.size();
+		}
+	};
+
+	if (!arr.is_sparse() && arr.elements().is_int64()) {
+		// 整数数组：长度由十进制位数算出，写入时直接格式化到目标缓冲区
+		auto& elements = arr.elements();
+		for (uint32_t i = 0; i < elements.size(); ++i) {
+			if (!elements.IsHole(i)) {
+				total += Int64DecimalLength(elements.int64_data()[i]);
+			}
+		}
+		return Value(String::New(total, [&](char* out) {
+			for (uint32_t i = 0; i < elements.size(); ++i) {
+				write_separator(out, i);
+				if (!elements.IsHole(i)) {
+					out = std::to_chars(out, out + 20, elements.int64_data()[i]).ptr;
+				}
+			}
+		}));
+	}
+
+	// 通用路径：空洞、undefined 和 null 为空串，整数延迟到写入时格式化，其他元素先转换为字符串
+	std::vector<Value> parts;
+	parts.reserve(length);
+	for (size_t i = 0; i < length; ++i) {
+		Value element;
+		arr.GetElement(context, i, &element);
+		if (element.IsUndefined() || element.IsNull()) {
+			parts.emplace_back();
+			continue;
+		}
+		if (element.IsInt64()) {
+			total += Int64DecimalLength(element.i64());
+			parts.push_back(std::move(element));
+			continue;
+		}
+		if (!element.IsString()) {
+			element = element.ToString(context);
+			if (element.IsException()) {
+				return element;
+			}
+		}
+		total += StringValueView(element).size();
+		parts.push_back(std::move(element));
+	}
+	return Value(String::New(total, [&](char* out) {
+		for (size_t i = 0; i < parts.size(); ++i) {
+			write_separator(out, i);
+			auto& part = parts[i];
+			if (part.IsInt64()) {
+				out = std::to_chars(out, out + 20, part.i64()).ptr;
+			}
+			else if (part.IsString()) {
+				auto view = StringValueView(part);
+				std::memcpy(out, view.data(), view.size());
+				out += view.size();
+			}
+		}
+	}));
+}
+
+Value ArrayObjectClassDef::Slice(Context* context, uint32_t par_count, const StackFrame& stack) {
+	auto length = stack.this_val().array().GetLength();
+	auto begin = ToRelativeIndex(ArgumentOrUndefined(par_count, stack, 0), length, 0);
+	auto end = ToRelativeIndex(ArgumentOrUndefined(par_count, stack, 1), length, length);
+
+	GCHandleScope<1> scope(context);
+	auto result = scope.New<ArrayObject>();
+	// 分配可能移动 this 数组，分配之后重新获取
+	result->AppendElements(context, stack.this_val().array(), begin, end);
+	return scope.Close(result);
+}
+
+Value ArrayObjectClassDef::Concat(Context* context, uint32_t par_count, const StackFrame& stack) {
+	GCHandleScope<1> scope(context);
+	auto result = scope.New<ArrayObject>();
+
+	size_t total = stack.this_val().array().GetLength();
+	for (uint32_t i = 0; i < par_count; ++i) {
+		total += stack.get(i).IsArrayObject() ? stack.get(i).array().GetLength() : 1;
+	}
+	result->ReserveElements(context, total);
+
+	auto& arr = stack.this_val().array();
+	result->AppendElements(context, arr, 0, arr.GetLength());
+	for (uint32_t i = 0; i < par_count; ++i) {
+		auto& arg = stack.get(i);
+		if (arg.IsArrayObject()) {
+			result->AppendElements(context, arg.array(), 0, arg.array().GetLength());
+		}
+		else {
+			result->Push(context, arg);
+		}
+	}
+	return scope.Close(result);
+}
+
+Value ArrayObjectClassDef::Splice(Context* context, uint32_t par_count, const StackFrame& stack) {
+	auto length = stack.this_val().array().GetLength();
+	auto start = ToRelativeIndex(ArgumentOrUndefined(par_count, stack, 0), length, 0);
+	size_t delete_count = 0;
+	if (par_count == 1) {
+		delete_count = length - start;
+	}
+	else if (par_count >= 2) {
+		auto count = ToIntegerOrZero(stack.get(1));
+		delete_count = static_cast<size_t>(std::clamp<int64_t>(count, 0, static_cast<int64_t>(length - start)));
+	}
+
+	GCHandleScope<1> scope(context);
+	auto removed = scope.New<ArrayObject>();
+	auto& arr = stack.this_val().array();
+	removed->AppendElements(context, arr, start, start + delete_count);
+
+	uint32_t item_count = par_count > 2 ? par_count - 2 : 0;
+	arr.SpliceElements(context, start, delete_count, item_count > 0 ? &stack.get(2) : nullptr, item_count);
+	return scope.Close(removed);
+}
+
+Value ArrayObjectClassDef::IndexOf(Context* context, uint32_t par_count, const StackFrame& stack) {
+	auto& arr = stack.this_val().array();
+	auto from = ToRelativeIndex(ArgumentOrUndefined(par_count, stack, 1), arr.GetLength(), 0);
+	return Value(arr.IndexOfElement(context, ArgumentOrUndefined(par_count, stack, 0), from, false));
+}
+
+Value ArrayObjectClassDef::Includes(Context* context, uint32_t par_count, const StackFrame& stack) {
+	auto& arr = stack.this_val().array();
+	auto length = arr.GetLength();
+	auto from = ToRelativeIndex(ArgumentOrUndefined(par_count, stack, 1), length, 0);
+	auto& value = ArgumentOrUndefined(par_count, stack, 0);
+	if (arr.IndexOfElement(context, value, from, true) >= 0) {
+		return Value(true);
+	}
+	if (value.IsUndefined()) {
+		// includes 把空洞视为 undefined
+		for (size_t i = from; i < length; ++i) {
+			Value element;
+			if (!arr.GetElement(context, i, &element)) {
+				return Value(true);
+			}
+		}
+	}
+	return Value(false);
+}
+
+Value ArrayObjectClassDef::Fill(Context* context, uint32_t par_count, const StackFrame& stack) {
+	auto& arr = stack.this_val().array();
+	auto length = arr.GetLength();
+	auto begin = ToRelativeIndex(ArgumentOrUndefined(par_count, stack, 1), length, 0);
+	auto end = ToRelativeIndex(ArgumentOrUndefined(par_count, stack, 2), length, length);
+	arr.FillElements(context, begin, end, ArgumentOrUndefined(par_count, stack, 0));
+	return stack.this_val();
+}
+
 } // namespace mjs
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include <mjs/class_def/data_view_object_class_def.h>
+
+#include <mjs/stack_frame.h>
+#include <mjs/context.h>
+#include <mjs/runtime.h>
+#include <mjs/gc/handle.h>
+#include <mjs/class_def/array_buffer_object_class_def.h>
+#include <mjs/value/object/data_view_object.h>
+#include <mjs/value/object/typed_array_object.h>
+
+namespace mjs {
+
+namespace {
+
+// 校验 this 并解析 byteOffset / littleEndian 参数，littleEndian 参数位于 little_endian_arg
+DataViewObject* CheckDataViewArgs(Context* context, uint32_t par_count, const StackFrame& stack, uint32_t little_endian_arg,
+	size_t* byte_index, bool* little_endian, Value* error)
+{
+	auto& this_val = stack.this_val();
+	if (!this_val.IsObject() || this_val.object().class_id() != ClassId::kDataViewObject) {
+		*error = TypeError::Throw(context, "Receiver is not a DataView");
+		return nullptr;
+	}
+	if (par_count < 1 || !ArrayBufferObjectClassDef::ToIndex(stack.get(0), byte_index)) {
+		*error = RangeError::Throw(context, "Offset is outside the bounds of the DataView");
+		return nullptr;
+	}
+	*little_endian = par_count > little_endian_arg && stack.get(little_endian_arg).ToBoolean().boolean();
+	return &this_val.object().get<DataViewObject>();
+}
+
+template<typename T>
+Value DataViewGet(Context* context, uint32_t par_count, const StackFrame& stack) {
+	size_t byte_index;
+	bool little_endian;
+	Value error;
+	auto* data_view = CheckDataViewArgs(context, par_count, stack, 1, &byte_index, &little_endian, &error);
+	if (!data_view) {
+		return error;
+	}
+	T element;
+	if (!data_view->Load(byte_index, little_endian, &element)) {
+		return RangeError::Throw(context, "Offset is outside the bounds of the DataView");
+	}
+	if constexpr (std::is_floating_point_v<T>) {
+		return Value(static_cast<double>(element));
+	}
+	else {
+		return Value(static_cast<int64_t>(element));
+	}
+}
+
+template<typename T>
+Value DataViewSet(Context* context, uint32_t par_count, const StackFrame& stack) {
+	size_t byte_index;
+	bool little_endian;
+	Value error;
+	auto* data_view = CheckDataViewArgs(context, par_count, stack, 2, &byte_index, &little_endian, &error);
+	if (!data_view) {
+		return error;
+	}
+	Value value;
+	if (par_count >= 2) {
+		value = stack.get(1);
+	}
+	T element;
+	if constexpr (std::is_floating_point_v<T>) {
+		element = static_cast<T>(TypedArrayObject::ToDouble(value));
+	}
+	else {
+		element = static_cast<T>(TypedArrayObject::ToInt32Bits(value));
+	}
+	if (!data_view->Store(byte_index, little_endian, element)) {
+		return RangeError::Throw(context, "Offset is outside the bounds of the DataView");
+	}
+	return Value();
+}
+
+} // namespace
+
+DataViewObjectClassDef::DataViewObjectClassDef(Runtime* runtime)
+	: ClassDef(runtime, ClassId::kDataViewObject, "DataView")
+{
+	prototype_.object().SetPrototype(&runtime->default_context(), runtime->class_def_table()[ClassId::kObject].prototype());
+	constructor_.object().SetPrototype(&runtime->default_context(), runtime->class_def_table()[ClassId::kFunctionObject].prototype());
+
+	auto* context = &runtime->default_context();
+	prototype_.object().SetProperty(context, ConstIndexEmbedded::kGetUint8, Value(DataViewGet<uint8_t>));
+	prototype_.object().SetProperty(context, ConstIndexEmbedded::kSetUint8, Value(DataViewSet<uint8_t>));
+	prototype_.object().SetProperty(context, ConstIndexEmbedded::kGetInt32, Value(DataViewGet<int32_t>));
+	prototype_.object().SetProperty(context, ConstIndexEmbedded::kSetInt32, Value(DataViewSet<int32_t>));
+	prototype_.object().SetProperty(context, ConstIndexEmbedded::kGetFloat64, Value(DataViewGet<double>));
+	prototype_.object().SetProperty(context, ConstIndexEmbedded::kSetFloat64, Value(DataViewSet<double>));
+}
+
+Value DataViewObjectClassDef::NewConstructor(Context* context, uint32_t par_count, const StackFrame& stack) const {
+	// new DataView(buffer, byteOffset?, byteLength?)
+	if (par_count < 1 || !stack.get(0).IsObject() || stack.get(0).object().class_id() != ClassId::kArrayBufferObject) {
+		return TypeError::Throw(context, "First argument to DataView constructor must be an ArrayBuffer");
+	}
+	auto buffer_length = stack.get(0).object().get<ArrayBufferObject>().byte_length();
+
+	size_t byte_offset = 0;
+	if (par_count >= 2 && !ArrayBufferObjectClassDef::ToIndex(stack.get(1), &byte_offset)) {
+		return RangeError::Throw(context, "Invalid DataView offset");
+	}
+	if (byte_offset > buffer_length) {
+		return RangeError::Throw(context, "Start offset {} is outside the bounds of the buffer", byte_offset);
+	}
+
+	size_t byte_length = buffer_length - byte_offset;
+	if (par_count >= 3 && !stack.get(2).IsUndefined()) {
+		if (!ArrayBufferObjectClassDef::ToIndex(stack.get(2), &byte_length) || byte_length > buffer_length - byte_offset) {
+			return RangeError::Throw(context, "Invalid DataView length");
+		}
+	}
+
+	GCHandleScope<1> scope(context);
+	auto data_view = scope.New<DataViewObject>(Value(stack.get(0)), byte_offset, byte_length);
+	return scope.Close(data_view);
+}
+
+} // namespace mjs
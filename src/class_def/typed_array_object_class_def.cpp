@@ -0,0 +1,102 @@
+#include <mjs/class_def/typed_array_object_class_def.h>
+
+#include <mjs/stack_frame.h>
+#include <mjs/context.h>
+#include <mjs/runtime.h>
+#include <mjs/gc/handle.h>
+#include <mjs/class_def/array_buffer_object_class_def.h>
+#include <mjs/value/object/array_object.h>
+#include <mjs/value/object/array_buffer_object.h>
+
+namespace mjs {
+
+TypedArrayObjectClassDef::TypedArrayObjectClassDef(Runtime* runtime, TypedArrayKind kind, const char* name)
+	: ClassDef(runtime, TypedArrayObject::KindToClassId(kind), name)
+	, kind_(kind)
+{
+	prototype_.object().SetPrototype(&runtime->default_context(), runtime->class_def_table()[ClassId::kObject].prototype());
+	constructor_.object().SetPrototype(&runtime->default_context(), runtime->class_def_table()[ClassId::kFunctionObject].prototype());
+}
+
+Value TypedArrayObjectClassDef::NewConstructor(Context* context, uint32_t par_count, const StackFrame& stack) const {
+	// 标准 new TypedArray() 行为:
+	// - new Uint8Array() / new Uint8Array(length)
+	// - new Uint8Array(buffer, byteOffset?, length?)：在已有缓冲区上创建视图，不复制
+	// - new Uint8Array(array / typedArray)：复制元素
+	auto element_size = TypedArrayObject::ElementSize(kind_);
+
+	GCHandleScope<2> scope(context);
+	if (par_count == 0 || stack.get(0).IsNumber() || stack.get(0).IsUndefined()) {
+		size_t length = 0;
+		if (par_count >= 1 && !ArrayBufferObjectClassDef::ToIndex(stack.get(0), &length)) {
+			return RangeError::Throw(context, "Invalid typed array length");
+		}
+		auto buffer = scope.New<ArrayBufferObject>(length * element_size);
+		auto typed_array = scope.New<TypedArrayObject>(kind_, buffer.ToValue(), 0, length);
+		return scope.Close(typed_array);
+	}
+
+	auto& arg = stack.get(0);
+	if (arg.IsObject() && arg.object().class_id() == ClassId::kArrayBufferObject) {
+		auto byte_length = arg.object().get<ArrayBufferObject>().byte_length();
+		size_t byte_offset = 0;
+		if (par_count >= 2 && !ArrayBufferObjectClassDef::ToIndex(stack.get(1), &byte_offset)) {
+			return RangeError::Throw(context, "Invalid typed array offset");
+		}
+		if (byte_offset % element_size != 0) {
+			return RangeError::Throw(context, "Start offset of {} should be a multiple of {}", name_string(), element_size);
+		}
+		if (byte_offset > byte_length) {
+			return RangeError::Throw(context, "Start offset {} is outside the bounds of the buffer", byte_offset);
+		}
+
+		size_t length;
+		if (par_count >= 3 && !stack.get(2).IsUndefined()) {
+			if (!ArrayBufferObjectClassDef::ToIndex(stack.get(2), &length)) {
+				return RangeError::Throw(context, "Invalid typed array length");
+			}
+			if (length * element_size > byte_length - byte_offset) {
+				return RangeError::Throw(context, "Invalid typed array length: {}", length);
+			}
+		}
+		else {
+			if ((byte_length - byte_offset) % element_size != 0) {
+				return RangeError::Throw(context, "Byte length of {} should be a multiple of {}", name_string(), element_size);
+			}
+			length = (byte_length - byte_offset) / element_size;
+		}
+		auto typed_array = scope.New<TypedArrayObject>(kind_, Value(arg), byte_offset, length);
+		return scope.Close(typed_array);
+	}
+
+	if (arg.IsArrayObject()) {
+		auto length = arg.array().GetLength();
+		auto buffer = scope.New<ArrayBufferObject>(length * element_size);
+		auto typed_array = scope.New<TypedArrayObject>(kind_, buffer.ToValue(), 0, length);
+		// 数组仍由栈上的参数引用，分配之后重新获取
+		auto& array = stack.get(0).array();
+		for (size_t i = 0; i < length; ++i) {
+			Value element;
+			array.GetElement(context, i, &element);
+			typed_array->SetElement(static_cast<int64_t>(i), element);
+		}
+		return scope.Close(typed_array);
+	}
+
+	if (arg.IsObject() && TypedArrayObject::IsTypedArrayClassId(arg.object().class_id())) {
+		auto length = arg.object().get<TypedArrayObject>().length();
+		auto buffer = scope.New<ArrayBufferObject>(length * element_size);
+		auto typed_array = scope.New<TypedArrayObject>(kind_, buffer.ToValue(), 0, length);
+		auto& source = stack.get(0).object().get<TypedArrayObject>();
+		for (size_t i = 0; i < length; ++i) {
+			Value element;
+			source.GetElement(static_cast<int64_t>(i), &element);
+			typed_array->SetElement(static_cast<int64_t>(i), element);
+		}
+		return scope.Close(typed_array);
+	}
+
+	return TypeError::Throw(context, "Invalid argument for {} constructor", name_string());
+}
+
+} // namespace mjs
@@ -8,6 +8,9 @@
 #include <mjs/class_def/function_object_class_def.h>
 #include <mjs/class_def/generator_object_class_def.h>
 #include <mjs/class_def/promise_object_class_def.h>
+#include <mjs/class_def/array_buffer_object_class_def.h>
+#include <mjs/class_def/typed_array_object_class_def.h>
+#include <mjs/class_def/data_view_object_class_def.h>
 
 namespace mjs {
 
@@ -26,6 +29,11 @@ void ClassDefTable::Initialize(Runtime* runtime) {
 	Register(std::make_unique<ClassDef>(runtime, ClassId::kModuleObject, "Module"));
 	Register(std::make_unique<ClassDef>(runtime, ClassId::kCppModuleObject, "CppModule"));
 	Register(std::make_unique<SymbolClassDef>(runtime));
+	Register(std::make_unique<ArrayBufferObjectClassDef>(runtime));
+	Register(std::make_unique<TypedArrayObjectClassDef>(runtime, TypedArrayKind::kUint8, "Uint8Array"));
+	Register(std::make_unique<TypedArrayObjectClassDef>(runtime, TypedArrayKind::kInt32, "Int32Array"));
+	Register(std::make_unique<TypedArrayObjectClassDef>(runtime, TypedArrayKind::kFloat64, "Float64Array"));
+	Register(std::make_unique<DataViewObjectClassDef>(runtime));
 }
 
 void ClassDefTable::Register(ClassDefUnique class_def) {
@@ -1,5 +1,7 @@
 #include "src/compiler/expression_impl/object_expression.h"
 
+#include <algorithm>
+
 #include <mjs/class_def/object_class_def.h>
 #include <mjs/error.h>
 
@@ -24,6 +26,11 @@ void ObjectExpression::GenerateCode(CodeGenerator* code_generator, FunctionDefBa
         }
     }
 
+    if (!has_getter_setter && TryGenerateBoilerplateCode(code_generator, function_def_base)) {
+        // 全部为静态键，已按样板生成
+        return;
+    }
+
     if (!has_getter_setter) {
         // 没有 getter/setter，使用快速路径
         for (auto& prop : properties()) {
@@ -88,6 +95,37 @@ void ObjectExpression::GenerateCode(CodeGenerator* code_generator, FunctionDefBa
     }
 }
 
+bool ObjectExpression::TryGenerateBoilerplateCode(CodeGenerator* code_generator, FunctionDefBase* function_def_base) const {
+    auto& boilerplate_table = function_def_base->boilerplate_table();
+    if (boilerplate_table.object_boilerplate_count() >= UINT16_MAX) {
+        return false;
+    }
+
+    // 只有全部为静态键、且键不重复时，最终形状才能在编译期确定
+    std::vector<ConstIndex> keys;
+    keys.reserve(properties().size());
+    for (auto& prop : properties()) {
+        if (prop.kind != PropertyKind::kNormal || prop.computed || prop.key == "__proto__") {
+            return false;
+        }
+        auto key_const_index = code_generator->AllocateConst(Value(String::New(prop.key)));
+        if (std::find(keys.begin(), keys.end(), key_const_index) != keys.end()) {
+            return false;
+        }
+        keys.push_back(key_const_index);
+    }
+
+    // 按声明顺序求值，值依次入栈，由指令按槽位顺序填充
+    for (auto& prop : properties()) {
+        prop.value->GenerateCode(code_generator, function_def_base);
+    }
+
+    auto boilerplate_idx = boilerplate_table.AddObjectBoilerplate(std::move(keys));
+    function_def_base->bytecode_table().EmitOpcode(OpcodeType::kNewObjectFromBoilerplate);
+    function_def_base->bytecode_table().EmitU16(static_cast<uint16_t>(boilerplate_idx));
+    return true;
+}
+
 /**
  * @brief 解析对象表达式
  *
@@ -69,6 +69,19 @@ public:
      */
     void GenerateCode(CodeGenerator* code_generator, FunctionDefBase* function_def_base) const override;
 
+private:
+    /**
+     * @brief 尝试按对象字面量样板生成代码
+     *
+     * 仅当所有属性都是静态键的普通属性且键不重复时生效，
+     * 生成 kNewObjectFromBoilerplate 指令，运行时以最终形状直接分配对象。
+     *
+     * @param code_generator 代码生成器
+     * @param function_def_base 函数定义
+     * @return 是否已生成代码
+     */
+    bool TryGenerateBoilerplateCode(CodeGenerator* code_generator, FunctionDefBase* function_def_base) const;
+
 private:
     std::vector<Property> properties_; ///< 对象属性列表
 };
@@ -15,14 +15,14 @@
 
 namespace mjs {
 	
-Context::Context(Runtime* runtime)
+Context::Context(Runtime* runtime, const GCHeapConfig& gc_config)
 	: runtime_(runtime)
 	, gc_manager_(this)
 	, vm_(this)
 	, shape_manager_(this)
 	/* , symbol_table_(this)*/ {
 	// 初始化GC管理器
-	gc_manager_.Initialize();
+	gc_manager_.Initialize(gc_config);
 }
 
 Context::~Context() {
@@ -0,0 +1,143 @@
+/**
+ * @file concurrent_marker.cpp
+ * @brief 老年代并发标记实现
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <mjs/gc/concurrent_marker.h>
+
+#include <mjs/context.h>
+#include <mjs/gc/gc_heap.h>
+#include <mjs/value/value.h>
+#include <mjs/value/object/object.h>
+
+namespace mjs {
+
+ConcurrentMarker::ConcurrentMarker(GCHeap* heap, bool background)
+    : heap_(heap) {
+    if (background) {
+        thread_ = std::thread(&ConcurrentMarker::ThreadMain, this);
+    }
+}
+
+ConcurrentMarker::~ConcurrentMarker() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard lock(mutex_);
+        shutdown_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+}
+
+void ConcurrentMarker::ThreadMain() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [&]() { return shutdown_ || (marking_ && !worklist_.empty()); });
+        if (shutdown_) {
+            return;
+        }
+        background_scanned_ += Drain(kConcurrentMarkingBatchSize);
+
+        // 每批之间让出锁，主线程的写屏障、Scavenge和最终标记可以进入
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+    }
+}
+
+void ConcurrentMarker::Begin() {
+    worklist_.clear();
+    background_scanned_ = 0;
+    marked_size_ = 0;
+    marking_ = true;
+}
+
+void ConcurrentMarker::Resume() {
+    cv_.notify_one();
+}
+
+void ConcurrentMarker::Grey(GCObject* obj) {
+    auto* header = obj->header();
+    if (header->generation() != GCGeneration::kOld || header->IsMarked()) {
+        return;
+    }
+    header->SetMarked(true);
+    if (!header->IsLarge()) {
+        marked_size_ += header->size();
+    }
+    worklist_.push_back(obj);
+}
+
+void ConcurrentMarker::ScanBeforeWrite(GCObject* obj) {
+    {
+        std::lock_guard lock(mutex_);
+        if (!marking_ || obj->header()->IsScanned()) {
+            return;
+        }
+        if (!obj->header()->IsMarked()) {
+            obj->header()->SetMarked(true);
+            if (!obj->header()->IsLarge()) {
+                marked_size_ += obj->header()->size();
+            }
+        }
+        ScanObject(obj);
+    }
+    // 扫描可能产生新的灰色对象
+    cv_.notify_one();
+}
+
+bool ConcurrentMarker::IsComplete() {
+    std::lock_guard lock(mutex_);
+    return worklist_.empty();
+}
+
+bool ConcurrentMarker::Step(std::chrono::steady_clock::time_point deadline) {
+    std::lock_guard lock(mutex_);
+    while (!worklist_.empty()) {
+        Drain(kIncrementalMarkingCheckInterval);
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+    return worklist_.empty();
+}
+
+void ConcurrentMarker::Finish() {
+    Drain(SIZE_MAX);
+    marking_ = false;
+}
+
+size_t ConcurrentMarker::Drain(size_t max_count) {
+    size_t count = 0;
+    while (count < max_count && !worklist_.empty()) {
+        GCObject* obj = worklist_.back();
+        worklist_.pop_back();
+        // 可能已经在写屏障中扫描过
+        if (obj->header()->IsScanned()) {
+            continue;
+        }
+        ScanObject(obj);
+        ++count;
+    }
+    return count;
+}
+
+void ConcurrentMarker::ScanObject(GCObject* obj) {
+    obj->GCTraverse(heap_->context_, GreyCallback);
+    obj->header()->SetScanned(true);
+}
+
+void ConcurrentMarker::GreyCallback(Context* context, Value* child) {
+    if (!child->IsObject()) {
+        return;
+    }
+    // 新生代对象已在初始标记时扫描过，这里只追踪老年代对象
+    context->gc_manager().heap()->concurrent_marker()->Grey(static_cast<GCObject*>(&child->object()));
+}
+
+} // namespace mjs
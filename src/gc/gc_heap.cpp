@@ -11,22 +11,32 @@
  * - GC触发控制
  * - 统计信息
  * - 根集合管理
- * - Scavenge (新生代复制GC)
- * - Mark-Compact (老年代标记-压缩GC)
+ * - Scavenge (新生代复制GC，以记忆集代替老年代扫描)
+ * - Mark-Sweep / Mark-Compact (老年代标记后惰性清除，碎片过多时压缩)
+ * - 并发标记的调度（初始标记、最终标记）及停顿统计
+ * - 大对象空间的分配与回收
+ * - 按分配点存活率预先晋升
+ * - 空闲通知中的GC调度
+ * - 堆大小的软限制与硬限制
+ * - GC事件追踪
  */
 
 #include <mjs/gc/gc_heap.h>
 
 #include <cstring>
 #include <algorithm>
+#include <random>
 
 #include <mjs/context.h>
 #include <mjs/runtime.h>
 #include <mjs/value/value.h>
 #include <mjs/value/object/object.h>
+#include <mjs/shape/shape.h>
 #include <mjs/stack_frame.h>
 #include <mjs/job_queue.h>
 #include <mjs/gc/handle.h>
+#include <mjs/gc/native_memory.h>
+#include <mjs/gc/heap_snapshot.h>
 
 namespace mjs {
 
@@ -37,44 +47,87 @@ GCHeap::GCHeap(Context* context)
 
 GCHeap::~GCHeap() = default;
 
-bool GCHeap::Initialize() {
+bool GCHeap::Initialize(const GCHeapConfig& config) {
+    if (config.eden_ratio == 0 || config.survivor_ratio == 0) {
+        return false;
+    }
+    config_ = config;
+    config_.min_new_space_size = std::min(config_.min_new_space_size, config_.new_space_size);
+    config_.max_new_space_size = std::max(config_.max_new_space_size, config_.new_space_size);
+    new_space_size_ = config_.new_space_size;
+
     new_space_ = std::make_unique<NewSpace>();
     old_space_ = std::make_unique<OldSpace>();
+    large_object_space_ = std::make_unique<LargeObjectSpace>();
+    large_object_limit_ = config_.old_space_initial_size;
 
-    if (!new_space_->Initialize()) {
+    size_t eden_size, survivor_size;
+    SplitNewSpace(new_space_size_, &eden_size, &survivor_size);
+    if (!new_space_->Initialize(eden_size, survivor_size)) {
         return false;
     }
 
-    if (!old_space_->Initialize()) {
+    if (!old_space_->Initialize(config_.old_space_initial_size)) {
         return false;
     }
 
+    set_scavenge_threads(config_.scavenge_threads);
+
+    if (config_.concurrent_marking || config_.incremental_marking) {
+        // 只启用增量标记时不需要后台线程
+        concurrent_marker_ = std::make_unique<ConcurrentMarker>(this, config_.concurrent_marking);
+    }
+
     return true;
 }
 
-void* GCHeap::Allocate(size_t* total_size, GCGeneration* generation) {
+void GCHeap::set_scavenge_threads(uint32_t thread_count) {
+    if (thread_count <= 1) {
+        parallel_scavenger_.reset();
+        return;
+    }
+    if (!parallel_scavenger_) {
+        parallel_scavenger_ = std::make_unique<ParallelScavenger>(this);
+    }
+    parallel_scavenger_->set_thread_count(thread_count);
+}
+
+void GCHeap::SplitNewSpace(size_t new_space_size, size_t* eden_size, size_t* survivor_size) const {
+    auto total_ratio = config_.eden_ratio + config_.survivor_ratio * 2;
+    *eden_size = new_space_size * config_.eden_ratio / total_ratio;
+    *survivor_size = new_space_size * config_.survivor_ratio / total_ratio;
+}
+
+void* GCHeap::Allocate(size_t* total_size, GCGeneration* generation, AllocationSite* site) {
     // 检查是否需要GC
-    if (!in_gc_ && new_space_->used_size() > kEdenSpaceSize * gc_threshold_ / 100) {
+    if (!in_gc_ && new_space_->used_size() > new_space_->eden_size() * gc_threshold_ / 100) {
         CollectGarbage(false);
     }
 
+    if (!in_gc_ && config_.incremental_marking && is_marking()) {
+        IncrementalMarkingOnAllocation(*total_size);
+    }
+
+    if (!in_gc_ && old_space_->sweeping()) {
+        LazySweepOnAllocation(*total_size);
+    }
+
     void* mem = nullptr;
 
-    // 大对象直接在老年代分配
+    // 大对象在大对象空间单独映射，不占用老年代，也不会触发老年代扩容
     if (*total_size >= kLargeObjectThreshold) {
-        mem = old_space_->Allocate(total_size);
         *generation = GCGeneration::kOld;
-        if (!mem) {
-            // 尝试完整GC
-            if (!in_gc_ && CollectGarbage(true)) {
-                mem = old_space_->Allocate(total_size);
-            }
-            // 如果GC后仍然空间不足，尝试扩容
-            if (!mem && !in_gc_) {
-                if (ExpandOldSpace(*total_size)) {
-                    mem = old_space_->Allocate(total_size);
-                }
-            }
+        if (!in_gc_ && large_object_space_->used_size() + *total_size > large_object_limit_) {
+            CollectGarbage(true);
+        }
+        mem = large_object_space_->Allocate(total_size);
+    }
+    else if (site && site->pretenured()) {
+        // 存活率高的分配点直接在老年代分配，避免在新生代中反复复制
+        mem = AllocatePretenured(total_size);
+        *generation = GCGeneration::kOld;
+        if (mem) {
+            pretenured_bytes_ += *total_size;
         }
     }
     else {
@@ -83,14 +136,29 @@ void* GCHeap::Allocate(size_t* total_size, GCGeneration* generation) {
         *generation = GCGeneration::kNew;
         if (!mem) {
             // 新生代满了，触发Scavenge
-            if (!in_gc_ && Scavenge()) {
-                mem = new_space_->Allocate(total_size);
+            if (!in_gc_) {
+                auto start = std::chrono::steady_clock::now();
+                in_gc_ = true;
+                bool result = Scavenge();
+                ScheduleConcurrentMarking();
+                in_gc_ = false;
+                RecordPause(std::chrono::steady_clock::now() - start);
+                if (result) {
+                    mem = new_space_->Allocate(total_size);
+                }
             }
         }
     }
 
     if (mem) {
         total_allocated_ += *total_size;
+        if (site && *generation == GCGeneration::kNew) {
+            site->RecordAllocation();
+            allocation_site_records_.push_back({ static_cast<GCObject*>(mem), site });
+        }
+        if (sampling_heap_profiler_) {
+            sampling_heap_profiler_->OnAllocation(static_cast<GCObject*>(mem), *total_size);
+        }
     }
 
     // std::cout << "alloc: " << mem << std::endl;
@@ -103,18 +171,31 @@ bool GCHeap::CollectGarbage(bool full_gc) {
         return false;
     }
 
+    auto start = std::chrono::steady_clock::now();
     in_gc_ = true;
     bool result = true;
 
     // 首先执行新生代GC
     result = Scavenge();
 
-    // 如果需要完整GC，执行老年代GC
+    // 如果需要完整GC，执行老年代GC；正在并发标记时直接完成标记
     if (full_gc && result) {
-        result = MarkCompact();
+        auto full_gc_start = std::chrono::steady_clock::now();
+        last_full_gc_size_ = old_space_->used_size();
+        if (is_marking()) {
+            FinishConcurrentMarking();
+        }
+        else {
+            result = MarkCompact();
+        }
+        last_full_gc_time_ = std::chrono::steady_clock::now() - full_gc_start;
+    }
+    else {
+        ScheduleConcurrentMarking();
     }
 
     in_gc_ = false;
+    RecordPause(std::chrono::steady_clock::now() - start);
     return result;
 }
 
@@ -122,12 +203,227 @@ void GCHeap::ForceFullGC() {
     CollectGarbage(true);
 }
 
+void GCHeap::StartSamplingHeapProfiler(uint64_t sample_interval, uint32_t stack_depth, uint64_t seed) {
+    if (seed == 0) {
+        seed = std::random_device{}();
+    }
+    sampling_heap_profiler_ = std::make_unique<SamplingHeapProfiler>(context_, sample_interval, stack_depth, seed);
+}
+
+bool GCHeap::WriteHeapSnapshot(std::ostream& out) {
+    if (in_gc_) {
+        return false;
+    }
+    // 完整GC后新生代只剩Survivor区中的存活对象，清除完成后老年代的死亡对象都变成空闲块
+    CollectGarbage(true);
+    old_space_->FinishSweeping();
+
+    HeapSnapshotWriter writer(this, out);
+    return writer.Write();
+}
+
+GCIdleResult GCHeap::NotifyIdle(std::chrono::nanoseconds budget) {
+    GCIdleResult result;
+    if (in_gc_ || budget <= std::chrono::nanoseconds::zero()) {
+        return result;
+    }
+    auto start = std::chrono::steady_clock::now();
+    PerformIdleWork(start + budget, &result);
+    result.elapsed = std::chrono::steady_clock::now() - start;
+    if (result.action != GCIdleAction::kNone) {
+        ++idle_task_count_;
+    }
+    return result;
+}
+
+void GCHeap::PerformIdleWork(std::chrono::steady_clock::time_point deadline, GCIdleResult* result) {
+    auto remaining = deadline - std::chrono::steady_clock::now();
+
+    // 可分段的工作优先：推进正在进行的标记和清除
+    if (is_marking()) {
+        result->action = GCIdleAction::kIncrementalMarking;
+        result->more_work = !Step(deadline);
+        return;
+    }
+    if (old_space_->sweeping()) {
+        result->action = GCIdleAction::kSweep;
+        auto start = std::chrono::steady_clock::now();
+        bool done;
+        do {
+            done = old_space_->Sweep(kLazySweepStepSize);
+        } while (!done && std::chrono::steady_clock::now() < deadline);
+        allocated_since_sweep_ = 0;
+        RecordPause(std::chrono::steady_clock::now() - start);
+        result->more_work = !done;
+        return;
+    }
+
+    // Eden区将要触发Scavenge时提前执行，预计超出预算时留给之后的空闲时间
+    if (new_space_->used_size() > new_space_->eden_size() * config_.idle_scavenge_ratio) {
+        if (EstimateScavengeTime() > remaining) {
+            result->more_work = true;
+            return;
+        }
+        CollectGarbage(false);
+        result->action = GCIdleAction::kScavenge;
+        result->more_work = is_marking() || old_space_->sweeping();
+        return;
+    }
+
+    // 老年代使用率超过阈值，且自上次完整GC以来分配的字节数超过当时存活字节数的一半时回收老年代，
+    // 避免存活对象较多时在每次空闲时间重复执行完整GC
+    bool old_space_grown = old_space_->used_size() > old_space_->capacity() * config_.concurrent_marking_start_ratio
+        && old_space_->allocated_size() - last_full_gc_allocated_ > last_full_gc_live_ / 2;
+    if (old_space_grown && concurrent_marker_) {
+        // 初始标记前需要执行一次Scavenge
+        if (EstimateScavengeTime() > remaining) {
+            result->more_work = true;
+            return;
+        }
+        StartConcurrentMarking();
+        result->action = GCIdleAction::kIncrementalMarking;
+        result->more_work = !Step(deadline);
+        return;
+    }
+    if (old_space_grown) {
+        if (EstimateScavengeTime() + EstimateFullGCTime() > remaining) {
+            result->more_work = true;
+            return;
+        }
+        CollectGarbage(true);
+        result->action = GCIdleAction::kFullGC;
+        result->more_work = old_space_->sweeping();
+    }
+}
+
+size_t GCHeap::heap_size() const {
+    return new_space_->used_size() + old_space_->used_size() + large_object_space_->used_size()
+        + external_memory_ + NativeMemory::bytes();
+}
+
+bool GCHeap::CheckHeapLimitSlow() {
+    if (in_gc_) {
+        return true;
+    }
+    auto soft_limit = config_.heap_soft_limit ? config_.heap_soft_limit : SIZE_MAX;
+    auto hard_limit = config_.heap_hard_limit ? config_.heap_hard_limit : SIZE_MAX;
+    auto size = heap_size();
+    if (size <= soft_limit && size <= hard_limit) {
+        near_heap_limit_notified_ = false;
+        heap_limit_gc_size_ = 0;
+        return true;
+    }
+
+    // 超过限制时先积极回收：完整GC并缩小新生代；堆自上次回收后没有增长时不重复回收
+    if (size > heap_limit_gc_size_) {
+        memory_pressure_ = true;
+        CollectGarbage(true);
+        size = heap_size();
+        heap_limit_gc_size_ = size;
+    }
+
+    if (size > soft_limit && !near_heap_limit_notified_) {
+        near_heap_limit_notified_ = true;
+        ++near_heap_limit_count_;
+        if (near_heap_limit_callback_) {
+            near_heap_limit_callback_(context_, size, soft_limit, near_heap_limit_data_);
+            // 回调可能释放了外部内存或调整了限制
+            hard_limit = config_.heap_hard_limit ? config_.heap_hard_limit : SIZE_MAX;
+            size = heap_size();
+        }
+    }
+    else if (size <= soft_limit) {
+        near_heap_limit_notified_ = false;
+    }
+
+    if (size > hard_limit) {
+        ++heap_limit_exceeded_count_;
+        return false;
+    }
+    return true;
+}
+
+std::chrono::nanoseconds GCHeap::EstimateScavengeTime() const {
+    // 复制量与新生代已使用大小大致成正比；没有历史数据时返回0，由第一次执行得到用时
+    if (last_scavenge_size_ == 0) {
+        return std::chrono::nanoseconds::zero();
+    }
+    double ratio = static_cast<double>(new_space_->used_size()) / last_scavenge_size_;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(last_scavenge_time_ * ratio);
+}
+
+std::chrono::nanoseconds GCHeap::EstimateFullGCTime() const {
+    if (last_full_gc_size_ == 0) {
+        return std::chrono::nanoseconds::zero();
+    }
+    double ratio = static_cast<double>(old_space_->used_size()) / last_full_gc_size_;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(last_full_gc_time_ * ratio);
+}
+
+void* GCHeap::AllocatePretenured(size_t* size) {
+    void* mem = old_space_->Allocate(size);
+    if (!mem && ExpandOldSpace(*size)) {
+        mem = old_space_->Allocate(size);
+    }
+    return mem;
+}
+
 void GCHeap::GetStats(size_t& total_allocated, size_t& total_collected, uint32_t& gc_count) const {
     total_allocated = total_allocated_;
     total_collected = total_collected_;
     gc_count = gc_count_;
 }
 
+void GCHeap::GetHeapStats(GCHeapStats* stats) const {
+    stats->new_space_used = new_space_->used_size();
+    stats->new_space_capacity = new_space_->capacity();
+    stats->eden_size = new_space_->eden_size();
+    stats->survivor_size = new_space_->survivor_size();
+    stats->old_space_used = old_space_->used_size();
+    stats->old_space_capacity = old_space_->capacity();
+    stats->old_space_free = old_space_->free_size();
+    stats->large_object_space_used = large_object_space_->used_size();
+    stats->large_object_count = large_object_space_->object_count();
+    stats->last_survival_rate = last_survival_rate_;
+    stats->last_decision = last_decision_;
+    stats->new_space_grow_count = new_space_grow_count_;
+    stats->new_space_shrink_count = new_space_shrink_count_;
+    stats->pause_count = pause_count_;
+    std::copy(std::begin(pause_histogram_), std::end(pause_histogram_), std::begin(stats->pause_histogram));
+    stats->total_pause_ms = std::chrono::duration<double, std::milli>(total_pause_).count();
+    stats->max_pause_ms = std::chrono::duration<double, std::milli>(max_pause_).count();
+    auto& histogram = tracer_.pause_histogram();
+    stats->pause_p50_ms = histogram.Percentile(50) / 1000.0;
+    stats->pause_p90_ms = histogram.Percentile(90) / 1000.0;
+    stats->pause_p99_ms = histogram.Percentile(99) / 1000.0;
+    stats->pause_p999_ms = histogram.Percentile(99.9) / 1000.0;
+    stats->concurrent_marking_count = concurrent_marking_count_;
+    stats->incremental_step_count = incremental_step_count_;
+    stats->mark_sweep_count = mark_sweep_count_;
+    stats->compaction_count = compaction_count_;
+    stats->scavenge_copied_bytes = scavenge_copied_bytes_;
+    stats->pretenured_bytes = pretenured_bytes_;
+    stats->idle_task_count = idle_task_count_;
+    stats->heap_size = heap_size();
+    stats->external_memory = external_memory_;
+    stats->native_memory = NativeMemory::bytes();
+    stats->near_heap_limit_count = near_heap_limit_count_;
+    stats->heap_limit_exceeded_count = heap_limit_exceeded_count_;
+}
+
+void GCHeap::RecordPause(std::chrono::steady_clock::duration pause) {
+    auto us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(pause).count());
+    size_t bucket = 0;
+    while (bucket < kGCPauseHistogramBuckets - 1 && us >= GCPauseBucketLimitUs(bucket)) {
+        ++bucket;
+    }
+    ++pause_histogram_[bucket];
+    ++pause_count_;
+    total_pause_ += pause;
+    max_pause_ = std::max(max_pause_, pause);
+    tracer_.RecordPause(pause);
+}
+
 void GCHeap::AddRoot(Value* value) {
     if (!value) {
         return;
@@ -213,72 +509,84 @@ void GCHeap::IterateRoots(RootCallback callback, void* data) {
 
 bool GCHeap::Scavenge() {
     ++gc_count_;
+    auto start = std::chrono::steady_clock::now();
+    size_t scavenge_size = new_space_->used_size();
+    GCEvent event;
+    event.kind = GCEventKind::kScavenge;
+    event.start = start;
 
-    // 重置Survivor To空间分配指针
-    new_space_->ResetToSpace();
+    // 并发标记期间暂停后台线程：复制会移动新生代对象，并更新老年代对象中的引用
+    auto pause = PauseConcurrentMarker();
 
-    // 遍历所有根对象，将其复制到Survivor To空间
-    IterateRoots([](Value* root, void* data) {
-        GCHeap* heap = static_cast<GCHeap*>(data);
-        heap->ProcessCopyOrReference(root);
-    }, this);
+    promoted_bytes_ = 0;
 
-    // Cheney扫描算法：遍历Survivor To空间中已复制的对象，处理其引用
-    // 扫描同时会持续将To中找到的对象的子对象复制到Survivor To区，直到所有对象都被处理完毕
-    uint8_t* scan = new_space_->survivor_to();
-    while (scan < new_space_->survivor_to_top()) {
-        GCObject* obj = reinterpret_cast<GCObject*>(scan);
+    // 重置Survivor To空间分配指针
+    new_space_->ResetToSpace();
 
-        // 遍历对象的子对象，处理引用指针
-        obj->GCTraverse(context_, [](Context* context, Value* child) {
-            GCHeap* heap = context->gc_manager().heap();
-            heap->ProcessCopyOrReference(child);
-        });
+    // 记忆集中的老年代对象同样作为根，只扫描这些对象而不遍历整个老年代
+    // 扫描时会重新记录仍然引用新生代对象的对象，所以先取出旧的记忆集
+    std::vector<GCObject*> remembered;
+    remembered.swap(remembered_set_);
 
-        scan += obj->header()->size();
+    auto phase_start = std::chrono::steady_clock::now();
+    if (parallel_scavenger_) {
+        // 并行复制根集合、记忆集及其可达的对象
+        promoted_bytes_ = parallel_scavenger_->Scavenge(&remembered);
+        phase_start = event.RecordPhase(GCPhase::kCopy, phase_start);
     }
+    else {
+        // 遍历所有根对象，将其复制到Survivor To空间
+        IterateRoots([](Value* root, void* data) {
+            GCHeap* heap = static_cast<GCHeap*>(data);
+            heap->ProcessCopyOrReference(root);
+        }, this);
+
+        for (auto* obj : remembered) {
+            obj->header()->SetRemembered(false);
+            ScavengeOldObject(obj);
+        }
+        phase_start = event.RecordPhase(GCPhase::kRoots, phase_start);
+
+        // Cheney扫描算法：遍历Survivor To空间中已复制的对象，处理其引用
+        // 扫描同时会持续将To中找到的对象的子对象复制到Survivor To区，直到所有对象都被处理完毕
+        // 本次晋升的对象不在To空间中，通过晋升工作表单独扫描
+        uint8_t* scan = new_space_->survivor_to();
+        while (scan < new_space_->survivor_to_top() || !promoted_worklist_.empty()) {
+            while (scan < new_space_->survivor_to_top()) {
+                GCObject* obj = reinterpret_cast<GCObject*>(scan);
+
+                // 遍历对象的子对象，处理引用指针
+                obj->GCTraverse(context_, [](Context* context, Value* child) {
+                    GCHeap* heap = context->gc_manager().heap();
+                    heap->ProcessCopyOrReference(child);
+                });
+
+                scan += obj->header()->size();
+            }
 
-    // 在交换空间前，遍历Eden区和Survivor From区，调用死亡对象的析构函数
-    // 死亡对象是未被转发的对象
-
-    // 遍历Eden区
-    uint8_t* current = new_space_->eden_space();
-    uint8_t* end = new_space_->eden_top();
-    while (current < end) {
-        GCObject* obj = reinterpret_cast<GCObject*>(current);
-        // 在调用析构函数前先记录大小，因为调用后虚函数表可能被破坏
-        size_t obj_size = obj->header()->size();
-        // 如果对象没有被转发，说明它是死亡对象
-        if (!obj->header()->IsForwarded() && !obj->header()->IsDestructed()) {
-            // 标记为已析构，避免重复调用
-            obj->header()->SetDestructed(true);
-            // 调用虚析构函数
-            // std::cout << "sfree eden: " << obj << std::endl;
-            obj->~GCObject();
+            while (!promoted_worklist_.empty()) {
+                GCObject* obj = promoted_worklist_.back();
+                promoted_worklist_.pop_back();
+                ScavengeOldObject(obj);
+            }
         }
-        current += obj_size;
+        phase_start = event.RecordPhase(GCPhase::kCopy, phase_start);
     }
 
-    // 遍历Survivor From区
-    current = new_space_->survivor_from();
-    end = new_space_->survivor_from_top();
-    while (current < end) {
-        GCObject* obj = reinterpret_cast<GCObject*>(current);
-        // 在调用析构函数前先记录大小，因为调用后虚函数表可能被破坏
-        size_t obj_size = obj->header()->size();
-        // 如果对象没有被转发，说明它是死亡对象
-        if (!obj->header()->IsForwarded() && !obj->header()->IsDestructed()) {
-            // 标记为已析构，避免重复调用
-            obj->header()->SetDestructed(true);
-            // 调用虚析构函数
-            // std::cout << "sfree survivor: " << obj << std::endl;
-            obj->~GCObject();
-        }
-        current += obj_size;
+    UpdateAllocationSites();
+    if (sampling_heap_profiler_) {
+        sampling_heap_profiler_->UpdateAfterScavenge();
     }
 
-    // 计算存活对象大小（Survivor To区中的对象）
+    // 死亡对象是未被转发的对象，只有登记了析构的需要调用析构函数，其余的随Eden区和Survivor From区一起丢弃
+    // 不再遍历死亡对象，Scavenge的开销只和存活对象成正比
+    SweepYoungFinalizers();
+    UpdateYoungShapes();
+
+    // 计算存活对象大小（Survivor To区中的对象），新生代中的其余部分都被回收
     size_t survived = static_cast<size_t>(new_space_->survivor_to_top() - new_space_->survivor_to());
+    scavenge_copied_bytes_ += survived + promoted_bytes_;
+    size_t collected = scavenge_size > survived + promoted_bytes_ ? scavenge_size - survived - promoted_bytes_ : 0;
 
     // 交换Survivor From和To空间
     new_space_->SwapSurvivorSpaces();
@@ -286,13 +594,83 @@ bool GCHeap::Scavenge() {
     // 重置Eden区（清空）
     new_space_->ResetEden();
 
-    // 计算回收的内存
-    size_t collected = kEdenSpaceSize + kSurvivorSpaceSize - survived;
     total_collected_ += collected;
+    event.RecordPhase(GCPhase::kSweep, phase_start);
+    event.promoted_bytes = promoted_bytes_;
+    event.freed_bytes = collected;
+    tracer_.RecordEvent(context_, &event);
+
+    // 此时Eden区为空，Survivor To区中只剩死对象，可以调整新生代大小
+    AdjustNewSpace(survived + promoted_bytes_, collected);
 
+    // Scavenge结束后预留出足够下一次全部晋升的空间，避免晋升时逐页扩容
+    if (old_space_->available_size() < new_space_->capacity()) {
+        ExpandOldSpace(new_space_->capacity());
+    }
+
+    last_scavenge_time_ = std::chrono::steady_clock::now() - start;
+    last_scavenge_size_ = scavenge_size;
     return true;
 }
 
+void GCHeap::UpdateAllocationSites() {
+    // 本轮在Eden区分配的对象被转发说明存活（复制到Survivor区或晋升）
+    for (auto& record : allocation_site_records_) {
+        if (record.object->header()->IsForwarded()) {
+            record.site->RecordSurvival();
+        }
+    }
+    for (auto& record : allocation_site_records_) {
+        record.site->Decide();
+    }
+    allocation_site_records_.clear();
+}
+
+void GCHeap::AdjustNewSpace(size_t survived, size_t collected) {
+    size_t live_before = survived + collected;
+    last_survival_rate_ = live_before ? static_cast<double>(survived) / live_before : 0;
+    last_decision_ = NewSpaceResizeDecision::kKeep;
+
+    bool memory_pressure = memory_pressure_;
+    memory_pressure_ = false;
+    if (config_.memory_pressure_threshold != 0
+        && new_space_->capacity() + old_space_->capacity() > config_.memory_pressure_threshold) {
+        memory_pressure = true;
+    }
+
+    size_t target = new_space_size_;
+    if (memory_pressure) {
+        // 内存压力：缩小到一半，不低于下限
+        if (new_space_size_ > config_.min_new_space_size) {
+            target = std::max(new_space_size_ / 2, config_.min_new_space_size);
+            last_decision_ = NewSpaceResizeDecision::kShrink;
+        }
+    }
+    else if (config_.adaptive_new_space && live_before > 0 && last_survival_rate_ < config_.low_survival_rate) {
+        // 大部分对象在新生代就已死亡，扩大新生代可以减少Scavenge次数而几乎不增加复制量
+        if (new_space_size_ < config_.max_new_space_size) {
+            target = std::min(new_space_size_ * 2, config_.max_new_space_size);
+            last_decision_ = NewSpaceResizeDecision::kGrow;
+        }
+    }
+
+    // 即使大小不变也要调用，Survivor区的调整会延迟到交换后完成
+    size_t eden_size, survivor_size;
+    SplitNewSpace(target, &eden_size, &survivor_size);
+    if (!new_space_->Resize(eden_size, survivor_size)) {
+        last_decision_ = NewSpaceResizeDecision::kKeep;
+        return;
+    }
+    new_space_size_ = target;
+
+    if (last_decision_ == NewSpaceResizeDecision::kGrow) {
+        ++new_space_grow_count_;
+    }
+    else if (last_decision_ == NewSpaceResizeDecision::kShrink) {
+        ++new_space_shrink_count_;
+    }
+}
+
 GCObject* GCHeap::CopyObject(GCObject* obj) {
     size_t size = obj->header()->size();
 
@@ -321,15 +699,22 @@ GCObject* GCHeap::CopyObject(GCObject* obj) {
 
 GCObject* GCHeap::PromoteObject(GCObject* obj) {
     size_t size = obj->header()->size();
+    size_t allocated_size = size;
 
-    void* mem = old_space_->Allocate(&size);
+    void* mem = old_space_->Allocate(&allocated_size);
+    if (!mem && ExpandOldSpace(allocated_size)) {
+        // 扩容只增加新的页，不会移动已有对象，可以在Scavenge中途进行
+        mem = old_space_->Allocate(&allocated_size);
+    }
     if (!mem) {
         return nullptr;
     }
 
-    // 复制对象
+    // 复制对象，从空闲块中分配时实际大小可能更大
     std::memcpy(mem, obj, size);
     GCObject* new_obj = reinterpret_cast<GCObject*>(mem);
+    new_obj->header()->set_size(allocated_size);
+    size = allocated_size;
 
     // 设置为老年代
     new_obj->header()->set_generation(GCGeneration::kOld);
@@ -340,9 +725,106 @@ GCObject* GCHeap::PromoteObject(GCObject* obj) {
 
     obj->header()->SetForwardingAddress(new_obj);
 
+    // 并发标记期间晋升的对象视为新分配的老年代对象
+    MarkAllocatedObject(new_obj);
+
+    // 晋升后的对象可能仍引用新生代对象，需要在本次Scavenge中扫描
+    promoted_worklist_.push_back(new_obj);
+    promoted_objects_.push_back(new_obj);
+    promoted_bytes_ += size;
+
     return new_obj;
 }
 
+void GCHeap::ScavengeOldObject(GCObject* obj) {
+    scavenge_found_young_ = false;
+    obj->GCTraverse(context_, [](Context* context, Value* child) {
+        GCHeap* heap = context->gc_manager().heap();
+        heap->ProcessCopyOrReference(child);
+        // 复制到To空间的对象仍属于新生代，下次Scavenge还需要通过记忆集找到它
+        if (child->IsObject() && child->object().header()->generation() == GCGeneration::kNew) {
+            heap->scavenge_found_young_ = true;
+        }
+    });
+    if (scavenge_found_young_) {
+        RecordWrite(obj);
+    }
+}
+
+void GCHeap::SweepYoungFinalizers() {
+    std::vector<GCObject*> finalizers;
+    finalizers.swap(young_finalizers_);
+    for (auto* obj : finalizers) {
+        auto* header = obj->header();
+        if (header->IsForwarded()) {
+            // 复制到To空间的对象保持登记，晋升的对象由老年代的清除负责析构
+            auto* new_obj = header->GetForwardingAddress();
+            if (new_obj->header()->generation() == GCGeneration::kNew) {
+                young_finalizers_.push_back(new_obj);
+            }
+            else {
+                new_obj->header()->SetFinalizable(false);
+            }
+            continue;
+        }
+        if (!header->IsDestructed()) {
+            // 标记为已析构，避免重复调用
+            header->SetDestructed(true);
+            obj->~GCObject();
+        }
+    }
+}
+
+void GCHeap::PinYoungShape(Shape* shape) {
+    if (shape->young_pinned()) {
+        return;
+    }
+    shape->set_young_pinned(true);
+    shape->Reference();
+    young_shapes_.push_back(shape);
+}
+
+void GCHeap::UpdateYoungShapes() {
+    // 晋升的对象改为持有形状的引用计数
+    for (auto* obj : promoted_objects_) {
+        if (obj->header()->type() == GCObjectType::kObject) {
+            static_cast<Object*>(obj)->ReferenceShapeOnPromotion();
+        }
+    }
+    promoted_objects_.clear();
+
+    // 先按仍在新生代的对象重新持有，再释放之前的引用，避免仍在使用的形状被释放
+    std::vector<Shape*> shapes;
+    shapes.swap(young_shapes_);
+    for (auto* shape : shapes) {
+        shape->set_young_pinned(false);
+    }
+    uint8_t* current = new_space_->survivor_to();
+    uint8_t* end = new_space_->survivor_to_top();
+    while (current < end) {
+        GCObject* obj = reinterpret_cast<GCObject*>(current);
+        // 跳过并行Scavenge留下的填充对象和不是 Object 的GC对象
+        if (obj->header()->type() == GCObjectType::kObject) {
+            PinYoungShape(static_cast<Object*>(obj)->shape());
+        }
+        current += obj->header()->size();
+    }
+    for (auto* shape : shapes) {
+        shape->Dereference();
+    }
+}
+
+void GCHeap::UpdateRememberedSet() {
+    size_t live = 0;
+    for (auto* obj : remembered_set_) {
+        if (!obj->header()->IsMarked()) {
+            continue;
+        }
+        remembered_set_[live++] = obj->header()->IsForwarded() ? obj->header()->GetForwardingAddress() : obj;
+    }
+    remembered_set_.resize(live);
+}
+
 void GCHeap::ProcessCopyOrReference(Value* value) {
     if (!value || !value->IsObject()) return;
 
@@ -369,8 +851,8 @@ void GCHeap::ProcessCopyOrReference(Value* value) {
     }
 
     if (new_obj) {
-        // 更新Value中的引用
-        *value = Value(static_cast<Object*>(new_obj));
+        // 更新Value中的引用，保留原有的值类型（数组、函数等）
+        value->set_object(static_cast<Object*>(new_obj));
     }
 }
 
@@ -378,21 +860,74 @@ void GCHeap::ProcessCopyOrReference(Value* value) {
 
 bool GCHeap::MarkCompact() {
     ++full_gc_count_;
+    GCEvent event;
+    event.start = std::chrono::steady_clock::now();
+    size_t used_before = old_space_->used_size() + large_object_space_->used_size();
+
+    // 上一次的清除尚未完成时，死亡对象与存活对象只能通过标记位区分，需要在清除标记前完成
+    old_space_->FinishSweeping();
+    auto phase_start = event.RecordPhase(GCPhase::kSweep, event.start);
 
     // 标记阶段
     MarkPhase();
+    event.RecordPhase(GCPhase::kMark, phase_start);
 
-    // 压缩阶段
-    CompactPhase();
+    // 清除或压缩阶段
+    SweepOrCompact(marked_size_, &event);
 
+    size_t used_after = old_space_->used_size() + large_object_space_->used_size();
+    event.freed_bytes = used_before > used_after ? used_before - used_after : 0;
+    tracer_.RecordEvent(context_, &event);
     return true;
 }
 
+void GCHeap::SweepOrCompact(size_t live_size, GCEvent* event) {
+    auto size = old_space_->area_size();
+    double fragmentation = size ? 1.0 - static_cast<double>(std::min(live_size, size)) / size : 0;
+    auto phase_start = std::chrono::steady_clock::now();
+    if (!config_.old_space_sweeping || fragmentation > config_.compaction_threshold) {
+        ++compaction_count_;
+        event->kind = GCEventKind::kMarkCompact;
+        CompactPhase(event);
+        phase_start = std::chrono::steady_clock::now();
+    }
+    else {
+        // 存活对象不移动，只需要从记忆集中去掉死亡对象，死亡对象之后在分配时惰性清除
+        ++mark_sweep_count_;
+        event->kind = GCEventKind::kMarkSweep;
+        UpdateRememberedSet();
+        if (sampling_heap_profiler_) {
+            sampling_heap_profiler_->UpdateAfterMark();
+        }
+        old_space_->StartSweeping(live_size);
+    }
+
+    // 大对象从不移动，死亡的大对象直接解除映射；下次触发完整GC的大小随存活量增长
+    total_collected_ += large_object_space_->Sweep();
+    event->RecordPhase(GCPhase::kSweep, phase_start);
+    large_object_limit_ = std::max(config_.old_space_initial_size, large_object_space_->used_size() * 2);
+
+    // 空闲调度据此判断老年代自上次完整GC以来的增长
+    last_full_gc_live_ = old_space_->used_size();
+    last_full_gc_allocated_ = old_space_->allocated_size();
+}
+
+void GCHeap::LazySweepOnAllocation(size_t size) {
+    allocated_since_sweep_ += size;
+    if (allocated_since_sweep_ < kLazySweepInterval) {
+        return;
+    }
+    allocated_since_sweep_ = 0;
+    auto start = std::chrono::steady_clock::now();
+    old_space_->Sweep(kLazySweepStepSize);
+    RecordPause(std::chrono::steady_clock::now() - start);
+}
+
 void GCHeap::MarkPhase() {
-    // 清除老年代区域中的所有对象的标记
-    old_space_->IterateObjects([](GCObject* obj, void* data) {
-        obj->header()->SetMarked(false);
-    }, nullptr);
+    marked_size_ = 0;
+
+    // 新生代对象同样会被标记（用于避免重复遍历），上次标记留下的标记需要一并清除
+    ClearMarks(true);
 
     // 遍历所有根并标记从根开始的所有可达对象
     IterateRoots([](Value* root, void* data) {
@@ -406,6 +941,34 @@ void GCHeap::MarkPhase() {
         GCHeap* heap = static_cast<GCHeap*>(data);
         heap->MarkObject(gc_obj);
     }, this);
+
+    // 使用显式工作表代替递归，避免长链表等深层对象图导致栈溢出
+    while (!marking_worklist_.empty()) {
+        GCObject* obj = marking_worklist_.back();
+        marking_worklist_.pop_back();
+        obj->GCTraverse(context_, [](Context* context, Value* child) {
+            if (!child->IsObject()) {
+                return;
+            }
+            Object* child_obj = &child->object();
+            GCObject* child_gc_obj = static_cast<GCObject*>(child_obj);
+            context->gc_manager().heap()->MarkObject(child_gc_obj);
+        });
+    }
+}
+
+void GCHeap::ClearMarks(bool clear_young) {
+    auto clear = [](GCObject* obj, void* data) {
+        obj->header()->SetMarked(false);
+        obj->header()->SetScanned(false);
+    };
+    old_space_->IterateObjects(clear, nullptr);
+    large_object_space_->IterateObjects(clear, nullptr);
+    if (clear_young) {
+        new_space_->IterateObjects([](GCObject* obj, void* data) {
+            obj->header()->SetMarked(false);
+        }, nullptr);
+    }
 }
 
 void GCHeap::MarkObject(GCObject* obj) {
@@ -413,21 +976,17 @@ void GCHeap::MarkObject(GCObject* obj) {
         return;
     }
 
-    // 标记对象
+    // 标记对象，子对象在 MarkPhase 中扫描
     obj->header()->SetMarked(true);
-
-    // 递归标记子对象
-    obj->GCTraverse(context_, [](Context* context, Value* child) {
-        if (!child->IsObject()) {
-            return;
-        }
-        Object* child_obj = &child->object();
-        GCObject* child_gc_obj = static_cast<GCObject*>(child_obj);
-        context->gc_manager().heap()->MarkObject(child_gc_obj);
-    });
+    if (obj->header()->generation() == GCGeneration::kOld && !obj->header()->IsLarge()) {
+        marked_size_ += obj->header()->size();
+    }
+    marking_worklist_.push_back(obj);
 }
 
-void GCHeap::CompactPhase() {
+void GCHeap::CompactPhase(GCEvent* event) {
+    auto phase_start = std::chrono::steady_clock::now();
+
     // 在压缩之前，遍历所有对象，调用死亡对象（未标记）的析构函数
     old_space_->IterateObjects([](GCObject* obj, void* data) {
         // 在调用析构函数前先检查是否已析构，避免重复调用
@@ -440,71 +999,178 @@ void GCHeap::CompactPhase() {
             obj->~GCObject();
         }
     }, nullptr);
+    phase_start = event->RecordPhase(GCPhase::kSweep, phase_start);
 
-    // 计算新的位置
-    uint8_t* new_top = old_space_->ComputeCompactTop();
-
-    // 第一遍：计算转发地址，使用内联转发指针
-    OldSpace::CompactForwardData fwd_data;
-    fwd_data.new_pos = old_space_->space_start();
+    // 第一遍：按页计算转发地址，使用内联转发指针
+    old_space_->ComputeForwardingAddresses();
 
-    old_space_->IterateObjects(OldSpace::ComputeForwardingAddr, &fwd_data);
-
-    // 第二遍：移动对象
-    OldSpace::MoveObjectData move_data;
-    move_data.heap = this;
-
-    old_space_->IterateLiveObjects(OldSpace::MoveObject, &move_data);
+    // 移动对象前更新所有引用，此时原位置上的转发地址和标记仍然有效
+    // 移动后对象的原位置可能已被其他对象覆盖，无法再读取转发地址
+    UpdateRememberedSet();
+    if (sampling_heap_profiler_) {
+        sampling_heap_profiler_->UpdateAfterMark();
+    }
 
     // 更新根引用（使用 IterateRoots 遍历所有根）
     IterateRoots([](Value* root, void* data) {
         OldSpace::UpdateReference(root);
     }, nullptr);
 
-    // 更新对象内部引用
-    uint8_t* current = old_space_->space_start();
-    while (current < fwd_data.new_pos) {
-        GCObject* obj = reinterpret_cast<GCObject*>(current);
-        obj->GCTraverse(context_, [](Context* context, Value* child) {
+    // 更新存活的老年代对象内部引用
+    old_space_->IterateLiveObjects([](GCObject* obj, void* data) {
+        GCHeap* heap = static_cast<GCHeap*>(data);
+        obj->GCTraverse(heap->context_, [](Context* context, Value* child) {
             OldSpace::UpdateReference(child);
         });
-        current += obj->header()->size();
-    }
+    }, this);
 
-    // 清除转发标记
-    old_space_->IterateObjects([](GCObject * obj, void* data) {
-        obj->header()->SetForwardingAddress(nullptr);
-    }, nullptr);
+    // 更新新生代和存活的大对象中指向老年代的引用
+    auto update = [](GCObject* obj, void* data) {
+        GCHeap* heap = static_cast<GCHeap*>(data);
+        obj->GCTraverse(heap->context_, [](Context* context, Value* child) {
+            OldSpace::UpdateReference(child);
+        });
+    };
+    new_space_->IterateObjects(update, this);
+    large_object_space_->IterateLiveObjects(update, this);
 
-    // 更新top
-    old_space_->set_top(fwd_data.new_pos);
+    // 第二遍：移动对象，归还空出的页
+    old_space_->Compact();
+    event->RecordPhase(GCPhase::kCompact, phase_start);
 }
 
-bool GCHeap::ExpandOldSpace(size_t min_size) {
-    // 步骤1：扩容（分配新内存，复制对象，设置转发地址）
-    if (!old_space_->Expand(min_size)) {
+// ==================== Concurrent Marking ====================
+
+std::unique_lock<std::recursive_mutex> GCHeap::PauseConcurrentMarker() {
+    if (!is_marking()) {
+        return {};
+    }
+    return std::unique_lock(concurrent_marker_->mutex());
+}
+
+bool GCHeap::StartConcurrentMarking() {
+    if (!concurrent_marker_ || is_marking() || in_gc_) {
         return false;
     }
+    auto start = std::chrono::steady_clock::now();
+    in_gc_ = true;
+    // 先执行一次Scavenge，使新生代中只剩存活对象
+    Scavenge();
+    BeginConcurrentMarking();
+    in_gc_ = false;
+    RecordPause(std::chrono::steady_clock::now() - start);
+    return true;
+}
 
-    // 步骤2：更新所有引用（使用转发地址）
-    // 更新根引用
-    IterateRoots([](Value* value, void* data) {
-        GCHeap* heap = static_cast<GCHeap*>(data);
-        OldSpace::UpdateReference(value);
-    }, this);
+void GCHeap::BeginConcurrentMarking() {
+    {
+        std::lock_guard lock(concurrent_marker_->mutex());
+        old_space_->FinishSweeping();
+        ClearMarks(false);
+        concurrent_marker_->Begin();
+        // 标记期间分配的对象都是黑色的，结束时计入存活字节数
+        marking_start_allocated_ = old_space_->allocated_size();
+
+        // 初始标记：根集合中的老年代对象置灰
+        IterateRoots([](Value* root, void* data) {
+            if (!root || !root->IsObject()) {
+                return;
+            }
+            auto* marker = static_cast<ConcurrentMarker*>(data);
+            marker->Grey(static_cast<GCObject*>(&root->object()));
+        }, concurrent_marker_.get());
+
+        // 新生代对象不参与并发标记，在这里扫描一遍，将其引用的老年代对象置灰
+        new_space_->IterateObjects([](GCObject* obj, void* data) {
+            if (obj->header()->IsDestructed()) {
+                return;
+            }
+            GCHeap* heap = static_cast<GCHeap*>(data);
+            obj->GCTraverse(heap->context_, [](Context* context, Value* child) {
+                if (child->IsObject()) {
+                    context->gc_manager().heap()->concurrent_marker()->Grey(static_cast<GCObject*>(&child->object()));
+                }
+            });
+        }, this);
+    }
+    concurrent_marker_->Resume();
+}
 
-    // 更新对象内部引用
-    old_space_->IterateObjects([](GCObject* obj, void* data) {
-        GCHeap* heap = static_cast<GCHeap*>(data);
-        obj->GCTraverse(heap->context_, [](Context* context, Value* child) {
-            OldSpace::UpdateReference(child);
-        });
-    }, this);
+void GCHeap::FinishConcurrentMarking() {
+    GCEvent event;
+    event.start = std::chrono::steady_clock::now();
+    size_t used_before = old_space_->used_size() + large_object_space_->used_size();
+    {
+        std::lock_guard lock(concurrent_marker_->mutex());
+        // 最终标记：后台线程尚未处理的灰色对象由主线程处理
+        concurrent_marker_->Finish();
+    }
+    event.RecordPhase(GCPhase::kMark, event.start);
+    ++full_gc_count_;
+    ++concurrent_marking_count_;
+    SweepOrCompact(concurrent_marker_->marked_size() + old_space_->allocated_size() - marking_start_allocated_, &event);
 
-    // 步骤3：完成扩容（清除转发标记，释放旧内存）
-    old_space_->FinishExpand();
+    size_t used_after = old_space_->used_size() + large_object_space_->used_size();
+    event.freed_bytes = used_before > used_after ? used_before - used_after : 0;
+    tracer_.RecordEvent(context_, &event);
+}
 
-    return true;
+bool GCHeap::Step(std::chrono::steady_clock::time_point deadline) {
+    if (!is_marking() || in_gc_) {
+        return !is_marking();
+    }
+    auto start = std::chrono::steady_clock::now();
+    ++incremental_step_count_;
+    allocated_since_step_ = 0;
+    if (concurrent_marker_->Step(deadline)) {
+        in_gc_ = true;
+        FinishConcurrentMarking();
+        in_gc_ = false;
+    }
+    RecordPause(std::chrono::steady_clock::now() - start);
+    return !is_marking();
+}
+
+void GCHeap::IncrementalMarkingOnAllocation(size_t size) {
+    allocated_since_step_ += size;
+    if (allocated_since_step_ < config_.incremental_step_bytes) {
+        return;
+    }
+    allocated_since_step_ = 0;
+    auto start = std::chrono::steady_clock::now();
+    ++incremental_step_count_;
+    // 分配时只推进标记，最终标记和压缩留到之后的Scavenge或 Step，避免超出预算
+    concurrent_marker_->Step(start + std::chrono::microseconds(config_.incremental_step_budget_us));
+    RecordPause(std::chrono::steady_clock::now() - start);
+}
+
+void GCHeap::ScheduleConcurrentMarking() {
+    if (!concurrent_marker_) {
+        return;
+    }
+    if (is_marking()) {
+        if (concurrent_marker_->IsComplete()) {
+            FinishConcurrentMarking();
+        }
+        return;
+    }
+    if (old_space_->used_size() > old_space_->capacity() * config_.concurrent_marking_start_ratio) {
+        BeginConcurrentMarking();
+    }
+}
+
+bool GCHeap::ExpandOldSpace(size_t min_size) {
+    GCEvent event;
+    event.kind = GCEventKind::kExpand;
+    event.start = std::chrono::steady_clock::now();
+    size_t capacity = old_space_->capacity();
+
+    // 老年代按页扩容，已有对象不移动，不需要更新引用
+    bool result = old_space_->Expand(min_size);
+
+    event.expanded_bytes = old_space_->capacity() - capacity;
+    tracer_.RecordEvent(context_, &event);
+    return result;
 }
 
 } // namespace mjs
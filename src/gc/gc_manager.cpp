@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <format>
+#include <fstream>
 
 #include <mjs/context.h>
 #include <mjs/value/value.h>
@@ -14,9 +15,9 @@ GCManager::GCManager(Context* context)
 
 GCManager::~GCManager() = default;
 
-bool GCManager::Initialize() {
+bool GCManager::Initialize(const GCHeapConfig& config) {
     heap_ = std::make_unique<GCHeap>(context_);
-    return heap_->Initialize();
+    return heap_->Initialize(config);
 }
 
 bool GCManager::CollectGarbage(bool full_gc) {
@@ -39,12 +40,27 @@ void GCManager::GetHeapStats(size_t& new_space_used, size_t& new_space_capacity,
         new_space_capacity = old_space_capacity = 0;
         return;
     }
-    
-    // 通过GCHeap获取统计信息
-    // 这些需要通过新增API暴露
-    new_space_capacity = kNewSpaceTotalSize;
-    old_space_capacity = kOldSpaceInitialSize;
-    new_space_used = old_space_used = 0;  // 需要GCHeap暴露
+
+    GCHeapStats stats;
+    heap_->GetHeapStats(&stats);
+    new_space_used = stats.new_space_used;
+    new_space_capacity = stats.new_space_capacity;
+    old_space_used = stats.old_space_used;
+    old_space_capacity = stats.old_space_capacity;
+}
+
+void GCManager::GetHeapStats(GCHeapStats* stats) const {
+    if (!heap_) {
+        *stats = GCHeapStats();
+        return;
+    }
+    heap_->GetHeapStats(stats);
+}
+
+void GCManager::NotifyMemoryPressure() {
+    if (heap_) {
+        heap_->NotifyMemoryPressure();
+    }
 }
 
 void GCManager::GetGCStats(size_t& total_allocated, size_t& total_collected, uint32_t& gc_count) const {
@@ -73,6 +89,51 @@ void GCManager::SetGCThreshold(uint8_t threshold) {
     }
 }
 
+void GCManager::SetScavengeThreads(uint32_t thread_count) {
+    if (heap_) {
+        heap_->set_scavenge_threads(thread_count);
+    }
+}
+
+bool GCManager::StartConcurrentMarking() {
+    if (!heap_) {
+        return false;
+    }
+    return heap_->StartConcurrentMarking();
+}
+
+bool GCManager::Step(std::chrono::steady_clock::time_point deadline) {
+    if (!heap_) {
+        return true;
+    }
+    return heap_->Step(deadline);
+}
+
+void GCManager::SetHeapLimits(size_t soft_limit, size_t hard_limit) {
+    if (heap_) {
+        heap_->SetHeapLimits(soft_limit, hard_limit);
+    }
+}
+
+void GCManager::SetNearHeapLimitCallback(NearHeapLimitCallback callback, void* data) {
+    if (heap_) {
+        heap_->SetNearHeapLimitCallback(callback, data);
+    }
+}
+
+void GCManager::AdjustExternalMemory(int64_t delta) {
+    if (heap_) {
+        heap_->AdjustExternalMemory(delta);
+    }
+}
+
+GCIdleResult GCManager::NotifyIdle(std::chrono::nanoseconds budget) {
+    if (!heap_) {
+        return {};
+    }
+    return heap_->NotifyIdle(budget);
+}
+
 void GCManager::AddRoot(Value* value) {
     if (heap_) {
         heap_->AddRoot(value);
@@ -91,4 +152,79 @@ void GCManager::PrintObjectTree(Context* context) {
     // 具体实现取决于需要展示的信息
 }
 
+bool GCManager::WriteHeapSnapshot(std::ostream& out) {
+    if (!heap_) {
+        return false;
+    }
+    return heap_->WriteHeapSnapshot(out);
+}
+
+bool GCManager::WriteHeapSnapshot(const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        return false;
+    }
+    return WriteHeapSnapshot(out) && out.flush().good();
+}
+
+void GCManager::StartSamplingHeapProfiler(uint64_t sample_interval, uint32_t stack_depth) {
+    if (heap_) {
+        heap_->StartSamplingHeapProfiler(sample_interval, stack_depth);
+    }
+}
+
+void GCManager::StopSamplingHeapProfiler() {
+    if (heap_) {
+        heap_->StopSamplingHeapProfiler();
+    }
+}
+
+bool GCManager::WriteSamplingHeapProfile(std::ostream& out) {
+    if (!heap_ || !heap_->sampling_heap_profiler()) {
+        return false;
+    }
+    return heap_->sampling_heap_profiler()->WriteHeapProfile(out);
+}
+
+bool GCManager::WriteSamplingHeapProfile(const std::string& path) {
+    if (!heap_ || !heap_->sampling_heap_profiler()) {
+        return false;
+    }
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        return false;
+    }
+    return WriteSamplingHeapProfile(out) && out.flush().good();
+}
+
+void GCManager::SetGCEventCallback(GCEventCallback callback, void* data) {
+    if (heap_) {
+        heap_->SetGCEventCallback(callback, data);
+    }
+}
+
+void GCManager::StartGCTracing() {
+    if (heap_) {
+        heap_->StartGCTracing();
+    }
+}
+
+bool GCManager::StopGCTracing(std::ostream& out) {
+    if (!heap_ || !heap_->tracer().tracing()) {
+        return false;
+    }
+    return heap_->StopGCTracing(out);
+}
+
+bool GCManager::StopGCTracing(const std::string& path) {
+    if (!heap_ || !heap_->tracer().tracing()) {
+        return false;
+    }
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        return false;
+    }
+    return StopGCTracing(out) && out.flush().good();
+}
+
 } // namespace mjs
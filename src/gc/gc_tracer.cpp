@@ -0,0 +1,147 @@
+/**
+ * @file gc_tracer.cpp
+ * @brief GC事件追踪与停顿时间直方图实现
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <mjs/gc/gc_tracer.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace mjs {
+
+const char* GCEventKindName(GCEventKind kind) {
+    switch (kind) {
+    case GCEventKind::kScavenge: return "Scavenge";
+    case GCEventKind::kMarkSweep: return "MarkSweep";
+    case GCEventKind::kMarkCompact: return "MarkCompact";
+    case GCEventKind::kExpand: return "Expand";
+    }
+    return "Unknown";
+}
+
+const char* GCPhaseName(GCPhase phase) {
+    switch (phase) {
+    case GCPhase::kRoots: return "roots";
+    case GCPhase::kCopy: return "copy";
+    case GCPhase::kMark: return "mark";
+    case GCPhase::kCompact: return "compact";
+    case GCPhase::kSweep: return "sweep";
+    default: break;
+    }
+    return "unknown";
+}
+
+// ==================== GCPauseHistogram ====================
+
+size_t GCPauseHistogram::IndexOf(uint64_t value) {
+    if (value < kSubBucketCount) {
+        return static_cast<size_t>(value);
+    }
+    // 最高位为第 msb 位的值右移 shift 位后落在 [kSubBucketHalfCount, kSubBucketCount) 内
+    uint32_t msb = static_cast<uint32_t>(std::bit_width(value)) - 1;
+    uint32_t shift = msb - kSubBucketBits + 1;
+    return static_cast<size_t>(kSubBucketCount + (shift - 1) * kSubBucketHalfCount
+        + ((value >> shift) - kSubBucketHalfCount));
+}
+
+uint64_t GCPauseHistogram::HighestValueOf(size_t index) {
+    if (index < kSubBucketCount) {
+        return index;
+    }
+    uint64_t shift = (index - kSubBucketCount) / kSubBucketHalfCount + 1;
+    uint64_t sub_bucket = (index - kSubBucketCount) % kSubBucketHalfCount + kSubBucketHalfCount;
+    return (sub_bucket << shift) + (uint64_t(1) << shift) - 1;
+}
+
+void GCPauseHistogram::Record(uint64_t value) {
+    value = std::min(value, kMaxValue);
+    ++counts_[IndexOf(value)];
+    ++count_;
+    total_ += value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+}
+
+uint64_t GCPauseHistogram::Percentile(double percentile) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    auto target = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(percentile / 100 * count_)), 1);
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        total += counts_[i];
+        if (total >= target) {
+            return std::min(HighestValueOf(i), max_);
+        }
+    }
+    return max_;
+}
+
+void GCPauseHistogram::Reset() {
+    counts_.fill(0);
+    count_ = 0;
+    total_ = 0;
+    min_ = UINT64_MAX;
+    max_ = 0;
+}
+
+// ==================== GCTracer ====================
+
+void GCTracer::RecordEvent(Context* context, GCEvent* event) {
+    event->end = std::chrono::steady_clock::now();
+    ++event_count_;
+    if (tracing_) {
+        trace_events_.push_back(*event);
+    }
+    if (event_callback_) {
+        event_callback_(context, *event, event_data_);
+    }
+}
+
+void GCTracer::StartTracing() {
+    tracing_ = true;
+    trace_start_ = std::chrono::steady_clock::now();
+    trace_events_.clear();
+}
+
+bool GCTracer::StopTracing(std::ostream& out) {
+    if (!tracing_) {
+        return false;
+    }
+    tracing_ = false;
+
+    auto to_us = [](std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+
+    // 每个事件是一个完整事件（"ph":"X"），阶段用时和字节数放在 args 中
+    out << "{\"traceEvents\":[";
+    for (size_t i = 0; i < trace_events_.size(); ++i) {
+        auto& event = trace_events_[i];
+        if (i != 0) {
+            out << ",";
+        }
+        out << "\n{\"name\":\"" << GCEventKindName(event.kind) << "\",\"cat\":\"gc\",\"ph\":\"X\""
+            << ",\"ts\":" << to_us(event.start - trace_start_)
+            << ",\"dur\":" << to_us(event.elapsed())
+            << ",\"pid\":1,\"tid\":1,\"args\":{"
+            << "\"promoted_bytes\":" << event.promoted_bytes
+            << ",\"freed_bytes\":" << event.freed_bytes
+            << ",\"expanded_bytes\":" << event.expanded_bytes;
+        for (size_t phase = 0; phase < kGCPhaseCount; ++phase) {
+            out << ",\"" << GCPhaseName(static_cast<GCPhase>(phase)) << "_us\":" << to_us(event.phases[phase]);
+        }
+        out << "}}";
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    trace_events_.clear();
+    return out.good();
+}
+
+} // namespace mjs
@@ -0,0 +1,166 @@
+/**
+ * @file heap_cage.cpp
+ * @brief 指针压缩的堆笼实现
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <mjs/gc/heap_cage.h>
+
+#include <iterator>
+#include <new>
+
+#include <mjs/gc/virtual_memory.h>
+
+namespace mjs {
+
+HeapCage& HeapCage::Instance() {
+    // 不析构，进程退出时其他静态对象可能仍持有笼内的内存
+    static HeapCage* cage = new HeapCage();
+    return *cage;
+}
+
+HeapCage::HeapCage() {
+    base_ = static_cast<uint8_t*>(ReserveVirtualMemory(kHeapCageSize));
+    if (!base_) {
+        throw std::bad_alloc();
+    }
+    // 第一页不分配，偏移0和转发地址占位值1不会指向有效对象
+    top_ = VirtualMemoryPageSize();
+}
+
+void* HeapCage::Allocate(size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return AllocateLocked(size);
+}
+
+void* HeapCage::AllocateLocked(size_t size) {
+    size = AlignVirtualMemorySize(size);
+    size_t offset = kHeapCageSize;
+    for (auto iter = free_ranges_.begin(); iter != free_ranges_.end(); ++iter) {
+        if (iter->second < size) {
+            continue;
+        }
+        offset = iter->first;
+        size_t remaining = iter->second - size;
+        free_ranges_.erase(iter);
+        if (remaining > 0) {
+            free_ranges_.emplace(offset + size, remaining);
+        }
+        break;
+    }
+    if (offset == kHeapCageSize) {
+        if (size > kHeapCageSize - top_) {
+            return nullptr;
+        }
+        offset = top_;
+        top_ += size;
+    }
+
+    auto* address = base_ + offset;
+    if (!CommitVirtualMemory(address, size)) {
+        free_ranges_.emplace(offset, size);
+        return nullptr;
+    }
+    committed_size_ += size;
+    return address;
+}
+
+void HeapCage::Free(void* address, size_t size) {
+    if (!address) {
+        return;
+    }
+    size = AlignVirtualMemorySize(size);
+    DecommitVirtualMemory(address, size);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    committed_size_ -= size;
+    size_t offset = static_cast<size_t>(static_cast<uint8_t*>(address) - base_);
+
+    // 与前后相邻的空闲区间合并
+    auto next = free_ranges_.lower_bound(offset);
+    if (next != free_ranges_.end() && offset + size == next->first) {
+        size += next->second;
+        next = free_ranges_.erase(next);
+    }
+    if (next != free_ranges_.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            prev->second += size;
+            return;
+        }
+    }
+    free_ranges_.emplace_hint(next, offset, size);
+}
+
+void* HeapCage::AllocateCell(size_t size) {
+    if (size > kMaxCellSize) {
+        auto* address = Allocate(size);
+        if (!address) {
+            throw std::bad_alloc();
+        }
+        return address;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& free_list = free_cells_[CellClassOf(size)];
+    if (free_list) {
+        auto* node = free_list;
+        free_list = node->next;
+        return node;
+    }
+
+    size_t cell_size = (CellClassOf(size) + 1) * kCellAlignment;
+    if (cell_top_ + cell_size > cell_end_) {
+        // 当前小块内存的剩余部分不再使用，释放时也不会归还
+        cell_top_ = static_cast<uint8_t*>(AllocateLocked(kCellChunkSize));
+        if (!cell_top_) {
+            cell_end_ = nullptr;
+            throw std::bad_alloc();
+        }
+        cell_end_ = cell_top_ + kCellChunkSize;
+    }
+    auto* address = cell_top_;
+    cell_top_ += cell_size;
+    return address;
+}
+
+void HeapCage::FreeCell(void* address, size_t size) {
+    if (!address) {
+        return;
+    }
+    if (size > kMaxCellSize) {
+        Free(address, size);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto* node = static_cast<FreeCellNode*>(address);
+    auto& free_list = free_cells_[CellClassOf(size)];
+    node->next = free_list;
+    free_list = node;
+}
+
+size_t HeapCage::committed_size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return committed_size_;
+}
+
+void* AllocateHeapMemory(size_t size) {
+#ifdef ENABLE_POINTER_COMPRESSION
+    return HeapCage::Instance().Allocate(size);
+#else
+    return AllocateVirtualMemory(AlignVirtualMemorySize(size));
+#endif
+}
+
+void FreeHeapMemory(void* address, size_t size) {
+#ifdef ENABLE_POINTER_COMPRESSION
+    HeapCage::Instance().Free(address, size);
+#else
+    FreeVirtualMemory(address, AlignVirtualMemorySize(size));
+#endif
+}
+
+} // namespace mjs
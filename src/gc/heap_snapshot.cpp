@@ -0,0 +1,371 @@
+#include <mjs/gc/heap_snapshot.h>
+
+#include <cassert>
+
+#include <mjs/context.h>
+#include <mjs/runtime.h>
+#include <mjs/gc/gc_heap.h>
+#include <mjs/gc/new_space.h>
+#include <mjs/gc/old_space.h>
+#include <mjs/gc/large_object_space.h>
+#include <mjs/shape/shape.h>
+#include <mjs/value/value.h>
+#include <mjs/value/object/object.h>
+#include <mjs/value/object/array_object.h>
+#include <mjs/value/object/function_object.h>
+
+namespace mjs {
+
+namespace {
+
+/**
+ * @brief 节点类型，顺序与 meta.node_types 一致
+ */
+enum NodeType : uint32_t {
+    kNodeHidden = 0,
+    kNodeArray,
+    kNodeString,
+    kNodeObject,
+    kNodeCode,
+    kNodeClosure,
+    kNodeRegExp,
+    kNodeNumber,
+    kNodeNative,
+    kNodeSynthetic,
+    kNodeConsString,
+    kNodeSlicedString,
+    kNodeSymbol,
+    kNodeBigInt,
+    kNodeObjectShape,
+};
+
+/**
+ * @brief 边类型，顺序与 meta.edge_types 一致
+ */
+enum EdgeType : uint32_t {
+    kEdgeContext = 0,
+    kEdgeElement,
+    kEdgeProperty,
+    kEdgeInternal,
+    kEdgeHidden,
+    kEdgeShortcut,
+    kEdgeWeak,
+};
+
+constexpr uint32_t kNodeFieldCount = 7;    ///< 每个节点的字段数，边的 to_node 为节点序号乘以该值
+constexpr uint32_t kRootNodeIndex = 0;     ///< GC根合成节点的序号
+
+constexpr const char* kSnapshotMeta =
+    "{\"node_fields\":[\"type\",\"name\",\"id\",\"self_size\",\"edge_count\",\"trace_node_id\",\"detachedness\"],"
+    "\"node_types\":[[\"hidden\",\"array\",\"string\",\"object\",\"code\",\"closure\",\"regexp\",\"number\","
+    "\"native\",\"synthetic\",\"concatenated string\",\"sliced string\",\"symbol\",\"bigint\",\"object shape\"],"
+    "\"string\",\"number\",\"number\",\"number\",\"number\",\"number\"],"
+    "\"edge_fields\":[\"type\",\"name_or_index\",\"to_node\"],"
+    "\"edge_types\":[[\"context\",\"element\",\"property\",\"internal\",\"hidden\",\"shortcut\",\"weak\"],"
+    "\"string_or_number\",\"node\"],"
+    "\"trace_function_info_fields\":[\"function_id\",\"name\",\"script_name\",\"script_id\",\"line\",\"column\"],"
+    "\"trace_node_fields\":[\"id\",\"function_info_index\",\"count\",\"size\",\"children\"],"
+    "\"sample_fields\":[\"timestamp_us\",\"last_assigned_id\"],"
+    "\"location_fields\":[\"object_index\",\"script_id\",\"line\",\"column\"]}";
+
+thread_local HeapSnapshotWriter* t_writer = nullptr;
+
+} // namespace
+
+void WriteJsonString(std::ostream& out, std::string_view str) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    out << '"';
+    for (char c : str) {
+        switch (c) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\r': out << "\\r"; break;
+        case '\t': out << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out << "\\u00" << kHex[(c >> 4) & 0xf] << kHex[c & 0xf];
+            }
+            else {
+                out << c;
+            }
+            break;
+        }
+    }
+    out << '"';
+}
+
+HeapSnapshotWriter::HeapSnapshotWriter(GCHeap* heap, std::ostream& out)
+    : heap_(heap)
+    , context_(heap->context_)
+    , out_(out) {}
+
+bool HeapSnapshotWriter::Write() {
+    assert(!t_writer);
+    t_writer = this;
+
+    AssignNodeIndices();
+    CountEdges();
+
+    WriteHeader();
+    WriteNodes();
+    WriteEdges();
+    out_ << ",\n\"trace_function_infos\":[],\n\"trace_tree\":[],\n\"samples\":[],\n\"locations\":[]";
+    WriteStrings();
+    out_ << "}\n";
+
+    ClearNodeIndices();
+    t_writer = nullptr;
+    return out_.good();
+}
+
+template <typename Func>
+void HeapSnapshotWriter::ForEachObject(Func func) {
+    auto visit = [](GCObject* obj, void* data) {
+        // 跳过老年代空闲块和并行Scavenge留下的填充对象
+        if (!obj->header()->IsDestructed()) {
+            (*static_cast<Func*>(data))(obj);
+        }
+    };
+    heap_->new_space_->IterateObjects(visit, &func);
+    heap_->old_space_->IterateObjects(visit, &func);
+    heap_->large_object_space_->IterateObjects(visit, &func);
+}
+
+void HeapSnapshotWriter::AssignNodeIndices() {
+    ForEachObject([this](GCObject* obj) {
+        // 快照期间不移动对象，转发地址空闲，借用来存放节点序号（0 留给GC根）
+        assert(!obj->header()->IsForwarded());
+        obj->header()->SetForwardingAddress(reinterpret_cast<GCObject*>(static_cast<uintptr_t>(++object_count_)));
+
+        for (Shape* shape = static_cast<Object*>(obj)->shape_; shape; shape = shape->parent_shape()) {
+            if (!shape_indices_.emplace(shape, static_cast<uint32_t>(shapes_.size())).second) {
+                break;
+            }
+            shapes_.push_back(shape);
+        }
+    });
+}
+
+void HeapSnapshotWriter::ClearNodeIndices() {
+    ForEachObject([](GCObject* obj) {
+        obj->header()->SetForwardingAddress(nullptr);
+    });
+}
+
+void HeapSnapshotWriter::CountEdges() {
+    heap_->IterateRoots([](Value* root, void* data) {
+        uint32_t index;
+        if (root && root->IsObject() && NodeIndex(&root->object(), &index)) {
+            ++static_cast<HeapSnapshotWriter*>(data)->root_count_;
+        }
+    }, this);
+    edge_count_ = root_count_;
+
+    ForEachObject([this](GCObject* obj) {
+        edge_count_ += ObjectEdgeCount(static_cast<Object*>(obj));
+    });
+    for (Shape* shape : shapes_) {
+        edge_count_ += shape->parent_shape() ? 1 : 0;
+    }
+}
+
+void HeapSnapshotWriter::WriteHeader() {
+    out_ << "{\"snapshot\":{\"meta\":" << kSnapshotMeta
+        << ",\"node_count\":" << 1 + object_count_ + shapes_.size()
+        << ",\"edge_count\":" << edge_count_
+        << ",\"trace_function_count\":0},\n";
+}
+
+void HeapSnapshotWriter::WriteNodes() {
+    out_ << "\"nodes\":[";
+    first_item_ = true;
+
+    WriteNode(kNodeSynthetic, "(GC roots)", kRootNodeIndex, 0, root_count_);
+
+    ForEachObject([this](GCObject* obj) {
+        auto* object = static_cast<Object*>(obj);
+        uint32_t index;
+        NodeIndex(obj, &index);
+        uint32_t type;
+        std::string name;
+        DescribeObject(object, &type, &name);
+        WriteNode(type, name, index, obj->header()->size(), ObjectEdgeCount(object));
+    });
+
+    for (Shape* shape : shapes_) {
+        WriteNode(kNodeObjectShape, "(object shape)", ShapeIndex(shape), sizeof(Shape),
+            shape->parent_shape() ? 1 : 0);
+    }
+    out_ << "]";
+}
+
+void HeapSnapshotWriter::WriteEdges() {
+    out_ << ",\n\"edges\":[";
+    first_item_ = true;
+
+    // 顺序必须与节点一致：每个节点的边紧跟在前一个节点的边之后
+    visit_edges_ = 0;
+    heap_->IterateRoots([](Value* root, void* data) {
+        auto* writer = static_cast<HeapSnapshotWriter*>(data);
+        uint32_t index;
+        if (root && root->IsObject() && NodeIndex(&root->object(), &index)) {
+            writer->WriteEdge(kEdgeElement, writer->visit_edges_++, index);
+        }
+    }, this);
+
+    ForEachObject([this](GCObject* obj) {
+        WriteObjectEdges(static_cast<Object*>(obj));
+    });
+
+    uint32_t parent_name = InternString("parent");
+    for (Shape* shape : shapes_) {
+        if (shape->parent_shape()) {
+            WriteEdge(kEdgeInternal, parent_name, ShapeIndex(shape->parent_shape()));
+        }
+    }
+    out_ << "]";
+}
+
+void HeapSnapshotWriter::WriteStrings() {
+    out_ << ",\n\"strings\":[";
+    for (size_t i = 0; i < strings_.size(); ++i) {
+        if (i != 0) {
+            out_ << ",\n";
+        }
+        WriteJsonString(out_, strings_[i]);
+    }
+    out_ << "]";
+}
+
+void HeapSnapshotWriter::WriteNode(uint32_t type, std::string_view name, uint32_t index, size_t self_size, uint32_t edge_count) {
+    if (!first_item_) {
+        out_ << ",\n";
+    }
+    first_item_ = false;
+    // 与 V8 一致，堆对象的 id 取奇数
+    out_ << type << ',' << InternString(name) << ',' << index * 2 + 1 << ','
+        << self_size << ',' << edge_count << ",0,0";
+}
+
+void HeapSnapshotWriter::WriteEdge(uint32_t type, uint32_t name_or_index, uint32_t to_index) {
+    if (!first_item_) {
+        out_ << ",\n";
+    }
+    first_item_ = false;
+    out_ << type << ',' << name_or_index << ',' << to_index * kNodeFieldCount;
+}
+
+uint32_t HeapSnapshotWriter::ObjectEdgeCount(Object* obj) {
+    visit_mode_ = VisitMode::kCount;
+    visit_object_ = obj;
+    visit_edges_ = 0;
+    obj->GCTraverse(context_, &HeapSnapshotWriter::TraverseCallback);
+    visit_object_ = nullptr;
+    return visit_edges_ + (obj->shape_ ? 1 : 0);
+}
+
+void HeapSnapshotWriter::WriteObjectEdges(Object* obj) {
+    visit_mode_ = VisitMode::kWrite;
+    visit_object_ = obj;
+    visit_edges_ = 0;
+    obj->GCTraverse(context_, &HeapSnapshotWriter::TraverseCallback);
+    visit_object_ = nullptr;
+    if (obj->shape_) {
+        WriteEdge(kEdgeInternal, InternString("map"), ShapeIndex(obj->shape_));
+    }
+}
+
+void HeapSnapshotWriter::TraverseCallback(Context* context, Value* child) {
+    t_writer->VisitChild(child);
+}
+
+void HeapSnapshotWriter::VisitChild(Value* child) {
+    // 只记录指向GC堆对象的引用，字符串、数字等不是堆节点
+    uint32_t to_index;
+    if (!child->IsObject() || !NodeIndex(&child->object(), &to_index)) {
+        return;
+    }
+    ++visit_edges_;
+    if (visit_mode_ == VisitMode::kCount) {
+        return;
+    }
+
+    Object* obj = visit_object_;
+
+    // 属性槽：通过形状找到属性名
+    if (obj->property_count_ > 0) {
+        auto offset = reinterpret_cast<const uint8_t*>(child) - reinterpret_cast<const uint8_t*>(&obj->property_slots()[0].value);
+        if (offset >= 0 && static_cast<size_t>(offset) < obj->property_count_ * sizeof(Object::PropertySlot)
+            && offset % sizeof(Object::PropertySlot) == 0) {
+            auto slot_index = static_cast<PropertySlotIndex>(offset / sizeof(Object::PropertySlot));
+            if (obj->shape_ && static_cast<uint32_t>(slot_index) < obj->shape_->property_size()) {
+                auto name = PropertyName(obj->shape_->GetProperty(slot_index).const_index());
+                WriteEdge(kEdgeProperty, InternString(name), to_index);
+                return;
+            }
+        }
+    }
+
+    // 稠密数组元素：记录下标
+    if (obj->class_id() == ClassId::kArrayObject) {
+        auto& elements = static_cast<ArrayObject*>(obj)->elements();
+        if (elements.is_value() && child >= elements.value_data() && child < elements.value_data() + elements.size()) {
+            WriteEdge(kEdgeElement, static_cast<uint32_t>(child - elements.value_data()), to_index);
+            return;
+        }
+    }
+
+    WriteEdge(kEdgeInternal, InternString("(internal)"), to_index);
+}
+
+void HeapSnapshotWriter::DescribeObject(Object* obj, uint32_t* type, std::string* name) {
+    *type = kNodeObject;
+    *name = context_->runtime().class_def_table()[obj->class_id()].name_string();
+    if (auto* func = dynamic_cast<FunctionObject*>(obj)) {
+        *type = kNodeClosure;
+        if (!func->function_def().name().empty()) {
+            *name = func->function_def().name();
+        }
+    }
+    if (name->empty()) {
+        *name = "(object)";
+    }
+}
+
+std::string HeapSnapshotWriter::PropertyName(ConstIndex const_index) {
+    const Value& key = context_->GetConstValue(const_index);
+    if (key.IsString()) {
+        return key.string_view();
+    }
+    if (key.IsSymbol()) {
+        return "<symbol>";
+    }
+    Value str = key.ToString(context_);
+    return str.IsString() ? str.string_view() : "(unknown)";
+}
+
+bool HeapSnapshotWriter::NodeIndex(GCObject* obj, uint32_t* index) {
+    auto* addr = obj->header()->GetForwardingAddress();
+    if (!addr) {
+        return false;
+    }
+    *index = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(addr));
+    return true;
+}
+
+uint32_t HeapSnapshotWriter::ShapeIndex(Shape* shape) const {
+    auto iter = shape_indices_.find(shape);
+    assert(iter != shape_indices_.end());
+    return 1 + object_count_ + iter->second;
+}
+
+uint32_t HeapSnapshotWriter::InternString(std::string_view str) {
+    auto [iter, inserted] = string_indices_.emplace(std::string(str), static_cast<uint32_t>(strings_.size()));
+    if (inserted) {
+        strings_.emplace_back(str);
+    }
+    return iter->second;
+}
+
+} // namespace mjs
@@ -0,0 +1,89 @@
+/**
+ * @file large_object_space.cpp
+ * @brief 大对象空间实现
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <mjs/gc/large_object_space.h>
+
+#include <new>
+
+#include <mjs/gc/heap_cage.h>
+#include <mjs/gc/virtual_memory.h>
+
+namespace mjs {
+
+const size_t LargeObjectChunk::kHeaderSize = AlignGCObjectSize(sizeof(LargeObjectChunk));
+
+LargeObjectSpace::~LargeObjectSpace() {
+    // 与老年代一致，销毁时不调用对象的析构函数
+    while (!chunks_.empty()) {
+        FreeChunk(&chunks_.front());
+    }
+}
+
+void* LargeObjectSpace::Allocate(size_t* size) {
+    *size = AlignGCObjectSize(*size);
+    size_t mapped_size = AlignVirtualMemorySize(LargeObjectChunk::kHeaderSize + *size);
+    void* mem = AllocateHeapMemory(mapped_size);
+    if (!mem) {
+        return nullptr;
+    }
+
+    auto* chunk = new (mem) LargeObjectChunk(mapped_size, *size);
+    chunks_.push_back(*chunk);
+    used_size_ += *size;
+    mapped_size_ += mapped_size;
+    ++object_count_;
+    return chunk->object();
+}
+
+size_t LargeObjectSpace::Sweep() {
+    size_t collected = 0;
+    auto it = chunks_.begin();
+    while (it != chunks_.end()) {
+        // 先取得下一个块，当前块可能被解除映射
+        auto& chunk = *it;
+        ++it;
+        GCObject* obj = chunk.object();
+        if (obj->header()->IsMarked()) {
+            continue;
+        }
+        collected += chunk.object_size();
+        if (!obj->header()->IsDestructed()) {
+            obj->header()->SetDestructed(true);
+            obj->~GCObject();
+        }
+        FreeChunk(&chunk);
+    }
+    return collected;
+}
+
+void LargeObjectSpace::FreeChunk(LargeObjectChunk* chunk) {
+    size_t mapped_size = chunk->mapped_size();
+    used_size_ -= chunk->object_size();
+    mapped_size_ -= mapped_size;
+    --object_count_;
+    chunk->unlink();
+    chunk->~LargeObjectChunk();
+    FreeHeapMemory(chunk, mapped_size);
+}
+
+void LargeObjectSpace::IterateObjects(ObjectCallback callback, void* data) {
+    for (auto& chunk : chunks_) {
+        callback(chunk.object(), data);
+    }
+}
+
+void LargeObjectSpace::IterateLiveObjects(ObjectCallback callback, void* data) {
+    for (auto& chunk : chunks_) {
+        GCObject* obj = chunk.object();
+        if (obj->header()->IsMarked()) {
+            callback(obj, data);
+        }
+    }
+}
+
+} // namespace mjs
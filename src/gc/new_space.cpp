@@ -8,32 +8,70 @@
 
 #include <mjs/gc/new_space.h>
 
+#include <cassert>
 #include <cstring>
 #include <algorithm>
+#include <new>
+
+#include <mjs/gc/heap_cage.h>
 
 namespace mjs {
 
+namespace {
+
+/**
+ * @brief 分配新生代的区域，启用指针压缩时从堆笼中分配
+ */
+uint8_t* AllocateRegion(size_t size) {
+#ifdef ENABLE_POINTER_COMPRESSION
+    return static_cast<uint8_t*>(AllocateHeapMemory(size));
+#else
+    return new (std::nothrow) uint8_t[size];
+#endif
+}
+
+/**
+ * @brief 释放 AllocateRegion 分配的区域
+ */
+void FreeRegion(uint8_t* region, size_t size) {
+#ifdef ENABLE_POINTER_COMPRESSION
+    FreeHeapMemory(region, size);
+#else
+    (void)size;
+    delete[] region;
+#endif
+}
+
+} // namespace
+
 // ==================== NewSpace Implementation ====================
 
 NewSpace::NewSpace() = default;
 
 NewSpace::~NewSpace() {
     if (eden_space_) {
-        delete[] eden_space_;
+        FreeRegion(eden_space_, eden_size_);
     }
     if (survivor_from_) {
-        delete[] survivor_from_;
+        FreeRegion(survivor_from_, survivor_from_size_);
     }
     if (survivor_to_) {
-        delete[] survivor_to_;
+        FreeRegion(survivor_to_, survivor_to_size_);
     }
 }
 
-bool NewSpace::Initialize() {
+bool NewSpace::Initialize(size_t eden_size, size_t survivor_size) {
+    if (eden_size == 0 || survivor_size == 0) {
+        return false;
+    }
+
     // 分配三个区域：Eden、Survivor From、Survivor To
-    eden_space_ = new uint8_t[kEdenSpaceSize];
-    survivor_from_ = new uint8_t[kSurvivorSpaceSize];
-    survivor_to_ = new uint8_t[kSurvivorSpaceSize];
+    eden_space_ = AllocateRegion(eden_size);
+    survivor_from_ = AllocateRegion(survivor_size);
+    survivor_to_ = AllocateRegion(survivor_size);
+    eden_size_ = eden_size;
+    survivor_from_size_ = survivor_size;
+    survivor_to_size_ = survivor_size;
 
     if (!eden_space_ || !survivor_from_ || !survivor_to_) {
         return false;
@@ -67,7 +105,7 @@ void* NewSpace::AllocateInToSpace(size_t* size) {
     *size = AlignGCObjectSize(*size);
 
     // 检查Survivor To空间是否有足够空间
-    if (survivor_to_top_ + *size > survivor_to_ + kSurvivorSpaceSize) {
+    if (survivor_to_top_ + *size > survivor_to_ + survivor_to_size_) {
         return nullptr;
     }
 
@@ -80,12 +118,44 @@ void* NewSpace::AllocateInToSpace(size_t* size) {
 }
 
 bool NewSpace::HasSpace(size_t size) const {
-    return eden_top_ + size <= eden_space_ + kEdenSpaceSize;
+    return eden_top_ + size <= eden_space_ + eden_size_;
 }
 
 void NewSpace::SwapSurvivorSpaces() {
     std::swap(survivor_from_, survivor_to_);
     std::swap(survivor_from_top_, survivor_to_top_);
+    std::swap(survivor_from_size_, survivor_to_size_);
+}
+
+bool NewSpace::Resize(size_t eden_size, size_t survivor_size) {
+    assert(eden_top_ == eden_space_);
+    ResetToSpace();
+    if (eden_size == 0 || survivor_size == 0) {
+        return false;
+    }
+
+    if (eden_size != eden_size_) {
+        auto* new_eden = AllocateRegion(eden_size);
+        if (!new_eden) {
+            return false;
+        }
+        FreeRegion(eden_space_, eden_size_);
+        eden_space_ = new_eden;
+        eden_top_ = eden_space_;
+        eden_size_ = eden_size;
+    }
+
+    if (survivor_size != survivor_to_size_) {
+        auto* new_to = AllocateRegion(survivor_size);
+        if (!new_to) {
+            return false;
+        }
+        FreeRegion(survivor_to_, survivor_to_size_);
+        survivor_to_ = new_to;
+        survivor_to_top_ = survivor_to_;
+        survivor_to_size_ = survivor_size;
+    }
+    return true;
 }
 
 void NewSpace::IterateObjects(ObjectCallback callback, void* data) {
@@ -8,135 +8,291 @@
 
 #include <mjs/gc/old_space.h>
 
+#include <algorithm>
+#include <bit>
 #include <cstring>
 
 #include <mjs/value/value.h>
 #include <mjs/value/object/object.h>
+#include <mjs/gc/heap_cage.h>
+#include <mjs/gc/virtual_memory.h>
 
 namespace mjs {
 
+namespace {
+
+/**
+ * @brief 空闲块，占据清除后合并的死亡对象或分配剩余的空间
+ *
+ * 标记为已析构，遍历老年代时不会被当作存活对象，也不会被调用析构函数。
+ */
+class GCFreeBlock : public GCObject {};
+
+static_assert(kOldSpaceSizeClassCount <= 64, "free_list_mask_ has one bit per size class");
+
+} // namespace
+
 // ==================== OldSpace Implementation ====================
 
 OldSpace::OldSpace() = default;
 
 OldSpace::~OldSpace() {
-    if (space_start_) {
-        delete[] space_start_;
+    for (auto& page : pages_) {
+        FreeHeapMemory(page.start(), kOldSpacePageSize);
+    }
+    for (auto* start : empty_pages_) {
+        FreeHeapMemory(start, kOldSpacePageSize);
     }
 }
 
 bool OldSpace::Initialize(size_t initial_size) {
-    space_start_ = new uint8_t[initial_size];
-    if (!space_start_) {
-        return false;
-    }
-
-    capacity_ = initial_size;
-    top_ = space_start_;
-    used_size_ = 0;
-    return true;
+    return initial_size == 0 || Expand(initial_size);
 }
 
 void* OldSpace::Allocate(size_t* size) {
     *size = AlignGCObjectSize(*size);
 
-    // 检查是否有足够空间
-    if (top_ + *size > space_start_ + capacity_) {
-        // 空间不足，返回 nullptr
-        // 调用者应触发 GC 或扩容
-        return nullptr;
+    if (free_list_mask_ != 0) {
+        if (void* mem = AllocateFromFreeList(size)) {
+            used_size_ += *size;
+            allocated_size_ += *size;
+            return mem;
+        }
     }
 
-    void* result = top_;
-    top_ += *size;
-    used_size_ += *size;
+    // 当前页放不下时换到空页，没有空页时返回 nullptr，调用者应触发 GC 或扩容
+    if (pages_.empty() || *size > static_cast<size_t>(pages_.back().end() - pages_.back().top())) {
+        if (*size > kOldSpacePageSize || !AddPage()) {
+            return nullptr;
+        }
+    }
 
-    // 清零内存
-    // std::memset(result, 0, size);
+    auto& page = pages_.back();
+    void* result = page.top();
+    page.set_top(page.top() + *size);
+    used_size_ += *size;
+    allocated_size_ += *size;
     return result;
 }
 
-bool OldSpace::Expand(size_t min_size) {
-    // 计算新的容量（至少是当前的两倍，或足够容纳 min_size）
-    size_t new_capacity = capacity_ * 2;
-    if (new_capacity < capacity_ + min_size) {
-        new_capacity = capacity_ + min_size + kOldSpaceInitialSize;
-    }
-
-    // 分配新的内存块
-    uint8_t* new_space_start = new uint8_t[new_capacity];
-    if (!new_space_start) {
+bool OldSpace::AddPage() {
+    if (empty_pages_.empty()) {
         return false;
     }
+    if (!pages_.empty()) {
+        auto& page = pages_.back();
+        size_t remaining = static_cast<size_t>(page.end() - page.top());
+        if (remaining >= kOldSpaceMinFreeBlockSize) {
+            AddFreeBlock(page.top(), remaining);
+            page.set_top(page.end());
+        }
+    }
+    pages_.emplace_back(empty_pages_.back());
+    empty_pages_.pop_back();
+    return true;
+}
 
-    uint8_t* new_top = new_space_start;
+void OldSpace::ReleasePage(uint8_t* start) {
+    DiscardVirtualMemory(start, kOldSpacePageSize);
+    empty_pages_.push_back(start);
+}
 
-    // 复制所有对象到新内存，并设置转发地址
-    uint8_t* current = space_start_;
-    while (current < top_) {
-        GCObject* old_obj = reinterpret_cast<GCObject*>(current);
-        size_t obj_size = old_obj->header()->size();
+void* OldSpace::AllocateFromFreeList(size_t* size) {
+    uint8_t size_class = OldSpaceSizeClass(*size);
+    GCObject* block = nullptr;
 
-        // 复制对象到新内存
-        GCObject* new_obj = reinterpret_cast<GCObject*>(new_top);
-        std::memcpy(new_top, current, obj_size);
+    auto& list = free_lists_[size_class];
+    if (*size <= kOldSpaceExactSizeLimit) {
+        // 精确类别中的空闲块大小都相同
+        if (!list.empty()) {
+            block = list.back();
+            list.pop_back();
+        }
+    }
+    else {
+        // 范围类别中的空闲块大小不同，只查找末尾的几个，避免长链表上的线性查找
+        constexpr size_t kMaxProbe = 8;
+        size_t probe = std::min(list.size(), kMaxProbe);
+        for (size_t i = 0; i < probe; ++i) {
+            auto it = list.end() - 1 - i;
+            if ((*it)->header()->size() >= *size) {
+                block = *it;
+                *it = list.back();
+                list.pop_back();
+                break;
+            }
+        }
+    }
+    if (list.empty()) {
+        free_list_mask_ &= ~(uint64_t(1) << size_class);
+    }
 
-        // 在旧对象中设置转发地址
-        old_obj->header()->SetForwardingAddress(new_obj);
+    if (!block) {
+        // 更大的类别中的任意空闲块都足够大
+        uint64_t larger = size_class + 1 < kOldSpaceSizeClassCount ? free_list_mask_ >> (size_class + 1) : 0;
+        if (larger == 0) {
+            return nullptr;
+        }
+        size_t larger_class = size_class + 1 + std::countr_zero(larger);
+        auto& larger_list = free_lists_[larger_class];
+        block = larger_list.back();
+        larger_list.pop_back();
+        if (larger_list.empty()) {
+            free_list_mask_ &= ~(uint64_t(1) << larger_class);
+        }
+    }
 
-        // 调用对象的移动回调
-        new_obj->GCMoved(old_obj);
+    size_t block_size = block->header()->size();
+    free_size_ -= block_size;
 
-        new_top += obj_size;
-        current += obj_size;
+    // 剩余部分足够构成空闲块时拆分，否则整块分配
+    size_t remaining = block_size - *size;
+    if (remaining >= kOldSpaceMinFreeBlockSize) {
+        AddFreeBlock(reinterpret_cast<uint8_t*>(block) + *size, remaining);
     }
+    else {
+        *size = block_size;
+    }
+    return block;
+}
 
-    // 保存旧内存地址（用于后续释放）
-    old_space_start_ = space_start_;
-    old_top_ = top_;
+void OldSpace::AddFreeBlock(uint8_t* start, size_t size) {
+    auto* block = new (start) GCFreeBlock();
+    block->header()->set_size(size);
+    block->header()->set_generation(GCGeneration::kOld);
+    block->header()->SetDestructed(true);
+
+    uint8_t size_class = OldSpaceSizeClass(size);
+    block->header()->set_size_class(size_class);
+    free_lists_[size_class].push_back(block);
+    free_list_mask_ |= uint64_t(1) << size_class;
+    free_size_ += size;
+}
 
-    // 更新指针和容量
-    space_start_ = new_space_start;
-    top_ = new_top;
-    capacity_ = new_capacity;
+void OldSpace::ResetFreeLists() {
+    for (auto& list : free_lists_) {
+        list.clear();
+    }
+    free_list_mask_ = 0;
+    free_size_ = 0;
+}
 
-    return true;
+void OldSpace::StartSweeping(size_t live_size) {
+    // 已有的空闲块会在清除时与相邻的死亡对象合并，重新放入空闲链表
+    ResetFreeLists();
+    sweep_page_ = 0;
+    sweep_page_count_ = pages_.size();
+    sweep_cursor_ = pages_.empty() ? nullptr : pages_.front().start();
+    sweep_top_ = pages_.empty() ? nullptr : pages_.back().top();
+    used_size_ = live_size;
 }
 
-void OldSpace::FinishExpand() {
-    if (old_space_start_) {
-        // 清除旧内存中的转发标记
-        uint8_t* current = old_space_start_;
-        while (current < old_top_) {
-            GCObject* obj = reinterpret_cast<GCObject*>(current);
-            obj->header()->SetForwardingAddress(nullptr);
-            current += obj->header()->size();
+bool OldSpace::Sweep(size_t max_size) {
+    size_t swept = 0;
+    while (sweeping() && swept < max_size) {
+        auto& page = pages_[sweep_page_];
+        // 开始清除时的当前页只清除到当时的top
+        uint8_t* end = sweep_page_ + 1 == sweep_page_count_ ? sweep_top_ : page.top();
+        if (sweep_cursor_ >= end) {
+            ++sweep_page_;
+            sweep_cursor_ = sweeping() ? pages_[sweep_page_].start() : nullptr;
+            continue;
+        }
+
+        GCObject* obj = reinterpret_cast<GCObject*>(sweep_cursor_);
+        if (obj->header()->IsMarked()) {
+            swept += obj->header()->size();
+            sweep_cursor_ += obj->header()->size();
+            continue;
+        }
+
+        // 合并页内连续的死亡对象和空闲块
+        uint8_t* start = sweep_cursor_;
+        while (sweep_cursor_ < end && swept < max_size) {
+            obj = reinterpret_cast<GCObject*>(sweep_cursor_);
+            if (obj->header()->IsMarked()) {
+                break;
+            }
+            // 在调用析构函数前先记录大小
+            size_t obj_size = obj->header()->size();
+            if (!obj->header()->IsDestructed()) {
+                obj->header()->SetDestructed(true);
+                obj->~GCObject();
+            }
+            swept += obj_size;
+            sweep_cursor_ += obj_size;
         }
 
-        // 释放旧内存
-        delete[] old_space_start_;
-        old_space_start_ = nullptr;
-        old_top_ = nullptr;
+        if (sweep_cursor_ == page.top() && sweep_page_ + 1 == pages_.size()) {
+            // 当前页末尾的空闲内存直接归还给顺序分配
+            page.set_top(start);
+            sweep_cursor_ = start;
+            sweep_top_ = start;
+        }
+        else if (sweep_cursor_ == page.top() && start == page.start()) {
+            // 整页都是死亡对象，归还给操作系统
+            ReleasePage(page.start());
+            pages_.erase(pages_.begin() + sweep_page_);
+            --sweep_page_count_;
+            sweep_cursor_ = sweeping() ? pages_[sweep_page_].start() : nullptr;
+        }
+        else {
+            AddFreeBlock(start, static_cast<size_t>(sweep_cursor_ - start));
+        }
+    }
+    return !sweeping();
+}
+
+bool OldSpace::Expand(size_t min_size) {
+    // 扩容只映射新的页，已有对象不移动
+    size_t page_count = std::max<size_t>((min_size + kOldSpacePageSize - 1) / kOldSpacePageSize, 1);
+    for (size_t i = 0; i < page_count; ++i) {
+        auto* start = static_cast<uint8_t*>(AllocateHeapMemory(kOldSpacePageSize));
+        if (!start) {
+            return false;
+        }
+        empty_pages_.push_back(start);
+    }
+    return true;
+}
+
+size_t OldSpace::area_size() const {
+    size_t size = 0;
+    for (auto& page : pages_) {
+        size += static_cast<size_t>(page.top() - page.start());
+    }
+    return size;
+}
+
+size_t OldSpace::available_size() const {
+    size_t size = empty_pages_.size() * kOldSpacePageSize;
+    if (!pages_.empty()) {
+        size += static_cast<size_t>(pages_.back().end() - pages_.back().top());
     }
+    return size;
 }
 
 void OldSpace::IterateObjects(ObjectCallback callback, void* data) {
-    uint8_t* current = space_start_;
-    while (current < top_) {
-        GCObject* obj = reinterpret_cast<GCObject*>(current);
-        callback(obj, data);
-        current += obj->header()->size();
+    for (auto& page : pages_) {
+        uint8_t* current = page.start();
+        while (current < page.top()) {
+            GCObject* obj = reinterpret_cast<GCObject*>(current);
+            callback(obj, data);
+            current += obj->header()->size();
+        }
     }
 }
 
 void OldSpace::IterateLiveObjects(ObjectCallback callback, void* data) {
-    uint8_t* current = space_start_;
-    while (current < top_) {
-        GCObject* obj = reinterpret_cast<GCObject*>(current);
-        if (obj->header()->IsMarked()) {
-            callback(obj, data);
+    for (auto& page : pages_) {
+        uint8_t* current = page.start();
+        while (current < page.top()) {
+            GCObject* obj = reinterpret_cast<GCObject*>(current);
+            if (obj->header()->IsMarked()) {
+                callback(obj, data);
+            }
+            current += obj->header()->size();
         }
-        current += obj->header()->size();
     }
 }
 
@@ -158,44 +314,75 @@ void OldSpace::UpdateReference(Value* value) {
 
     GCObject* new_obj = gc_obj->header()->GetForwardingAddress();
     if (new_obj != gc_obj) {
-        *value = Value(static_cast<Object*>(new_obj));
+        value->set_object(static_cast<Object*>(new_obj));
     }
 }
 
-uint8_t* OldSpace::ComputeCompactTop() {
-    uint8_t* new_top = space_start_;
-    uint8_t* current = space_start_;
+void OldSpace::ComputeForwardingAddresses() {
+    compact_tops_.clear();
+    if (pages_.empty()) {
+        return;
+    }
 
-    while (current < top_) {
-        GCObject* obj = reinterpret_cast<GCObject*>(current);
-        if (obj->header()->IsMarked()) {
-            new_top += obj->header()->size();
+    // 存活对象按页顺序紧凑排列，当前目标页放不下时换到下一页
+    // 目标位置不会超过对象原来的位置，因此之后可以按同样的顺序原地移动
+    size_t dest_page = 0;
+    uint8_t* dest = pages_[dest_page].start();
+    for (auto& page : pages_) {
+        uint8_t* current = page.start();
+        while (current < page.top()) {
+            GCObject* obj = reinterpret_cast<GCObject*>(current);
+            size_t size = obj->header()->size();
+            if (obj->header()->IsMarked()) {
+                if (size > static_cast<size_t>(pages_[dest_page].end() - dest)) {
+                    compact_tops_.push_back(dest);
+                    dest = pages_[++dest_page].start();
+                }
+                // 使用内联转发指针存储新地址
+                obj->header()->SetForwardingAddress(reinterpret_cast<GCObject*>(dest));
+                dest += size;
+            }
+            current += size;
         }
-        current += obj->header()->size();
     }
-
-    return new_top;
+    compact_tops_.push_back(dest);
 }
 
-void OldSpace::MoveObject(GCObject* obj, void* data) {
-    MoveObjectData* move_data = static_cast<MoveObjectData*>(data);
-    GCObject* new_addr = obj->header()->GetForwardingAddress();
-    if (new_addr != obj) {
-        size_t size = obj->header()->size();
-        std::memmove(new_addr, obj, size);
-
-        // 调用移动回调
-        new_addr->GCMoved(obj);
+void OldSpace::Compact() {
+    for (auto& page : pages_) {
+        uint8_t* current = page.start();
+        while (current < page.top()) {
+            GCObject* obj = reinterpret_cast<GCObject*>(current);
+            // 移动可能覆盖对象原来的头部，先记录大小
+            size_t size = obj->header()->size();
+            if (obj->header()->IsMarked()) {
+                GCObject* new_addr = obj->header()->GetForwardingAddress();
+                if (new_addr != obj) {
+                    std::memmove(new_addr, obj, size);
+                    // 调用移动回调
+                    new_addr->GCMoved(obj);
+                }
+                new_addr->header()->SetForwardingAddress(nullptr);
+            }
+            current += size;
+        }
     }
-}
 
-void OldSpace::ComputeForwardingAddr(GCObject* obj, void* data) {
-    CompactForwardData* fwd_data = static_cast<CompactForwardData*>(data);
-    if (obj->header()->IsMarked()) {
-        // 使用内联转发指针存储新地址
-        obj->header()->SetForwardingAddress(reinterpret_cast<GCObject*>(fwd_data->new_pos));
-        fwd_data->new_pos += obj->header()->size();
+    // 存活对象之后的页已经空出，归还给操作系统
+    while (pages_.size() > compact_tops_.size()) {
+        ReleasePage(pages_.back().start());
+        pages_.pop_back();
     }
+    used_size_ = 0;
+    for (size_t i = 0; i < pages_.size(); ++i) {
+        pages_[i].set_top(compact_tops_[i]);
+        used_size_ += static_cast<size_t>(compact_tops_[i] - pages_[i].start());
+    }
+    compact_tops_.clear();
+
+    ResetFreeLists();
+    sweep_page_ = sweep_page_count_ = 0;
+    sweep_cursor_ = sweep_top_ = nullptr;
 }
 
 } // namespace mjs
@@ -0,0 +1,412 @@
+/**
+ * @file parallel_scavenger.cpp
+ * @brief 并行Scavenge实现
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <mjs/gc/parallel_scavenger.h>
+
+#include <cstring>
+#include <new>
+
+#include <mjs/gc/gc_heap.h>
+#include <mjs/value/value.h>
+#include <mjs/value/object/object.h>
+
+namespace mjs {
+
+namespace {
+
+/**
+ * @brief 填充对象，占据线程本地分配缓冲区中未使用的空间
+ *
+ * 标记为已析构，Scavenge时不会被复制，也不会被调用析构函数。
+ */
+class GCFillerObject : public GCObject {};
+
+thread_local ParallelScavenger* t_scavenger = nullptr;
+thread_local void* t_worker = nullptr;
+
+} // namespace
+
+// ==================== GCWorkStealingDeque ====================
+
+void GCWorkStealingDeque::Push(GCObject* obj) {
+    std::lock_guard lock(mutex_);
+    items_.push_back(obj);
+    size_.store(items_.size(), std::memory_order_release);
+}
+
+bool GCWorkStealingDeque::Pop(GCObject** obj) {
+    if (empty()) {
+        return false;
+    }
+    std::lock_guard lock(mutex_);
+    if (items_.empty()) {
+        return false;
+    }
+    *obj = items_.back();
+    items_.pop_back();
+    size_.store(items_.size(), std::memory_order_release);
+    return true;
+}
+
+bool GCWorkStealingDeque::Steal(GCObject** obj) {
+    if (empty()) {
+        return false;
+    }
+    std::lock_guard lock(mutex_);
+    if (items_.empty()) {
+        return false;
+    }
+    *obj = items_.front();
+    items_.pop_front();
+    size_.store(items_.size(), std::memory_order_release);
+    return true;
+}
+
+// ==================== ParallelScavenger ====================
+
+ParallelScavenger::ParallelScavenger(GCHeap* heap)
+    : heap_(heap) {
+    set_thread_count(1);
+}
+
+ParallelScavenger::~ParallelScavenger() {
+    StopThreads();
+}
+
+void ParallelScavenger::set_thread_count(uint32_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = 1;
+    }
+    if (thread_count == thread_count_ && workers_.size() == thread_count) {
+        return;
+    }
+    StopThreads();
+    thread_count_ = thread_count;
+    workers_.clear();
+    for (uint32_t i = 0; i < thread_count_; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->id = i;
+        worker->scavenger = this;
+        workers_.push_back(std::move(worker));
+    }
+    StartThreads();
+}
+
+void ParallelScavenger::StartThreads() {
+    shutdown_ = false;
+    epoch_ = 0;
+    for (uint32_t i = 1; i < thread_count_; ++i) {
+        threads_.emplace_back(&ParallelScavenger::ThreadMain, this, workers_[i].get());
+    }
+}
+
+void ParallelScavenger::StopThreads() {
+    {
+        std::lock_guard lock(pool_mutex_);
+        shutdown_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+    threads_.clear();
+}
+
+void ParallelScavenger::ThreadMain(Worker* worker) {
+    uint64_t seen_epoch = 0;
+    while (true) {
+        {
+            std::unique_lock lock(pool_mutex_);
+            start_cv_.wait(lock, [&]() { return shutdown_ || epoch_ != seen_epoch; });
+            if (shutdown_) {
+                return;
+            }
+            seen_epoch = epoch_;
+        }
+
+        Run(worker);
+
+        {
+            std::lock_guard lock(pool_mutex_);
+            if (--running_ == 0) {
+                done_cv_.notify_one();
+            }
+        }
+    }
+}
+
+size_t ParallelScavenger::Scavenge(std::vector<GCObject*>* remembered) {
+    remembered_ = remembered;
+    next_remembered_.store(0, std::memory_order_relaxed);
+    idle_workers_.store(0, std::memory_order_relaxed);
+    for (auto& worker : workers_) {
+        worker->promoted_bytes = 0;
+        worker->remembered.clear();
+        worker->promoted.clear();
+    }
+
+    {
+        std::lock_guard lock(pool_mutex_);
+        running_ = thread_count_ - 1;
+        ++epoch_;
+    }
+    start_cv_.notify_all();
+
+    Run(workers_[0].get());
+
+    {
+        std::unique_lock lock(pool_mutex_);
+        done_cv_.wait(lock, [&]() { return running_ == 0; });
+    }
+
+    // 合并各线程的结果
+    size_t promoted_bytes = 0;
+    for (auto& worker : workers_) {
+        promoted_bytes += worker->promoted_bytes;
+        heap_->remembered_set_.insert(heap_->remembered_set_.end(), worker->remembered.begin(), worker->remembered.end());
+        heap_->promoted_objects_.insert(heap_->promoted_objects_.end(), worker->promoted.begin(), worker->promoted.end());
+    }
+    remembered_ = nullptr;
+    return promoted_bytes;
+}
+
+void ParallelScavenger::Run(Worker* worker) {
+    t_scavenger = this;
+    t_worker = worker;
+
+    // 根集合通常很小，由调用线程处理，复制出的对象会被其他线程窃取
+    if (worker->id == 0) {
+        heap_->IterateRoots([](Value* root, void* data) {
+            auto* worker = static_cast<Worker*>(data);
+            worker->scavenger->ProcessSlot(worker, root);
+        }, worker);
+    }
+
+    // 记忆集可能很大，所有线程按块领取
+    auto& remembered = *remembered_;
+    while (true) {
+        size_t begin = next_remembered_.fetch_add(kScavengeRememberedChunk, std::memory_order_relaxed);
+        if (begin >= remembered.size()) {
+            break;
+        }
+        size_t end = std::min(begin + kScavengeRememberedChunk, remembered.size());
+        for (size_t i = begin; i < end; ++i) {
+            remembered[i]->header()->SetRemembered(false);
+            ScanObject(worker, remembered[i]);
+        }
+    }
+
+    // 扫描队列中的对象，自己的队列为空时窃取；所有线程都空闲时不会再产生新的对象，复制阶段结束
+    while (true) {
+        GCObject* obj;
+        if (worker->deque.Pop(&obj) || StealWork(worker, &obj)) {
+            ScanObject(worker, obj);
+            continue;
+        }
+
+        idle_workers_.fetch_add(1, std::memory_order_acq_rel);
+        bool finished = false;
+        while (true) {
+            if (idle_workers_.load(std::memory_order_acquire) == thread_count_) {
+                finished = true;
+                break;
+            }
+            if (HasWork()) {
+                idle_workers_.fetch_sub(1, std::memory_order_acq_rel);
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (finished) {
+            break;
+        }
+    }
+
+    RetireLab(worker);
+    t_scavenger = nullptr;
+    t_worker = nullptr;
+}
+
+void ParallelScavenger::SlotCallback(Context* context, Value* child) {
+    t_scavenger->ProcessSlot(static_cast<Worker*>(t_worker), child);
+}
+
+void ParallelScavenger::ScanObject(Worker* worker, GCObject* obj) {
+    worker->found_young = false;
+    obj->GCTraverse(heap_->context_, SlotCallback);
+    // 对象只会被一个线程扫描，直接设置记忆集标记
+    if (worker->found_young && obj->header()->generation() == GCGeneration::kOld) {
+        obj->header()->SetRemembered(true);
+        worker->remembered.push_back(obj);
+    }
+}
+
+void ParallelScavenger::ProcessSlot(Worker* worker, Value* value) {
+    if (!value || !value->IsObject()) {
+        return;
+    }
+    GCObject* obj = static_cast<GCObject*>(&value->object());
+
+    // 同一个引用可能被多次访问（如共享的闭包变量），已经更新为To区中的新地址时无需处理
+    if (heap_->new_space_->InToSpace(obj)) {
+        worker->found_young = true;
+        return;
+    }
+    if (obj->header()->generation() != GCGeneration::kNew) {
+        return;
+    }
+
+    GCObject* new_obj = Evacuate(worker, obj);
+    if (!new_obj) {
+        worker->found_young = true;
+        return;
+    }
+    value->set_object(static_cast<Object*>(new_obj));
+    if (new_obj->header()->generation() == GCGeneration::kNew) {
+        worker->found_young = true;
+    }
+}
+
+GCObject* ParallelScavenger::Evacuate(Worker* worker, GCObject* obj) {
+    auto* header = obj->header();
+    while (true) {
+        GCObject* forwarding = header->LoadForwardingAddress();
+        if (forwarding == GCObjectHeader::ForwardingBusy()) {
+            // 其他线程正在复制，等待其发布新地址
+            std::this_thread::yield();
+            continue;
+        }
+        if (forwarding) {
+            return forwarding;
+        }
+        if (!header->TryClaimForwarding()) {
+            continue;
+        }
+
+        GCObject* new_obj = nullptr;
+        if (header->age() < kTenureAgeThreshold) {
+            new_obj = CopyToSurvivor(worker, obj);
+        }
+        if (!new_obj) {
+            new_obj = PromoteToOld(worker, obj);
+        }
+        header->PublishForwardingAddress(new_obj);
+        if (new_obj) {
+            worker->deque.Push(new_obj);
+        }
+        return new_obj;
+    }
+}
+
+GCObject* ParallelScavenger::CopyToSurvivor(Worker* worker, GCObject* obj) {
+    size_t size = obj->header()->size();
+    void* mem;
+    if (size > kScavengeLabSize / 2) {
+        std::lock_guard lock(to_space_mutex_);
+        mem = heap_->new_space_->AllocateInToSpace(&size);
+    }
+    else {
+        mem = AllocateInLab(worker, size);
+    }
+    if (!mem) {
+        return nullptr;
+    }
+
+    std::memcpy(mem, obj, size);
+    GCObject* new_obj = reinterpret_cast<GCObject*>(mem);
+    new_obj->header()->IncrementAge();
+    new_obj->header()->SetDestructed(false);
+    // 复制时源对象的转发地址是复制中占位值
+    new_obj->header()->SetForwardingAddress(nullptr);
+    return new_obj;
+}
+
+GCObject* ParallelScavenger::PromoteToOld(Worker* worker, GCObject* obj) {
+    size_t size = obj->header()->size();
+    size_t allocated_size = size;
+    void* mem;
+    {
+        std::lock_guard lock(old_space_mutex_);
+        mem = heap_->old_space_->Allocate(&allocated_size);
+        if (!mem && heap_->old_space_->Expand(allocated_size)) {
+            mem = heap_->old_space_->Allocate(&allocated_size);
+        }
+    }
+    if (!mem) {
+        return nullptr;
+    }
+
+    // 从空闲块中分配时实际大小可能更大
+    std::memcpy(mem, obj, size);
+    GCObject* new_obj = reinterpret_cast<GCObject*>(mem);
+    new_obj->header()->set_size(allocated_size);
+    size = allocated_size;
+    new_obj->header()->set_generation(GCGeneration::kOld);
+    new_obj->header()->ClearAge();
+    new_obj->header()->SetDestructed(false);
+    new_obj->header()->SetForwardingAddress(nullptr);
+    heap_->MarkAllocatedObject(new_obj);
+    worker->promoted.push_back(new_obj);
+    worker->promoted_bytes += size;
+    return new_obj;
+}
+
+void* ParallelScavenger::AllocateInLab(Worker* worker, size_t size) {
+    size = AlignGCObjectSize(size);
+    // 保证缓冲区剩余空间为0或者足以放下填充对象
+    size_t remaining = static_cast<size_t>(worker->lab_end - worker->lab_top);
+    if (size != remaining && size + sizeof(GCFillerObject) > remaining) {
+        RetireLab(worker);
+
+        std::lock_guard lock(to_space_mutex_);
+        size_t lab_size = kScavengeLabSize;
+        auto* lab = static_cast<uint8_t*>(heap_->new_space_->AllocateInToSpace(&lab_size));
+        if (!lab) {
+            // To区剩余不足一个缓冲区，只分配这一个对象
+            return heap_->new_space_->AllocateInToSpace(&size);
+        }
+        worker->lab_top = lab;
+        worker->lab_end = lab + lab_size;
+    }
+
+    void* result = worker->lab_top;
+    worker->lab_top += size;
+    return result;
+}
+
+void ParallelScavenger::RetireLab(Worker* worker) {
+    size_t remaining = static_cast<size_t>(worker->lab_end - worker->lab_top);
+    if (remaining > 0) {
+        auto* filler = new (worker->lab_top) GCFillerObject();
+        filler->header()->set_size(remaining);
+        filler->header()->SetDestructed(true);
+    }
+    worker->lab_top = nullptr;
+    worker->lab_end = nullptr;
+}
+
+bool ParallelScavenger::StealWork(Worker* worker, GCObject** obj) {
+    for (uint32_t i = 1; i < thread_count_; ++i) {
+        auto& victim = workers_[(worker->id + i) % thread_count_];
+        if (victim->deque.Steal(obj)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParallelScavenger::HasWork() const {
+    for (auto& worker : workers_) {
+        if (!worker->deque.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace mjs
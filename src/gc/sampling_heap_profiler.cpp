@@ -0,0 +1,165 @@
+#include <mjs/gc/sampling_heap_profiler.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <mjs/context.h>
+#include <mjs/stack_frame.h>
+#include <mjs/gc/gc_object.h>
+#include <mjs/gc/heap_snapshot.h>
+#include <mjs/value/function_def.h>
+#include <mjs/value/module_def.h>
+
+namespace mjs {
+
+SamplingHeapProfiler::SamplingHeapProfiler(Context* context, uint64_t sample_interval, uint32_t stack_depth, uint64_t seed)
+    : context_(context)
+    , sample_interval_(std::max<uint64_t>(sample_interval, 1))
+    , stack_depth_(stack_depth)
+    , random_(seed)
+    , distribution_(1.0 / static_cast<double>(sample_interval_))
+{
+    root_.id = next_node_id_++;
+    root_.function_name = "(root)";
+    bytes_until_sample_ = NextSampleInterval();
+}
+
+void SamplingHeapProfiler::UpdateAfterScavenge() {
+    size_t live = 0;
+    for (auto& sample : samples_) {
+        auto* header = sample.object->header();
+        if (header->generation() == GCGeneration::kNew) {
+            if (!header->IsForwarded()) {
+                continue;
+            }
+            sample.object = header->GetForwardingAddress();
+        }
+        samples_[live++] = sample;
+    }
+    samples_.resize(live);
+}
+
+void SamplingHeapProfiler::UpdateAfterMark() {
+    size_t live = 0;
+    for (auto& sample : samples_) {
+        auto* header = sample.object->header();
+        if (header->generation() == GCGeneration::kOld) {
+            if (!header->IsMarked()) {
+                continue;
+            }
+            if (header->IsForwarded()) {
+                sample.object = header->GetForwardingAddress();
+            }
+        }
+        samples_[live++] = sample;
+    }
+    samples_.resize(live);
+}
+
+uint64_t SamplingHeapProfiler::ScaledSize(size_t size) const {
+    double probability = 1.0 - std::exp(-static_cast<double>(size) / static_cast<double>(sample_interval_));
+    if (probability <= 0) {
+        return size;
+    }
+    return static_cast<uint64_t>(static_cast<double>(size) / probability + 0.5);
+}
+
+bool SamplingHeapProfiler::WriteHeapProfile(std::ostream& out) const {
+    std::vector<uint64_t> self_sizes(next_node_id_, 0);
+    for (auto& sample : samples_) {
+        self_sizes[sample.node->id] += ScaledSize(sample.size);
+    }
+
+    out << "{\"head\":";
+    WriteNode(out, root_, self_sizes);
+    out << ",\"samples\":[";
+    for (size_t i = 0; i < samples_.size(); ++i) {
+        auto& sample = samples_[i];
+        if (i != 0) {
+            out << ",";
+        }
+        out << "{\"size\":" << ScaledSize(sample.size)
+            << ",\"nodeId\":" << sample.node->id
+            << ",\"ordinal\":" << sample.ordinal << "}";
+    }
+    out << "]}\n";
+    return out.good();
+}
+
+void SamplingHeapProfiler::Sample(GCObject* obj, size_t size) {
+    // 一次分配最多采样一次，跨越多个采样间隔的大对象由 ScaledSize 按概率放大
+    bytes_until_sample_ = NextSampleInterval();
+    samples_.push_back({ obj, size, CaptureStack(), next_ordinal_++ });
+}
+
+int64_t SamplingHeapProfiler::NextSampleInterval() {
+    double next = distribution_(random_);
+    return static_cast<int64_t>(std::clamp(next, 1.0, static_cast<double>(INT64_MAX / 2)));
+}
+
+SamplingHeapProfileNode* SamplingHeapProfiler::CaptureStack() {
+    // 从当前栈帧向上遍历，宿主和原生函数的栈帧没有函数定义，跳过
+    stack_buffer_.clear();
+    for (const StackFrame* frame = context_->vm().current_stack_frame();
+        frame && stack_buffer_.size() < stack_depth_;
+        frame = frame->upper_stack_frame()) {
+        const FunctionDefBase* function_def = frame->function_def();
+        if (!function_def) {
+            continue;
+        }
+        SourceLine line = kSourceLineInvalid;
+        if (auto* entry = function_def->debug_table().FindEntry(frame->pc())) {
+            line = entry->source_line;
+        }
+        stack_buffer_.emplace_back(function_def, line);
+    }
+
+    // 调用树从最外层的调用者开始
+    SamplingHeapProfileNode* node = &root_;
+    for (auto iter = stack_buffer_.rbegin(); iter != stack_buffer_.rend(); ++iter) {
+        node = FindOrAddChild(node, iter->first, iter->second);
+    }
+    return node;
+}
+
+SamplingHeapProfileNode* SamplingHeapProfiler::FindOrAddChild(SamplingHeapProfileNode* parent,
+    const FunctionDefBase* function_def, SourceLine line)
+{
+    for (auto& child : parent->children) {
+        if (child->function_def == function_def && child->line == line) {
+            return child.get();
+        }
+    }
+    auto child = std::make_unique<SamplingHeapProfileNode>();
+    child->id = next_node_id_++;
+    child->function_def = function_def;
+    child->line = line;
+    child->function_name = function_def->name();
+    child->url = function_def->module_def().name();
+    parent->children.push_back(std::move(child));
+    return parent->children.back().get();
+}
+
+void SamplingHeapProfiler::WriteNode(std::ostream& out, const SamplingHeapProfileNode& node,
+    const std::vector<uint64_t>& self_sizes) const
+{
+    // .heapprofile 的行号从0开始，未知为-1
+    int64_t line = node.line == kSourceLineInvalid ? -1 : static_cast<int64_t>(node.line) - 1;
+    out << "{\"callFrame\":{\"functionName\":";
+    WriteJsonString(out, node.function_name);
+    out << ",\"scriptId\":\"0\",\"url\":";
+    WriteJsonString(out, node.url);
+    out << ",\"lineNumber\":" << line << ",\"columnNumber\":-1}"
+        << ",\"selfSize\":" << self_sizes[node.id]
+        << ",\"id\":" << node.id
+        << ",\"children\":[";
+    for (size_t i = 0; i < node.children.size(); ++i) {
+        if (i != 0) {
+            out << ",";
+        }
+        WriteNode(out, *node.children[i], self_sizes);
+    }
+    out << "]}";
+}
+
+} // namespace mjs
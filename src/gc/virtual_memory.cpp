@@ -0,0 +1,85 @@
+/**
+ * @file virtual_memory.cpp
+ * @brief 虚拟内存分配实现
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <mjs/gc/virtual_memory.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace mjs {
+
+size_t VirtualMemoryPageSize() {
+    static const size_t page_size = []() -> size_t {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+#else
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }();
+    return page_size;
+}
+
+void* AllocateVirtualMemory(size_t size) {
+#ifdef _WIN32
+    return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return address == MAP_FAILED ? nullptr : address;
+#endif
+}
+
+void FreeVirtualMemory(void* address, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    VirtualFree(address, 0, MEM_RELEASE);
+#else
+    munmap(address, size);
+#endif
+}
+
+void* ReserveVirtualMemory(size_t size) {
+#ifdef _WIN32
+    return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    void* address = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return address == MAP_FAILED ? nullptr : address;
+#endif
+}
+
+bool CommitVirtualMemory(void* address, size_t size) {
+#ifdef _WIN32
+    return VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+    return mprotect(address, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+void DecommitVirtualMemory(void* address, size_t size) {
+#ifdef _WIN32
+    VirtualFree(address, size, MEM_DECOMMIT);
+#else
+    madvise(address, size, MADV_DONTNEED);
+    mprotect(address, size, PROT_NONE);
+#endif
+}
+
+void DiscardVirtualMemory(void* address, size_t size) {
+#ifdef _WIN32
+    VirtualAlloc(address, size, MEM_RESET, PAGE_READWRITE);
+#else
+    madvise(address, size, MADV_DONTNEED);
+#endif
+}
+
+} // namespace mjs
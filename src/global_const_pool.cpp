@@ -30,7 +30,7 @@ void GlobalConstPool::Initialize() {
 	assert(index == ConstIndexEmbedded::kSplit);
 	index = FindOrInsert(Value("substring"));
 	assert(index == ConstIndexEmbedded::kSubString);
-	index = FindOrInsert(Value("indexoOf"));
+	index = FindOrInsert(Value("indexOf"));
 	assert(index == ConstIndexEmbedded::kIndexOf);
 	index = FindOrInsert(Value("toLowerCase"));
 	assert(index == ConstIndexEmbedded::kToLowerCase);
@@ -68,6 +68,42 @@ void GlobalConstPool::Initialize() {
 	assert(index == ConstIndexEmbedded::kFilter);
 	index = FindOrInsert(Value("reduce"));
 	assert(index == ConstIndexEmbedded::kReduce);
+	index = FindOrInsert(Value("sort"));
+	assert(index == ConstIndexEmbedded::kSort);
+	index = FindOrInsert(Value("toSorted"));
+	assert(index == ConstIndexEmbedded::kToSorted);
+	index = FindOrInsert(Value("join"));
+	assert(index == ConstIndexEmbedded::kJoin);
+	index = FindOrInsert(Value("slice"));
+	assert(index == ConstIndexEmbedded::kSlice);
+	index = FindOrInsert(Value("concat"));
+	assert(index == ConstIndexEmbedded::kConcat);
+	index = FindOrInsert(Value("splice"));
+	assert(index == ConstIndexEmbedded::kSplice);
+	index = FindOrInsert(Value("includes"));
+	assert(index == ConstIndexEmbedded::kIncludes);
+	index = FindOrInsert(Value("fill"));
+	assert(index == ConstIndexEmbedded::kFill);
+
+	index = FindOrInsert(Value("byteLength"));
+	assert(index == ConstIndexEmbedded::kByteLength);
+	index = FindOrInsert(Value("byteOffset"));
+	assert(index == ConstIndexEmbedded::kByteOffset);
+	index = FindOrInsert(Value("buffer"));
+	assert(index == ConstIndexEmbedded::kBuffer);
+
+	index = FindOrInsert(Value("getUint8"));
+	assert(index == ConstIndexEmbedded::kGetUint8);
+	index = FindOrInsert(Value("setUint8"));
+	assert(index == ConstIndexEmbedded::kSetUint8);
+	index = FindOrInsert(Value("getInt32"));
+	assert(index == ConstIndexEmbedded::kGetInt32);
+	index = FindOrInsert(Value("setInt32"));
+	assert(index == ConstIndexEmbedded::kSetInt32);
+	index = FindOrInsert(Value("getFloat64"));
+	assert(index == ConstIndexEmbedded::kGetFloat64);
+	index = FindOrInsert(Value("setFloat64"));
+	assert(index == ConstIndexEmbedded::kSetFloat64);
 
 	assert(size() == ConstIndexEmbedded::kEnd);
 }
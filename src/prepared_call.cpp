@@ -0,0 +1,38 @@
+#include <mjs/prepared_call.h>
+
+#include <mjs/context.h>
+#include <mjs/runtime.h>
+#include <mjs/vm.h>
+#include <mjs/value/function_def.h>
+
+namespace mjs {
+
+PreparedCall::PreparedCall(Context* context, const Value& func_val, Value this_val)
+	: context_(context)
+	, func_val_(func_val)
+	, this_val_(std::move(this_val))
+	, stack_frame_(&context->runtime().stack())
+{
+	if (!func_val_.IsFunctionDef() && !func_val_.IsFunctionObject()) {
+		return;
+	}
+	auto& function_def = func_val_.ToFunctionDefBase();
+	if (function_def.is_generator() || function_def.is_async()) {
+		return;
+	}
+	param_count_ = function_def.param_count();
+	prepared_ = true;
+}
+
+Value PreparedCall::Invoke() {
+	// 上一次调用返回时栈已还原到栈底，只需要重置执行位置
+	stack_frame_.set_pc(0);
+	context_->vm().CallInternal(&stack_frame_, func_val_, this_val_, param_count_);
+	return stack_frame_.pop();
+}
+
+Value PreparedCall::CallSlow(Value* argv, size_t argc) {
+	return context_->CallFunction(&func_val_, this_val_, argv, argv + argc);
+}
+
+} // namespace mjs
@@ -1,18 +1,26 @@
 #include <mjs/shape/shape_manager.h>
 
 #include <mjs/context.h>
+#include <mjs/const_index_embedded.h>
 #include <mjs/class_def/object_class_def.h>
 
 namespace mjs {
 
 ShapeManager::ShapeManager(Context* context)
     : context_(context)
+    , id_(next_id_.fetch_add(1, std::memory_order_relaxed))
 {
     empty_shape_ = new Shape(this);
     empty_shape_->Reference();
 }
 
 ShapeManager::~ShapeManager() {
+    for (auto& [id, shape] : boilerplate_shapes_) {
+        shape->Dereference();
+    }
+    if (prototype_shape_) {
+        prototype_shape_->Dereference();
+    }
     empty_shape_->Dereference();
 }
 
@@ -61,4 +69,31 @@ PropertySlotIndex ShapeManager::AddProperty(Shape** base_shape_ptr, ShapePropert
     return new_shape->property_size() - 1;
 }
 
+Shape* ShapeManager::CreateBoilerplateShape(const ObjectBoilerplate& boilerplate) {
+    // 其他 Context 也可能执行同一函数定义，此时样板内的缓存属于其他 ShapeManager
+    auto iter = boilerplate_shapes_.find(boilerplate.id());
+    if (iter != boilerplate_shapes_.end()) {
+        boilerplate.UpdateCachedShape(id_, iter->second);
+        return iter->second;
+    }
+
+    Shape* shape = empty_shape_;
+    shape->Reference();
+    for (auto key : boilerplate.keys()) {
+        AddProperty(&shape, ShapeProperty(key));
+    }
+    assert(shape->property_size() == boilerplate.property_count());
+
+    boilerplate_shapes_.emplace(boilerplate.id(), shape);
+    boilerplate.UpdateCachedShape(id_, shape);
+    return shape;
+}
+
+Shape* ShapeManager::CreatePrototypeShape() {
+    Shape* shape = empty_shape_;
+    shape->Reference();
+    AddProperty(&shape, ShapeProperty(ConstIndexEmbedded::kProto));
+    return shape;
+}
+
 } // namespace mjs
\ No newline at end of file
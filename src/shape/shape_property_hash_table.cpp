@@ -1,109 +1,74 @@
 #include <cassert>
 #include <cstring>
+#include <bit>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MJS_SHAPE_LOOKUP_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define MJS_SHAPE_LOOKUP_NEON
+#include <arm_neon.h>
+#endif
 
 #include <mjs/shape/shape_property_hash_table.h>
 #include <mjs/context.h>
 
 namespace mjs {
 
+static_assert(sizeof(ShapeProperty) == sizeof(ConstIndex), "ShapeProperty must be a packed ConstIndex for SIMD key scan.");
+
 ShapePropertyHashTable::~ShapePropertyHashTable() {
     if (properties_) {
         delete[] properties_;
     }
-    if (slot_indices_) {
-        delete[] slot_indices_;
+    if (hash_entries_) {
+        delete[] hash_entries_;
     }
 }
 
 const PropertySlotIndex ShapePropertyHashTable::Find(ConstIndex const_index, uint32_t property_size) const {
-    if (property_size_ <= kPropertiesMaxSize) {
-        // 当属性数量较少时，线性查找更优
-        for (uint32_t i = 0; i < property_size; i++) {
-            if (properties_[i].const_index() == const_index) {
-                return i;
-            }
-        }
-        return kPropertySlotIndexInvalid;
+    assert(property_size <= property_size_);
+    if (property_size <= kPropertiesMaxSize) {
+        // 当属性数量较少时，扫描紧凑的键数组更优
+        return FindInKeys(const_index, property_size);
     }
     else {
-        // 使用哈希表查找，带线性探测
-        uint32_t index = std::hash<int32_t>()(const_index) & hash_mask_;
-        uint32_t original_index = index;
-
-        do {
-            int32_t slot_index = slot_indices_[index];
-
-            if (slot_index == kPropertySlotIndexInvalid) {
-                // 找到空槽位，说明元素不存在
-                return kPropertySlotIndexInvalid;
-            }
-
-            const auto& prop = properties_[slot_index];
-            if (prop.const_index() == const_index) {
-                if (slot_index >= property_size) {
-                    return kPropertySlotIndexInvalid;
-                }
-                return slot_index;
-            }
-
-            // 线性探测下一个位置
-            index = (index + 1) & hash_mask_;
-        } while (index != original_index); // 避免无限循环
-
-        return kPropertySlotIndexInvalid;
+        return FindInHashTable(const_index, property_size);
     }
 }
 
 void ShapePropertyHashTable::Add(ShapeProperty&& prop) {
     auto index = property_size_++;
     if (index >= property_capacity_) {
-        if (property_capacity_ < 4) {
-            property_capacity_ = 4;
+        if (property_capacity_ < kKeyBlockSize) {
+            property_capacity_ = kKeyBlockSize;
         }
         else {
             property_capacity_ = property_size_ * 1.5;
         }
-        assert(property_capacity_ > property_size_);
+        // 容量按块对齐，SIMD 扫描时整块读取不会越界
+        property_capacity_ = (property_capacity_ + kKeyBlockSize - 1) & ~(kKeyBlockSize - 1);
+        assert(property_capacity_ > index);
+
         auto* old_properties = properties_;
         properties_ = new ShapeProperty[property_capacity_];
-        std::memcpy(properties_, old_properties, sizeof(*properties_) * (property_size_ - 1));
+        // 填充无效键，避免扫描尾部块时读取未初始化的内存
+        std::fill_n(properties_, property_capacity_, ShapeProperty(kConstIndexInvalid));
+        if (old_properties) {
+            std::memcpy(properties_, old_properties, sizeof(*properties_) * index);
+            delete[] old_properties;
+        }
     }
     properties_[index] = std::move(prop);
 
     if (property_size_ > kPropertiesMaxSize) {
-        if (hash_capacity_ == 0) {
-            auto hash_capacity = GetPower2(property_size_);
-            auto loading_factor = CalcLoadingFactor();
-            if (loading_factor >= kLoadingFactor) {
-                hash_capacity *= 2;
-            }
-            // 提升为哈希表
-            Rehash(hash_capacity);
-            return;
-        }
-
-        // 检查是否需要rehash
-        auto loading_factor = CalcLoadingFactor();
-        if (loading_factor >= kLoadingFactor) {
-            Rehash(hash_capacity_ * 2);
+        if (property_size_ * kHashCapacityFactor > hash_capacity_) {
+            // 首次提升为哈希表或需要扩容
+            Rehash(std::bit_ceil(property_size_ * kHashCapacityFactor));
             return;
         }
-
-        // 使用线性探测法插入
-        uint32_t hash_index = std::hash<int32_t>()(prop.const_index()) & hash_mask_;
-
-        while (slot_indices_[hash_index] != kPropertySlotIndexInvalid) {
-            // 如果已经存在相同的key，直接更新
-            if (properties_[slot_indices_[hash_index]].const_index() == prop.const_index()) {
-                slot_indices_[hash_index] = index;
-                return;
-            }
-            // 否则继续探测下一个位置
-            hash_index = (hash_index + 1) & hash_mask_;
-        }
-
-        // 找到空槽位，插入
-        slot_indices_[hash_index] = index;
+        InsertToHashTable(properties_[index].const_index(), index);
     }
 }
 
@@ -117,52 +82,95 @@ void ShapePropertyHashTable::DereferenceConstValue(Context* context) {
     }
 }
 
-uint32_t ShapePropertyHashTable::GetPower2(uint32_t n) {
-    if (n <= 1) {
-        return 1;
+PropertySlotIndex ShapePropertyHashTable::FindInKeys(ConstIndex const_index, uint32_t property_size) const {
+    // 表内键不重复，第一个命中即为唯一命中，超出当前 shape 范围则视为不存在
+    const auto* keys = reinterpret_cast<const ConstIndex*>(properties_);
+#if defined(MJS_SHAPE_LOOKUP_SSE2)
+    const __m128i needle = _mm_set1_epi32(const_index);
+    for (uint32_t i = 0; i < property_size; i += kKeyBlockSize) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        auto mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, needle))));
+        if (mask) {
+            auto index = i + std::countr_zero(mask);
+            return index < property_size ? static_cast<PropertySlotIndex>(index) : kPropertySlotIndexInvalid;
+        }
     }
-    uint32_t p = 1;
-    while (p < n) {
-        p <<= 1;
+    return kPropertySlotIndexInvalid;
+#elif defined(MJS_SHAPE_LOOKUP_NEON)
+    const int32x4_t needle = vdupq_n_s32(const_index);
+    for (uint32_t i = 0; i < property_size; i += kKeyBlockSize) {
+        uint32x4_t eq = vceqq_s32(vld1q_s32(keys + i), needle);
+        if (vmaxvq_u32(eq)) {
+            for (uint32_t j = i; j < i + kKeyBlockSize; ++j) {
+                if (keys[j] == const_index) {
+                    return j < property_size ? static_cast<PropertySlotIndex>(j) : kPropertySlotIndexInvalid;
+                }
+            }
+        }
+    }
+    return kPropertySlotIndexInvalid;
+#else
+    for (uint32_t i = 0; i < property_size; i++) {
+        if (keys[i] == const_index) {
+            return i;
+        }
+    }
+    return kPropertySlotIndexInvalid;
+#endif
+}
+
+PropertySlotIndex ShapePropertyHashTable::FindInHashTable(ConstIndex const_index, uint32_t property_size) const {
+    assert(hash_entries_);
+    // 负载因子不超过 0.5，必然存在空槽，探测一定会终止
+    uint32_t index = HashIndex(const_index);
+    while (true) {
+        const auto& entry = hash_entries_[index];
+        if (entry.slot_index == kPropertySlotIndexInvalid) {
+            // 找到空槽位，说明元素不存在
+            return kPropertySlotIndexInvalid;
+        }
+        if (entry.key == const_index) {
+            if (static_cast<uint32_t>(entry.slot_index) >= property_size) {
+                return kPropertySlotIndexInvalid;
+            }
+            return entry.slot_index;
+        }
+        // 线性探测下一个位置
+        index = (index + 1) & hash_mask_;
     }
-    return p;
 }
 
-double ShapePropertyHashTable::CalcLoadingFactor() const {
-    return static_cast<double>(property_size_) / hash_capacity_;
+uint32_t ShapePropertyHashTable::HashIndex(ConstIndex const_index) const {
+    // Fibonacci 散列，取高位，常量索引通常连续分配，直接取低位容易聚集
+    return (static_cast<uint32_t>(const_index) * 2654435769u) >> hash_shift_;
+}
+
+void ShapePropertyHashTable::InsertToHashTable(ConstIndex const_index, PropertySlotIndex slot_index) {
+    uint32_t index = HashIndex(const_index);
+    while (hash_entries_[index].slot_index != kPropertySlotIndexInvalid) {
+        assert(hash_entries_[index].key != const_index);
+        index = (index + 1) & hash_mask_;
+    }
+    hash_entries_[index] = HashEntry{ .key = const_index, .slot_index = slot_index };
 }
 
 void ShapePropertyHashTable::Rehash(uint32_t new_capacity) {
-    // 保存旧的数据
-    int32_t* old_indices = slot_indices_;
+    assert(std::has_single_bit(new_capacity) && new_capacity > 1);
+
+    if (hash_entries_) {
+        delete[] hash_entries_;
+    }
 
-    // 分配新的空间
     hash_capacity_ = new_capacity;
     hash_mask_ = hash_capacity_ - 1;
-    slot_indices_ = new int32_t[hash_capacity_];
-
-    // 初始化新的slot_indices_数组
-    for (uint32_t i = 0; i < hash_capacity_; i++) {
-        slot_indices_[i] = kPropertySlotIndexInvalid;
-    }
+    hash_shift_ = 32 - std::countr_zero(hash_capacity_);
+    hash_entries_ = new HashEntry[hash_capacity_];
+    std::fill_n(hash_entries_, hash_capacity_, HashEntry{ .key = kConstIndexInvalid, .slot_index = kPropertySlotIndexInvalid });
 
     // 重新插入所有元素
     for (uint32_t i = 0; i < property_size_; i++) {
-        const auto& prop = properties_[i];
-        uint32_t hash_index = std::hash<int32_t>()(prop.const_index()) & hash_mask_;
-
-        // 使用线性探测找到新的位置
-        while (slot_indices_[hash_index] != kPropertySlotIndexInvalid) {
-            hash_index = (hash_index + 1) & hash_mask_;
-        }
-
-        slot_indices_[hash_index] = i;
-    }
-
-    // 删除旧的数据
-    if (old_indices) {
-        delete[] old_indices;
+        InsertToHashTable(properties_[i].const_index(), i);
     }
 }
 
-} // namespace mjs
\ No newline at end of file
+} // namespace mjs
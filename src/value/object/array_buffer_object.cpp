@@ -0,0 +1,49 @@
+#include <mjs/value/object/array_buffer_object.h>
+
+#include <mjs/context.h>
+#include <mjs/const_index_embedded.h>
+
+namespace mjs {
+
+ArrayBufferObject::ArrayBufferObject(Context* context, size_t byte_length)
+	: Object(context, ClassId::kArrayBufferObject)
+	, context_(context)
+	, data_(byte_length ? new uint8_t[byte_length]() : nullptr)
+	, byte_length_(byte_length)
+	, release_(&FreeInternal)
+{
+	context->gc_manager().AdjustExternalMemory(static_cast<int64_t>(byte_length_));
+}
+
+ArrayBufferObject::ArrayBufferObject(Context* context, void* data, size_t byte_length, ExternalReleaseCallback release, void* opaque)
+	: Object(context, ClassId::kArrayBufferObject)
+	, context_(context)
+	, data_(static_cast<uint8_t*>(data))
+	, byte_length_(byte_length)
+	, release_(release)
+	, opaque_(opaque)
+	, external_(true)
+{
+	context->gc_manager().AdjustExternalMemory(static_cast<int64_t>(byte_length_));
+}
+
+ArrayBufferObject::~ArrayBufferObject() {
+	context_->gc_manager().AdjustExternalMemory(-static_cast<int64_t>(byte_length_));
+	if (release_) {
+		release_(data_, byte_length_, opaque_);
+	}
+}
+
+bool ArrayBufferObject::GetProperty(Context* context, ConstIndex key, Value* value) {
+	if (key == ConstIndexEmbedded::kByteLength) {
+		*value = Value(static_cast<int64_t>(byte_length_));
+		return true;
+	}
+	return Object::GetProperty(context, key, value);
+}
+
+void ArrayBufferObject::FreeInternal(void* data, size_t byte_length, void* opaque) {
+	delete[] static_cast<uint8_t*>(data);
+}
+
+} // namespace mjs
@@ -0,0 +1,571 @@
+#include <mjs/value/object/array_elements.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MJS_ARRAY_ELEMENTS_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define MJS_ARRAY_ELEMENTS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace mjs {
+
+namespace {
+
+// 在 [begin, end) 中查找第一个等于 needle 的 int64_t，找不到时返回 end
+uint32_t FindInt64(const int64_t* data, uint32_t begin, uint32_t end, int64_t needle) {
+    uint32_t i = begin;
+#if defined(MJS_ARRAY_ELEMENTS_SSE2)
+    // SSE2 没有 64 位相等比较：按 32 位比较后，高低两半都相等的 64 位通道才算相等
+    const __m128i target = _mm_set1_epi64x(needle);
+    for (; i + 4 <= end; i += 4) {
+        __m128i eq0 = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), target);
+        __m128i eq1 = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 2)), target);
+        eq0 = _mm_and_si128(eq0, _mm_shuffle_epi32(eq0, _MM_SHUFFLE(2, 3, 0, 1)));
+        eq1 = _mm_and_si128(eq1, _mm_shuffle_epi32(eq1, _MM_SHUFFLE(2, 3, 0, 1)));
+        auto mask = static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(eq0)) | (_mm_movemask_pd(_mm_castsi128_pd(eq1)) << 2));
+        if (mask) {
+            return i + std::countr_zero(mask);
+        }
+    }
+#elif defined(MJS_ARRAY_ELEMENTS_NEON)
+    const int64x2_t target = vdupq_n_s64(needle);
+    for (; i + 2 <= end; i += 2) {
+        uint64x2_t eq = vceqq_s64(vld1q_s64(data + i), target);
+        if (vgetq_lane_u64(eq, 0)) {
+            return i;
+        }
+        if (vgetq_lane_u64(eq, 1)) {
+            return i + 1;
+        }
+    }
+#endif
+    for (; i < end; ++i) {
+        if (data[i] == needle) {
+            return i;
+        }
+    }
+    return end;
+}
+
+// 在 [begin, end) 中查找第一个等于 needle 的 double（needle 不能是 NaN），找不到时返回 end
+uint32_t FindFloat64(const double* data, uint32_t begin, uint32_t end, double needle) {
+    uint32_t i = begin;
+#if defined(MJS_ARRAY_ELEMENTS_SSE2)
+    const __m128d target = _mm_set1_pd(needle);
+    for (; i + 4 <= end; i += 4) {
+        auto mask = static_cast<uint32_t>(_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(data + i), target))
+            | (_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(data + i + 2), target)) << 2));
+        if (mask) {
+            return i + std::countr_zero(mask);
+        }
+    }
+#elif defined(MJS_ARRAY_ELEMENTS_NEON)
+    const float64x2_t target = vdupq_n_f64(needle);
+    for (; i + 2 <= end; i += 2) {
+        uint64x2_t eq = vceqq_f64(vld1q_f64(data + i), target);
+        if (vgetq_lane_u64(eq, 0)) {
+            return i;
+        }
+        if (vgetq_lane_u64(eq, 1)) {
+            return i + 1;
+        }
+    }
+#endif
+    for (; i < end; ++i) {
+        if (data[i] == needle) {
+            return i;
+        }
+    }
+    return end;
+}
+
+} // namespace
+
+ArrayElements::~ArrayElements() {
+    Clear();
+}
+
+void ArrayElements::Set(uint32_t index, Value&& value) {
+    assert(index < size_);
+    if (!CanStore(value)) {
+        TransitionForValue(value);
+    }
+    switch (Representation(kind_)) {
+    case ElementsKind::kPackedInt64:
+        data_.i64_[index] = value.i64();
+        break;
+    case ElementsKind::kPackedFloat64:
+        data_.f64_[index] = value.f64();
+        break;
+    default:
+        data_.values_[index] = std::move(value);
+        break;
+    }
+    if (is_holey()) {
+        SetHoleBit(index, false);
+    }
+}
+
+void ArrayElements::Push(Value&& value) {
+    if (!CanStore(value)) {
+        TransitionForValue(value);
+    }
+    if (size_ == capacity_) {
+        Reallocate(std::max(kInitialCapacity, capacity_ + capacity_ / 2 + 1));
+    }
+    auto index = size_++;
+    switch (Representation(kind_)) {
+    case ElementsKind::kPackedInt64:
+        data_.i64_[index] = value.i64();
+        break;
+    case ElementsKind::kPackedFloat64:
+        data_.f64_[index] = value.f64();
+        break;
+    default:
+        new (&data_.values_[index]) Value(std::move(value));
+        break;
+    }
+    if (is_holey()) {
+        SetHoleBit(index, false);
+    }
+}
+
+bool ArrayElements::Pop(Value* value) {
+    assert(size_ > 0);
+    auto index = size_ - 1;
+    auto exists = Get(index, value);
+    if (is_value()) {
+        data_.values_[index].~Value();
+    }
+    --size_;
+    return exists;
+}
+
+void ArrayElements::Delete(uint32_t index) {
+    assert(index < size_);
+    if (!is_holey()) {
+        TransitionToHoley();
+    }
+    if (is_value()) {
+        // 释放引用，空洞位置保持 undefined
+        data_.values_[index] = Value();
+    }
+    SetHoleBit(index, true);
+}
+
+void ArrayElements::Resize(uint32_t new_size) {
+    if (new_size < size_) {
+        if (is_value()) {
+            std::destroy(data_.values_ + new_size, data_.values_ + size_);
+        }
+        size_ = new_size;
+        return;
+    }
+    if (new_size == size_) {
+        return;
+    }
+
+    // 扩展部分均为空洞
+    if (!is_holey()) {
+        TransitionToHoley();
+    }
+    if (new_size > capacity_) {
+        Reallocate(std::max(new_size, capacity_ + capacity_ / 2));
+    }
+    for (uint32_t i = size_; i < new_size; ++i) {
+        switch (Representation(kind_)) {
+        case ElementsKind::kPackedInt64:
+            data_.i64_[i] = 0;
+            break;
+        case ElementsKind::kPackedFloat64:
+            data_.f64_[i] = 0;
+            break;
+        default:
+            new (&data_.values_[i]) Value();
+            break;
+        }
+        SetHoleBit(i, true);
+    }
+    size_ = new_size;
+}
+
+void ArrayElements::Reserve(uint32_t new_capacity) {
+    if (new_capacity > capacity_) {
+        Reallocate(new_capacity);
+    }
+}
+
+void ArrayElements::Clear() {
+    if (data_.raw_) {
+        if (is_value()) {
+            std::destroy(data_.values_, data_.values_ + size_);
+        }
+        ::operator delete(data_.raw_);
+        data_.raw_ = nullptr;
+    }
+    size_ = 0;
+    capacity_ = 0;
+    kind_ = ElementsKind::kPackedInt64;
+    hole_bitmap_.clear();
+    hole_bitmap_.shrink_to_fit();
+}
+
+void ArrayElements::AppendRange(const ArrayElements& source, uint32_t begin, uint32_t end) {
+    assert(&source != this && begin <= end && end <= source.size_);
+    auto count = end - begin;
+    if (count == 0) {
+        return;
+    }
+
+    // 选择能同时容纳两侧元素的表示
+    if (Representation(kind_) != Representation(source.kind_)) {
+        if (!is_value() && !source.is_value() && (size_ == 0 || CountHoles() == size_)) {
+            // 还没有实际元素，直接改用源的数值表示
+            kind_ = static_cast<ElementsKind>(static_cast<uint8_t>(Representation(source.kind_)) | (static_cast<uint8_t>(kind_) & 4));
+        }
+        else if (!is_value()) {
+            TransitionToValueRepresentation();
+        }
+    }
+
+    bool copy_holes = false;
+    if (source.is_holey()) {
+        for (uint32_t i = begin; i < end && !copy_holes; ++i) {
+            copy_holes = source.IsHole(i);
+        }
+        if (copy_holes && !is_holey()) {
+            TransitionToHoley();
+        }
+    }
+
+    if (size_ + count > capacity_) {
+        Reallocate(std::max(size_ + count, capacity_ + capacity_ / 2));
+    }
+
+    if (Representation(kind_) == Representation(source.kind_)) {
+        if (is_value()) {
+            std::uninitialized_copy(source.data_.values_ + begin, source.data_.values_ + end, data_.values_ + size_);
+        }
+        else {
+            std::memcpy(data_.i64_ + size_, source.data_.i64_ + begin, sizeof(int64_t) * count);
+        }
+    }
+    else {
+        // 数值元素转换为 Value
+        assert(is_value() && !source.is_value());
+        for (uint32_t i = 0; i < count; ++i) {
+            if (source.IsHole(begin + i)) {
+                new (&data_.values_[size_ + i]) Value();
+            }
+            else if (source.is_int64()) {
+                new (&data_.values_[size_ + i]) Value(source.data_.i64_[begin + i]);
+            }
+            else {
+                new (&data_.values_[size_ + i]) Value(source.data_.f64_[begin + i]);
+            }
+        }
+    }
+
+    if (is_holey()) {
+        for (uint32_t i = 0; i < count; ++i) {
+            SetHoleBit(size_ + i, copy_holes && source.IsHole(begin + i));
+        }
+    }
+    size_ += count;
+}
+
+void ArrayElements::Splice(uint32_t start, uint32_t delete_count, uint32_t insert_count) {
+    assert(start <= size_ && delete_count <= size_ - start);
+    auto old_size = size_;
+    auto new_size = size_ - delete_count + insert_count;
+    if (new_size > capacity_) {
+        Reallocate(std::max(new_size, capacity_ + capacity_ / 2));
+    }
+
+    auto from = start + delete_count;
+    auto to = start + insert_count;
+    if (is_value()) {
+        auto* values = data_.values_;
+        if (to < from) {
+            std::move(values + from, values + old_size, values + to);
+            std::destroy(values + new_size, values + old_size);
+        }
+        else if (to > from) {
+            std::uninitialized_value_construct(values + old_size, values + new_size);
+            std::move_backward(values + from, values + old_size, values + new_size);
+        }
+        // 腾出的位置置为 undefined，同时释放被删除元素的引用
+        std::fill(values + start, values + to, Value());
+    }
+    else {
+        std::memmove(data_.i64_ + to, data_.i64_ + from, sizeof(int64_t) * (old_size - from));
+        std::fill(data_.i64_ + start, data_.i64_ + to, 0);
+    }
+
+    if (is_holey()) {
+        auto is_hole = [this](uint32_t index) {
+            return (hole_bitmap_[index / 64] >> (index % 64)) & 1;
+        };
+        if (to < from) {
+            for (uint32_t i = from; i < old_size; ++i) {
+                SetHoleBit(i - from + to, is_hole(i));
+            }
+        }
+        else if (to > from) {
+            for (uint32_t i = old_size; i > from; --i) {
+                SetHoleBit(i - 1 - from + to, is_hole(i - 1));
+            }
+        }
+        for (uint32_t i = start; i < to; ++i) {
+            SetHoleBit(i, false);
+        }
+    }
+    size_ = new_size;
+}
+
+void ArrayElements::Fill(uint32_t begin, uint32_t end, const Value& value) {
+    assert(begin <= end && end <= size_);
+    if (begin == end) {
+        return;
+    }
+    if (!CanStore(value)) {
+        TransitionForValue(value);
+    }
+    switch (Representation(kind_)) {
+    case ElementsKind::kPackedInt64:
+        std::fill(data_.i64_ + begin, data_.i64_ + end, value.i64());
+        break;
+    case ElementsKind::kPackedFloat64:
+        std::fill(data_.f64_ + begin, data_.f64_ + end, value.f64());
+        break;
+    default:
+        std::fill(data_.values_ + begin, data_.values_ + end, value);
+        break;
+    }
+    if (is_holey()) {
+        for (uint32_t i = begin; i < end; ++i) {
+            SetHoleBit(i, false);
+        }
+        // 空洞全部被填满（如 new Array(n).fill(x)）时恢复为 packed
+        if (CountHoles() == 0) {
+            kind_ = Representation(kind_);
+            hole_bitmap_.clear();
+        }
+    }
+}
+
+int64_t ArrayElements::IndexOf(const Value& value, uint32_t from, bool same_value_zero) const {
+    switch (Representation(kind_)) {
+    case ElementsKind::kPackedInt64: {
+        int64_t needle;
+        if (value.IsInt64()) {
+            needle = value.i64();
+        }
+        else if (value.IsFloat() && std::trunc(value.f64()) == value.f64() && std::abs(value.f64()) < 9223372036854775808.0) {
+            needle = static_cast<int64_t>(value.f64());
+        }
+        else {
+            return -1;
+        }
+        for (auto i = FindInt64(data_.i64_, from, size_, needle); i < size_; i = FindInt64(data_.i64_, i + 1, size_, needle)) {
+            // 空洞位置的内容无意义，命中后需要排除
+            if (!IsHole(i)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+    case ElementsKind::kPackedFloat64: {
+        double needle;
+        if (value.IsFloat()) {
+            needle = value.f64();
+        }
+        else if (value.IsInt64()) {
+            needle = static_cast<double>(value.i64());
+        }
+        else {
+            return -1;
+        }
+        if (std::isnan(needle)) {
+            if (!same_value_zero) {
+                return -1;
+            }
+            for (uint32_t i = from; i < size_; ++i) {
+                if (std::isnan(data_.f64_[i]) && !IsHole(i)) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+        for (auto i = FindFloat64(data_.f64_, from, size_, needle); i < size_; i = FindFloat64(data_.f64_, i + 1, size_, needle)) {
+            if (!IsHole(i)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+    default:
+        for (uint32_t i = from; i < size_; ++i) {
+            if (!IsHole(i) && ElementEquals(data_.values_[i], value, same_value_zero)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+}
+
+bool ArrayElements::ElementEquals(const Value& element, const Value& value, bool same_value_zero) {
+    auto is_number = [](const Value& v) { return v.IsInt64() || v.IsFloat(); };
+    if (is_number(element) && is_number(value)) {
+        if (element.IsInt64() && value.IsInt64()) {
+            return element.i64() == value.i64();
+        }
+        auto a = element.IsInt64() ? static_cast<double>(element.i64()) : element.f64();
+        auto b = value.IsInt64() ? static_cast<double>(value.i64()) : value.f64();
+        if (same_value_zero && std::isnan(a) && std::isnan(b)) {
+            return true;
+        }
+        return a == b;
+    }
+    if (element.IsString() && value.IsString()) {
+        return std::strcmp(element.string_view(), value.string_view()) == 0;
+    }
+    if (element.type() != value.type()) {
+        return false;
+    }
+    if (element.IsObject()) {
+        return &element.object() == &value.object();
+    }
+    return element == value;
+}
+
+uint32_t ArrayElements::CountHoles() const {
+    if (!is_holey()) {
+        return 0;
+    }
+    uint32_t count = 0;
+    uint32_t full_words = size_ / 64;
+    for (uint32_t i = 0; i < full_words; ++i) {
+        count += std::popcount(hole_bitmap_[i]);
+    }
+    if (size_ % 64) {
+        count += std::popcount(hole_bitmap_[full_words] & ((uint64_t(1) << (size_ % 64)) - 1));
+    }
+    return count;
+}
+
+void ArrayElements::GCTraverse(Context* context, GCTraverseCallback callback) {
+    if (!is_value()) {
+        return;
+    }
+    for (uint32_t i = 0; i < size_; ++i) {
+        callback(context, &data_.values_[i]);
+    }
+}
+
+bool ArrayElements::CanStore(const Value& value) const {
+    switch (Representation(kind_)) {
+    case ElementsKind::kPackedInt64:
+        return value.IsInt64();
+    case ElementsKind::kPackedFloat64:
+        return value.IsFloat();
+    default:
+        return true;
+    }
+}
+
+void ArrayElements::TransitionForValue(const Value& value) {
+    assert(!is_value());
+    // 还没有任何实际元素时可以直接改用匹配的数值表示，无需转换
+    if (size_ == 0 || CountHoles() == size_) {
+        ElementsKind representation = ElementsKind::kPackedValue;
+        if (value.IsInt64()) {
+            representation = ElementsKind::kPackedInt64;
+        }
+        else if (value.IsFloat()) {
+            representation = ElementsKind::kPackedFloat64;
+        }
+        if (representation != ElementsKind::kPackedValue) {
+            // 数值缓冲区之间宽度一致，空洞位置的内容无意义，直接改种类即可
+            kind_ = static_cast<ElementsKind>(static_cast<uint8_t>(representation) | (static_cast<uint8_t>(kind_) & 4));
+            return;
+        }
+    }
+    TransitionToValueRepresentation();
+}
+
+void ArrayElements::TransitionToValueRepresentation() {
+    assert(!is_value());
+    auto* new_values = capacity_ ? static_cast<Value*>(::operator new(sizeof(Value) * capacity_)) : nullptr;
+    for (uint32_t i = 0; i < size_; ++i) {
+        if (IsHole(i)) {
+            new (&new_values[i]) Value();
+        }
+        else if (is_int64()) {
+            new (&new_values[i]) Value(data_.i64_[i]);
+        }
+        else {
+            new (&new_values[i]) Value(data_.f64_[i]);
+        }
+    }
+    if (data_.raw_) {
+        ::operator delete(data_.raw_);
+    }
+    data_.values_ = new_values;
+    kind_ = static_cast<ElementsKind>(static_cast<uint8_t>(ElementsKind::kPackedValue) | (static_cast<uint8_t>(kind_) & 4));
+}
+
+void ArrayElements::TransitionToHoley() {
+    assert(!is_holey());
+    hole_bitmap_.assign(BitmapWords(capacity_), 0);
+    kind_ = static_cast<ElementsKind>(static_cast<uint8_t>(kind_) | 4);
+}
+
+void ArrayElements::Reallocate(uint32_t new_capacity) {
+    assert(new_capacity >= size_);
+    if (is_value()) {
+        auto* new_values = static_cast<Value*>(::operator new(sizeof(Value) * new_capacity));
+        for (uint32_t i = 0; i < size_; ++i) {
+            new (&new_values[i]) Value(std::move(data_.values_[i]));
+            data_.values_[i].~Value();
+        }
+        if (data_.raw_) {
+            ::operator delete(data_.raw_);
+        }
+        data_.values_ = new_values;
+    }
+    else {
+        static_assert(sizeof(int64_t) == sizeof(double));
+        auto* new_data = ::operator new(sizeof(int64_t) * new_capacity);
+        if (data_.raw_) {
+            std::memcpy(new_data, data_.raw_, sizeof(int64_t) * size_);
+            ::operator delete(data_.raw_);
+        }
+        data_.raw_ = new_data;
+    }
+    if (is_holey()) {
+        hole_bitmap_.resize(BitmapWords(new_capacity), 0);
+    }
+    capacity_ = new_capacity;
+}
+
+void ArrayElements::SetHoleBit(uint32_t index, bool hole) {
+    assert(is_holey() && index / 64 < hole_bitmap_.size());
+    auto mask = uint64_t(1) << (index % 64);
+    if (hole) {
+        hole_bitmap_[index / 64] |= mask;
+    }
+    else {
+        hole_bitmap_[index / 64] &= ~mask;
+    }
+}
+
+} // namespace mjs
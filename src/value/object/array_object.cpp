@@ -13,56 +13,38 @@
 namespace mjs {
 
 // 设计：
-// 混合模式结构：[哈希表元素0...N-1] [快速数组元素0...M-1]
-// - slow_property_count_：哈希表元素数量（N）
-// - length_：数组元素数量（M）
-// 哈希表元素从4开始，需要时翻倍增长
-// 快速数组元素直接通过索引访问
+// 命名属性与数组元素分离存储
+// - 属性槽：命名属性（如 arr.foo），由 Object 按 shape 管理
+// - elements_：稠密数组元素，按元素种类存放在连续的 int64_t / double / Value 缓冲区中
+// - length_：数组长度，非稀疏模式下与 elements_.size() 一致
+// 空洞过多时转换为稀疏模式，元素以字符串下标的形式迁移到命名属性中
 
 ArrayObject::ArrayObject(Context* context)
-    : Object(context, ClassId::kArrayObject)
-{
-    // 预留初始哈希表空间
-    properties_.reserve(kInitialHashTableCapacity);
-    length_ = 0;
-    slow_property_count_ = 0;
-    is_sparse_ = false;
-}
+    : Object(context, ClassId::kArrayObject) {}
 
 ArrayObject::ArrayObject(Context* context, size_t count)
     : Object(context, ClassId::kArrayObject)
 {
-    // 预留空间：哈希表 + 数组元素
-    properties_.reserve(kInitialHashTableCapacity + count);
-
     length_ = count;
-    slow_property_count_ = 0;
-    is_sparse_ = false;
-
-    // 初始化数组元素为 undefined，且都不存在（空洞）
-    for (size_t i = 0; i < count; ++i) {
-        // 空洞元素：不设置kExists标志
-        properties_.emplace_back(PropertySlot(Value(), ShapeProperty::kNone));
-    }
+    // 初始化数组元素为空洞
+    elements_.Resize(count);
 }
 
 ArrayObject::ArrayObject(Context* context, std::initializer_list<Value> values)
     : Object(context, ClassId::kArrayObject)
 {
-    // 预留空间：哈希表 + 数组元素
-    properties_.reserve(kInitialHashTableCapacity + values.size());
-
     length_ = values.size();
-    slow_property_count_ = 0;
-    is_sparse_ = false;
-
-    // 初始化数组元素
+    elements_.Reserve(values.size());
     for (auto& value : values) {
-        // 显式设置的元素：设置kExists标志
-        properties_.emplace_back(PropertySlot(Value(value), ShapeProperty::kDefault));
+        elements_.Push(Value(value));
     }
 }
 
+void ArrayObject::GCTraverse(Context* context, GCTraverseCallback callback) {
+    Object::GCTraverse(context, callback);
+    elements_.GCTraverse(context, callback);
+}
+
 bool ArrayObject::GetProperty(Context* context, ConstIndex key, Value* value) {
     // 检查是否访问 length 属性
     if (key == ConstIndexEmbedded::kLength) {
@@ -79,40 +61,12 @@ bool ArrayObject::GetComputedProperty(Context* context, const Value& key, Value*
         return Object::GetComputedProperty(context, key, value);
     }
 
-    // 优化：直接处理数字索引
-    if (key.IsInt64()) {
-        int64_t i64_val = key.i64();
-        if (i64_val >= 0) {
-            size_t idx = static_cast<size_t>(i64_val);
-            if (IsValidArrayIndex(static_cast<uint64_t>(idx))) {
-                // 访问快速数组部分
-                if (idx < length_) {
-                    *value = properties_[slow_property_count_ + idx].value;
-                    // JS标准：检查元素是否存在（通过kExists标志）
-                    return (properties_[slow_property_count_ + idx].flags & ShapeProperty::kExists) != 0;
-                }
-                // 索引超出范围，返回 false（属性不存在）
-                return false;
-            }
-        }
+    uint64_t array_index = 0;
+    if (TryKeyToArrayIndex(key, &array_index)) {
+        return elements_.Get(static_cast<uint32_t>(array_index), value);
     }
 
-    // 可能是"1"、"2"此类的字符串，需要转成数字索引
-    if (key.IsString()) {
-        uint64_t array_index = 0;
-        if (TryStringToArrayIndex(key.string_view(), &array_index)) {
-            size_t idx = static_cast<size_t>(array_index);
-            // 访问快速数组部分
-            if (idx < length_) {
-                *value = properties_[slow_property_count_ + idx].value;
-                // JS标准：检查元素是否存在（通过kExists标志）
-                return (properties_[slow_property_count_ + idx].flags & ShapeProperty::kExists) != 0;
-            }
-            return false;
-        }
-    }
-
-    // 其他情况（如非数字字符串）从哈希表获取
+    // 其他情况（如非数字字符串）从命名属性获取
     return Object::GetComputedProperty(context, key, value);
 }
 
@@ -161,22 +115,11 @@ void ArrayObject::SetProperty(Context* context, ConstIndex key, Value&& value) {
 
         size_t new_length = static_cast<size_t>(new_length_i64);
 
-        if (new_length < length_) {
-            // 缩短快速数组
-            if (!is_sparse_) {
-                properties_.resize(slow_property_count_ + new_length);
-            }
-            // 稀疏模式：length缩短不影响已存储的元素
-        } else if (new_length > length_) {
-            // 扩容：填充空洞（不设置kExists标志）
-            if (!is_sparse_) {
-                size_t required_size = slow_property_count_ + new_length;
-                if (properties_.size() < required_size) {
-                    properties_.resize(required_size);
-                }
-                // 新增的位置默认kNone标志（空洞），无需额外处理
-            }
-            // 稀疏模式：只需要更新length，不需要实际填充元素
+        // 缩短时截断元素，扩容时填充空洞
+        // 稀疏模式：只需要更新length，不影响已存储的元素
+        if (!is_sparse_) {
+            MarkingBarrier(context);
+            elements_.Resize(static_cast<uint32_t>(new_length));
         }
 
         // 更新 length 值
@@ -184,10 +127,7 @@ void ArrayObject::SetProperty(Context* context, ConstIndex key, Value&& value) {
         return;
     }
 
-    // 确保哈希表有足够空间
-    EnsureHashTableCapacity(context);
-
-    // 其他属性通过父类处理（存储在哈希表中）
+    // 其他属性通过父类处理（存储在命名属性中）
     Object::SetProperty(context, key, std::move(value));
 }
 
@@ -196,65 +136,20 @@ void ArrayObject::SetComputedProperty(Context* context, const Value& key, Value&
     if (is_sparse_) {
         // 更新length（如果是数组索引）
         uint64_t array_index = 0;
-        if ((key.IsInt64() && key.i64() >= 0) ||
-            (key.IsString() && TryStringToArrayIndex(key.string_view(), &array_index))) {
-            size_t idx = key.IsInt64() ? static_cast<size_t>(key.i64()) : static_cast<size_t>(array_index);
-            if (IsValidArrayIndex(static_cast<uint64_t>(idx)) && idx >= length_) {
-                length_ = idx + 1;
-            }
+        if (TryKeyToArrayIndex(key, &array_index) && array_index >= length_) {
+            length_ = array_index + 1;
         }
         Object::SetComputedProperty(context, key, std::move(value));
         return;
     }
 
-    // 优化：直接处理数字索引
-    if (key.IsInt64()) {
-        int64_t i64_val = key.i64();
-        if (i64_val >= 0) {
-            uint64_t array_index = static_cast<uint64_t>(i64_val);
-            if (IsValidArrayIndex(array_index)) {
-                size_t idx = static_cast<size_t>(array_index);
-
-                // 更新 length
-                if (idx >= length_) {
-                    length_ = idx + 1;
-                }
-
-                // 在快速数组中存储
-                size_t required_size = slow_property_count_ + length_;
-                if (properties_.size() < required_size) {
-                    properties_.resize(required_size);
-                }
-                properties_[slow_property_count_ + idx].value = std::move(value);
-                properties_[slow_property_count_ + idx].flags |= ShapeProperty::kExists;  // 标记元素存在
-                return;
-            }
-        }
-    }
-
-    // 可能是"1"、"2"此类的字符串，需要转成数字索引
-    if (key.IsString()) {
-        uint64_t array_index = 0;
-        if (TryStringToArrayIndex(key.string_view(), &array_index)) {
-            size_t idx = static_cast<size_t>(array_index);
-
-            // 更新 length
-            if (idx >= length_) {
-                length_ = idx + 1;
-            }
-
-            // 在快速数组中存储
-            size_t required_size = slow_property_count_ + length_;
-            if (properties_.size() < required_size) {
-                properties_.resize(required_size);
-            }
-            properties_[slow_property_count_ + idx].value = std::move(value);
-            properties_[slow_property_count_ + idx].flags |= ShapeProperty::kExists;  // 标记元素存在
-            return;
-        }
+    uint64_t array_index = 0;
+    if (TryKeyToArrayIndex(key, &array_index)) {
+        SetIndexedElement(context, array_index, std::move(value));
+        return;
     }
 
-    // 其他情况调用父类方法（哈希表存储）
+    // 其他情况调用父类方法（命名属性存储）
     Object::SetComputedProperty(context, key, std::move(value));
 }
 
@@ -264,58 +159,68 @@ bool ArrayObject::DelComputedProperty(Context* context, const Value& key, Value*
         return Object::DelComputedProperty(context, key, value);
     }
 
-    // 优化：直接处理数字索引
-    if (key.IsInt64()) {
-        int64_t i64_val = key.i64();
-        if (i64_val >= 0) {
-            size_t idx = static_cast<size_t>(i64_val);
-            if (IsValidArrayIndex(static_cast<uint64_t>(idx))) {
-                // 从快速数组中删除
-                if (idx < length_) {
-                    *value = std::move(properties_[slow_property_count_ + idx].value);
-                    // 创建空洞：设置为undefined，并清除kExists标志
-                    properties_[slow_property_count_ + idx].value = Value();
-                    properties_[slow_property_count_ + idx].flags &= ~ShapeProperty::kExists;  // 清除存在标志
-
-                    // 检查是否应该转换为稀疏模式
-                    if (ShouldConvertToSparse(idx)) {
-                        ConvertToSparseMode(context);
-                    }
-                    return true;
-                }
-                // 索引超出范围，返回 false
-                *value = Value();
-                return false;
-            }
-        }
+    uint64_t array_index = 0;
+    if (TryKeyToArrayIndex(key, &array_index)) {
+        return DelIndexedElement(context, array_index, value);
     }
 
-    // 可能是"1"、"2"此类的字符串，需要转成数字索引
-    if (key.IsString()) {
-        uint64_t array_index = 0;
-        if (TryStringToArrayIndex(key.string_view(), &array_index)) {
-            size_t idx = static_cast<size_t>(array_index);
-            // 从快速数组中删除
-            if (idx < length_) {
-                *value = std::move(properties_[slow_property_count_ + idx].value);
-                // 创建空洞：设置为undefined，并清除kExists标志
-                properties_[slow_property_count_ + idx].value = Value();
-                properties_[slow_property_count_ + idx].flags &= ~ShapeProperty::kExists;  // 清除存在标志
-
-                // 检查是否应该转换为稀疏模式
-                if (ShouldConvertToSparse(idx)) {
-                    ConvertToSparseMode(context);
-                }
-                return true;
-            }
-            // 索引超出范围，返回 false
-            *value = Value();
-            return false;
-        }
+    // 其他情况调用父类方法（从命名属性删除）
+    return Object::DelComputedProperty(context, key, value);
+}
+
+bool ArrayObject::GetElement(Context* context, size_t index, Value* value) {
+    if (is_sparse_) {
+        return Object::GetComputedProperty(context, Value(static_cast<int64_t>(index)), value);
+    }
+    // 索引超出范围时元素不存在，空洞同样视为不存在
+    if (index >= elements_.size()) {
+        *value = Value();
+        return false;
     }
+    return elements_.Get(static_cast<uint32_t>(index), value);
+}
 
-    // 其他情况调用父类方法（从哈希表删除）
-    return Object::DelComputedProperty(context, key, value);
+void ArrayObject::SetElement(Context* context, size_t index, Value&& value) {
+    if (is_sparse_) {
+        SetComputedProperty(context, Value(static_cast<int64_t>(index)), std::move(value));
+        return;
+    }
+    SetIndexedElement(context, index, std::move(value));
+}
+
+void ArrayObject::SetIndexedElement(Context* context, uint64_t index, Value&& value) {
+    MarkingBarrier(context);
+    WriteBarrier(context, value);
+    auto idx = static_cast<uint32_t>(index);
+    if (idx < elements_.size()) {
+        elements_.Set(idx, std::move(value));
+        return;
+    }
+
+    // 在末尾之后写入，中间的位置成为空洞
+    elements_.Resize(idx);
+    elements_.Push(std::move(value));
+    length_ = elements_.size();
+}
+
+bool ArrayObject::DelIndexedElement(Context* context, uint64_t index, Value* value) {
+    if (index >= length_) {
+        // 索引超出范围，返回 false
+        *value = Value();
+        return false;
+    }
+
+    auto idx = static_cast<uint32_t>(index);
+    elements_.Get(idx, value);
+    MarkingBarrier(context);
+    // 创建空洞
+    elements_.Delete(idx);
+
+    // 检查是否应该转换为稀疏模式
+    if (ShouldConvertToSparse(idx)) {
+        ConvertToSparseMode(context);
+    }
+    return true;
 }
 
 void ArrayObject::Push(Context* context, Value val) {
@@ -330,7 +235,9 @@ void ArrayObject::Push(Context* context, Value val) {
     }
 
     // 快速数组模式：直接添加到末尾
-    properties_.emplace_back(PropertySlot(std::move(val), ShapeProperty::kDefault));
+    MarkingBarrier(context);
+    WriteBarrier(context, val);
+    elements_.Push(std::move(val));
     ++length_;
 }
 
@@ -353,8 +260,9 @@ Value ArrayObject::Pop(Context* context) {
     }
 
     // 快速数组模式：从末尾移除
-    Value result = std::move(properties_[slow_property_count_ + last_index].value);
-    properties_.pop_back();
+    MarkingBarrier(context);
+    Value result;
+    elements_.Pop(&result);
     --length_;
     return result;
 }
@@ -362,7 +270,8 @@ Value ArrayObject::Pop(Context* context) {
 void ArrayObject::ForEach(Context* context, Value callback) {
     // 遍历数组元素，调用回调函数
     for (size_t i = 0; i < length_; ++i) {
-        Value element_value = properties_[slow_property_count_ + i].value;
+        Value element_value;
+        elements_.Get(static_cast<uint32_t>(i), &element_value);
 
         // 调用回调函数：callback(element, index, array)
         Value argv[] = { element_value, Value(static_cast<int64_t>(i)), Value(this) };
@@ -370,6 +279,24 @@ void ArrayObject::ForEach(Context* context, Value callback) {
     }
 }
 
+bool ArrayObject::TryKeyToArrayIndex(const Value& key, uint64_t* out_index) {
+    // 优化：直接处理数字索引
+    if (key.IsInt64()) {
+        int64_t i64_val = key.i64();
+        if (i64_val >= 0 && IsValidArrayIndex(static_cast<uint64_t>(i64_val))) {
+            *out_index = static_cast<uint64_t>(i64_val);
+            return true;
+        }
+        return false;
+    }
+
+    // 可能是"1"、"2"此类的字符串，需要转成数字索引
+    if (key.IsString()) {
+        return TryStringToArrayIndex(key.string_view(), out_index);
+    }
+    return false;
+}
+
 bool ArrayObject::TryStringToArrayIndex(std::string_view str, uint64_t* out_index) {
     if (str.empty()) {
         return false;
@@ -406,40 +333,117 @@ bool ArrayObject::TryStringToArrayIndex(std::string_view str, uint64_t* out_inde
     return false;
 }
 
-void ArrayObject::EnsureHashTableCapacity(Context* context) {
-    size_t current_capacity = properties_.size() - length_;
-    if (slow_property_count_ < current_capacity) {
-        return; // 还有空间
-    }
+size_t ArrayObject::GetLength() const {
+    return length_;
+}
 
-    // 计算新容量：从4开始翻倍增长
-    size_t new_capacity = (current_capacity == 0) ? kInitialHashTableCapacity : current_capacity * 2;
+void ArrayObject::ReserveElements(Context* context, size_t capacity) {
+    if (!is_sparse_) {
+        MarkingBarrier(context);
+        elements_.Reserve(static_cast<uint32_t>(capacity));
+    }
+}
 
-    // 需要复制整个数组，因为快速数组元素在后面
-    std::vector<PropertySlot> new_properties;
-    new_properties.reserve(new_capacity + length_);
+void ArrayObject::AppendElements(Context* context, ArrayObject& source, size_t begin, size_t end) {
+    if (begin >= end) {
+        return;
+    }
+    if (!is_sparse_ && !source.is_sparse_) {
+        MarkingBarrier(context);
+        if (source.elements_.is_value()) {
+            // 批量复制不逐个检查元素
+            RecordWrite(context);
+        }
+        elements_.AppendRange(source.elements_, static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+        length_ = elements_.size();
+        return;
+    }
 
-    // 复制哈希表元素
-    for (size_t i = 0; i < slow_property_count_; ++i) {
-        new_properties.push_back(std::move(properties_[i]));
+    // 任意一方为稀疏模式：逐个复制存在的元素，空洞只计入长度
+    size_t base = length_;
+    for (size_t i = begin; i < end; ++i) {
+        Value element;
+        if (source.GetElement(context, i, &element)) {
+            SetElement(context, base + (i - begin), std::move(element));
+        }
     }
+    if (length_ < base + (end - begin)) {
+        SetProperty(context, ConstIndexEmbedded::kLength, Value(static_cast<int64_t>(base + (end - begin))));
+    }
+}
 
-    // 填充剩余哈希表空间为空
-    for (size_t i = slow_property_count_; i < new_capacity; ++i) {
-        new_properties.emplace_back(PropertySlot(Value()));
+void ArrayObject::SpliceElements(Context* context, size_t start, size_t delete_count, const Value* items, size_t item_count) {
+    assert(start <= length_ && delete_count <= length_ - start);
+    if (!is_sparse_) {
+        MarkingBarrier(context);
+        elements_.Splice(static_cast<uint32_t>(start), static_cast<uint32_t>(delete_count), static_cast<uint32_t>(item_count));
+        for (size_t i = 0; i < item_count; ++i) {
+            WriteBarrier(context, items[i]);
+            elements_.Set(static_cast<uint32_t>(start + i), Value(items[i]));
+        }
+        length_ = elements_.size();
+        return;
     }
 
-    // 复制快速数组元素
-    for (size_t i = 0; i < length_; ++i) {
-        new_properties.push_back(std::move(properties_[slow_property_count_ + i]));
+    // 稀疏模式：逐个移动之后的元素
+    size_t length = length_;
+    size_t new_length = length - delete_count + item_count;
+    auto move_element = [&](size_t from, size_t to) {
+        Value element;
+        if (GetElement(context, from, &element)) {
+            SetElement(context, to, std::move(element));
+        }
+        else {
+            DelComputedProperty(context, Value(static_cast<int64_t>(to)), &element);
+        }
+    };
+    if (item_count < delete_count) {
+        for (size_t k = start + delete_count; k < length; ++k) {
+            move_element(k, k - delete_count + item_count);
+        }
+        for (size_t k = length; k > new_length; --k) {
+            Value deleted;
+            DelComputedProperty(context, Value(static_cast<int64_t>(k - 1)), &deleted);
+        }
+    }
+    else if (item_count > delete_count) {
+        for (size_t k = length; k > start + delete_count; --k) {
+            move_element(k - 1, k - 1 - delete_count + item_count);
+        }
+    }
+    for (size_t i = 0; i < item_count; ++i) {
+        SetElement(context, start + i, Value(items[i]));
     }
+    length_ = new_length;
+}
 
-    properties_ = std::move(new_properties);
-    // element_exists_不受影响，因为只扩容哈希表部分
+void ArrayObject::FillElements(Context* context, size_t begin, size_t end, const Value& value) {
+    assert(end <= length_);
+    if (begin >= end) {
+        return;
+    }
+    if (!is_sparse_) {
+        MarkingBarrier(context);
+        WriteBarrier(context, value);
+        elements_.Fill(static_cast<uint32_t>(begin), static_cast<uint32_t>(end), value);
+        return;
+    }
+    for (size_t i = begin; i < end; ++i) {
+        SetElement(context, i, Value(value));
+    }
 }
 
-size_t ArrayObject::GetLength() const {
-    return length_;
+int64_t ArrayObject::IndexOfElement(Context* context, const Value& value, size_t from, bool same_value_zero) {
+    if (!is_sparse_) {
+        return from < elements_.size() ? elements_.IndexOf(value, static_cast<uint32_t>(from), same_value_zero) : -1;
+    }
+    for (size_t i = from; i < length_; ++i) {
+        Value element;
+        if (GetElement(context, i, &element) && ArrayElements::ElementEquals(element, value, same_value_zero)) {
+            return static_cast<int64_t>(i);
+        }
+    }
+    return -1;
 }
 
 bool ArrayObject::ShouldConvertToSparse(size_t deleted_index) const {
@@ -453,27 +457,20 @@ bool ArrayObject::ShouldConvertToSparse(size_t deleted_index) const {
         return false;
     }
 
-    // 计算空洞元素数量（使用kExists标志）
-    size_t hole_count = 0;
-    for (size_t i = 0; i < length_; ++i) {
-        if ((properties_[slow_property_count_ + i].flags & ShapeProperty::kExists) == 0) {
-            ++hole_count;
-        }
-    }
-
     // 空洞占比超过阈值，转换为稀疏模式
-    return (100 * hole_count / length_) >= kSparseThreshold;
+    return (100 * static_cast<size_t>(elements_.CountHoles()) / length_) >= kSparseThreshold;
 }
 
 void ArrayObject::ConvertToSparseMode(Context* context) {
     if (is_sparse_) {
         return; // 已经是稀疏模式
     }
+    MarkingBarrier(context);
 
-    // 将快速数组中存在的元素移到哈希表（使用字符串索引键）
-    for (size_t i = 0; i < length_; ++i) {
-        if ((properties_[slow_property_count_ + i].flags & ShapeProperty::kExists) != 0) {  // 只迁移存在的元素
-            Value elem_value = std::move(properties_[slow_property_count_ + i].value);
+    // 将稠密元素中存在的元素移到哈希表（使用字符串索引键）
+    for (uint32_t i = 0; i < elements_.size(); ++i) {
+        Value elem_value;
+        if (elements_.Get(i, &elem_value)) {  // 只迁移存在的元素
             // 使用字符串索引作为键存储到哈希表
             std::string key_str = std::to_string(i);
             Value key_value = Value(String::New(key_str));
@@ -481,8 +478,8 @@ void ArrayObject::ConvertToSparseMode(Context* context) {
         }
     }
 
-    // 移除快速数组部分
-    properties_.resize(slow_property_count_);
+    // 释放稠密元素存储
+    elements_.Clear();
     is_sparse_ = true;
 }
 
@@ -0,0 +1,52 @@
+#include <mjs/value/object/data_view_object.h>
+
+#include <bit>
+
+#include <mjs/context.h>
+#include <mjs/const_index_embedded.h>
+
+namespace mjs {
+
+DataViewObject::DataViewObject(Context* context, Value buffer, size_t byte_offset, size_t byte_length)
+	: Object(context, ClassId::kDataViewObject)
+	, buffer_(std::move(buffer))
+	, byte_offset_(byte_offset)
+	, byte_length_(byte_length)
+{
+	auto& array_buffer = buffer_.object().get<ArrayBufferObject>();
+	assert(byte_offset + byte_length <= array_buffer.byte_length());
+	data_ = array_buffer.data() + byte_offset;
+}
+
+void DataViewObject::GCTraverse(Context* context, GCTraverseCallback callback) {
+	Object::GCTraverse(context, callback);
+	callback(context, &buffer_);
+}
+
+bool DataViewObject::GetProperty(Context* context, ConstIndex key, Value* value) {
+	switch (key) {
+	case ConstIndexEmbedded::kByteLength:
+		*value = Value(static_cast<int64_t>(byte_length_));
+		return true;
+	case ConstIndexEmbedded::kByteOffset:
+		*value = Value(static_cast<int64_t>(byte_offset_));
+		return true;
+	case ConstIndexEmbedded::kBuffer:
+		*value = buffer_;
+		return true;
+	default:
+		return Object::GetProperty(context, key, value);
+	}
+}
+
+void DataViewObject::CopyBytes(uint8_t* dst, const uint8_t* src, size_t size, bool little_endian) {
+	if (little_endian == (std::endian::native == std::endian::little)) {
+		std::memcpy(dst, src, size);
+		return;
+	}
+	for (size_t i = 0; i < size; ++i) {
+		dst[i] = src[size - 1 - i];
+	}
+}
+
+} // namespace mjs
@@ -45,10 +45,10 @@ void FunctionObject::InitPrototypeProperty(Context* context) {
 	auto index = shape_->Find(ConstIndexEmbedded::kPrototype);
 	if (index == kPropertySlotIndexInvalid) {
 		ShapeProperty prop(ConstIndexEmbedded::kPrototype);
-		index = shape_->shape_manager()->AddProperty(&shape_, std::move(prop));
-		AddPropertySlot(index, std::move(prototype_obj_value), flags);
+		index = AddShapeProperty(std::move(prop));
+		AddPropertySlot(context, index, std::move(prototype_obj_value), flags);
 	} else {
-		SetPropertyValue(index, std::move(prototype_obj_value));
+		SetPropertyValue(context, index, std::move(prototype_obj_value));
 	}
 }
 
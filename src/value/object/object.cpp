@@ -1,5 +1,6 @@
 #include <mjs/value/object/object.h>
 
+#include <algorithm>
 #include <functional>
 
 #include <mjs/context.h>
@@ -24,21 +25,109 @@ Object::Object(Context* context, ClassId class_id)
 
 Object::~Object() {
 	// 对于 GC 管理的对象，析构函数由 GC 系统在清理时调用
-	shape_->Dereference();
+	auto* slots = property_slots();
+	for (uint32_t i = 0; i < property_count_; ++i) {
+		slots[i].~PropertySlot();
+	}
+	if (out_of_line_properties_) {
+		::operator delete(out_of_line_properties_);
+	}
+	// 新生代对象的形状引用由GC堆持有
+	if (!tag_.young_managed_) {
+		shape_->Dereference();
+	}
 }
 
-void Object::GCTraverse(Context* context, GCTraverseCallback callback) {
-	// 遍历所有属性
-	for (auto& slot : properties_) {
-		callback(context, &slot.value);
+void Object::InitializeGCAllocated(GCHeap* heap, size_t in_object_size) {
+	if (!out_of_line_properties_) {
+		property_capacity_ = static_cast<uint32_t>(in_object_size / sizeof(PropertySlot));
+	}
+	if (header_.generation() == GCGeneration::kNew) {
+		tag_.young_managed_ = 1;
+		heap->PinYoungShape(shape_);
+		shape_->Dereference();
 	}
+}
 
-	// 遍历原型对象
-	if (tag_.set_proto_) {
-		auto index = shape_->Find(ConstIndexEmbedded::kProto);
-		if (index != kPropertySlotIndexInvalid) {
-			callback(context, &properties_[index].value);
-		}
+void Object::ReferenceShapeOnPromotion() {
+	if (tag_.young_managed_) {
+		tag_.young_managed_ = 0;
+		shape_->Reference();
+	}
+}
+
+GCHeap* Object::young_heap() const {
+	return shape_->shape_manager()->context().gc_manager().heap();
+}
+
+void Object::RegisterFinalizer() {
+	young_heap()->RegisterFinalizer(this);
+}
+
+void Object::ReservePropertySlots(uint32_t capacity) {
+	if (capacity <= property_capacity_) {
+		return;
+	}
+	capacity = std::max(capacity, property_capacity_ * 2);
+	auto* slots = static_cast<PropertySlot*>(::operator new(sizeof(PropertySlot) * capacity));
+	auto* old_slots = property_slots();
+	for (uint32_t i = 0; i < property_count_; ++i) {
+		new (&slots[i]) PropertySlot(std::move(old_slots[i]));
+		old_slots[i].~PropertySlot();
+	}
+	if (out_of_line_properties_) {
+		::operator delete(out_of_line_properties_);
+	}
+	out_of_line_properties_ = slots;
+	property_capacity_ = capacity;
+
+	// 对象外的属性槽需要在对象死亡时释放
+	if (tag_.young_managed_ && !header_.IsFinalizable()) {
+		RegisterFinalizer();
+	}
+}
+
+void Object::ReplaceShape(Shape* shape) {
+	if (tag_.young_managed_) {
+		young_heap()->PinYoungShape(shape);
+	}
+	else {
+		shape->Reference();
+		shape_->Dereference();
+	}
+	shape_ = shape;
+}
+
+PropertySlotIndex Object::AddShapeProperty(ShapeProperty&& property) {
+	Shape* shape = shape_;
+	if (!tag_.young_managed_) {
+		auto index = shape->shape_manager()->AddProperty(&shape, std::move(property));
+		shape_ = shape;
+		return index;
+	}
+	// 过渡会转移调用者对原形状的引用，先临时补上，过渡后的形状改由GC堆持有
+	shape->Reference();
+	auto index = shape->shape_manager()->AddProperty(&shape, std::move(property));
+	young_heap()->PinYoungShape(shape);
+	shape->Dereference();
+	shape_ = shape;
+	return index;
+}
+
+void Object::RecordWrite(Context* context) {
+	context->gc_manager().heap()->RecordWrite(this);
+}
+
+void Object::MarkingBarrierSlow(Context* context) {
+	context->gc_manager().heap()->MarkingBarrier(this);
+}
+
+void Object::GCTraverse(Context* context, GCTraverseCallback callback) {
+	// 遍历所有属性，原型对象同样存放在属性槽中
+	// 不读取 shape：并发标记时 shape 可能正被主线程修改
+	auto* slots = property_slots();
+	for (uint32_t i = 0; i < property_count_; ++i) {
+		callback(context, &slots[i].value);
 	}
 }
 
@@ -120,14 +209,14 @@ void Object::SetProperty(Context* context, ConstIndex key, Value&& value) {
 		}
 
 		// 可写的普通属性，直接更新值
-		SetPropertyValue(index, std::move(value));
+		SetPropertyValue(context, index, std::move(value));
 		return;
 	}
 
 	// 添加新属性，使用默认标志（包含 enumerable, configurable, writable）
 	uint32_t default_flags = ShapeProperty::kDefault;
-	index = shape_->shape_manager()->AddProperty(&shape_, ShapeProperty(key));
-	AddPropertySlot(index, std::move(value), default_flags);
+	index = AddShapeProperty(ShapeProperty(key));
+	AddPropertySlot(context, index, std::move(value), default_flags);
 }
 
 bool Object::HasProperty(Context* context, ConstIndex key) {
@@ -167,8 +256,8 @@ void Object::SetPropertyWithFlags(Context* context, ConstIndex key, Value&& valu
 	}
 
 	// 添加或更新属性
-	index = shape_->shape_manager()->AddProperty(&shape_, ShapeProperty(key));
-	AddPropertySlot(index, std::move(value), flags);
+	index = AddShapeProperty(ShapeProperty(key));
+	AddPropertySlot(context, index, std::move(value), flags);
 }
 
 void Object::DefineAccessorProperty(Context* context, ConstIndex key,
@@ -230,8 +319,9 @@ bool Object::DelComputedProperty(Context* context, const Value& key, Value* valu
 Value Object::ToString(Context* context) {
 	std::string str = "{";
 
-	for (auto& slot : properties_) {
-		Value value = slot.value;
+	auto* slots = property_slots();
+	for (uint32_t i = 0; i < property_count_; ++i) {
+		Value value = slots[i].value;
 		// str += context->runtime().const_pool()[prop.first].string().data();
 		// str += ":";
 		if (value.IsObject() && &value.object() == this) {
@@ -252,7 +342,7 @@ const Value& Object::GetPrototype(Context* context) const {
 	if (tag_.set_proto_) {
 		auto index = shape_->Find(ConstIndexEmbedded::kProto);
 		assert(index != kPropertySlotIndexInvalid);
-		return properties_[index].value;
+		return property_slots()[index].value;
 	}
 	return context->runtime().class_def_table()[static_cast<ClassId>(tag_.class_id_)].prototype();
 }
@@ -264,22 +354,45 @@ void Object::SetPrototype(Context* context, Value prototype) {
 	SetProperty(context, ConstIndexEmbedded::kProto, std::move(prototype));
 }
 
+void Object::InitializeWithShape(Shape* shape, Value* values, uint32_t count) {
+	assert(property_count_ == 0 && shape_->property_size() == 0);
+	assert(shape->property_size() == count);
+
+	ReplaceShape(shape);
+
+	ReservePropertySlots(count);
+	auto* slots = property_slots();
+	for (uint32_t i = 0; i < count; ++i) {
+		FinalizerBarrier(values[i]);
+		new (&slots[i]) PropertySlot(std::move(values[i]), ShapeProperty::kDefault);
+	}
+	property_count_ = count;
+}
+
+void Object::InitializeWithPrototype(Context* context, Value prototype, uint32_t slot_capacity) {
+	// 先按预期槽数分配，后续添加属性不再扩容
+	ReservePropertySlots(std::max<uint32_t>(slot_capacity, 1));
+	tag_.set_proto_ = true;
+	InitializeWithShape(&context->shape_manager().prototype_shape(), &prototype, 1);
+}
+
 void Object::Freeze() {
 	// 1. 标记为不可扩展
 	tag_.is_extensible_ = 0;
 
 	// 2. 将所有现有属性的标志设置为不可写和不可配置
 	// 现在每个对象都有独立的属性标志，可以安全修改
-	for (uint32_t i = 0; i < properties_.size(); i++) {
-		uint32_t flags = properties_[i].flags;
+	auto* slots = property_slots();
+	for (uint32_t i = 0; i < property_count_; i++) {
+		uint32_t flags = slots[i].flags;
 
 		// 只修改数据属性，保留 accessor 的特殊标志
 		if (!(flags & (ShapeProperty::kIsGetter | ShapeProperty::kIsSetter))) {
 			// 移除 writable 和 configurable 标志
-			properties_[i].flags = flags & ~(ShapeProperty::kWritable | ShapeProperty::kConfigurable);
+			slots[i].flags = flags & ~(ShapeProperty::kWritable | ShapeProperty::kConfigurable);
 		} else {
 			// Accessor 属性只移除 configurable
-			properties_[i].flags = flags & ~ShapeProperty::kConfigurable;
+			slots[i].flags = flags & ~ShapeProperty::kConfigurable;
 		}
 	}
 
@@ -297,8 +410,9 @@ void Object::Seal() {
 	tag_.is_extensible_ = 0;
 
 	// 2. 将所有现有属性设置为不可配置
-	for (uint32_t i = 0; i < properties_.size(); i++) {
-		properties_[i].flags &= ~ShapeProperty::kConfigurable;
+	auto* slots = property_slots();
+	for (uint32_t i = 0; i < property_count_; i++) {
+		slots[i].flags &= ~ShapeProperty::kConfigurable;
 	}
 
 	// 3. 标记为已密封
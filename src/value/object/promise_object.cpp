@@ -35,6 +35,8 @@ void PromiseObject::Resolve(Context* context, Value result) {
     }
 
     state_ = State::kFulfilled;
+    MarkingBarrier(context);
+    WriteBarrier(context, result);
     result_or_reason_ = result;
 
     auto& microtask_queue = context->microtask_queue();
@@ -61,6 +63,8 @@ void PromiseObject::Reject(Context* context, Value reason) {
     }
 
     state_ = State::kRejected;
+    MarkingBarrier(context);
+    WriteBarrier(context, reason);
     result_or_reason_ = reason.SetException();
 
     auto& microtask_queue = context->microtask_queue();
@@ -126,6 +130,7 @@ Value PromiseObject::Then(Context* context, Value on_fulfilled, Value on_rejecte
 
     if (IsPending()) {
         // 挂起状态：注册回调
+        MarkingBarrier(context);
         auto fulfill_job = Job(std::move(fulfilled_handler), Value(new_promise));
         fulfill_job.AddArg(on_fulfilled);
         on_fulfill_callbacks_.emplace_back(std::move(fulfill_job));
@@ -133,6 +138,9 @@ Value PromiseObject::Then(Context* context, Value on_fulfilled, Value on_rejecte
         auto reject_job = Job(std::move(rejected_handler), Value(new_promise));
         reject_job.AddArg(on_rejected);
         on_reject_callbacks_.emplace_back(std::move(reject_job));
+
+        // 回调作业中保存了函数和新的 Promise
+        RecordWrite(context);
     }
     else if (IsFulfilled()) {
         // 已完成状态：只添加fulfill任务
@@ -0,0 +1,112 @@
+#include <mjs/value/object/typed_array_object.h>
+
+#include <charconv>
+
+#include <mjs/context.h>
+#include <mjs/const_index_embedded.h>
+
+namespace mjs {
+
+TypedArrayObject::TypedArrayObject(Context* context, TypedArrayKind kind, Value buffer, size_t byte_offset, size_t length)
+	: Object(context, KindToClassId(kind))
+	, buffer_(std::move(buffer))
+	, byte_offset_(byte_offset)
+	, length_(length)
+	, kind_(kind)
+{
+	auto& array_buffer = buffer_.object().get<ArrayBufferObject>();
+	assert(byte_offset % ElementSize(kind) == 0);
+	assert(byte_offset + length * ElementSize(kind) <= array_buffer.byte_length());
+	data_ = array_buffer.data() + byte_offset;
+}
+
+void TypedArrayObject::GCTraverse(Context* context, GCTraverseCallback callback) {
+	Object::GCTraverse(context, callback);
+	callback(context, &buffer_);
+}
+
+bool TypedArrayObject::GetProperty(Context* context, ConstIndex key, Value* value) {
+	switch (key) {
+	case ConstIndexEmbedded::kLength:
+		*value = Value(static_cast<int64_t>(length_));
+		return true;
+	case ConstIndexEmbedded::kByteLength:
+		*value = Value(static_cast<int64_t>(byte_length()));
+		return true;
+	case ConstIndexEmbedded::kByteOffset:
+		*value = Value(static_cast<int64_t>(byte_offset_));
+		return true;
+	case ConstIndexEmbedded::kBuffer:
+		*value = buffer_;
+		return true;
+	default:
+		return Object::GetProperty(context, key, value);
+	}
+}
+
+void TypedArrayObject::SetProperty(Context* context, ConstIndex key, Value&& value) {
+	switch (key) {
+	case ConstIndexEmbedded::kLength:
+	case ConstIndexEmbedded::kByteLength:
+	case ConstIndexEmbedded::kByteOffset:
+	case ConstIndexEmbedded::kBuffer:
+		// 只读属性，忽略写入
+		return;
+	default:
+		Object::SetProperty(context, key, std::move(value));
+	}
+}
+
+bool TypedArrayObject::GetComputedProperty(Context* context, const Value& key, Value* value) {
+	int64_t index;
+	if (TryKeyToIndex(key, &index)) {
+		if (!GetElement(index, value)) {
+			*value = Value();
+			return false;
+		}
+		return true;
+	}
+	return Object::GetComputedProperty(context, key, value);
+}
+
+void TypedArrayObject::SetComputedProperty(Context* context, const Value& key, Value&& value) {
+	int64_t index;
+	if (TryKeyToIndex(key, &index)) {
+		// 越界写入被忽略，不会产生命名属性
+		SetElement(index, value);
+		return;
+	}
+	Object::SetComputedProperty(context, key, std::move(value));
+}
+
+bool TypedArrayObject::TryKeyToIndex(const Value& key, int64_t* index) {
+	if (key.IsInt64()) {
+		*index = key.i64();
+		return true;
+	}
+	if (key.IsFloat()) {
+		auto number = key.f64();
+		if (std::trunc(number) != number) {
+			return false;
+		}
+		// 超出范围的整数下标一律视为越界
+		*index = std::abs(number) < 9007199254740992.0 ? static_cast<int64_t>(number) : -1;
+		return true;
+	}
+	if (key.IsString()) {
+		std::string_view str = key.string_view();
+		if (str.empty() || (str.size() > 1 && str[0] == '0')) {
+			return false;
+		}
+		uint64_t result = 0;
+		auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), result);
+		if (ec != std::errc() || ptr != str.data() + str.size() || result > INT64_MAX) {
+			return false;
+		}
+		*index = static_cast<int64_t>(result);
+		return true;
+	}
+	return false;
+}
+
+} // namespace mjs
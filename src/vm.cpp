@@ -8,6 +8,7 @@
 #include <mjs/opcode.h>
 #include <mjs/gc/handle.h>
 #include <mjs/value/object/array_object.h>
+#include <mjs/value/object/typed_array_object.h>
 #include <mjs/value/object/function_object.h>
 #include <mjs/value/object/generator_object.h>
 #include <mjs/value/object/async_object.h>
@@ -284,6 +285,12 @@ bool VM::FunctionScheduling(StackFrame* stack_frame, uint32_t par_count) {
 	} \
     break;
 
+// 检查堆限制，超过硬限制时抛出 RangeError（或终止执行）
+#define VM_HEAP_LIMIT_CHECK() \
+	if (!context_->gc_manager().heap()->CheckHeapLimit()) { \
+		VM_EXCEPTION_THROW(HeapLimitExceeded()); \
+	} \
+
 #define VM_EXCEPTION_THROW_AUTO_INC_PC(VALUE) \
 	pending_error_val = std::move(VALUE); \
 	if (!ThrowException(stack_frame, &pending_error_val, true)) { \
@@ -303,6 +310,9 @@ void VM::CallInternal(StackFrame* stack_frame, Value func_val, Value this_val, u
 	OpcodeType opcode;
 	Pc pending_goto_pc = kInvalidPc;
 	const FunctionDefBase* func_def = nullptr;
+	const StackFrame* caller_stack_frame = current_stack_frame_;
+	current_stack_frame_ = stack_frame;
+	++call_depth_;
 
 	if (!FunctionScheduling(stack_frame, param_count)) {
 		if (stack_frame->function_val().IsAsyncRejectResume()) {
@@ -318,6 +328,13 @@ void VM::CallInternal(StackFrame* stack_frame, Value func_val, Value this_val, u
 	// std::cout << stack_frame->function_def()->Disassembly(context_);
 	
 	func_def = stack_frame->function_def();
+
+	// 函数入口检查堆限制，中断失控的递归
+	if (!context_->gc_manager().heap()->CheckHeapLimit()) {
+		pending_return_val = HeapLimitExceeded();
+		goto exit_;
+	}
+
 	while (stack_frame->pc() >= 0 && func_def && stack_frame->pc() < func_def->bytecode_table().Size()) {
 		{
 			// OpcodeType opcode_; uint32_t par; auto pc = stack_frame->pc(); std::cout << func_def->bytecode_table().Disassembly(context_, pc, opcode_, par, func_def) << std::endl;
@@ -447,6 +464,14 @@ void VM::CallInternal(StackFrame* stack_frame, Value func_val, Value this_val, u
 			auto& obj_val = stack_frame->get(-1);
 			auto& obj = obj_val.object();
 
+			// 类型化数组整数下标快速路径，直接读取底层缓冲区
+			if (idx_val.IsInt64() && obj_val.IsObject() && TypedArrayObject::IsTypedArrayClassId(obj.class_id())) {
+				if (!obj.get<TypedArrayObject>().GetElement(idx_val.i64(), &obj_val)) {
+					obj_val = Value();
+				}
+				break;
+			}
+
 			auto success = obj.GetComputedProperty(context_, idx_val, &obj_val);
 			if (!success) {
 				obj_val = Value();
@@ -459,6 +484,10 @@ void VM::CallInternal(StackFrame* stack_frame, Value func_val, Value this_val, u
 			auto& obj = obj_val.object();
 
 			auto val = stack_frame->get(-1);
+			if (idx_val.IsInt64() && obj_val.IsObject() && TypedArrayObject::IsTypedArrayClassId(obj.class_id())) {
+				obj.get<TypedArrayObject>().SetElement(idx_val.i64(), val);
+				break;
+			}
 			obj.SetComputedProperty(context_, idx_val, std::move(val));
 			break;
 		}
@@ -575,8 +604,15 @@ void VM::CallInternal(StackFrame* stack_frame, Value func_val, Value this_val, u
 				// 内置类，直接调用C++的NewConstructor
 				auto target_class_id = func_val.constructor().target_class_id();
 				auto& target_class_def = context_->runtime().class_def_table()[target_class_id];
-				auto obj = target_class_def.NewConstructor(context_, param_count, *stack_frame);
+				auto param_count = stack_frame->pop().u64();
+
+				// 参数已经在栈上了，调整bottom，使 NewConstructor 通过 stack.get(i) 读取参数
+				auto new_stack_frame = StackFrame(stack_frame);
+				new_stack_frame.set_bottom(new_stack_frame.bottom() - param_count);
+				auto obj = target_class_def.NewConstructor(context_, param_count, new_stack_frame);
+				stack_frame->reduce(param_count);
 				stack_frame->push(std::move(obj));
+				VM_EXCEPTION_CHECK_AND_THROW(stack_frame->get(-1));
 				break;
 			}
 			else if (func_val.IsFunctionObject()) {
@@ -585,7 +621,7 @@ void VM::CallInternal(StackFrame* stack_frame, Value func_val, Value this_val, u
 
 				// 1. 创建新对象
 				GCHandleScope<1> scope(context_);
-				auto obj = scope.New<Object>();
+				auto obj = scope.NewForSite<Object>(&func.function_def().allocation_site());
 				auto obj_val = obj.ToValue();
 
 				// 2. 获取构造函数的 prototype 属性
@@ -596,8 +632,9 @@ void VM::CallInternal(StackFrame* stack_frame, Value func_val, Value this_val, u
 					prototype_val = object_class_def.prototype();
 				}
 
-				// 3. 设置新对象的原型
-				obj_val.object().SetPrototype(context_, prototype_val);
+				// 3. 设置新对象的原型，并按松弛追踪观察到的槽数预分配属性
+				auto& slack_tracker = func.function_def().instance_slack_tracker();
+				obj_val.object().InitializeWithPrototype(context_, std::move(prototype_val), slack_tracker.slot_count());
 
 				auto param_count = stack_frame->pop().u64();
 
@@ -616,6 +653,7 @@ void VM::CallInternal(StackFrame* stack_frame, Value func_val, Value this_val, u
 				// 5. 如果构造函数返回对象，则返回该对象；否则返回新创建的对象
 				if (ret.type() == ValueType::kUndefined || !ret.IsObject()) {
 					ret = obj_val;
+					slack_tracker.Record(obj->property_slot_count());
 				}
 			}
 			else {
@@ -695,6 +733,23 @@ void VM::CallInternal(StackFrame* stack_frame, Value func_val, Value this_val, u
 			stack_frame->push(super_prototype);
 			break;
 		}
+		case OpcodeType::kNewObjectFromBoilerplate: {
+			auto boilerplate_idx = func_def->bytecode_table().GetU16(stack_frame->pc());
+			stack_frame->set_pc(stack_frame->pc() + 2);
+			auto& boilerplate = func_def->boilerplate_table().GetObjectBoilerplate(boilerplate_idx);
+			auto* shape = context_->shape_manager().GetBoilerplateShape(boilerplate);
+			auto count = boilerplate.property_count();
+
+			GCHandleScope<1> scope(context_);
+			auto obj = scope.NewForSite<Object>(&boilerplate.allocation_site());
+
+			// 属性值已按槽位顺序入栈，分配完成后再取地址（分配可能触发GC更新栈上的值）
+			Value* values = count > 0 ? &stack_frame->get(-static_cast<ptrdiff_t>(count)) : nullptr;
+			obj->InitializeWithShape(shape, values, count);
+			stack_frame->reduce(count);
+			stack_frame->push(scope.Close(obj));
+			break;
+		}
 		case OpcodeType::kReturn: {
 			goto exit_;
 			break;
@@ -854,6 +909,8 @@ void VM::CallInternal(StackFrame* stack_frame, Value func_val, Value this_val, u
 			break;
 		}
 		case OpcodeType::kGoto: {
+			// 循环回边检查堆限制，中断失控的循环
+			VM_HEAP_LIMIT_CHECK();
 			stack_frame->set_pc(func_def->bytecode_table().CalcPc(stack_frame->pc() - 1));
 			break;
 		}
@@ -1021,7 +1078,10 @@ exit_:
 		}
 		pending_return_val = Value(String::Format("\n\t[func:{}, line:{}] {}", func, line, pending_return_val->ToString(context_).string_view())).SetException();
 
-		if (stack_frame->function_val().IsAsyncObject()
+		if (terminating_) {
+			// 终止执行时异常直接返回到宿主，不转换为 Promise 拒绝
+		}
+		else if (stack_frame->function_val().IsAsyncObject()
 			|| stack_frame->function_val().IsAsyncResolveResume() 
 			|| stack_frame->function_val().IsAsyncRejectResume()) {
 			auto& async = stack_frame->function_val().async();
@@ -1035,6 +1095,13 @@ exit_:
 	}
 
 return_:
+	current_stack_frame_ = caller_stack_frame;
+	--call_depth_;
+	if (call_depth_ == 0) {
+		// 已返回到宿主，结束终止状态
+		terminating_ = false;
+	}
+
 	// 还原栈帧
 	stack().resize(stack_frame->bottom());
 	stack_frame->push(std::move(*pending_return_val));
@@ -1044,6 +1111,11 @@ return_:
 
 
 bool VM::ThrowException(StackFrame* stack_frame, std::optional<Value>* error_val, bool need_inc_pc) {
+	if (terminating_) {
+		// 终止执行：不进入 catch 和 finally，逐层返回到宿主
+		return false;
+	}
+
 	auto& table = stack_frame->function_def()->exception_table();
 
 	auto* entry = table.FindEntry(stack_frame->pc());
@@ -1083,15 +1155,27 @@ bool VM::ThrowException(StackFrame* stack_frame, std::optional<Value>* error_val
 	return true;
 }
 
+Value VM::HeapLimitExceeded() {
+	auto* heap = context_->gc_manager().heap();
+	if (heap->heap_limit_action() == HeapLimitAction::kTerminate) {
+		terminating_ = true;
+	}
+	return RangeError::Throw(context_, "Heap limit exceeded: {} bytes in use", heap->heap_size());
+}
+
 void VM::GeneratorSaveContext(StackFrame* stack_frame, GeneratorObject* generator) {
 	// 保存当前生成器的pc
 	generator->set_pc(stack_frame->pc());
+	generator->MarkingBarrier(context_);
 
 	// 保存当前栈帧到generator的栈帧中
 	auto& gen_vector = generator->stack().vector();
 	for (int32_t i = 0; i < gen_vector.size(); ++i) {
 		gen_vector[i] = std::move(stack_frame->get(i));
 	}
+
+	// 整个栈帧被写入生成器，不逐个检查
+	generator->RecordWrite(context_);
 }
 
 void VM::GeneratorRestoreContext(StackFrame* stack_frame, GeneratorObject* generator) {
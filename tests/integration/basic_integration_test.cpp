@@ -168,6 +168,154 @@ TEST_F(BasicIntegrationTest, ObjectLiteral) {
     )");
 }
 
+TEST_F(BasicIntegrationTest, ObjectLiteralBoilerplate) {
+    // 测试静态键对象字面量（按样板创建），多次创建后属性互不影响，且可继续添加属性
+    AssertTrue(R"(
+        let list = [];
+        for (let i = 0; i < 100; i++) {
+            list.push({ a: i, b: i * 2, c: 'c' + i });
+        }
+        list[7].d = 1;
+        list[0].a === 0 && list[99].b === 198 && list[42].c === 'c42' &&
+            list[7].d === 1 && list[8].d === undefined;
+    )");
+
+    // 空对象、重复键仍保持原有语义
+    AssertTrue(R"(
+        let empty = {};
+        empty.x = 1;
+        let dup = { k: 1, k: 2 };
+        empty.x === 1 && dup.k === 2;
+    )");
+}
+
+TEST_F(BasicIntegrationTest, ArraySort) {
+    // 默认比较按字符串顺序，undefined 排在末尾，空洞保留在最后
+    AssertTrue(R"(
+        let nums = [10, 9, -1, 100, 1, -12];
+        nums.sort();
+        nums[0] === -1 && nums[1] === -12 && nums[2] === 1 && nums[3] === 10 && nums[4] === 100 && nums[5] === 9;
+    )");
+
+    AssertTrue(R"(
+        let words = ['pear', 'apple', 'fig', 'apple'];
+        let sorted = words.toSorted();
+        words[0] === 'pear' && sorted[0] === 'apple' && sorted[1] === 'apple' && sorted[2] === 'fig' && sorted[3] === 'pear';
+    )");
+
+    AssertTrue(R"(
+        let mixed = [3, undefined, 'b', 1.5];
+        mixed[6] = 'a';
+        mixed.sort();
+        mixed[0] === 1.5 && mixed[1] === 3 && mixed[2] === 'a' && mixed[3] === 'b' &&
+            mixed[4] === undefined && mixed.length === 7;
+    )");
+
+    // 比较函数：稳定排序，返回 this
+    AssertTrue(R"(
+        let items = [{ k: 2, v: 'a' }, { k: 1, v: 'b' }, { k: 2, v: 'c' }, { k: 1, v: 'd' }];
+        let same = items.sort((x, y) => x.k - y.k);
+        same.push(0);
+        items.length === 5 && items[0].v === 'b' && items[1].v === 'd' && items[2].v === 'a' && items[3].v === 'c';
+    )");
+
+    AssertTrue(R"(
+        let desc = [5, 1, 4, 2, 3].toSorted((a, b) => b - a);
+        desc[0] === 5 && desc[1] === 4 && desc[4] === 1;
+    )");
+}
+
+TEST_F(BasicIntegrationTest, ArrayBulkMethods) {
+    // join：空洞、undefined、null 为空串
+    AssertTrue(R"(
+        let holes = [1, undefined, 'x', null, 2.5];
+        holes[7] = -30;
+        [1, 22, -333].join() === '1,22,-333' && [].join() === '' && ['a', 'b'].join('') === 'ab' &&
+            holes.join('-') === '1--x--2.5----30';
+    )");
+
+    // slice / concat 保留空洞，不修改原数组
+    AssertTrue(R"(
+        let arr = [0, 1, 2, 3, 4];
+        let part = arr.slice(1, -1);
+        let tail = arr.slice(-2);
+        let joined = arr.concat([5, 6], 7, ['s']);
+        part.length === 3 && part[0] === 1 && part[2] === 3 && tail[0] === 3 && tail.length === 2 &&
+            joined.length === 9 && joined[6] === 6 && joined[7] === 7 && joined[8] === 's' && arr.length === 5;
+    )");
+
+    // splice：返回被删除的元素，之后的元素整体移动
+    AssertTrue(R"(
+        let arr = [0, 1, 2, 3, 4, 5];
+        let removed = arr.splice(1, 2, 'a', 'b', 'c');
+        let removed2 = arr.splice(-2);
+        removed.length === 2 && removed[0] === 1 && removed[1] === 2 &&
+            arr.length === 5 && arr[1] === 'a' && arr[3] === 'c' && arr[4] === 3 &&
+            removed2.length === 2 && removed2[0] === 4 && removed2[1] === 5;
+    )");
+
+    // indexOf / includes：数值按数学值比较，includes 能找到 NaN
+    AssertTrue(R"(
+        let ints = [];
+        for (let i = 0; i < 100; i++) {
+            ints.push(i * 3);
+        }
+        let floats = [0.5, 1.5, 0 / 0];
+        ints.indexOf(99) === 33 && ints.indexOf(100) === -1 && ints.indexOf(0, 1) === -1 &&
+            ints.indexOf(297, -1) === 99 && floats.indexOf(1.5) === 1 &&
+            floats.indexOf(0 / 0) === -1 && floats.includes(0 / 0) && ints.includes('3') === false &&
+            ['a', 'b'].indexOf('b') === 1 && ['a', 'b'].includes('c') === false;
+    )");
+
+    // fill：填满后的数组可以继续按下标读写
+    AssertTrue(R"(
+        let filled = new Array(4).fill(7);
+        let partial = [1, 2, 3, 4].fill(0, 1, -1);
+        filled.length === 4 && filled[0] === 7 && filled[3] === 7 &&
+            partial[0] === 1 && partial[1] === 0 && partial[2] === 0 && partial[3] === 4;
+    )");
+}
+
+TEST_F(BasicIntegrationTest, TypedArrays) {
+    // 测试类型化数组：按元素类型截断，越界访问返回 undefined
+    AssertTrue(R"(
+        let bytes = new Uint8Array(4);
+        bytes[0] = 300;
+        bytes[1] = -1;
+        bytes[9] = 1;
+        bytes[0] === 44 && bytes[1] === 255 && bytes[9] === undefined && bytes.length === 4;
+    )");
+
+    AssertEq(R"(
+        let values = new Float64Array([0.5, 1.5, 2]);
+        let sum = 0;
+        for (let i = 0; i < values.length; i++) {
+            sum = sum + values[i];
+        }
+        sum;
+    )", Value(4.0));
+
+    // 共享同一个 ArrayBuffer 的视图互相可见
+    AssertTrue(R"(
+        let buffer = new ArrayBuffer(8);
+        let ints = new Int32Array(buffer);
+        let tail = new Uint8Array(buffer, 4, 4);
+        ints[1] = 258;
+        buffer.byteLength === 8 && ints.length === 2 && tail.byteOffset === 4 && tail[0] + tail[1] === 3;
+    )");
+}
+
+TEST_F(BasicIntegrationTest, DataView) {
+    AssertTrue(R"(
+        let view = new DataView(new ArrayBuffer(24), 4);
+        view.setInt32(0, -2);
+        view.setInt32(4, 1, true);
+        view.setFloat64(8, 1.25);
+        view.getUint8(3) === 254 && view.getInt32(0) === -2 && view.getUint8(4) === 1 &&
+            view.getInt32(4, true) === 1 && view.getFloat64(8) === 1.25 && view.byteLength === 20;
+    )");
+}
+
 // ==================== 控制流 ====================
 
 TEST_F(BasicIntegrationTest, IfStatement) {
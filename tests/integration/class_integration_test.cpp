@@ -935,6 +935,34 @@ TEST_F(ClassIntegrationTest, EmptyClassFields) {
     )");
 }
 
+TEST_F(ClassIntegrationTest, ManyInstancesAfterSlackTracking) {
+    // 测试超过松弛追踪次数后创建的实例（预分配槽位），以及实例大小不一致的情况
+    AssertTrue(R"(
+        class Vec {
+            z = 0;
+            constructor(x, y) {
+                this.x = x;
+                this.y = y;
+                if (x > 50) {
+                    this.big = true;
+                }
+            }
+
+            sum() {
+                return this.x + this.y + this.z;
+            }
+        }
+
+        let list = [];
+        for (let i = 0; i < 100; i++) {
+            list.push(new Vec(i, i * 2));
+        }
+        list[3].extra = 'e';
+        list[99].sum() === 297 && list[10].big === undefined && list[60].big === true &&
+            list[3].extra === 'e' && list[4].extra === undefined && list[0] instanceof Vec;
+    )");
+}
+
 // ==================== 类字段和方法的交互 ====================
 
 TEST_F(ClassIntegrationTest, FieldsAndMethodsInteraction) {
@@ -9,6 +9,8 @@
 #include "test_helper.h"
 #include <gtest/gtest.h>
 
+#include <mjs/context.h>
+
 namespace mjs::test {
 
 /**
@@ -448,4 +450,63 @@ TEST_F(ExceptionIntegrationTest, MultipleCatchBlocks) {
     )", Value("TypeError: Type error"));
 }
 
+// ==================== 堆限制 ====================
+
+TEST_F(ExceptionIntegrationTest, HeapHardLimitThrowsRangeError) {
+    // 失控的分配循环超过硬限制后抛出异常，返回到宿主而不是耗尽内存
+    auto& gc = context()->gc_manager();
+    gc.SetHeapLimits(0, gc.heap()->heap_size() + 4 * 1024 * 1024);
+    auto result = Exec(R"(
+        let list = [];
+        while (true) {
+            list.push([1, 2, 3, 4]);
+        }
+    )");
+    ASSERT_TRUE(result.IsException());
+    EXPECT_NE(std::string(result.string_view()).find("Heap limit exceeded"), std::string::npos);
+}
+
+TEST_F(ExceptionIntegrationTest, HeapHardLimitErrorIsCatchable) {
+    auto& gc = context()->gc_manager();
+    gc.SetHeapLimits(0, gc.heap()->heap_size() + 4 * 1024 * 1024);
+    AssertEq(R"(
+        let caught = false;
+        try {
+            let list = [];
+            while (true) {
+                list.push([1, 2, 3, 4]);
+            }
+        } catch (e) {
+            caught = true;
+        }
+        return caught;
+    )", Value(true));
+}
+
+TEST_F(ExceptionIntegrationTest, HeapHardLimitTerminatesExecution) {
+    // 终止执行时 catch 不会捕获，之后放宽限制可以继续执行
+    GCHeapConfig config;
+    config.heap_limit_action = HeapLimitAction::kTerminate;
+    Context context(runtime(), config);
+    auto& gc = context.gc_manager();
+    gc.SetHeapLimits(0, gc.heap()->heap_size() + 4 * 1024 * 1024);
+    auto result = context.Eval("terminate_test", R"(
+        let list = [];
+        try {
+            while (true) {
+                list.push([1, 2, 3, 4]);
+            }
+        } catch (e) {
+            return 'caught';
+        }
+        return 'finished';
+    )");
+    EXPECT_TRUE(result.IsException());
+
+    gc.SetHeapLimits(0, 0);
+    result = context.Eval("after_terminate_test", "return 1 + 1;");
+    ASSERT_FALSE(result.IsException());
+    EXPECT_EQ(result.ToNumber().f64(), 2);
+}
+
 } // namespace mjs::test
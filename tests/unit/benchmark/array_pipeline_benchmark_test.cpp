@@ -0,0 +1,103 @@
+/**
+ * @file array_pipeline_benchmark_test.cpp
+ * @brief 数组高阶方法基准测试
+ *
+ * 测量 100 万个元素的 map/filter/reduce 链式调用耗时，
+ * 覆盖原生方法复用栈帧调用回调的路径。
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+
+namespace mjs {
+namespace test {
+
+/**
+ * @class ArrayPipelineBenchmarkTest
+ * @brief 数组高阶方法基准测试
+ */
+class ArrayPipelineBenchmarkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+        context_ = std::make_unique<Context>(runtime_.get());
+    }
+
+    void TearDown() override {
+        context_.reset();
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 执行脚本并返回耗时（毫秒）
+     */
+    double EvalMs(const std::string& module_name, const std::string& code, Value* result) {
+        auto start = std::chrono::steady_clock::now();
+        *result = context_->Eval(module_name, code);
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+    std::unique_ptr<Context> context_;
+};
+
+/**
+ * @test 100 万个元素的 map/filter/reduce 链
+ */
+TEST_F(ArrayPipelineBenchmarkTest, MapFilterReduceChain) {
+    const std::string build = R"(
+        const n = 1000000;
+        const arr = [];
+        for (let i = 0; i < n; i += 1) {
+            arr.push(i);
+        }
+    )";
+
+    Value result;
+    auto build_ms = EvalMs("array_pipeline_build", build + "arr.length;", &result);
+    ASSERT_FALSE(result.IsException()) << result.ToString(context_.get()).string_view();
+
+    auto total_ms = EvalMs("array_pipeline_chain", build + R"(
+        arr.map((x) => x * 2)
+            .filter((x) => x % 3 == 0)
+            .reduce((acc, x) => acc + x, 0);
+    )", &result);
+    ASSERT_FALSE(result.IsException()) << result.ToString(context_.get()).string_view();
+
+    // 2 * (0 + 3 + 6 + ... + 999999)
+    EXPECT_DOUBLE_EQ(result.ToNumber().f64(), 333333666666.0);
+
+    std::cout << "[array pipeline] elements=1000000 build=" << build_ms
+        << "ms map/filter/reduce=" << (total_ms - build_ms) << "ms" << std::endl;
+}
+
+/**
+ * @test forEach 回调按顺序访问元素并跳过空洞
+ */
+TEST_F(ArrayPipelineBenchmarkTest, ForEachSkipsHoles) {
+    Value result;
+    EvalMs("array_pipeline_for_each", R"(
+        const arr = [1, 2, 3];
+        arr[5] = 6;
+        let sum = 0;
+        let count = 0;
+        arr.forEach((x, i) => { sum += x * i; count += 1; });
+        sum * 100 + count;
+    )", &result);
+    ASSERT_FALSE(result.IsException()) << result.ToString(context_.get()).string_view();
+    // 1*0 + 2*1 + 3*2 + 6*5 = 38，共 4 个元素
+    EXPECT_DOUBLE_EQ(result.ToNumber().f64(), 3804.0);
+}
+
+} // namespace test
+} // namespace mjs
@@ -0,0 +1,144 @@
+/**
+ * @file array_sort_benchmark_test.cpp
+ * @brief Array.prototype.sort 基准测试
+ *
+ * 测量 100 万个整数、100 万个字符串按默认比较排序的耗时，
+ * 以及通过比较函数（稳定归并排序）排序的耗时。
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/value/object/array_object.h>
+
+namespace mjs {
+namespace test {
+
+/**
+ * @class ArraySortBenchmarkTest
+ * @brief Array.prototype.sort 基准测试
+ */
+class ArraySortBenchmarkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+        context_ = std::make_unique<Context>(runtime_.get());
+    }
+
+    void TearDown() override {
+        context_.reset();
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 执行脚本并返回耗时（毫秒）
+     */
+    double EvalMs(const std::string& module_name, const std::string& code, Value* result) {
+        auto start = std::chrono::steady_clock::now();
+        *result = context_->Eval(module_name, code);
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+    std::unique_ptr<Context> context_;
+};
+
+/**
+ * @test 100 万个整数按默认比较（字符串顺序）排序
+ */
+TEST_F(ArraySortBenchmarkTest, SortOneMillionNumbers) {
+    Value result;
+    auto total_ms = EvalMs("array_sort_numbers", R"(
+        const arr = [];
+        let x = 12345;
+        for (let i = 0; i < 1000000; i += 1) {
+            x = (x * 1103515245 + 12345) % 2147483648;
+            arr.push(x);
+        }
+        arr.sort();
+    )", &result);
+    ASSERT_TRUE(result.IsArrayObject()) << result.ToString(context_.get()).string_view();
+
+    auto& arr = result.array();
+    ASSERT_EQ(arr.GetLength(), 1000000);
+    Value prev, cur;
+    arr.GetElement(context_.get(), 0, &prev);
+    for (size_t i = 1; i < arr.GetLength(); ++i) {
+        arr.GetElement(context_.get(), i, &cur);
+        ASSERT_LE(std::to_string(prev.i64()), std::to_string(cur.i64())) << "index " << i;
+        prev = cur;
+    }
+
+    std::cout << "[array sort] numbers=1000000 build+sort=" << total_ms << "ms" << std::endl;
+}
+
+/**
+ * @test 100 万个字符串按默认比较排序
+ */
+TEST_F(ArraySortBenchmarkTest, SortOneMillionStrings) {
+    Value result;
+    auto total_ms = EvalMs("array_sort_strings", R"(
+        const arr = [];
+        let x = 54321;
+        for (let i = 0; i < 1000000; i += 1) {
+            x = (x * 1103515245 + 12345) % 2147483648;
+            arr.push('key' + x);
+        }
+        arr.sort();
+    )", &result);
+    ASSERT_TRUE(result.IsArrayObject()) << result.ToString(context_.get()).string_view();
+
+    auto& arr = result.array();
+    ASSERT_EQ(arr.GetLength(), 1000000);
+    Value prev, cur;
+    arr.GetElement(context_.get(), 0, &prev);
+    for (size_t i = 1; i < arr.GetLength(); ++i) {
+        arr.GetElement(context_.get(), i, &cur);
+        ASSERT_LE(std::string_view(prev.string_view()), std::string_view(cur.string_view())) << "index " << i;
+        prev = cur;
+    }
+
+    std::cout << "[array sort] strings=1000000 build+sort=" << total_ms << "ms" << std::endl;
+}
+
+/**
+ * @test 通过比较函数排序（稳定归并排序 + 复用栈帧调用）
+ */
+TEST_F(ArraySortBenchmarkTest, SortWithComparator) {
+    Value result;
+    auto total_ms = EvalMs("array_sort_comparator", R"(
+        const arr = [];
+        let x = 777;
+        for (let i = 0; i < 100000; i += 1) {
+            x = (x * 1103515245 + 12345) % 2147483648;
+            arr.push(x);
+        }
+        arr.sort((a, b) => a - b);
+    )", &result);
+    ASSERT_TRUE(result.IsArrayObject()) << result.ToString(context_.get()).string_view();
+
+    auto& arr = result.array();
+    ASSERT_EQ(arr.GetLength(), 100000);
+    Value prev, cur;
+    arr.GetElement(context_.get(), 0, &prev);
+    for (size_t i = 1; i < arr.GetLength(); ++i) {
+        arr.GetElement(context_.get(), i, &cur);
+        ASSERT_LE(prev.i64(), cur.i64()) << "index " << i;
+        prev = cur;
+    }
+
+    std::cout << "[array sort] comparator elements=100000 build+sort=" << total_ms << "ms" << std::endl;
+}
+
+} // namespace test
+} // namespace mjs
@@ -0,0 +1,215 @@
+/**
+ * @file concurrent_marking_benchmark_test.cpp
+ * @brief 老年代并发标记停顿基准测试
+ *
+ * 在老年代中构造指定大小的存活对象图，主线程不断替换其中一部分子图并分配临时对象，
+ * 分别使用暂停式标记、并发标记和增量标记回收老年代，输出各方式的停顿时间直方图。
+ * 增量标记每轮分配后执行一步，每步期限为 1ms。
+ *
+ * 老年代大小通过环境变量 MJS_GC_BENCH_HEAP_MB 指定（默认 16MB），例如设置为 1024 测量 1GB 堆。
+ * 机器核心数不足 2 个时后台线程无法与主线程并行，只输出结果，不检查停顿。
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/gc/handle.h>
+#include <mjs/value/object/array_object.h>
+
+namespace mjs {
+namespace test {
+
+/**
+ * @class ConcurrentMarkingBenchmarkTest
+ * @brief 老年代并发标记停顿基准测试
+ */
+class ConcurrentMarkingBenchmarkTest : public ::testing::Test {
+protected:
+    static constexpr size_t kLeafCount = 256;          ///< 每个子图中的叶子数组数量
+    static constexpr int kRounds = 5;                  ///< 老年代回收次数
+    static constexpr size_t kChurnObjects = 20000;     ///< 每轮分配的临时对象数量
+    static constexpr size_t kStepChurnObjects = 500;   ///< 增量标记每步之间分配的临时对象数量
+
+    enum class Mode {
+        kStopTheWorld,
+        kConcurrent,
+        kIncremental,
+    };
+
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+        heap_mb_ = 16;
+        if (auto* env = std::getenv("MJS_GC_BENCH_HEAP_MB")) {
+            heap_mb_ = std::max<size_t>(1, std::strtoull(env, nullptr, 10));
+        }
+    }
+
+    void TearDown() override {
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 构造一个子图，构造期间可能触发GC，子图通过根引用保持更新
+     */
+    static Value NewBranch(Context* context) {
+        auto& gc = context->gc_manager();
+        Value branch;
+        {
+            GCHandleScope<1> scope(context);
+            branch = scope.New<ArrayObject>(0).ToValue();
+        }
+        gc.AddRoot(&branch);
+        for (size_t i = 0; i < kLeafCount; ++i) {
+            GCHandleScope<1> scope(context);
+            auto leaf = scope.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+            branch.array().Push(context, leaf.ToValue());
+        }
+        gc.RemoveRoot(&branch);
+        return branch;
+    }
+
+    static void Churn(Context* context, size_t count = kChurnObjects) {
+        for (size_t i = 0; i < count; ++i) {
+            GCHandleScope<1> scope(context);
+            scope.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+        }
+    }
+
+    /**
+     * @brief 返回整个过程（包括构造对象图）的停顿统计
+     */
+    GCHeapStats Measure(Mode mode) {
+        GCHeapConfig config;
+        config.adaptive_new_space = false;
+        config.concurrent_marking = mode == Mode::kConcurrent;
+        config.incremental_marking = mode == Mode::kIncremental;
+        // 由基准测试控制老年代回收的时机，两种方式回收的次数相同
+        config.concurrent_marking_start_ratio = 2.0;
+        auto context = std::make_unique<Context>(runtime_.get(), config);
+        auto& gc = context->gc_manager();
+
+        Value root;
+        {
+            GCHandleScope<1> scope(context.get());
+            root = scope.New<ArrayObject>(0).ToValue();
+        }
+        gc.AddRoot(&root);
+
+        // 构造老年代对象图，直到老年代使用量达到目标大小
+        GCHeapStats stats;
+        do {
+            for (int i = 0; i < 16; ++i) {
+                auto branch = NewBranch(context.get());
+                root.array().Push(context.get(), std::move(branch));
+            }
+            for (int i = 0; i <= kTenureAgeThreshold; ++i) {
+                gc.CollectGarbage(false);
+            }
+            gc.GetHeapStats(&stats);
+        } while (stats.old_space_used < heap_mb_ * 1024 * 1024);
+        size_t branch_count = root.array().GetLength();
+
+        for (int round = 0; round < kRounds; ++round) {
+            // 替换八分之一的子图，旧子图成为老年代垃圾
+            for (size_t i = round; i < branch_count; i += 8) {
+                auto branch = NewBranch(context.get());
+                root.array().SetElement(context.get(), i, std::move(branch));
+            }
+
+            if (mode == Mode::kStopTheWorld) {
+                Churn(context.get());
+                gc.CollectGarbage(true);
+                continue;
+            }
+
+            gc.StartConcurrentMarking();
+            if (mode == Mode::kIncremental) {
+                // 主线程交替执行分配和标记步骤
+                do {
+                    Churn(context.get(), kStepChurnObjects);
+                } while (!gc.Step(std::chrono::steady_clock::now() + std::chrono::milliseconds(1)));
+                continue;
+            }
+            // 标记期间主线程继续运行，标记完成后可能已在某次Scavenge中自动结束
+            do {
+                Churn(context.get());
+                std::this_thread::yield();
+            } while (gc.heap()->is_marking() && !gc.heap()->IsConcurrentMarkingComplete());
+            if (gc.heap()->is_marking()) {
+                gc.CollectGarbage(true);
+            }
+        }
+
+        Value branch;
+        root.array().GetElement(context.get(), branch_count - 1, &branch);
+        Value leaf;
+        branch.array().GetElement(context.get(), kLeafCount - 1, &leaf);
+        Value element;
+        leaf.array().GetElement(context.get(), 0, &element);
+        EXPECT_EQ(element.i64(), static_cast<int64_t>(kLeafCount - 1));
+
+        gc.GetHeapStats(&stats);
+        gc.RemoveRoot(&root);
+        return stats;
+    }
+
+    static void PrintHistogram(const char* name, const GCHeapStats& stats) {
+        std::cout << "[concurrent marking] " << name
+            << " pauses=" << stats.pause_count
+            << " steps=" << stats.incremental_step_count
+            << " total=" << stats.total_pause_ms << "ms"
+            << " max=" << stats.max_pause_ms << "ms" << std::endl;
+        for (size_t i = 0; i < kGCPauseHistogramBuckets; ++i) {
+            if (stats.pause_histogram[i] == 0) {
+                continue;
+            }
+            std::cout << "    ";
+            if (i + 1 < kGCPauseHistogramBuckets) {
+                std::cout << "< " << GCPauseBucketLimitUs(i) << "us";
+            }
+            else {
+                std::cout << ">= " << GCPauseBucketLimitUs(i - 1) << "us";
+            }
+            std::cout << ": " << stats.pause_histogram[i] << std::endl;
+        }
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+    size_t heap_mb_ = 0;
+};
+
+/**
+ * @test 并发标记的老年代停顿短于暂停式标记，增量标记将标记拆分为多个步骤
+ */
+TEST_F(ConcurrentMarkingBenchmarkTest, PauseHistogram) {
+    auto stw = Measure(Mode::kStopTheWorld);
+    auto concurrent = Measure(Mode::kConcurrent);
+    auto incremental = Measure(Mode::kIncremental);
+    auto cores = std::thread::hardware_concurrency();
+
+    std::cout << "[concurrent marking] heap=" << heap_mb_ << "MB cores=" << cores << std::endl;
+    PrintHistogram("stop-the-world", stw);
+    PrintHistogram("concurrent", concurrent);
+    PrintHistogram("incremental", incremental);
+
+    EXPECT_EQ(concurrent.concurrent_marking_count, static_cast<uint32_t>(kRounds));
+    EXPECT_EQ(incremental.concurrent_marking_count, static_cast<uint32_t>(kRounds));
+    EXPECT_GT(incremental.incremental_step_count, static_cast<uint32_t>(kRounds));
+    if (cores >= 2) {
+        EXPECT_LT(concurrent.max_pause_ms, stw.max_pause_ms);
+    }
+}
+
+} // namespace test
+} // namespace mjs
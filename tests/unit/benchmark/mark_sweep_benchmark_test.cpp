@@ -0,0 +1,168 @@
+/**
+ * @file mark_sweep_benchmark_test.cpp
+ * @brief 老年代标记-清除与标记-压缩的完整GC停顿基准测试
+ *
+ * 在老年代中构造指定大小的存活对象图，每轮替换其中八分之一的子图后执行完整GC，
+ * 分别使用标记-清除（低碎片率时的默认方式）和标记-压缩，输出两种方式的完整GC停顿时间。
+ * 清除方式的停顿只包括标记，死亡对象在之后的分配中惰性清除。
+ *
+ * 老年代大小通过环境变量 MJS_GC_BENCH_HEAP_MB 指定（默认 16MB）。
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/gc/handle.h>
+#include <mjs/value/object/array_object.h>
+
+namespace mjs {
+namespace test {
+
+/**
+ * @class MarkSweepBenchmarkTest
+ * @brief 老年代标记-清除停顿基准测试
+ */
+class MarkSweepBenchmarkTest : public ::testing::Test {
+protected:
+    static constexpr size_t kLeafCount = 256;          ///< 每个子图中的叶子数组数量
+    static constexpr int kRounds = 5;                  ///< 完整GC次数
+    static constexpr size_t kChurnObjects = 20000;     ///< 每轮分配的临时对象数量
+
+    struct Result {
+        double total_ms = 0;        ///< 完整GC总时间
+        double max_ms = 0;          ///< 最长的完整GC时间
+        GCHeapStats stats;          ///< 结束时的堆统计
+    };
+
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+        heap_mb_ = 16;
+        if (auto* env = std::getenv("MJS_GC_BENCH_HEAP_MB")) {
+            heap_mb_ = std::max<size_t>(1, std::strtoull(env, nullptr, 10));
+        }
+    }
+
+    void TearDown() override {
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 构造一个子图，构造期间可能触发GC，子图通过根引用保持更新
+     */
+    static Value NewBranch(Context* context) {
+        auto& gc = context->gc_manager();
+        Value branch;
+        {
+            GCHandleScope<1> scope(context);
+            branch = scope.New<ArrayObject>(0).ToValue();
+        }
+        gc.AddRoot(&branch);
+        for (size_t i = 0; i < kLeafCount; ++i) {
+            GCHandleScope<1> scope(context);
+            auto leaf = scope.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+            branch.array().Push(context, leaf.ToValue());
+        }
+        gc.RemoveRoot(&branch);
+        return branch;
+    }
+
+    Result Measure(bool sweeping) {
+        GCHeapConfig config;
+        config.adaptive_new_space = false;
+        config.old_space_sweeping = sweeping;
+        auto context = std::make_unique<Context>(runtime_.get(), config);
+        auto& gc = context->gc_manager();
+
+        Value root;
+        {
+            GCHandleScope<1> scope(context.get());
+            root = scope.New<ArrayObject>(0).ToValue();
+        }
+        gc.AddRoot(&root);
+
+        GCHeapStats stats;
+        do {
+            for (int i = 0; i < 16; ++i) {
+                auto branch = NewBranch(context.get());
+                root.array().Push(context.get(), std::move(branch));
+            }
+            for (int i = 0; i <= kTenureAgeThreshold; ++i) {
+                gc.CollectGarbage(false);
+            }
+            gc.GetHeapStats(&stats);
+        } while (stats.old_space_used < heap_mb_ * 1024 * 1024);
+        size_t branch_count = root.array().GetLength();
+
+        Result result;
+        for (int round = 0; round < kRounds; ++round) {
+            // 替换八分之一的子图，旧子图成为老年代垃圾
+            for (size_t i = round; i < branch_count; i += 8) {
+                auto branch = NewBranch(context.get());
+                root.array().SetElement(context.get(), i, std::move(branch));
+            }
+            for (size_t i = 0; i < kChurnObjects; ++i) {
+                GCHandleScope<1> scope(context.get());
+                scope.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            gc.CollectGarbage(true);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            result.total_ms += ms;
+            result.max_ms = std::max(result.max_ms, ms);
+        }
+
+        Value branch;
+        root.array().GetElement(context.get(), branch_count - 1, &branch);
+        Value leaf;
+        branch.array().GetElement(context.get(), kLeafCount - 1, &leaf);
+        Value element;
+        leaf.array().GetElement(context.get(), 0, &element);
+        EXPECT_EQ(element.i64(), static_cast<int64_t>(kLeafCount - 1));
+
+        gc.GetHeapStats(&result.stats);
+        gc.RemoveRoot(&root);
+        return result;
+    }
+
+    static void Print(const char* name, const Result& result) {
+        std::cout << "[mark sweep] " << name
+            << " full_gc_total=" << result.total_ms << "ms"
+            << " full_gc_max=" << result.max_ms << "ms"
+            << " old_used=" << result.stats.old_space_used
+            << " old_free=" << result.stats.old_space_free
+            << " old_capacity=" << result.stats.old_space_capacity << std::endl;
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+    size_t heap_mb_ = 0;
+};
+
+/**
+ * @test 低碎片率时标记-清除的完整GC停顿短于标记-压缩
+ */
+TEST_F(MarkSweepBenchmarkTest, FullGCPause) {
+    auto compact = Measure(false);
+    auto sweep = Measure(true);
+
+    std::cout << "[mark sweep] heap=" << heap_mb_ << "MB" << std::endl;
+    Print("mark-compact", compact);
+    Print("mark-sweep", sweep);
+
+    EXPECT_EQ(compact.stats.compaction_count, static_cast<uint32_t>(kRounds));
+    EXPECT_EQ(sweep.stats.mark_sweep_count, static_cast<uint32_t>(kRounds));
+    EXPECT_EQ(sweep.stats.compaction_count, 0u);
+    EXPECT_LT(sweep.total_ms, compact.total_ms);
+}
+
+} // namespace test
+} // namespace mjs
@@ -0,0 +1,119 @@
+/**
+ * @file parallel_scavenge_benchmark_test.cpp
+ * @brief 并行 Scavenge 停顿基准测试
+ *
+ * 在较大的新生代中构造相同的存活对象图，分别用 1 个线程和 8 个线程执行 Scavenge，
+ * 比较停顿时间。机器核心数不足 8 个时只输出结果，不检查加速比。
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/gc/handle.h>
+#include <mjs/value/object/array_object.h>
+
+namespace mjs {
+namespace test {
+
+/**
+ * @class ParallelScavengeBenchmarkTest
+ * @brief 并行 Scavenge 停顿基准测试
+ */
+class ParallelScavengeBenchmarkTest : public ::testing::Test {
+protected:
+    static constexpr size_t kBranchCount = 64;          ///< 根数组引用的子数组数量
+    static constexpr size_t kLeafCount = 1000;          ///< 每个子数组引用的叶子数组数量
+    static constexpr int kRounds = 5;                   ///< 测量轮数
+
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+    }
+
+    void TearDown() override {
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 使用 thread_count 个线程，返回 Scavenge 停顿的中位数（毫秒）
+     */
+    double MeasureScavengeMs(uint32_t thread_count) {
+        GCHeapConfig config;
+        config.new_space_size = 64 * 1024 * 1024;
+        config.adaptive_new_space = false;
+        config.scavenge_threads = thread_count;
+        auto context = std::make_unique<Context>(runtime_.get(), config);
+        auto& gc = context->gc_manager();
+
+        std::vector<double> samples;
+        for (int round = 0; round < kRounds; ++round) {
+            // 每轮构造新的对象图，Scavenge 时全部存活并复制到 Survivor 区
+            Value root;
+            {
+                GCHandleScope<1> scope(context.get());
+                root = scope.New<ArrayObject>(0).ToValue();
+            }
+            gc.AddRoot(&root);
+            for (size_t i = 0; i < kBranchCount; ++i) {
+                GCHandleScope<1> scope(context.get());
+                auto branch = scope.New<ArrayObject>(0);
+                for (size_t j = 0; j < kLeafCount; ++j) {
+                    GCHandleScope<1> inner(context.get());
+                    auto leaf = inner.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(j)) });
+                    branch->Push(context.get(), leaf.ToValue());
+                }
+                root.array().Push(context.get(), branch.ToValue());
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            gc.CollectGarbage(false);
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+
+            Value branch;
+            root.array().GetElement(context.get(), kBranchCount - 1, &branch);
+            Value leaf;
+            branch.array().GetElement(context.get(), kLeafCount - 1, &leaf);
+            Value element;
+            leaf.array().GetElement(context.get(), 0, &element);
+            EXPECT_EQ(element.i64(), static_cast<int64_t>(kLeafCount - 1));
+
+            gc.RemoveRoot(&root);
+        }
+
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+};
+
+/**
+ * @test 8 个线程的 Scavenge 停顿短于单线程
+ */
+TEST_F(ParallelScavengeBenchmarkTest, PauseWithEightThreads) {
+    auto serial_ms = MeasureScavengeMs(1);
+    auto parallel_ms = MeasureScavengeMs(8);
+    auto cores = std::thread::hardware_concurrency();
+
+    std::cout << "[parallel scavenge] live_objects=" << kBranchCount * (kLeafCount + 1)
+        << " cores=" << cores
+        << " threads=1 pause=" << serial_ms << "ms"
+        << " threads=8 pause=" << parallel_ms << "ms" << std::endl;
+
+    if (cores >= 8) {
+        EXPECT_LT(parallel_ms, serial_ms);
+    }
+}
+
+} // namespace test
+} // namespace mjs
@@ -0,0 +1,151 @@
+/**
+ * @file pointer_compression_benchmark_test.cpp
+ * @brief 指针压缩的内存和吞吐量基准测试
+ *
+ * 报告当前构建模式下对象头部和普通对象的大小、保留大量小对象时每个对象占用的堆内存，
+ * 以及创建对象并读写属性的脚本的耗时。
+ * 分别以默认配置和 -DENABLE_POINTER_COMPRESSION=ON 构建后运行，对比两次输出即为 A/B 结果。
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/gc/handle.h>
+#include <mjs/gc/heap_cage.h>
+#include <mjs/value/string.h>
+#include <mjs/value/object/array_object.h>
+
+namespace mjs {
+namespace test {
+
+#ifdef ENABLE_POINTER_COMPRESSION
+constexpr const char* kCompressionMode = "on";
+#else
+constexpr const char* kCompressionMode = "off";
+#endif
+
+/**
+ * @class PointerCompressionBenchmarkTest
+ * @brief 指针压缩基准测试
+ */
+class PointerCompressionBenchmarkTest : public ::testing::Test {
+protected:
+    static constexpr size_t kObjectCount = 100000;     ///< 保留的对象数量
+
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+        context_ = std::make_unique<Context>(runtime_.get());
+        heap_ = context_->gc_manager().heap();
+    }
+
+    void TearDown() override {
+        context_.reset();
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 获取新生代、老年代和大对象空间已使用的字节数
+     */
+    size_t HeapUsed() {
+        GCHeapStats stats;
+        heap_->GetHeapStats(&stats);
+        return stats.new_space_used + stats.old_space_used + stats.large_object_space_used;
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+    std::unique_ptr<Context> context_;
+    GCHeap* heap_ = nullptr;
+};
+
+/**
+ * @test 对象头部和普通对象的大小
+ */
+TEST_F(PointerCompressionBenchmarkTest, ObjectLayout) {
+#ifdef ENABLE_POINTER_COMPRESSION
+    EXPECT_EQ(sizeof(GCObjectHeader), 12u);
+#else
+    EXPECT_EQ(sizeof(GCObjectHeader), 16u);
+#endif
+    std::cout << "[pointer compression] mode=" << kCompressionMode
+        << " header=" << sizeof(GCObjectHeader)
+        << " gc_object=" << sizeof(GCObject)
+        << " object=" << sizeof(Object)
+        << " object_with_slots=" << sizeof(Object) + GCObjectTraits<Object>::kInObjectSize
+        << " array_object=" << sizeof(ArrayObject) << std::endl;
+}
+
+/**
+ * @test 保留大量带两个属性的对象时每个对象占用的堆内存
+ */
+TEST_F(PointerCompressionBenchmarkTest, RetainedObjectMemory) {
+    auto key_x = context_->FindConstOrInsertToLocal(Value(String::New("x")));
+    auto key_y = context_->FindConstOrInsertToLocal(Value(String::New("y")));
+
+    Value list;
+    {
+        GCHandleScope<1> scope(context_.get());
+        list = scope.New<ArrayObject>(0).ToValue();
+    }
+    context_->gc_manager().AddRoot(&list);
+    heap_->CollectGarbage(true);
+    size_t before = HeapUsed();
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kObjectCount; ++i) {
+        GCHandleScope<1> scope(context_.get());
+        auto obj = scope.New<Object>();
+        obj->SetProperty(context_.get(), key_x, Value(static_cast<int64_t>(i)));
+        obj->SetProperty(context_.get(), key_y, Value(static_cast<double>(i)));
+        list.array().Push(context_.get(), obj.ToValue());
+    }
+    auto allocate_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    heap_->CollectGarbage(true);
+    auto gc_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    size_t after = HeapUsed();
+
+    ASSERT_EQ(list.array().GetLength(), kObjectCount);
+    ASSERT_GT(after, before);
+    double bytes_per_object = static_cast<double>(after - before) / kObjectCount;
+    std::cout << "[pointer compression] mode=" << kCompressionMode
+        << " objects=" << kObjectCount
+        << " heap_bytes_per_object=" << bytes_per_object
+        << " allocate=" << allocate_ms << "ms full_gc=" << gc_ms << "ms" << std::endl;
+
+    context_->gc_manager().RemoveRoot(&list);
+}
+
+/**
+ * @test 创建对象并读写属性的脚本的吞吐量
+ */
+TEST_F(PointerCompressionBenchmarkTest, ObjectThroughput) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = context_->Eval("pointer_compression.js",
+        "let live = [];\n"
+        "let sum = 0;\n"
+        "for (let i = 0; i < 200000; i++) {\n"
+        "    let point = { x: i, y: i + 1, z: i + 2 };\n"
+        "    sum += point.x + point.y + point.z;\n"
+        "    if (i % 8 == 0) {\n"
+        "        live.push(point);\n"
+        "    }\n"
+        "}\n"
+        "sum;\n");
+    auto elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ASSERT_FALSE(result.IsException()) << result.ToString(context_.get()).string_view();
+
+    std::cout << "[pointer compression] mode=" << kCompressionMode
+        << " script=" << elapsed_ms << "ms" << std::endl;
+}
+
+} // namespace test
+} // namespace mjs
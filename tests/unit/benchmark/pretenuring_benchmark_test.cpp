@@ -0,0 +1,119 @@
+/**
+ * @file pretenuring_benchmark_test.cpp
+ * @brief 按分配点预先晋升的 Scavenge 复制量基准测试
+ *
+ * 模拟缓存预热：每轮在同一分配点创建一批缓存条目并一直保留，同时分配临时对象。
+ * 分别不使用分配点和使用分配点，比较 Scavenge 复制的字节数和总耗时：
+ * 使用分配点时，缓存条目在分配点被判定为长寿后直接在老年代分配，不再经过新生代的复制和晋升。
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/gc/handle.h>
+#include <mjs/value/object/array_object.h>
+
+namespace mjs {
+namespace test {
+
+/**
+ * @class PretenuringBenchmarkTest
+ * @brief 预先晋升基准测试
+ */
+class PretenuringBenchmarkTest : public ::testing::Test {
+protected:
+    static constexpr size_t kEntriesPerRound = 2000;   ///< 每轮新增的缓存条目数量
+    static constexpr size_t kChurnPerEntry = 4;        ///< 每个缓存条目伴随分配的临时对象数量
+    static constexpr int kRounds = 20;                 ///< 预热轮数
+
+    struct Result {
+        double total_ms = 0;        ///< 总耗时
+        GCHeapStats stats;          ///< 结束时的堆统计
+    };
+
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+    }
+
+    void TearDown() override {
+        runtime_.reset();
+    }
+
+    Result Measure(bool use_site) {
+        GCHeapConfig config;
+        config.adaptive_new_space = false;
+        auto context = std::make_unique<Context>(runtime_.get(), config);
+        auto& gc = context->gc_manager();
+        AllocationSite site;
+        AllocationSite* entry_site = use_site ? &site : nullptr;
+
+        Value cache;
+        {
+            GCHandleScope<1> scope(context.get());
+            cache = scope.New<ArrayObject>(0).ToValue();
+        }
+        gc.AddRoot(&cache);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round) {
+            for (size_t i = 0; i < kEntriesPerRound; ++i) {
+                GCHandleScope<1> scope(context.get());
+                auto entry = scope.NewForSite<ArrayObject>(entry_site,
+                    std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+                cache.array().Push(context.get(), entry.ToValue());
+                for (size_t j = 0; j < kChurnPerEntry; ++j) {
+                    GCHandleScope<1> temp_scope(context.get());
+                    temp_scope.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(j)) });
+                }
+            }
+        }
+        Result result;
+        result.total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        EXPECT_EQ(cache.array().GetLength(), kEntriesPerRound * kRounds);
+        Value entry;
+        cache.array().GetElement(context.get(), kEntriesPerRound * kRounds - 1, &entry);
+        Value element;
+        entry.array().GetElement(context.get(), 0, &element);
+        EXPECT_EQ(element.i64(), static_cast<int64_t>(kEntriesPerRound - 1));
+
+        gc.GetHeapStats(&result.stats);
+        gc.RemoveRoot(&cache);
+        return result;
+    }
+
+    static void Print(const char* name, const Result& result) {
+        std::cout << "[pretenuring] " << name
+            << " total=" << result.total_ms << "ms"
+            << " pauses=" << result.stats.pause_count
+            << " scavenge_copied=" << result.stats.scavenge_copied_bytes
+            << " pretenured=" << result.stats.pretenured_bytes << std::endl;
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+};
+
+/**
+ * @test 长寿对象的分配点预先晋升后，Scavenge 复制的字节数减少
+ */
+TEST_F(PretenuringBenchmarkTest, WarmCacheScavengeCopiedBytes) {
+    auto young = Measure(false);
+    auto pretenured = Measure(true);
+
+    Print("without site", young);
+    Print("with site", pretenured);
+
+    EXPECT_EQ(young.stats.pretenured_bytes, 0u);
+    EXPECT_GT(pretenured.stats.pretenured_bytes, 0u);
+    EXPECT_LT(pretenured.stats.scavenge_copied_bytes, young.stats.scavenge_copied_bytes);
+}
+
+} // namespace test
+} // namespace mjs
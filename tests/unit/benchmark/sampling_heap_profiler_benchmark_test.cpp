@@ -0,0 +1,99 @@
+/**
+ * @file sampling_heap_profiler_benchmark_test.cpp
+ * @brief 采样分配分析器开销基准测试
+ *
+ * 以分配为主的脚本分别在不开启和开启采样分配分析（默认采样间隔）的情况下执行，
+ * 比较总耗时，验证采样分析器可以在生产环境中长期开启。
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+
+namespace mjs {
+namespace test {
+
+/**
+ * @class SamplingHeapProfilerBenchmarkTest
+ * @brief 采样分配分析器开销基准测试
+ */
+class SamplingHeapProfilerBenchmarkTest : public ::testing::Test {
+protected:
+    static constexpr int kRuns = 3;    ///< 取最短耗时的执行次数
+
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+    }
+
+    void TearDown() override {
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 执行分配密集的脚本，返回最短耗时（毫秒）
+     */
+    double Measure(bool profile, uint64_t* sample_count) {
+        const std::string code = R"(
+            function makeNode(i, next) {
+                return { value: i, next: next };
+            }
+            let total = 0;
+            for (let round = 0; round < 20; round++) {
+                let head = null;
+                for (let i = 0; i < 10000; i++) {
+                    head = makeNode(i, head);
+                }
+                total += head.value;
+            }
+            total;
+        )";
+
+        double best = 0;
+        for (int run = 0; run < kRuns; ++run) {
+            auto context = std::make_unique<Context>(runtime_.get());
+            if (profile) {
+                context->gc_manager().StartSamplingHeapProfiler();
+            }
+            auto start = std::chrono::steady_clock::now();
+            auto result = context->Eval("sampling_benchmark", code);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            EXPECT_FALSE(result.IsException()) << result.ToString(context.get()).string_view();
+            if (run == 0 || ms < best) {
+                best = ms;
+            }
+            if (profile) {
+                *sample_count = context->gc_manager().heap()->sampling_heap_profiler()->sample_count();
+            }
+        }
+        return best;
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+};
+
+/**
+ * @test 默认采样间隔下开启分析的额外耗时
+ */
+TEST_F(SamplingHeapProfilerBenchmarkTest, DefaultIntervalOverhead) {
+    uint64_t sample_count = 0;
+    auto baseline_ms = Measure(false, &sample_count);
+    auto profiled_ms = Measure(true, &sample_count);
+
+    std::cout << "[sampling heap profiler] baseline=" << baseline_ms << "ms"
+        << " profiled=" << profiled_ms << "ms"
+        << " overhead=" << (profiled_ms / baseline_ms - 1) * 100 << "%"
+        << " samples=" << sample_count << std::endl;
+
+    EXPECT_GT(sample_count, 0u);
+}
+
+} // namespace test
+} // namespace mjs
@@ -0,0 +1,125 @@
+/**
+ * @file scavenge_benchmark_test.cpp
+ * @brief Scavenge 停顿基准测试
+ *
+ * 在老年代分别存放少量和大量对象，新生代工作集保持不变，
+ * 比较两种情况下的 Scavenge 停顿：跨代引用通过记忆集查找，停顿不应随老年代大小增长。
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/gc/handle.h>
+#include <mjs/value/object/array_object.h>
+
+namespace mjs {
+namespace test {
+
+/**
+ * @class ScavengeBenchmarkTest
+ * @brief Scavenge 停顿基准测试
+ */
+class ScavengeBenchmarkTest : public ::testing::Test {
+protected:
+    static constexpr size_t kYoungObjectCount = 2000;   ///< 每轮新生代存活对象数量
+    static constexpr int kRounds = 15;                  ///< 测量轮数
+
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+    }
+
+    void TearDown() override {
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 在老年代中构造 old_object_count 个对象，返回 Scavenge 停顿的中位数（毫秒）
+     */
+    double MeasureScavengeMs(size_t old_object_count) {
+        auto context = std::make_unique<Context>(runtime_.get());
+        auto& gc = context->gc_manager();
+
+        // 老年代对象：holder 引用 old_object_count 个单元素数组
+        Value holder;
+        {
+            GCHandleScope<1> scope(context.get());
+            holder = scope.New<ArrayObject>(0).ToValue();
+        }
+        gc.AddRoot(&holder);
+        for (size_t i = 0; i < old_object_count; ++i) {
+            GCHandleScope<1> scope(context.get());
+            auto leaf = scope.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+            holder.array().Push(context.get(), leaf.ToValue());
+        }
+        for (int i = 0; i <= kTenureAgeThreshold; ++i) {
+            gc.CollectGarbage(false);
+        }
+
+        Value sink;
+        gc.AddRoot(&sink);
+        holder.array().GetElement(context.get(), 0, &sink);
+        EXPECT_EQ(sink.object().header()->generation(), GCGeneration::kOld);
+
+        std::vector<double> samples;
+        for (int round = 0; round < kRounds; ++round) {
+            // 每轮新生代存活对象数量相同，并由一个老年代对象引用
+            Value young;
+            {
+                GCHandleScope<1> scope(context.get());
+                young = scope.New<ArrayObject>(0).ToValue();
+            }
+            gc.AddRoot(&young);
+            for (size_t i = 0; i < kYoungObjectCount; ++i) {
+                GCHandleScope<1> scope(context.get());
+                auto obj = scope.New<ArrayObject>(0);
+                young.array().Push(context.get(), obj.ToValue());
+            }
+            // 之后只能通过老年代对象找到新生代对象
+            sink.array().SetElement(context.get(), 0, Value(young));
+            gc.RemoveRoot(&young);
+
+            auto start = std::chrono::steady_clock::now();
+            gc.CollectGarbage(false);
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+
+            Value moved;
+            sink.array().GetElement(context.get(), 0, &moved);
+            EXPECT_EQ(moved.array().GetLength(), kYoungObjectCount);
+        }
+
+        gc.RemoveRoot(&sink);
+        gc.RemoveRoot(&holder);
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+};
+
+/**
+ * @test 老年代对象数量相差 50 倍时，Scavenge 停顿基本相同
+ */
+TEST_F(ScavengeBenchmarkTest, PauseIndependentOfOldSpaceSize) {
+    auto small_ms = MeasureScavengeMs(2000);
+    auto large_ms = MeasureScavengeMs(100000);
+
+    std::cout << "[scavenge] young_objects=" << kYoungObjectCount
+        << " old_objects=2000 pause=" << small_ms << "ms"
+        << " old_objects=100000 pause=" << large_ms << "ms" << std::endl;
+
+    // 扫描整个老年代时停顿会随对象数量线性增长，这里留出足够的测量误差
+    EXPECT_LT(large_ms, small_ms * 4 + 1.0);
+}
+
+} // namespace test
+} // namespace mjs
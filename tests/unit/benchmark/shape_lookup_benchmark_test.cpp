@@ -0,0 +1,144 @@
+/**
+ * @file shape_lookup_benchmark_test.cpp
+ * @brief 形状属性查找微基准测试
+ *
+ * 测量 Shape::Find 在 1~64 个属性下命中与未命中的平均耗时，
+ * 覆盖键数组 SIMD 扫描与开放寻址哈希表两条路径。
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/shape/shape.h>
+#include <mjs/shape/shape_manager.h>
+
+namespace mjs {
+namespace test {
+
+/**
+ * @class ShapeLookupBenchmarkTest
+ * @brief 形状属性查找微基准测试
+ */
+class ShapeLookupBenchmarkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+        context_ = std::make_unique<Context>(runtime_.get());
+    }
+
+    void TearDown() override {
+        context_.reset();
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 构建包含指定数量属性的形状
+     */
+    Shape* BuildShape(uint32_t property_count, std::vector<ConstIndex>* keys) {
+        Shape* shape = &context_->shape_manager().empty_shape();
+        shape->Reference();
+        for (uint32_t i = 0; i < property_count; ++i) {
+            auto key = context_->FindConstOrInsertToLocal(Value(String::New("bench_prop_" + std::to_string(i))));
+            keys->push_back(key);
+            context_->shape_manager().AddProperty(&shape, ShapeProperty(key));
+        }
+        return shape;
+    }
+
+    /**
+     * @brief 测量平均每次查找耗时（纳秒）
+     */
+    template <typename Fn>
+    static double MeasureNsPerLookup(uint32_t lookups, Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / lookups;
+    }
+
+    static constexpr uint32_t kLookupCount = 100000;
+
+    std::unique_ptr<Runtime> runtime_;
+    std::unique_ptr<Context> context_;
+};
+
+/**
+ * @test 命中与未命中查找，1~64 个属性
+ */
+TEST_F(ShapeLookupBenchmarkTest, FindHitAndMiss) {
+    auto miss_key = context_->FindConstOrInsertToLocal(Value(String::New("bench_missing_prop")));
+
+    for (uint32_t property_count : { 1u, 2u, 4u, 8u, 12u, 16u, 17u, 24u, 32u, 48u, 64u }) {
+        std::vector<ConstIndex> keys;
+        Shape* shape = BuildShape(property_count, &keys);
+        ASSERT_EQ(shape->property_size(), property_count);
+
+        PropertySlotIndex checksum = 0;
+        auto hit_ns = MeasureNsPerLookup(kLookupCount, [&] {
+            for (uint32_t i = 0; i < kLookupCount; ++i) {
+                checksum += shape->Find(keys[i % property_count]);
+            }
+        });
+
+        PropertySlotIndex miss_checksum = 0;
+        auto miss_ns = MeasureNsPerLookup(kLookupCount, [&] {
+            for (uint32_t i = 0; i < kLookupCount; ++i) {
+                miss_checksum += shape->Find(miss_key);
+            }
+        });
+
+        // 校验查找结果，同时避免循环被优化掉
+        for (uint32_t i = 0; i < property_count; ++i) {
+            EXPECT_EQ(shape->Find(keys[i]), static_cast<PropertySlotIndex>(i));
+        }
+        EXPECT_GE(checksum, 0);
+        EXPECT_EQ(miss_checksum, -static_cast<PropertySlotIndex>(kLookupCount));
+
+        std::cout << "[shape lookup] properties=" << property_count
+            << " hit=" << hit_ns << "ns miss=" << miss_ns << "ns" << std::endl;
+
+        shape->Dereference();
+    }
+}
+
+/**
+ * @test 共享属性表的前缀形状只能看到自己范围内的属性
+ */
+TEST_F(ShapeLookupBenchmarkTest, PrefixShapeRespectsPropertySize) {
+    std::vector<ConstIndex> keys;
+    Shape* shape = BuildShape(40, &keys);
+
+    // 沿父链回到 20 个属性的形状（与 40 个属性的形状共享同一张表）
+    Shape* prefix = shape;
+    while (prefix->property_size() > 20) {
+        prefix = prefix->parent_shape();
+    }
+    ASSERT_EQ(prefix->property_map(), shape->property_map());
+
+    for (uint32_t i = 0; i < 40; ++i) {
+        EXPECT_EQ(shape->Find(keys[i]), static_cast<PropertySlotIndex>(i));
+        EXPECT_EQ(prefix->Find(keys[i]), i < 20 ? static_cast<PropertySlotIndex>(i) : kPropertySlotIndexInvalid);
+    }
+
+    // 16 个属性以内走键数组扫描
+    while (prefix->property_size() > 10) {
+        prefix = prefix->parent_shape();
+    }
+    for (uint32_t i = 0; i < 40; ++i) {
+        EXPECT_EQ(prefix->Find(keys[i]), i < 10 ? static_cast<PropertySlotIndex>(i) : kPropertySlotIndexInvalid);
+    }
+
+    shape->Dereference();
+}
+
+} // namespace test
+} // namespace mjs
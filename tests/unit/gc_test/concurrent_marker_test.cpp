@@ -0,0 +1,335 @@
+/**
+ * @file concurrent_marker_test.cpp
+ * @brief 并发标记单元测试
+ *
+ * 测试老年代并发标记的功能：
+ * - 标记期间主线程继续修改对象图，起始快照中可达的对象不会被回收
+ * - 不可达的老年代对象在标记结束后被回收
+ * - 标记期间分配、晋升的对象直接置黑
+ * - 标记期间的Scavenge和老年代扩容
+ * - 增量标记：Step 按期限分步执行，分配时自动推进
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/gc/handle.h>
+#include <mjs/gc/concurrent_marker.h>
+#include <mjs/value/object/array_object.h>
+
+namespace mjs {
+namespace test {
+
+class ConcurrentMarkerTest : public ::testing::Test {
+protected:
+    static constexpr size_t kChildCount = 2000;
+
+    void SetUp() override {
+        GCHeapConfig config;
+        config.concurrent_marking = true;
+        Reset(config);
+    }
+
+    void Reset(GCHeapConfig config) {
+        context_.reset();
+        runtime_ = std::make_unique<Runtime>();
+        config.adaptive_new_space = false;
+        // 由测试显式开始标记
+        config.concurrent_marking_start_ratio = 2.0;
+        context_ = std::make_unique<Context>(runtime_.get(), config);
+    }
+
+    void TearDown() override {
+        context_.reset();
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 构造 holder -> [child_i] 的对象图，每个 child 为 [i]，并晋升到老年代
+     */
+    void BuildOldGraph(Value* holder) {
+        {
+            GCHandleScope<1> scope(context_.get());
+            *holder = scope.New<ArrayObject>(0).ToValue();
+        }
+        context_->gc_manager().AddRoot(holder);
+        for (size_t i = 0; i < kChildCount; ++i) {
+            GCHandleScope<1> scope(context_.get());
+            auto child = scope.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+            holder->array().Push(context_.get(), child.ToValue());
+        }
+        for (int i = 0; i <= kTenureAgeThreshold; ++i) {
+            context_->gc_manager().CollectGarbage(false);
+        }
+        ASSERT_EQ(holder->object().header()->generation(), GCGeneration::kOld);
+    }
+
+    void WaitForMarking() {
+        auto* heap = context_->gc_manager().heap();
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!heap->IsConcurrentMarkingComplete() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+    std::unique_ptr<Context> context_;
+};
+
+/**
+ * @test 未启用并发标记时不能开始标记
+ */
+TEST(ConcurrentMarkerConfigTest, DisabledByDefault) {
+    auto runtime = std::make_unique<Runtime>();
+    auto context = std::make_unique<Context>(runtime.get());
+    EXPECT_EQ(context->gc_manager().heap()->concurrent_marker(), nullptr);
+    EXPECT_FALSE(context->gc_manager().StartConcurrentMarking());
+    EXPECT_FALSE(context->gc_manager().heap()->is_marking());
+}
+
+/**
+ * @test 后台线程完成标记后，最终标记回收不可达对象并保留可达对象
+ */
+TEST_F(ConcurrentMarkerTest, MarksReachableObjects) {
+    auto& gc = context_->gc_manager();
+    Value holder;
+    BuildOldGraph(&holder);
+
+    // 一半子对象变为不可达
+    for (size_t i = 0; i < kChildCount / 2; ++i) {
+        holder.array().Pop(context_.get());
+    }
+
+    GCHeapStats before;
+    gc.GetHeapStats(&before);
+
+    ASSERT_TRUE(gc.StartConcurrentMarking());
+    EXPECT_TRUE(gc.heap()->is_marking());
+    EXPECT_FALSE(gc.StartConcurrentMarking());
+    WaitForMarking();
+    EXPECT_TRUE(gc.heap()->IsConcurrentMarkingComplete());
+
+    gc.CollectGarbage(true);
+    EXPECT_FALSE(gc.heap()->is_marking());
+
+    GCHeapStats after;
+    gc.GetHeapStats(&after);
+    EXPECT_EQ(after.concurrent_marking_count, 1u);
+    EXPECT_LT(after.old_space_used, before.old_space_used);
+
+    ASSERT_EQ(holder.array().GetLength(), kChildCount / 2);
+    for (size_t i = 0; i < kChildCount / 2; ++i) {
+        Value child;
+        ASSERT_TRUE(holder.array().GetElement(context_.get(), i, &child));
+        Value element;
+        ASSERT_TRUE(child.array().GetElement(context_.get(), 0, &element));
+        EXPECT_EQ(element.i64(), static_cast<int64_t>(i));
+    }
+
+    gc.RemoveRoot(&holder);
+}
+
+/**
+ * @test 标记期间将引用从未扫描的对象移到其他对象后删除，写屏障保证对象仍被标记
+ */
+TEST_F(ConcurrentMarkerTest, BarrierPreservesSnapshot) {
+    auto& gc = context_->gc_manager();
+    Value holder;
+    BuildOldGraph(&holder);
+    Value target;
+    {
+        GCHandleScope<1> scope(context_.get());
+        target = scope.New<ArrayObject>(0).ToValue();
+    }
+    gc.AddRoot(&target);
+    for (int i = 0; i <= kTenureAgeThreshold; ++i) {
+        gc.CollectGarbage(false);
+    }
+    ASSERT_EQ(target.object().header()->generation(), GCGeneration::kOld);
+
+    ASSERT_TRUE(gc.StartConcurrentMarking());
+    // 与后台线程同时把所有子对象从 holder 移到 target
+    for (size_t i = 0; i < kChildCount; ++i) {
+        Value child = holder.array().Pop(context_.get());
+        target.array().Push(context_.get(), std::move(child));
+    }
+    EXPECT_EQ(holder.array().GetLength(), 0u);
+    EXPECT_TRUE(holder.object().header()->IsScanned());
+    EXPECT_TRUE(target.object().header()->IsScanned());
+
+    gc.CollectGarbage(true);
+
+    ASSERT_EQ(target.array().GetLength(), kChildCount);
+    for (size_t i = 0; i < kChildCount; ++i) {
+        Value child;
+        ASSERT_TRUE(target.array().GetElement(context_.get(), i, &child));
+        Value element;
+        ASSERT_TRUE(child.array().GetElement(context_.get(), 0, &element));
+        EXPECT_EQ(element.i64(), static_cast<int64_t>(kChildCount - 1 - i));
+    }
+
+    gc.RemoveRoot(&target);
+    gc.RemoveRoot(&holder);
+}
+
+/**
+ * @test 标记期间主线程继续分配，Scavenge晋升的对象直接置黑并在标记结束后存活
+ */
+TEST_F(ConcurrentMarkerTest, AllocateDuringMarking) {
+    auto& gc = context_->gc_manager();
+    Value holder;
+    BuildOldGraph(&holder);
+
+    Value young;
+    {
+        GCHandleScope<1> scope(context_.get());
+        young = scope.New<ArrayObject>(0).ToValue();
+    }
+    gc.AddRoot(&young);
+    for (size_t i = 0; i < kChildCount; ++i) {
+        GCHandleScope<1> scope(context_.get());
+        auto obj = scope.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+        young.array().Push(context_.get(), obj.ToValue());
+    }
+    for (int i = 0; i < kTenureAgeThreshold - 1; ++i) {
+        gc.CollectGarbage(false);
+    }
+    // 开始标记时的Scavenge使对象达到晋升年龄
+    ASSERT_TRUE(gc.StartConcurrentMarking());
+    ASSERT_EQ(young.object().header()->generation(), GCGeneration::kNew);
+
+    // 标记期间的Scavenge晋升对象
+    gc.CollectGarbage(false);
+    ASSERT_EQ(young.object().header()->generation(), GCGeneration::kOld);
+    EXPECT_TRUE(young.object().header()->IsMarked());
+    gc.CollectGarbage(true);
+
+    ASSERT_EQ(young.array().GetLength(), kChildCount);
+    for (size_t i = 0; i < kChildCount; ++i) {
+        Value obj;
+        ASSERT_TRUE(young.array().GetElement(context_.get(), i, &obj));
+        Value element;
+        ASSERT_TRUE(obj.array().GetElement(context_.get(), 0, &element));
+        EXPECT_EQ(element.i64(), static_cast<int64_t>(i));
+    }
+    EXPECT_EQ(holder.array().GetLength(), kChildCount);
+
+    gc.RemoveRoot(&young);
+    gc.RemoveRoot(&holder);
+}
+
+/**
+ * @test 老年代使用率超过阈值时在Scavenge后自动开始标记，标记完成后自动结束
+ */
+TEST_F(ConcurrentMarkerTest, ScheduledBySurvivalRatio) {
+    context_.reset();
+    runtime_ = std::make_unique<Runtime>();
+    GCHeapConfig config;
+    config.adaptive_new_space = false;
+    config.concurrent_marking = true;
+    config.concurrent_marking_start_ratio = 0.0;
+    context_ = std::make_unique<Context>(runtime_.get(), config);
+    auto& gc = context_->gc_manager();
+
+    Value holder;
+    BuildOldGraph(&holder);
+    for (int i = 0; i < 3; ++i) {
+        WaitForMarking();
+        gc.CollectGarbage(false);
+    }
+    GCHeapStats stats;
+    gc.GetHeapStats(&stats);
+    EXPECT_GE(stats.concurrent_marking_count, 1u);
+    EXPECT_GT(stats.pause_count, 0u);
+    EXPECT_EQ(holder.array().GetLength(), kChildCount);
+
+    gc.RemoveRoot(&holder);
+}
+
+/**
+ * @test 增量标记没有后台线程，每次 Step 只处理期限内的对象，全部处理完后结束标记
+ */
+TEST_F(ConcurrentMarkerTest, IncrementalSteps) {
+    GCHeapConfig config;
+    config.incremental_marking = true;
+    Reset(config);
+    auto& gc = context_->gc_manager();
+    Value holder;
+    BuildOldGraph(&holder);
+    for (size_t i = 0; i < kChildCount / 2; ++i) {
+        holder.array().Pop(context_.get());
+    }
+
+    ASSERT_TRUE(gc.StartConcurrentMarking());
+    EXPECT_FALSE(gc.heap()->concurrent_marker()->background());
+    EXPECT_FALSE(gc.heap()->IsConcurrentMarkingComplete());
+
+    // 期限已过时每步仍会处理一小批对象
+    uint32_t steps = 1;
+    while (!gc.Step(std::chrono::steady_clock::now())) {
+        ++steps;
+        ASSERT_LT(steps, kChildCount);
+    }
+    EXPECT_GT(steps, 1u);
+    EXPECT_FALSE(gc.heap()->is_marking());
+
+    GCHeapStats stats;
+    gc.GetHeapStats(&stats);
+    EXPECT_EQ(stats.incremental_step_count, steps);
+    EXPECT_EQ(stats.concurrent_marking_count, 1u);
+    // 未在标记时 Step 直接返回
+    EXPECT_TRUE(gc.Step(std::chrono::steady_clock::now() + std::chrono::milliseconds(1)));
+
+    ASSERT_EQ(holder.array().GetLength(), kChildCount / 2);
+    for (size_t i = 0; i < kChildCount / 2; ++i) {
+        Value child;
+        ASSERT_TRUE(holder.array().GetElement(context_.get(), i, &child));
+        Value element;
+        ASSERT_TRUE(child.array().GetElement(context_.get(), 0, &element));
+        EXPECT_EQ(element.i64(), static_cast<int64_t>(i));
+    }
+
+    gc.RemoveRoot(&holder);
+}
+
+/**
+ * @test 增量标记期间分配达到配置的字节数时自动执行一步
+ */
+TEST_F(ConcurrentMarkerTest, IncrementalStepOnAllocation) {
+    GCHeapConfig config;
+    config.incremental_marking = true;
+    config.incremental_step_bytes = 4 * 1024;
+    Reset(config);
+    auto& gc = context_->gc_manager();
+    Value holder;
+    BuildOldGraph(&holder);
+
+    ASSERT_TRUE(gc.StartConcurrentMarking());
+    for (size_t i = 0; i < kChildCount * 4 && gc.heap()->is_marking(); ++i) {
+        GCHandleScope<1> scope(context_.get());
+        scope.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+        if (gc.heap()->IsConcurrentMarkingComplete()) {
+            break;
+        }
+    }
+    GCHeapStats stats;
+    gc.GetHeapStats(&stats);
+    EXPECT_GT(stats.incremental_step_count, 0u);
+    EXPECT_TRUE(gc.heap()->IsConcurrentMarkingComplete());
+
+    gc.CollectGarbage(true);
+    EXPECT_FALSE(gc.heap()->is_marking());
+    EXPECT_EQ(holder.array().GetLength(), kChildCount);
+
+    gc.RemoveRoot(&holder);
+}
+
+} // namespace test
+} // namespace mjs
@@ -8,6 +8,12 @@
  * - GC触发
  * - 根集合管理
  * - 统计信息
+ * - 记忆集（老年代到新生代的引用）
+ * - 老年代标记后惰性清除，碎片过多时压缩
+ * - 大对象空间
+ * - 按分配点预先晋升
+ * - 空闲通知
+ * - 堆大小限制
  * - 边界条件
  *
  * @copyright Copyright (c) 2025
@@ -22,7 +28,10 @@
 #include <mjs/runtime.h>
 #include <mjs/context.h>
 #include <mjs/value/object/object.h>
+#include <mjs/value/object/array_object.h>
 #include <mjs/gc/handle.h>
+#include <mjs/value/string.h>
+#include <mjs/value/object/array_buffer_object.h>
 
 namespace mjs {
 namespace test {
@@ -87,6 +96,28 @@ public:
     void GCTraverse(Context* c, GCTraverseCallback cb) override { (void)c; (void)cb; }
 };
 
+// 测试用的大对象，持有一个子引用，分配在大对象空间
+class LargeHolderObject : public Object {
+public:
+    explicit LargeHolderObject(Context* context) : Object(context) {}
+
+    const Value& child() const { return child_; }
+    void set_child(Context* context, const Value& child) {
+        MarkingBarrier(context);
+        WriteBarrier(context, child);
+        child_ = child;
+    }
+
+    void GCTraverse(Context* context, GCTraverseCallback callback) override {
+        Object::GCTraverse(context, callback);
+        callback(context, &child_);
+    }
+
+private:
+    Value child_;
+    char data_[kLargeObjectThreshold] = {};
+};
+
 /**
  * @class GCHeapTest
  * @brief GCHeap 类单元测试
@@ -756,6 +787,710 @@ TEST_F(GCHeapTest, CircularReferenceGC) {
     }
 }
 
+// ==================== 记忆集测试 ====================
+
+/**
+ * @test 老年代对象引用的新生代对象在Scavenge后存活，引用被更新，
+ *       被引用对象晋升后老年代对象移出记忆集
+ */
+TEST_F(GCHeapTest, RememberedSetKeepsYoungReferent) {
+    Value holder;
+    {
+        GCHandleScope<1> scope(context_);
+        holder = scope.New<ArrayObject>(0).ToValue();
+    }
+    gc_heap_->AddRoot(&holder);
+
+    // 复制 kTenureAgeThreshold 次之后的下一次Scavenge晋升到老年代
+    for (int i = 0; i <= kTenureAgeThreshold; ++i) {
+        gc_heap_->CollectGarbage(false);
+    }
+    ASSERT_EQ(holder.object().header()->generation(), GCGeneration::kOld);
+    EXPECT_FALSE(holder.object().header()->IsRemembered());
+
+    {
+        GCHandleScope<1> scope(context_);
+        auto child = scope.New<ArrayObject>(std::initializer_list<Value>{ Value(int64_t(42)) });
+        holder.array().Push(context_, child.ToValue());
+    }
+    EXPECT_TRUE(holder.object().header()->IsRemembered());
+
+    // 子对象只能通过老年代对象找到
+    gc_heap_->CollectGarbage(false);
+    Value child;
+    ASSERT_TRUE(holder.array().GetElement(context_, 0, &child));
+    EXPECT_EQ(child.object().header()->generation(), GCGeneration::kNew);
+    Value element;
+    ASSERT_TRUE(child.array().GetElement(context_, 0, &element));
+    EXPECT_EQ(element.i64(), 42);
+    EXPECT_TRUE(holder.object().header()->IsRemembered());
+
+    for (int i = 0; i < kTenureAgeThreshold; ++i) {
+        gc_heap_->CollectGarbage(false);
+    }
+    ASSERT_TRUE(holder.array().GetElement(context_, 0, &child));
+    EXPECT_EQ(child.object().header()->generation(), GCGeneration::kOld);
+    ASSERT_TRUE(child.array().GetElement(context_, 0, &element));
+    EXPECT_EQ(element.i64(), 42);
+    EXPECT_FALSE(holder.object().header()->IsRemembered());
+
+    gc_heap_->RemoveRoot(&holder);
+}
+
+// ==================== 新生代大小配置测试 ====================
+
+/**
+ * @test 通过 Context 传入的配置决定新生代布局
+ */
+TEST_F(GCHeapTest, CustomNewSpaceGeometry) {
+    GCHeapConfig config;
+    config.new_space_size = 1024 * 1024;
+    config.eden_ratio = 6;
+    config.survivor_ratio = 2;
+    auto context = std::make_unique<Context>(runtime_.get(), config);
+
+    GCHeapStats stats;
+    context->gc_manager().GetHeapStats(&stats);
+    EXPECT_EQ(stats.eden_size, config.new_space_size * 6 / 10);
+    EXPECT_EQ(stats.survivor_size, config.new_space_size * 2 / 10);
+    EXPECT_EQ(stats.new_space_capacity, stats.eden_size + stats.survivor_size * 2);
+    EXPECT_EQ(stats.old_space_capacity, kOldSpaceInitialSize);
+}
+
+/**
+ * @test 存活率低时扩大新生代，内存压力下缩小新生代
+ */
+TEST_F(GCHeapTest, AdaptiveNewSpaceSizing) {
+    GCHeapConfig config;
+    config.max_new_space_size = kNewSpaceTotalSize * 4;
+    auto context = std::make_unique<Context>(runtime_.get(), config);
+    auto& gc = context->gc_manager();
+
+    // 全部是垃圾对象，存活率为0
+    auto allocate_garbage = [&]() {
+        for (int i = 0; i < 1000; ++i) {
+            GCHandleScope<1> scope(context.get());
+            scope.New<ArrayObject>(0);
+        }
+    };
+    allocate_garbage();
+    gc.CollectGarbage(false);
+
+    GCHeapStats stats;
+    gc.GetHeapStats(&stats);
+    EXPECT_EQ(stats.last_decision, NewSpaceResizeDecision::kGrow);
+    EXPECT_LT(stats.last_survival_rate, config.low_survival_rate);
+    EXPECT_EQ(stats.eden_size, kEdenSpaceSize * 2);
+    EXPECT_EQ(stats.new_space_grow_count, 1u);
+
+    // 达到上限后保持不变
+    allocate_garbage();
+    gc.CollectGarbage(false);
+    allocate_garbage();
+    gc.CollectGarbage(false);
+    gc.GetHeapStats(&stats);
+    EXPECT_EQ(stats.eden_size, config.max_new_space_size * kEdenSpaceRatio / kTotalSpaceRatio);
+    EXPECT_EQ(stats.last_decision, NewSpaceResizeDecision::kKeep);
+
+    gc.NotifyMemoryPressure();
+    gc.CollectGarbage(false);
+    gc.GetHeapStats(&stats);
+    EXPECT_EQ(stats.last_decision, NewSpaceResizeDecision::kShrink);
+    EXPECT_EQ(stats.eden_size, kEdenSpaceSize * 2);
+    EXPECT_EQ(stats.new_space_shrink_count, 1u);
+
+    // 缩小后对象仍可正常分配和回收
+    Value holder;
+    {
+        GCHandleScope<1> scope(context.get());
+        holder = scope.New<ArrayObject>(std::initializer_list<Value>{ Value(int64_t(7)) }).ToValue();
+    }
+    gc.AddRoot(&holder);
+    gc.CollectGarbage(false);
+    Value element;
+    ASSERT_TRUE(holder.array().GetElement(context.get(), 0, &element));
+    EXPECT_EQ(element.i64(), 7);
+    gc.RemoveRoot(&holder);
+}
+
+// ==================== 老年代清除与压缩测试 ====================
+
+/**
+ * @brief 构造 holder -> [child_i] 的老年代对象图，每个 child 为 [i]
+ */
+static void BuildOldChildren(Context* context, Value* holder, size_t count) {
+    auto& gc = context->gc_manager();
+    {
+        GCHandleScope<1> scope(context);
+        *holder = scope.New<ArrayObject>(0).ToValue();
+    }
+    gc.AddRoot(holder);
+    for (size_t i = 0; i < count; ++i) {
+        GCHandleScope<1> scope(context);
+        auto child = scope.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+        holder->array().Push(context, child.ToValue());
+    }
+    for (int i = 0; i <= kTenureAgeThreshold; ++i) {
+        gc.CollectGarbage(false);
+    }
+}
+
+/**
+ * @test 碎片率低时老年代只清除不移动，死亡对象在之后的分配中惰性清除并重新使用
+ */
+TEST_F(GCHeapTest, MarkSweepKeepsObjectsInPlace) {
+    constexpr size_t kCount = 2000;
+    GCHeapConfig config;
+    config.adaptive_new_space = false;
+    auto context = std::make_unique<Context>(runtime_.get(), config);
+    auto& gc = context->gc_manager();
+    Value holder;
+    BuildOldChildren(context.get(), &holder, kCount);
+
+    // 末尾四分之一变为垃圾，其余子对象的地址在回收后不变
+    for (size_t i = 0; i < kCount / 4; ++i) {
+        holder.array().Pop(context.get());
+    }
+    Value first;
+    ASSERT_TRUE(holder.array().GetElement(context.get(), 0, &first));
+    ASSERT_EQ(first.object().header()->generation(), GCGeneration::kOld);
+    auto* first_addr = &first.object();
+
+    GCHeapStats before;
+    gc.GetHeapStats(&before);
+    gc.CollectGarbage(true);
+    GCHeapStats after;
+    gc.GetHeapStats(&after);
+    EXPECT_EQ(after.mark_sweep_count, 1u);
+    EXPECT_EQ(after.compaction_count, 0u);
+    EXPECT_LT(after.old_space_used, before.old_space_used);
+
+    ASSERT_TRUE(holder.array().GetElement(context.get(), 0, &first));
+    EXPECT_EQ(&first.object(), first_addr);
+
+    // 分配推进惰性清除，之后晋升的对象从空闲块中分配
+    Value survivor;
+    {
+        GCHandleScope<1> scope(context.get());
+        survivor = scope.New<ArrayObject>(std::initializer_list<Value>{ Value(int64_t(-1)) }).ToValue();
+    }
+    gc.AddRoot(&survivor);
+    for (int round = 0; round <= kTenureAgeThreshold; ++round) {
+        for (size_t i = 0; i < kCount; ++i) {
+            GCHandleScope<1> scope(context.get());
+            scope.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+        }
+        gc.CollectGarbage(false);
+    }
+    ASSERT_EQ(survivor.object().header()->generation(), GCGeneration::kOld);
+    gc.GetHeapStats(&after);
+    EXPECT_EQ(after.compaction_count, 0u);
+    EXPECT_GT(after.old_space_free, 0u);
+
+    ASSERT_EQ(holder.array().GetLength(), kCount - kCount / 4);
+    for (size_t i = 0; i < kCount - kCount / 4; ++i) {
+        Value child;
+        ASSERT_TRUE(holder.array().GetElement(context.get(), i, &child));
+        Value element;
+        ASSERT_TRUE(child.array().GetElement(context.get(), 0, &element));
+        EXPECT_EQ(element.i64(), static_cast<int64_t>(i));
+    }
+    Value element;
+    ASSERT_TRUE(survivor.array().GetElement(context.get(), 0, &element));
+    EXPECT_EQ(element.i64(), -1);
+
+    gc.RemoveRoot(&survivor);
+    gc.RemoveRoot(&holder);
+}
+
+/**
+ * @test 碎片率超过阈值时压缩老年代，空闲块全部消除
+ */
+TEST_F(GCHeapTest, CompactWhenFragmented) {
+    constexpr size_t kCount = 2000;
+    GCHeapConfig config;
+    config.adaptive_new_space = false;
+    auto context = std::make_unique<Context>(runtime_.get(), config);
+    auto& gc = context->gc_manager();
+    Value holder;
+    BuildOldChildren(context.get(), &holder, kCount);
+
+    // 先清除一次，产生空闲块
+    for (size_t i = 0; i < kCount / 4; ++i) {
+        holder.array().Pop(context.get());
+    }
+    gc.CollectGarbage(true);
+
+    // 大部分子对象变为垃圾
+    for (size_t i = 0; i < kCount / 2; ++i) {
+        holder.array().Pop(context.get());
+    }
+    gc.CollectGarbage(true);
+
+    GCHeapStats stats;
+    gc.GetHeapStats(&stats);
+    EXPECT_EQ(stats.mark_sweep_count, 1u);
+    EXPECT_EQ(stats.compaction_count, 1u);
+    EXPECT_EQ(stats.old_space_free, 0u);
+
+    ASSERT_EQ(holder.array().GetLength(), kCount / 4);
+    for (size_t i = 0; i < kCount / 4; ++i) {
+        Value child;
+        ASSERT_TRUE(holder.array().GetElement(context.get(), i, &child));
+        Value element;
+        ASSERT_TRUE(child.array().GetElement(context.get(), 0, &element));
+        EXPECT_EQ(element.i64(), static_cast<int64_t>(i));
+    }
+
+    gc.RemoveRoot(&holder);
+}
+
+/**
+ * @test 老年代按页扩容，已晋升的对象不移动
+ */
+TEST_F(GCHeapTest, ExpandDoesNotMoveOldObjects) {
+    GCHeapConfig config;
+    config.old_space_initial_size = kOldSpacePageSize;
+    auto context = std::make_unique<Context>(runtime_.get(), config);
+    auto& gc = context->gc_manager();
+    Value holder;
+    BuildOldChildren(context.get(), &holder, 100);
+    Value first;
+    ASSERT_TRUE(holder.array().GetElement(context.get(), 0, &first));
+    ASSERT_EQ(first.object().header()->generation(), GCGeneration::kOld);
+    auto* first_addr = &first.object();
+
+    GCHeapStats before;
+    gc.GetHeapStats(&before);
+    Value other;
+    BuildOldChildren(context.get(), &other, 5000);
+    GCHeapStats after;
+    gc.GetHeapStats(&after);
+    EXPECT_GT(after.old_space_capacity, before.old_space_capacity);
+    EXPECT_EQ(after.compaction_count, 0u);
+
+    ASSERT_TRUE(holder.array().GetElement(context.get(), 0, &first));
+    EXPECT_EQ(&first.object(), first_addr);
+
+    gc.RemoveRoot(&other);
+    gc.RemoveRoot(&holder);
+}
+
+// ==================== 大对象空间测试 ====================
+
+/**
+ * @test 大对象分配在大对象空间，不占用老年代；老年代压缩不移动大对象，死亡后释放
+ */
+TEST_F(GCHeapTest, LargeObjectIsNeverMoved) {
+    GCHeapConfig config;
+    config.old_space_sweeping = false;
+    config.old_space_initial_size = 64 * 1024;
+    auto context = std::make_unique<Context>(runtime_.get(), config);
+    auto& gc = context->gc_manager();
+
+    GCHeapStats before;
+    gc.GetHeapStats(&before);
+
+    auto* large = gc.AllocateObject<LargeHolderObject>();
+    Value holder(static_cast<Object*>(large));
+    gc.AddRoot(&holder);
+    EXPECT_TRUE(large->header()->IsLarge());
+    EXPECT_EQ(large->header()->generation(), GCGeneration::kOld);
+
+    GCHeapStats stats;
+    gc.GetHeapStats(&stats);
+    EXPECT_EQ(stats.large_object_count, 1u);
+    EXPECT_GE(stats.large_object_space_used, sizeof(LargeHolderObject));
+    EXPECT_EQ(stats.old_space_used, before.old_space_used);
+    EXPECT_EQ(stats.old_space_capacity, before.old_space_capacity);
+
+    // 大对象引用的新生代对象经由记忆集存活并晋升
+    {
+        GCHandleScope<1> scope(context.get());
+        auto child = scope.New<ArrayObject>(std::initializer_list<Value>{ Value(int64_t(42)) });
+        large->set_child(context.get(), child.ToValue());
+    }
+    for (int i = 0; i <= kTenureAgeThreshold; ++i) {
+        gc.CollectGarbage(false);
+    }
+    ASSERT_EQ(large->child().object().header()->generation(), GCGeneration::kOld);
+
+    // 晋升更多对象使老年代扩容，之后压缩移动老年代对象，大对象中的引用随之更新
+    Value other;
+    BuildOldChildren(context.get(), &other, 2000);
+    gc.GetHeapStats(&stats);
+    EXPECT_GT(stats.old_space_capacity, before.old_space_capacity);
+    gc.RemoveRoot(&other);
+    gc.CollectGarbage(true);
+    gc.GetHeapStats(&stats);
+    EXPECT_GT(stats.compaction_count, 0u);
+    EXPECT_EQ(&holder.object(), large);
+    Value element;
+    ASSERT_TRUE(large->child().array().GetElement(context.get(), 0, &element));
+    EXPECT_EQ(element.i64(), 42);
+
+    gc.RemoveRoot(&holder);
+    gc.CollectGarbage(true);
+    gc.GetHeapStats(&stats);
+    EXPECT_EQ(stats.large_object_count, 0u);
+    EXPECT_EQ(stats.large_object_space_used, 0u);
+}
+
+/**
+ * @test 大对象空间超过限制时触发完整GC，死亡的大对象不会累积，也不会扩容老年代
+ */
+TEST_F(GCHeapTest, LargeObjectAllocationTriggersFullGC) {
+    GCHeapConfig config;
+    auto context = std::make_unique<Context>(runtime_.get(), config);
+    auto& gc = context->gc_manager();
+
+    size_t count = config.old_space_initial_size / sizeof(LargeHolderObject) * 4;
+    for (size_t i = 0; i < count; ++i) {
+        gc.AllocateObject<LargeHolderObject>();
+    }
+
+    GCHeapStats stats;
+    gc.GetHeapStats(&stats);
+    EXPECT_LE(stats.large_object_space_used, config.old_space_initial_size + sizeof(LargeHolderObject));
+    EXPECT_EQ(stats.old_space_capacity, config.old_space_initial_size);
+    EXPECT_GT(stats.mark_sweep_count + stats.compaction_count, 0u);
+}
+
+// ==================== 预先晋升测试 ====================
+
+/**
+ * @test 分配次数不足时不做决策，存活率达到阈值后预先晋升
+ */
+TEST_F(GCHeapTest, AllocationSiteDecide) {
+    AllocationSite site;
+    for (uint32_t i = 0; i < kPretenureMinAllocations - 1; ++i) {
+        site.RecordAllocation();
+        site.RecordSurvival();
+    }
+    site.Decide();
+    EXPECT_FALSE(site.pretenured());
+    EXPECT_EQ(site.allocated_count(), kPretenureMinAllocations - 1);
+
+    site.RecordAllocation();
+    site.Decide();
+    EXPECT_TRUE(site.pretenured());
+    EXPECT_EQ(site.allocated_count(), 0u);
+    EXPECT_EQ(site.survived_count(), 0u);
+
+    AllocationSite dying_site;
+    for (uint32_t i = 0; i < kPretenureMinAllocations; ++i) {
+        dying_site.RecordAllocation();
+        if (i % 2 == 0) {
+            dying_site.RecordSurvival();
+        }
+    }
+    dying_site.Decide();
+    EXPECT_FALSE(dying_site.pretenured());
+}
+
+/**
+ * @test 分配的对象在Scavenge中存活的分配点之后直接在老年代分配
+ */
+TEST_F(GCHeapTest, PretenureSurvivingAllocationSite) {
+    GCHeapConfig config;
+    config.adaptive_new_space = false;
+    auto context = std::make_unique<Context>(runtime_.get(), config);
+    auto& gc = context->gc_manager();
+    AllocationSite site;
+
+    Value holder;
+    {
+        GCHandleScope<1> scope(context.get());
+        holder = scope.New<ArrayObject>(0).ToValue();
+    }
+    gc.AddRoot(&holder);
+    for (uint32_t i = 0; i < kPretenureMinAllocations; ++i) {
+        GCHandleScope<1> scope(context.get());
+        auto child = scope.NewForSite<ArrayObject>(&site, std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+        holder.array().Push(context.get(), child.ToValue());
+    }
+    EXPECT_FALSE(site.pretenured());
+    gc.CollectGarbage(false);
+    ASSERT_TRUE(site.pretenured());
+
+    GCHeapStats before;
+    gc.GetHeapStats(&before);
+    {
+        GCHandleScope<1> scope(context.get());
+        auto child = scope.NewForSite<ArrayObject>(&site, std::initializer_list<Value>{ Value(int64_t(42)) });
+        EXPECT_EQ(child->header()->generation(), GCGeneration::kOld);
+        EXPECT_FALSE(child->header()->IsLarge());
+        holder.array().Push(context.get(), child.ToValue());
+    }
+    GCHeapStats after;
+    gc.GetHeapStats(&after);
+    EXPECT_GT(after.pretenured_bytes, before.pretenured_bytes);
+    EXPECT_GT(after.old_space_used, before.old_space_used);
+
+    // 预先晋升的对象参与老年代回收
+    gc.CollectGarbage(true);
+    Value child;
+    ASSERT_TRUE(holder.array().GetElement(context.get(), kPretenureMinAllocations, &child));
+    Value element;
+    ASSERT_TRUE(child.array().GetElement(context.get(), 0, &element));
+    EXPECT_EQ(element.i64(), 42);
+
+    gc.RemoveRoot(&holder);
+}
+
+/**
+ * @test 分配的对象很快死亡的分配点保持在新生代分配
+ */
+TEST_F(GCHeapTest, DyingAllocationSiteStaysYoung) {
+    GCHeapConfig config;
+    config.adaptive_new_space = false;
+    auto context = std::make_unique<Context>(runtime_.get(), config);
+    auto& gc = context->gc_manager();
+    AllocationSite site;
+
+    for (uint32_t i = 0; i < kPretenureMinAllocations * 2; ++i) {
+        GCHandleScope<1> scope(context.get());
+        scope.NewForSite<ArrayObject>(&site, std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+    }
+    gc.CollectGarbage(false);
+    EXPECT_FALSE(site.pretenured());
+
+    GCHandleScope<1> scope(context.get());
+    auto obj = scope.NewForSite<ArrayObject>(&site, std::initializer_list<Value>{});
+    EXPECT_EQ(obj->header()->generation(), GCGeneration::kNew);
+}
+
+// ==================== 空闲通知测试 ====================
+
+/**
+ * @brief 分配临时对象直到新生代使用率超过 ratio（不超过GC触发阈值）
+ */
+static void FillNewSpace(Context* context, double ratio) {
+    auto& gc = context->gc_manager();
+    GCHeapStats stats;
+    do {
+        GCHandleScope<1> scope(context);
+        scope.New<ArrayObject>(std::initializer_list<Value>{ Value(int64_t(1)) });
+        gc.GetHeapStats(&stats);
+    } while (stats.new_space_used <= stats.eden_size * ratio);
+}
+
+/**
+ * @test 没有需要做的工作或预算为0时不执行GC
+ */
+TEST_F(GCHeapTest, NotifyIdleWithoutWork) {
+    auto context = std::make_unique<Context>(runtime_.get());
+    GCHeapStats before;
+    context->gc_manager().GetHeapStats(&before);
+
+    auto result = context->NotifyIdle(std::chrono::milliseconds(10));
+    EXPECT_EQ(result.action, GCIdleAction::kNone);
+    EXPECT_FALSE(result.more_work);
+
+    FillNewSpace(context.get(), 0.6);
+    result = context->NotifyIdle(std::chrono::nanoseconds::zero());
+    EXPECT_EQ(result.action, GCIdleAction::kNone);
+
+    GCHeapStats after;
+    context->gc_manager().GetHeapStats(&after);
+    EXPECT_EQ(after.pause_count, before.pause_count);
+    EXPECT_EQ(after.idle_task_count, 0u);
+}
+
+/**
+ * @test Eden区使用率超过阈值时在空闲时间提前执行Scavenge，预计超出预算时留到之后
+ */
+TEST_F(GCHeapTest, NotifyIdleScavenges) {
+    GCHeapConfig config;
+    config.adaptive_new_space = false;
+    auto context = std::make_unique<Context>(runtime_.get(), config);
+    auto& gc = context->gc_manager();
+
+    FillNewSpace(context.get(), config.idle_scavenge_ratio);
+    auto result = context->NotifyIdle(std::chrono::seconds(1));
+    EXPECT_EQ(result.action, GCIdleAction::kScavenge);
+    GCHeapStats stats;
+    gc.GetHeapStats(&stats);
+    EXPECT_LT(stats.new_space_used, stats.eden_size * config.idle_scavenge_ratio);
+    EXPECT_EQ(stats.idle_task_count, 1u);
+
+    // 已有上一次Scavenge的用时，预算不足时不执行
+    FillNewSpace(context.get(), config.idle_scavenge_ratio);
+    result = context->NotifyIdle(std::chrono::nanoseconds(1));
+    EXPECT_EQ(result.action, GCIdleAction::kNone);
+    EXPECT_TRUE(result.more_work);
+}
+
+/**
+ * @test 空闲时间推进老年代惰性清除
+ */
+TEST_F(GCHeapTest, NotifyIdleSweeps) {
+    constexpr size_t kCount = 2000;
+    GCHeapConfig config;
+    config.adaptive_new_space = false;
+    auto context = std::make_unique<Context>(runtime_.get(), config);
+    auto& gc = context->gc_manager();
+    Value holder;
+    BuildOldChildren(context.get(), &holder, kCount);
+    for (size_t i = 0; i < kCount / 4; ++i) {
+        holder.array().Pop(context.get());
+    }
+    gc.CollectGarbage(true);
+
+    GCIdleResult result;
+    do {
+        result = context->NotifyIdle(std::chrono::milliseconds(100));
+        EXPECT_EQ(result.action, GCIdleAction::kSweep);
+    } while (result.more_work);
+
+    // 清除完成后没有剩余工作
+    EXPECT_EQ(context->NotifyIdle(std::chrono::milliseconds(100)).action, GCIdleAction::kNone);
+
+    gc.RemoveRoot(&holder);
+}
+
+/**
+ * @test 空闲时间推进增量标记直到结束
+ */
+TEST_F(GCHeapTest, NotifyIdleFinishesIncrementalMarking) {
+    GCHeapConfig config;
+    config.adaptive_new_space = false;
+    config.incremental_marking = true;
+    config.concurrent_marking_start_ratio = 1.0;
+    auto context = std::make_unique<Context>(runtime_.get(), config);
+    auto& gc = context->gc_manager();
+    Value holder;
+    BuildOldChildren(context.get(), &holder, 2000);
+    ASSERT_TRUE(gc.StartConcurrentMarking());
+
+    GCIdleResult result;
+    int steps = 0;
+    do {
+        result = context->NotifyIdle(std::chrono::microseconds(200));
+        EXPECT_EQ(result.action, GCIdleAction::kIncrementalMarking);
+        ++steps;
+    } while (result.more_work && steps < 100000);
+    EXPECT_FALSE(gc.heap()->is_marking());
+
+    GCHeapStats stats;
+    gc.GetHeapStats(&stats);
+    EXPECT_EQ(stats.concurrent_marking_count, 1u);
+
+    Value child;
+    ASSERT_TRUE(holder.array().GetElement(context.get(), 1999, &child));
+    Value element;
+    ASSERT_TRUE(child.array().GetElement(context.get(), 0, &element));
+    EXPECT_EQ(element.i64(), 1999);
+
+    gc.RemoveRoot(&holder);
+}
+
+/**
+ * @test 未启用增量标记时，老年代增长后在空闲时间执行完整GC，之后不再重复执行
+ */
+TEST_F(GCHeapTest, NotifyIdleCollectsGrownOldSpace) {
+    GCHeapConfig config;
+    config.adaptive_new_space = false;
+    config.concurrent_marking_start_ratio = 0;
+    auto context = std::make_unique<Context>(runtime_.get(), config);
+    auto& gc = context->gc_manager();
+    Value holder;
+    BuildOldChildren(context.get(), &holder, 2000);
+
+    auto result = context->NotifyIdle(std::chrono::seconds(1));
+    EXPECT_EQ(result.action, GCIdleAction::kFullGC);
+    while (result.more_work) {
+        result = context->NotifyIdle(std::chrono::seconds(1));
+    }
+    GCHeapStats stats;
+    gc.GetHeapStats(&stats);
+    EXPECT_EQ(stats.mark_sweep_count + stats.compaction_count, 1u);
+
+    EXPECT_EQ(context->NotifyIdle(std::chrono::seconds(1)).action, GCIdleAction::kNone);
+
+    gc.RemoveRoot(&holder);
+}
+
+// ==================== 堆限制测试 ====================
+
+/**
+ * @test 堆大小包括外部内存（ArrayBuffer 的缓冲区）和引用计数原生对象的内存
+ */
+TEST_F(GCHeapTest, HeapSizeCountsExternalAndNativeMemory) {
+    constexpr size_t kBufferSize = 1024 * 1024;
+    auto context = std::make_unique<Context>(runtime_.get());
+    auto& gc = context->gc_manager();
+
+    GCHeapStats before;
+    gc.GetHeapStats(&before);
+    {
+        GCHandleScope<1> scope(context.get());
+        scope.New<ArrayBufferObject>(kBufferSize);
+        GCHeapStats stats;
+        gc.GetHeapStats(&stats);
+        EXPECT_EQ(stats.external_memory, before.external_memory + kBufferSize);
+        EXPECT_GE(stats.heap_size, before.heap_size + kBufferSize);
+    }
+    gc.CollectGarbage(true);
+    GCHeapStats after;
+    gc.GetHeapStats(&after);
+    EXPECT_EQ(after.external_memory, before.external_memory);
+
+    size_t native_before = NativeMemory::bytes();
+    {
+        Value str(String::New(std::string(4096, 'x')));
+        EXPECT_GE(NativeMemory::bytes(), native_before + 4096);
+    }
+    EXPECT_EQ(NativeMemory::bytes(), native_before);
+}
+
+static void CountNearHeapLimit(Context* context, size_t heap_size, size_t soft_limit, void* data) {
+    EXPECT_GT(heap_size, soft_limit);
+    ++*static_cast<int*>(data);
+}
+
+/**
+ * @test 超过软限制时调用一次回调，回落到软限制以下后重新生效；超过硬限制时检查失败
+ */
+TEST_F(GCHeapTest, HeapLimits) {
+    constexpr int64_t kExternalSize = 16 * 1024 * 1024;
+    auto context = std::make_unique<Context>(runtime_.get());
+    auto& gc = context->gc_manager();
+    auto* heap = gc.heap();
+    int near_limit_calls = 0;
+    gc.SetNearHeapLimitCallback(&CountNearHeapLimit, &near_limit_calls);
+
+    size_t base = heap->heap_size();
+    gc.SetHeapLimits(base + kExternalSize / 2, base + kExternalSize * 2);
+    EXPECT_TRUE(heap->CheckHeapLimit());
+    EXPECT_EQ(near_limit_calls, 0);
+
+    // 超过软限制：完整GC无法回收外部内存，调用回调
+    gc.AdjustExternalMemory(kExternalSize);
+    EXPECT_TRUE(heap->CheckHeapLimit());
+    EXPECT_TRUE(heap->CheckHeapLimit());
+    EXPECT_EQ(near_limit_calls, 1);
+
+    gc.AdjustExternalMemory(-kExternalSize);
+    EXPECT_TRUE(heap->CheckHeapLimit());
+    gc.AdjustExternalMemory(kExternalSize);
+    EXPECT_TRUE(heap->CheckHeapLimit());
+    EXPECT_EQ(near_limit_calls, 2);
+
+    // 超过硬限制
+    gc.AdjustExternalMemory(kExternalSize * 2);
+    EXPECT_FALSE(heap->CheckHeapLimit());
+    GCHeapStats stats;
+    gc.GetHeapStats(&stats);
+    EXPECT_EQ(stats.near_heap_limit_count, 2u);
+    EXPECT_EQ(stats.heap_limit_exceeded_count, 1u);
+
+    // 取消限制
+    gc.SetHeapLimits(0, 0);
+    EXPECT_TRUE(heap->CheckHeapLimit());
+    gc.AdjustExternalMemory(-kExternalSize * 3);
+}
+
 // ==================== 使用HandleScope的测试 ====================
 
 /**
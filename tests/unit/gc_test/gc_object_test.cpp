@@ -14,6 +14,7 @@
 #include <gtest/gtest.h>
 
 #include <mjs/gc/gc_object.h>
+#include <mjs/gc/heap_cage.h>
 #include <mjs/context.h>
 #include <mjs/runtime.h>
 
@@ -68,6 +69,18 @@ class GCObjectTest : public ::testing::Test {
 protected:
     void SetUp() override {}
     void TearDown() override {}
+
+    /**
+     * @brief 在堆笼中构造转发目标（启用指针压缩时转发地址只能指向堆笼内）
+     */
+    static TestGCObject* NewForwardingTarget() {
+        return new (HeapCage::Instance().AllocateCell(sizeof(TestGCObject))) TestGCObject();
+    }
+
+    static void DeleteForwardingTarget(TestGCObject* obj) {
+        obj->~TestGCObject();
+        HeapCage::Instance().FreeCell(obj, sizeof(TestGCObject));
+    }
 };
 
 // ==================== GCObjectHeader 测试 ====================
@@ -119,18 +132,26 @@ TEST_F(GCObjectTest, HeaderMarked) {
  */
 TEST_F(GCObjectTest, HeaderForwardingAddress) {
     TestGCObject obj1;
-    TestGCObject obj2;
+    auto* obj2 = NewForwardingTarget();
 
     EXPECT_FALSE(obj1.header()->IsForwarded());
     EXPECT_EQ(obj1.header()->GetForwardingAddress(), nullptr);
 
-    obj1.header()->SetForwardingAddress(&obj2);
+    obj1.header()->SetForwardingAddress(obj2);
     EXPECT_TRUE(obj1.header()->IsForwarded());
-    EXPECT_EQ(obj1.header()->GetForwardingAddress(), &obj2);
+    EXPECT_EQ(obj1.header()->GetForwardingAddress(), obj2);
 
     obj1.header()->SetForwardingAddress(nullptr);
     EXPECT_FALSE(obj1.header()->IsForwarded());
     EXPECT_EQ(obj1.header()->GetForwardingAddress(), nullptr);
+
+    // 正在复制的占位值
+    obj1.header()->SetForwardingAddress(GCObjectHeader::ForwardingBusy());
+    EXPECT_EQ(obj1.header()->LoadForwardingAddress(), GCObjectHeader::ForwardingBusy());
+    obj1.header()->PublishForwardingAddress(obj2);
+    EXPECT_EQ(obj1.header()->LoadForwardingAddress(), obj2);
+
+    DeleteForwardingTarget(obj2);
 }
 
 /**
@@ -386,21 +407,24 @@ TEST_F(GCObjectTest, MultipleHeaderFlags) {
  * @test 测试转发地址与标记的交互
  */
 TEST_F(GCObjectTest, ForwardingAddressWithFlags) {
-    TestGCObject obj1, obj2;
+    TestGCObject obj1;
+    auto* obj2 = NewForwardingTarget();
 
     obj1.header()->SetMarked(true);
     obj1.header()->SetPinned(true);
     obj1.header()->IncrementAge();
 
     // 设置转发地址
-    obj1.header()->SetForwardingAddress(&obj2);
+    obj1.header()->SetForwardingAddress(obj2);
 
     // 验证转发地址设置正确，其他标志不受影响
     EXPECT_TRUE(obj1.header()->IsForwarded());
-    EXPECT_EQ(obj1.header()->GetForwardingAddress(), &obj2);
+    EXPECT_EQ(obj1.header()->GetForwardingAddress(), obj2);
     EXPECT_TRUE(obj1.header()->IsMarked());
     EXPECT_TRUE(obj1.header()->IsPinned());
     EXPECT_EQ(obj1.header()->age(), 1);
+
+    DeleteForwardingTarget(obj2);
 }
 
 } // namespace test
@@ -0,0 +1,242 @@
+/**
+ * @file gc_tracer_test.cpp
+ * @brief GC事件追踪单元测试
+ *
+ * 测试GC事件追踪与停顿时间直方图：
+ * - 直方图的分位数误差在精度范围内
+ * - Scavenge、完整GC和老年代扩容通过回调交付事件，记录字节数和阶段用时
+ * - 堆统计信息中的停顿时间分位数
+ * - 以 Chrome trace-event JSON 格式写出事件
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/gc/handle.h>
+#include <mjs/value/object/object.h>
+
+namespace mjs {
+namespace test {
+
+/**
+ * @class GCTracerTest
+ * @brief GC事件追踪测试
+ */
+class GCTracerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+        context_ = std::make_unique<Context>(runtime_.get());
+        heap_ = context_->gc_manager().heap();
+        context_->gc_manager().SetGCEventCallback([](Context* context, const GCEvent& event, void* data) {
+            static_cast<std::vector<GCEvent>*>(data)->push_back(event);
+        }, &events_);
+    }
+
+    void TearDown() override {
+        context_->gc_manager().SetGCEventCallback(nullptr);
+        for (auto& value : retained_) {
+            context_->gc_manager().RemoveRoot(&value);
+        }
+        context_.reset();
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 分配对象，每 keep_every 个保留一个作为根
+     */
+    void AllocateObjects(size_t count, size_t keep_every) {
+        for (size_t i = 0; i < count; ++i) {
+            GCHandleScope<1> scope(context_.get());
+            auto obj = scope.New<Object>();
+            if (i % keep_every == 0) {
+                retained_.push_back(obj.ToValue());
+                context_->gc_manager().AddRoot(&retained_.back());
+            }
+        }
+    }
+
+    /**
+     * @brief 查找最后一个指定种类的事件
+     */
+    const GCEvent* FindLast(GCEventKind kind) const {
+        for (auto iter = events_.rbegin(); iter != events_.rend(); ++iter) {
+            if (iter->kind == kind) {
+                return &*iter;
+            }
+        }
+        return nullptr;
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+    std::unique_ptr<Context> context_;
+    GCHeap* heap_ = nullptr;
+    std::vector<GCEvent> events_;
+    std::deque<Value> retained_;    ///< 保留的对象，注册为根后地址不能改变
+};
+
+/**
+ * @test 直方图的分位数在精度范围内，小于 kSubBucketCount 的值精确记录
+ */
+TEST_F(GCTracerTest, HistogramPercentiles) {
+    GCPauseHistogram histogram;
+    EXPECT_EQ(histogram.Percentile(99), 0u);
+
+    for (uint64_t i = 1; i <= 100; ++i) {
+        histogram.Record(i);
+    }
+    EXPECT_EQ(histogram.Percentile(50), 50u);
+    EXPECT_EQ(histogram.Percentile(99), 99u);
+    EXPECT_EQ(histogram.Percentile(100), 100u);
+
+    histogram.Reset();
+    for (uint64_t i = 1; i <= 100000; ++i) {
+        histogram.Record(i);
+    }
+    EXPECT_EQ(histogram.count(), 100000u);
+    EXPECT_EQ(histogram.min(), 1u);
+    EXPECT_EQ(histogram.max(), 100000u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 50000.5);
+
+    // 相对误差不超过 2 / kSubBucketCount，且结果不小于真实值
+    double tolerance = 2.0 / GCPauseHistogram::kSubBucketCount;
+    for (double percentile : { 50.0, 90.0, 99.0, 99.9 }) {
+        double expected = percentile * 1000;
+        double actual = static_cast<double>(histogram.Percentile(percentile));
+        EXPECT_GE(actual, expected) << percentile;
+        EXPECT_LE(actual, expected * (1 + tolerance)) << percentile;
+    }
+    EXPECT_EQ(histogram.Percentile(100), 100000u);
+
+    // 超出范围的值按最大值记录
+    histogram.Record(UINT64_MAX);
+    EXPECT_EQ(histogram.max(), GCPauseHistogram::kMaxValue);
+}
+
+/**
+ * @test Scavenge 事件记录回收和晋升的字节数及阶段用时
+ */
+TEST_F(GCTracerTest, ScavengeEvent) {
+    AllocateObjects(1000, 10);
+    events_.clear();
+    ASSERT_TRUE(heap_->CollectGarbage(false));
+
+    auto* event = FindLast(GCEventKind::kScavenge);
+    ASSERT_NE(event, nullptr);
+    EXPECT_GT(event->freed_bytes, 0u);
+    EXPECT_LE(event->start, event->end);
+    EXPECT_GT(event->phase(GCPhase::kCopy).count(), 0);
+    EXPECT_EQ(event->phase(GCPhase::kMark).count(), 0);
+
+    std::chrono::steady_clock::duration phases{};
+    for (auto& phase : event->phases) {
+        phases += phase;
+    }
+    EXPECT_LE(phases, event->elapsed());
+
+    // 存活足够多次后晋升到老年代
+    size_t promoted = 0;
+    for (uint8_t i = 0; i <= kTenureAgeThreshold; ++i) {
+        ASSERT_TRUE(heap_->CollectGarbage(false));
+        promoted += FindLast(GCEventKind::kScavenge)->promoted_bytes;
+    }
+    EXPECT_GT(promoted, 0u);
+    EXPECT_EQ(heap_->tracer().event_count(), events_.size());
+}
+
+/**
+ * @test 完整GC生成标记后清除或压缩的事件，记录标记阶段和老年代回收的字节数
+ */
+TEST_F(GCTracerTest, FullGCEvent) {
+    AllocateObjects(1000, 2);
+    for (uint8_t i = 0; i <= kTenureAgeThreshold; ++i) {
+        ASSERT_TRUE(heap_->CollectGarbage(false));
+    }
+
+    // 释放一半晋升的对象
+    for (size_t i = 0; i < retained_.size(); i += 2) {
+        context_->gc_manager().RemoveRoot(&retained_[i]);
+    }
+
+    events_.clear();
+    ASSERT_TRUE(heap_->CollectGarbage(true));
+    ASSERT_GE(events_.size(), 2u);
+    EXPECT_EQ(events_.front().kind, GCEventKind::kScavenge);
+
+    auto& event = events_.back();
+    EXPECT_TRUE(event.kind == GCEventKind::kMarkSweep || event.kind == GCEventKind::kMarkCompact);
+    EXPECT_GT(event.phase(GCPhase::kMark).count(), 0);
+    EXPECT_GT(event.freed_bytes, 0u);
+    if (event.kind == GCEventKind::kMarkCompact) {
+        EXPECT_GT(event.phase(GCPhase::kCompact).count(), 0);
+    }
+}
+
+/**
+ * @test 晋升的对象超过老年代空闲空间时生成扩容事件
+ */
+TEST_F(GCTracerTest, ExpandEvent) {
+    for (int round = 0; round < 64 && !FindLast(GCEventKind::kExpand); ++round) {
+        AllocateObjects(10000, 1);
+        heap_->CollectGarbage(false);
+    }
+    auto* event = FindLast(GCEventKind::kExpand);
+    ASSERT_NE(event, nullptr);
+    EXPECT_GT(event->expanded_bytes, 0u);
+}
+
+/**
+ * @test 堆统计信息中的停顿时间分位数单调且不超过最长停顿
+ */
+TEST_F(GCTracerTest, PausePercentilesInStats) {
+    for (int i = 0; i < 20; ++i) {
+        AllocateObjects(200, 50);
+        heap_->CollectGarbage(i % 5 == 0);
+    }
+
+    GCHeapStats stats;
+    heap_->GetHeapStats(&stats);
+    EXPECT_EQ(heap_->tracer().pause_histogram().count(), stats.pause_count);
+    EXPECT_LE(stats.pause_p50_ms, stats.pause_p90_ms);
+    EXPECT_LE(stats.pause_p90_ms, stats.pause_p99_ms);
+    EXPECT_LE(stats.pause_p99_ms, stats.pause_p999_ms);
+    EXPECT_LE(stats.pause_p999_ms, stats.max_pause_ms);
+}
+
+/**
+ * @test 以 Chrome trace-event JSON 格式写出记录的事件
+ */
+TEST_F(GCTracerTest, ChromeTraceOutput) {
+    std::stringstream out;
+    EXPECT_FALSE(context_->gc_manager().StopGCTracing(out));
+
+    context_->gc_manager().StartGCTracing();
+    AllocateObjects(100, 10);
+    heap_->CollectGarbage(false);
+    heap_->CollectGarbage(true);
+    ASSERT_TRUE(context_->gc_manager().StopGCTracing(out));
+
+    auto json = out.str();
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"name\":\"Scavenge\",\"cat\":\"gc\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_TRUE(json.find("\"name\":\"MarkSweep\"") != std::string::npos
+        || json.find("\"name\":\"MarkCompact\"") != std::string::npos);
+    EXPECT_NE(json.find("\"mark_us\":"), std::string::npos);
+    EXPECT_NE(json.find("\"freed_bytes\":"), std::string::npos);
+
+    // 停止后不再记录
+    EXPECT_FALSE(heap_->tracer().tracing());
+    EXPECT_FALSE(context_->gc_manager().StopGCTracing(out));
+}
+
+} // namespace test
+} // namespace mjs
@@ -0,0 +1,149 @@
+/**
+ * @file heap_cage_test.cpp
+ * @brief 堆笼和压缩指针单元测试
+ *
+ * 测试指针压缩使用的堆笼：
+ * - 页级内存的分配、释放和相邻空闲区间的合并
+ * - 小块内存的分配和复用
+ * - 压缩指针与地址的相互转换
+ * - 启用指针压缩时GC堆的对象和形状位于堆笼内
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/gc/handle.h>
+#include <mjs/gc/heap_cage.h>
+#include <mjs/gc/virtual_memory.h>
+#include <mjs/shape/shape.h>
+#include <mjs/value/object/object.h>
+
+namespace mjs {
+namespace test {
+
+/**
+ * @test 分配的内存按页对齐、内容为0，释放后可以重新分配
+ */
+TEST(HeapCageTest, AllocateAndFree) {
+    auto& cage = HeapCage::Instance();
+    size_t page_size = VirtualMemoryPageSize();
+    size_t committed = cage.committed_size();
+
+    auto* a = static_cast<uint8_t*>(cage.Allocate(page_size * 2));
+    ASSERT_NE(a, nullptr);
+    EXPECT_TRUE(cage.Contains(a));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % page_size, 0u);
+    EXPECT_EQ(a[0], 0);
+    EXPECT_EQ(a[page_size * 2 - 1], 0);
+    std::memset(a, 0xcc, page_size * 2);
+    EXPECT_EQ(cage.committed_size(), committed + page_size * 2);
+
+    // 偏移不会是0或1
+    EXPECT_GT(CompressHeapPointer(a), 1u);
+
+    auto* b = static_cast<uint8_t*>(cage.Allocate(1));
+    ASSERT_NE(b, nullptr);
+    cage.Free(a, page_size * 2);
+    cage.Free(b, 1);
+    EXPECT_EQ(cage.committed_size(), committed);
+
+    // 释放的区间合并后可以容纳更大的分配，重新分配的内存内容为0
+    auto* c = static_cast<uint8_t*>(cage.Allocate(page_size * 3));
+    ASSERT_NE(c, nullptr);
+    EXPECT_EQ(c[0], 0);
+    cage.Free(c, page_size * 3);
+}
+
+/**
+ * @test 释放的小块被同一大小类别的分配复用
+ */
+TEST(HeapCageTest, CellReuse) {
+    auto& cage = HeapCage::Instance();
+    void* a = cage.AllocateCell(40);
+    void* b = cage.AllocateCell(40);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_NE(a, b);
+    EXPECT_TRUE(cage.Contains(a));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % HeapCage::kCellAlignment, 0u);
+
+    cage.FreeCell(a, 40);
+    EXPECT_EQ(cage.AllocateCell(48), a);
+
+    // 超过最大小块大小时按页分配
+    void* large = cage.AllocateCell(HeapCage::kMaxCellSize + 1);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(large) % VirtualMemoryPageSize(), 0u);
+
+    cage.FreeCell(a, 48);
+    cage.FreeCell(b, 40);
+    cage.FreeCell(large, HeapCage::kMaxCellSize + 1);
+}
+
+/**
+ * @test 压缩指针与地址相互转换，空指针压缩为0
+ */
+TEST(HeapCageTest, CompressedPointerRoundTrip) {
+    auto* cell = static_cast<Shape*>(HeapCage::Instance().AllocateCell(sizeof(Shape)));
+
+    CompressedPointer<Shape> pointer;
+    EXPECT_EQ(pointer.offset(), 0u);
+    EXPECT_EQ(pointer.get(), nullptr);
+
+    pointer = cell;
+    EXPECT_EQ(pointer.get(), cell);
+    EXPECT_EQ(static_cast<Shape*>(pointer), cell);
+    EXPECT_EQ(DecompressHeapPointer(pointer.offset()), cell);
+    EXPECT_EQ(sizeof(pointer), sizeof(uint32_t));
+
+    pointer = nullptr;
+    EXPECT_EQ(pointer.offset(), 0u);
+
+    HeapCage::Instance().FreeCell(cell, sizeof(Shape));
+}
+
+#ifdef ENABLE_POINTER_COMPRESSION
+/**
+ * @test 启用指针压缩时GC对象和形状位于堆笼内，对象移动后形状引用保持有效
+ */
+TEST(HeapCageTest, HeapObjectsInsideCage) {
+    auto runtime = std::make_unique<Runtime>();
+    auto context = std::make_unique<Context>(runtime.get());
+    auto& cage = HeapCage::Instance();
+
+    auto key = context->FindConstOrInsertToLocal(Value(String::New("caged")));
+    Value retained;
+    {
+        GCHandleScope<1> scope(context.get());
+        auto obj = scope.New<Object>();
+        obj->SetProperty(context.get(), key, Value(42));
+        retained = obj.ToValue();
+    }
+    context->gc_manager().AddRoot(&retained);
+    EXPECT_TRUE(cage.Contains(&retained.object()));
+    EXPECT_TRUE(cage.Contains(retained.object().shape()));
+
+    // 复制和晋升后仍然位于堆笼内
+    for (uint8_t i = 0; i <= kTenureAgeThreshold; ++i) {
+        ASSERT_TRUE(context->gc_manager().heap()->CollectGarbage(false));
+    }
+    ASSERT_TRUE(context->gc_manager().heap()->CollectGarbage(true));
+    EXPECT_TRUE(cage.Contains(&retained.object()));
+    Value value;
+    ASSERT_TRUE(retained.object().GetProperty(context.get(), key, &value));
+    EXPECT_EQ(value.i64(), 42);
+
+    context->gc_manager().RemoveRoot(&retained);
+    retained = Value();
+    context.reset();
+    runtime.reset();
+}
+#endif
+
+} // namespace test
+} // namespace mjs
@@ -0,0 +1,284 @@
+/**
+ * @file heap_snapshot_test.cpp
+ * @brief 堆快照单元测试
+ *
+ * 测试 V8 .heapsnapshot 格式的堆快照：
+ * - 节点和边的数量与 meta 中的声明一致
+ * - 属性名来自常量池，数组元素记录下标
+ * - 可以从GC根沿边找到保留对象
+ * - 写出后堆仍可正常回收
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/gc/handle.h>
+#include <mjs/value/object/object.h>
+#include <mjs/value/object/array_object.h>
+
+namespace mjs {
+namespace test {
+
+/**
+ * @brief 解析后的快照（只解析测试需要的部分）
+ */
+struct ParsedSnapshot {
+    size_t node_count = 0;
+    size_t edge_count = 0;
+    std::vector<uint64_t> nodes;
+    std::vector<uint64_t> edges;
+    std::vector<std::string> strings;
+
+    static constexpr size_t kNodeFields = 7;
+    static constexpr size_t kEdgeFields = 3;
+    static constexpr uint64_t kEdgeElement = 1;
+    static constexpr uint64_t kEdgeProperty = 2;
+
+    const std::string& NodeName(size_t node) const { return strings[nodes[node * kNodeFields + 1]]; }
+    uint64_t NodeEdgeCount(size_t node) const { return nodes[node * kNodeFields + 4]; }
+
+    /**
+     * @brief 获取节点第一条边的下标
+     */
+    size_t FirstEdge(size_t node) const {
+        size_t edge = 0;
+        for (size_t i = 0; i < node; ++i) {
+            edge += NodeEdgeCount(i);
+        }
+        return edge;
+    }
+
+    /**
+     * @brief 查找节点的指定属性边指向的节点，找不到返回 SIZE_MAX
+     */
+    size_t FindProperty(size_t node, const std::string& name) const {
+        size_t edge = FirstEdge(node);
+        for (size_t i = 0; i < NodeEdgeCount(node); ++i, ++edge) {
+            if (edges[edge * kEdgeFields] == kEdgeProperty && strings[edges[edge * kEdgeFields + 1]] == name) {
+                return edges[edge * kEdgeFields + 2] / kNodeFields;
+            }
+        }
+        return SIZE_MAX;
+    }
+
+    /**
+     * @brief 查找节点的指定下标元素边指向的节点，找不到返回 SIZE_MAX
+     */
+    size_t FindElement(size_t node, uint64_t index) const {
+        size_t edge = FirstEdge(node);
+        for (size_t i = 0; i < NodeEdgeCount(node); ++i, ++edge) {
+            if (edges[edge * kEdgeFields] == kEdgeElement && edges[edge * kEdgeFields + 1] == index) {
+                return edges[edge * kEdgeFields + 2] / kNodeFields;
+            }
+        }
+        return SIZE_MAX;
+    }
+};
+
+static size_t ParseCount(const std::string& json, const std::string& key) {
+    auto pos = json.find("\"" + key + "\":");
+    EXPECT_NE(pos, std::string::npos);
+    return std::stoull(json.substr(pos + key.size() + 3));
+}
+
+static std::vector<uint64_t> ParseNumbers(const std::string& json, const std::string& key) {
+    std::vector<uint64_t> numbers;
+    auto pos = json.find("\"" + key + "\":[");
+    EXPECT_NE(pos, std::string::npos);
+    pos += key.size() + 4;
+    auto end = json.find(']', pos);
+    std::stringstream ss(json.substr(pos, end - pos));
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        numbers.push_back(std::stoull(item));
+    }
+    return numbers;
+}
+
+static std::vector<std::string> ParseStrings(const std::string& json) {
+    std::vector<std::string> strings;
+    auto pos = json.find("\"strings\":[");
+    EXPECT_NE(pos, std::string::npos);
+    pos += 11;
+    while (pos < json.size() && json[pos] != ']') {
+        if (json[pos] != '"') {
+            ++pos;
+            continue;
+        }
+        std::string str;
+        for (++pos; json[pos] != '"'; ++pos) {
+            if (json[pos] == '\\') {
+                ++pos;
+            }
+            str += json[pos];
+        }
+        ++pos;
+        strings.push_back(std::move(str));
+    }
+    return strings;
+}
+
+static ParsedSnapshot ParseSnapshot(const std::string& json) {
+    ParsedSnapshot snapshot;
+    snapshot.node_count = ParseCount(json, "node_count");
+    snapshot.edge_count = ParseCount(json, "edge_count");
+    snapshot.nodes = ParseNumbers(json, "nodes");
+    snapshot.edges = ParseNumbers(json, "edges");
+    snapshot.strings = ParseStrings(json);
+    return snapshot;
+}
+
+/**
+ * @class HeapSnapshotTest
+ * @brief 堆快照测试
+ */
+class HeapSnapshotTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+        context_ = std::make_unique<Context>(runtime_.get());
+    }
+
+    void TearDown() override {
+        context_.reset();
+        runtime_.reset();
+    }
+
+    ConstIndex Key(const char* name) {
+        return context_->FindConstOrInsertToGlobal(Value(String::New(name)));
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+    std::unique_ptr<Context> context_;
+};
+
+/**
+ * @test 节点和边的数量与声明一致，每条边都指向有效节点
+ */
+TEST_F(HeapSnapshotTest, CountsMatchMeta) {
+    Value holder;
+    {
+        GCHandleScope<2> scope(context_.get());
+        auto obj = scope.New<Object>();
+        auto child = scope.New<Object>();
+        obj->SetProperty(context_.get(), Key("child"), child.ToValue());
+        holder = obj.ToValue();
+    }
+    context_->gc_manager().AddRoot(&holder);
+
+    std::stringstream out;
+    ASSERT_TRUE(context_->gc_manager().WriteHeapSnapshot(out));
+    auto json = out.str();
+    EXPECT_EQ(json.rfind("{\"snapshot\":{\"meta\":", 0), 0u);
+
+    auto snapshot = ParseSnapshot(json);
+    ASSERT_EQ(snapshot.nodes.size(), snapshot.node_count * ParsedSnapshot::kNodeFields);
+    ASSERT_EQ(snapshot.edges.size(), snapshot.edge_count * ParsedSnapshot::kEdgeFields);
+
+    size_t total_edges = 0;
+    for (size_t i = 0; i < snapshot.node_count; ++i) {
+        total_edges += snapshot.NodeEdgeCount(i);
+        EXPECT_LT(snapshot.nodes[i * ParsedSnapshot::kNodeFields + 1], snapshot.strings.size());
+    }
+    EXPECT_EQ(total_edges, snapshot.edge_count);
+    for (size_t i = 0; i < snapshot.edge_count; ++i) {
+        EXPECT_LT(snapshot.edges[i * ParsedSnapshot::kEdgeFields + 2], snapshot.nodes.size());
+    }
+    EXPECT_EQ(snapshot.NodeName(0), "(GC roots)");
+
+    context_->gc_manager().RemoveRoot(&holder);
+}
+
+/**
+ * @test 可以从GC根沿属性名和数组下标找到保留的对象
+ */
+TEST_F(HeapSnapshotTest, RetainerPathThroughPropertiesAndElements) {
+    Value holder;
+    {
+        GCHandleScope<3> scope(context_.get());
+        auto obj = scope.New<Object>();
+        auto cache = scope.New<ArrayObject>(0);
+        auto entry = scope.New<Object>();
+        entry->SetProperty(context_.get(), Key("payload"), Value(int64_t(42)));
+        cache->Push(context_.get(), Value(int64_t(0)));
+        cache->Push(context_.get(), entry.ToValue());
+        obj->SetProperty(context_.get(), Key("leakyCache"), cache.ToValue());
+        holder = obj.ToValue();
+    }
+    context_->gc_manager().AddRoot(&holder);
+
+    std::stringstream out;
+    ASSERT_TRUE(context_->gc_manager().WriteHeapSnapshot(out));
+    auto snapshot = ParseSnapshot(out.str());
+
+    // 在根引用的对象中找到带 leakyCache 属性的那个
+    size_t cache_node = SIZE_MAX;
+    size_t root_edge = 0;
+    for (size_t i = 0; i < snapshot.NodeEdgeCount(0); ++i, ++root_edge) {
+        size_t node = snapshot.edges[root_edge * ParsedSnapshot::kEdgeFields + 2] / ParsedSnapshot::kNodeFields;
+        cache_node = snapshot.FindProperty(node, "leakyCache");
+        if (cache_node != SIZE_MAX) {
+            break;
+        }
+    }
+    ASSERT_NE(cache_node, SIZE_MAX);
+    EXPECT_EQ(snapshot.NodeName(cache_node), "Array");
+
+    size_t entry_node = snapshot.FindElement(cache_node, 1);
+    ASSERT_NE(entry_node, SIZE_MAX);
+    EXPECT_EQ(snapshot.NodeName(entry_node), "Object");
+    // 数字元素不是堆节点
+    EXPECT_EQ(snapshot.FindElement(cache_node, 0), SIZE_MAX);
+
+    context_->gc_manager().RemoveRoot(&holder);
+}
+
+/**
+ * @test 写出快照后节点序号被清除，对象仍可正常回收和访问
+ */
+TEST_F(HeapSnapshotTest, HeapUsableAfterSnapshot) {
+    Value holder;
+    {
+        GCHandleScope<2> scope(context_.get());
+        auto obj = scope.New<Object>();
+        auto child = scope.New<Object>();
+        child->SetProperty(context_.get(), Key("value"), Value(int64_t(7)));
+        obj->SetProperty(context_.get(), Key("child"), child.ToValue());
+        holder = obj.ToValue();
+    }
+    context_->gc_manager().AddRoot(&holder);
+
+    auto path = (std::filesystem::temp_directory_path() / "mjs_heap_snapshot_test.heapsnapshot").string();
+    ASSERT_TRUE(context_->gc_manager().WriteHeapSnapshot(path));
+    std::ifstream in(path, std::ios::binary);
+    std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::remove(path.c_str());
+    EXPECT_FALSE(json.empty());
+    EXPECT_NE(json.find("\"child\""), std::string::npos);
+
+    EXPECT_TRUE(context_->gc_manager().heap()->CollectGarbage(false));
+    EXPECT_TRUE(context_->gc_manager().heap()->CollectGarbage(true));
+
+    Value child;
+    ASSERT_TRUE(holder.object().GetProperty(context_.get(), Key("child"), &child));
+    Value value;
+    ASSERT_TRUE(child.object().GetProperty(context_.get(), Key("value"), &value));
+    EXPECT_EQ(value.i64(), 7);
+
+    context_->gc_manager().RemoveRoot(&holder);
+}
+
+} // namespace test
+} // namespace mjs
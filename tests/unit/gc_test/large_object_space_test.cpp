@@ -0,0 +1,164 @@
+/**
+ * @file large_object_space_test.cpp
+ * @brief LargeObjectSpace 大对象空间单元测试
+ *
+ * 测试大对象空间的功能：
+ * - 内存分配与对齐
+ * - 对象遍历
+ * - 清除未标记对象
+ *
+ * @copyright Copyright (c) 2025
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include <mjs/gc/large_object_space.h>
+#include <mjs/gc/virtual_memory.h>
+#include <mjs/gc/gc_object.h>
+
+namespace mjs {
+namespace test {
+
+// 测试用的大对象，析构时计数
+class LargeSpaceTestObject : public GCObject {
+public:
+    static constexpr size_t kDataSize = 64 * 1024;
+
+    explicit LargeSpaceTestObject(int* destruct_count) : destruct_count_(destruct_count) {}
+
+    ~LargeSpaceTestObject() override {
+        ++*destruct_count_;
+    }
+
+    void GCTraverse(Context* context, GCTraverseCallback callback) override {
+        (void)context;
+        (void)callback;
+    }
+
+private:
+    int* destruct_count_;
+    char data_[kDataSize];
+};
+
+/**
+ * @class LargeObjectSpaceTest
+ * @brief LargeObjectSpace 类单元测试
+ */
+class LargeObjectSpaceTest : public ::testing::Test {
+protected:
+    LargeSpaceTestObject* AllocateObject(bool mark) {
+        size_t size = sizeof(LargeSpaceTestObject);
+        void* ptr = space_.Allocate(&size);
+        EXPECT_NE(ptr, nullptr);
+        auto* obj = new (ptr) LargeSpaceTestObject(&destruct_count_);
+        obj->header()->set_size(size);
+        obj->header()->set_type(GCObjectType::kObject);
+        obj->header()->set_generation(GCGeneration::kOld);
+        obj->header()->SetLarge(true);
+        obj->header()->SetMarked(mark);
+        return obj;
+    }
+
+    LargeObjectSpace space_;
+    int destruct_count_ = 0;
+};
+
+/**
+ * @test 测试分配：每个对象单独映射，按页对齐记录映射大小
+ */
+TEST_F(LargeObjectSpaceTest, Allocate) {
+    EXPECT_EQ(space_.object_count(), 0u);
+    EXPECT_EQ(space_.used_size(), 0u);
+
+    auto* obj = AllocateObject(true);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(obj) % kGCObjectAlignment, 0u);
+    EXPECT_EQ(space_.object_count(), 1u);
+    EXPECT_EQ(space_.used_size(), AlignGCObjectSize(sizeof(LargeSpaceTestObject)));
+    EXPECT_GE(space_.mapped_size(), space_.used_size());
+    EXPECT_EQ(space_.mapped_size() % VirtualMemoryPageSize(), 0u);
+
+    // 对象内存可以完整写入
+    std::memset(reinterpret_cast<uint8_t*>(obj) + sizeof(GCObject), 0xcc,
+        sizeof(LargeSpaceTestObject) - sizeof(GCObject));
+}
+
+/**
+ * @test 测试遍历所有对象和存活对象
+ */
+TEST_F(LargeObjectSpaceTest, IterateObjects) {
+    for (int i = 0; i < 4; ++i) {
+        AllocateObject(i % 2 == 0);
+    }
+
+    int count = 0;
+    space_.IterateObjects([](GCObject* obj, void* data) {
+        ++*static_cast<int*>(data);
+    }, &count);
+    EXPECT_EQ(count, 4);
+
+    count = 0;
+    space_.IterateLiveObjects([](GCObject* obj, void* data) {
+        EXPECT_TRUE(obj->header()->IsMarked());
+        ++*static_cast<int*>(data);
+    }, &count);
+    EXPECT_EQ(count, 2);
+}
+
+/**
+ * @test 测试清除：未标记的对象析构并解除映射，存活对象地址不变
+ */
+TEST_F(LargeObjectSpaceTest, SweepFreesUnmarkedObjects) {
+    std::vector<LargeSpaceTestObject*> live;
+    for (int i = 0; i < 6; ++i) {
+        auto* obj = AllocateObject(i % 3 == 0);
+        if (obj->header()->IsMarked()) {
+            live.push_back(obj);
+        }
+    }
+    size_t object_size = AlignGCObjectSize(sizeof(LargeSpaceTestObject));
+
+    EXPECT_EQ(space_.Sweep(), 4 * object_size);
+    EXPECT_EQ(destruct_count_, 4);
+    EXPECT_EQ(space_.object_count(), 2u);
+    EXPECT_EQ(space_.used_size(), 2 * object_size);
+
+    std::vector<GCObject*> remaining;
+    space_.IterateObjects([](GCObject* obj, void* data) {
+        static_cast<std::vector<GCObject*>*>(data)->push_back(obj);
+    }, &remaining);
+    ASSERT_EQ(remaining.size(), live.size());
+    for (size_t i = 0; i < live.size(); ++i) {
+        EXPECT_EQ(remaining[i], live[i]);
+    }
+
+    // 全部死亡后清空
+    for (auto* obj : live) {
+        obj->header()->SetMarked(false);
+    }
+    EXPECT_EQ(space_.Sweep(), 2 * object_size);
+    EXPECT_EQ(destruct_count_, 6);
+    EXPECT_EQ(space_.object_count(), 0u);
+    EXPECT_EQ(space_.used_size(), 0u);
+    EXPECT_EQ(space_.mapped_size(), 0u);
+}
+
+/**
+ * @test 测试清除时跳过已析构的对象
+ */
+TEST_F(LargeObjectSpaceTest, SweepSkipsDestructedObjects) {
+    auto* obj = AllocateObject(false);
+    obj->header()->SetDestructed(true);
+    obj->~LargeSpaceTestObject();
+    EXPECT_EQ(destruct_count_, 1);
+
+    space_.Sweep();
+    EXPECT_EQ(destruct_count_, 1);
+    EXPECT_EQ(space_.object_count(), 0u);
+}
+
+} // namespace test
+} // namespace mjs
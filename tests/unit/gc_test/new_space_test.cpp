@@ -95,8 +95,8 @@ TEST_F(NewSpaceTest, Initialize) {
  * @test 测试容量常量
  */
 TEST_F(NewSpaceTest, CapacityConstant) {
-    EXPECT_EQ(NewSpace::capacity(), kNewSpaceTotalSize);
-    EXPECT_GT(NewSpace::capacity(), 0);
+    EXPECT_EQ(new_space_->capacity(), kEdenSpaceSize + kSurvivorSpaceSize * 2);
+    EXPECT_GT(new_space_->capacity(), 0);
 }
 
 // ==================== 内存分配测试 ====================
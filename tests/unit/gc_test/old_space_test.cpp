@@ -5,9 +5,10 @@
  * 测试老年代内存空间的功能：
  * - 初始化
  * - 内存分配
- * - 空间扩容
+ * - 按页扩容
  * - 对象遍历
- * - 压缩计算
+ * - 按页压缩
+ * - 清除与空闲链表，归还空页
  * - 边界条件
  *
  * @copyright Copyright (c) 2025
@@ -74,6 +75,26 @@ protected:
         old_space_.reset();
     }
 
+    /**
+     * @brief 分配 count 个对象，mark 返回true的对象设置标记
+     */
+    template <typename Pred>
+    std::vector<TestGCObject*> AllocateObjects(int count, Pred mark) {
+        std::vector<TestGCObject*> objects;
+        for (int i = 0; i < count; i++) {
+            size_t size = sizeof(TestGCObject);
+            void* ptr = old_space_->Allocate(&size);
+            EXPECT_NE(ptr, nullptr);
+            TestGCObject* obj = new (ptr) TestGCObject(i);
+            obj->header()->set_size(size);
+            obj->header()->set_type(GCObjectType::kObject);
+            obj->header()->set_generation(GCGeneration::kOld);
+            obj->header()->SetMarked(mark(i));
+            objects.push_back(obj);
+        }
+        return objects;
+    }
+
     std::unique_ptr<OldSpace> old_space_;
 };
 
@@ -83,9 +104,10 @@ protected:
  * @test 测试老年代初始化
  */
 TEST_F(OldSpaceTest, Initialize) {
-    EXPECT_NE(old_space_->space_start(), nullptr);
-    EXPECT_EQ(old_space_->top(), old_space_->space_start());
+    EXPECT_TRUE(old_space_->pages().empty());
+    EXPECT_EQ(old_space_->empty_page_count(), kOldSpaceInitialSize / kOldSpacePageSize);
     EXPECT_EQ(old_space_->capacity(), kOldSpaceInitialSize);
+    EXPECT_EQ(old_space_->available_size(), kOldSpaceInitialSize);
     EXPECT_EQ(old_space_->used_size(), 0);
 }
 
@@ -122,7 +144,8 @@ TEST_F(OldSpaceTest, AllocateSmallObject) {
     void* ptr = old_space_->Allocate(&size);
 
     ASSERT_NE(ptr, nullptr);
-    EXPECT_EQ(ptr, old_space_->space_start());
+    ASSERT_EQ(old_space_->pages().size(), 1u);
+    EXPECT_EQ(ptr, old_space_->pages().front().start());
     EXPECT_EQ(old_space_->used_size(), size);
 }
 
@@ -171,10 +194,16 @@ TEST_F(OldSpaceTest, AllocateLargeObject) {
  * @test 测试空间不足时的分配
  */
 TEST_F(OldSpaceTest, AllocateWhenInsufficientSpace) {
-    // 分配接近容量的对象
-    size_t large_size = old_space_->capacity();
-    void* ptr1 = old_space_->Allocate(&large_size);
-    ASSERT_NE(ptr1, nullptr);
+    // 超过页大小的对象无法分配
+    size_t huge_size = kOldSpacePageSize + kGCObjectAlignment;
+    EXPECT_EQ(old_space_->Allocate(&huge_size), nullptr);
+
+    // 每次分配占满一页，直到所有页都被使用
+    for (size_t i = 0; i < kOldSpaceInitialSize / kOldSpacePageSize; ++i) {
+        size_t page_size = kOldSpacePageSize;
+        ASSERT_NE(old_space_->Allocate(&page_size), nullptr);
+    }
+    EXPECT_EQ(old_space_->available_size(), 0u);
 
     // 再次分配应该失败
     size_t small_size = sizeof(TestGCObject);
@@ -212,29 +241,52 @@ TEST_F(OldSpaceTest, FillEntireSpace) {
     EXPECT_LE(used, old_space_->capacity());
 }
 
-// ==================== 空间边界测试 ====================
+// ==================== 页测试 ====================
 
 /**
- * @test 测试空间起始和结束地址
+ * @test 测试页的起始和结束地址
  */
-TEST_F(OldSpaceTest, SpaceBoundaries) {
-    EXPECT_NE(old_space_->space_start(), nullptr);
-    EXPECT_NE(old_space_->space_end(), nullptr);
-    EXPECT_GT(old_space_->space_end(), old_space_->space_start());
-    EXPECT_EQ(old_space_->space_end(), old_space_->space_start() + old_space_->capacity());
+TEST_F(OldSpaceTest, PageBoundaries) {
+    size_t size = sizeof(TestGCObject);
+    auto* ptr = static_cast<uint8_t*>(old_space_->Allocate(&size));
+    ASSERT_EQ(old_space_->pages().size(), 1u);
+    auto& page = old_space_->pages().front();
+    EXPECT_EQ(page.end(), page.start() + kOldSpacePageSize);
+    EXPECT_GE(ptr, page.start());
+    EXPECT_LT(ptr, page.end());
 }
 
 /**
- * @test 测试top指针位置
+ * @test 测试页内top指针位置
  */
 TEST_F(OldSpaceTest, TopPointerPosition) {
-    EXPECT_EQ(old_space_->top(), old_space_->space_start());
-
     size_t size = sizeof(TestGCObject);
     old_space_->Allocate(&size);
+    auto& page = old_space_->pages().back();
+    EXPECT_EQ(page.top(), page.start() + size);
+    EXPECT_EQ(old_space_->area_size(), size);
+    EXPECT_EQ(old_space_->available_size(), old_space_->capacity() - size);
+}
 
-    EXPECT_EQ(old_space_->top(), old_space_->space_start() + size);
-    EXPECT_LE(old_space_->top(), old_space_->space_end());
+/**
+ * @test 当前页放不下时换到空页，剩余部分放入空闲链表
+ */
+TEST_F(OldSpaceTest, AllocateMovesToNextPage) {
+    size_t first_size = kOldSpacePageSize - 1024;
+    ASSERT_NE(old_space_->Allocate(&first_size), nullptr);
+
+    size_t size = 2048;
+    auto* ptr = static_cast<uint8_t*>(old_space_->Allocate(&size));
+    ASSERT_EQ(old_space_->pages().size(), 2u);
+    EXPECT_EQ(ptr, old_space_->pages().back().start());
+    EXPECT_EQ(old_space_->pages().front().top(), old_space_->pages().front().end());
+    EXPECT_EQ(old_space_->free_size(), 1024u);
+
+    // 较小的分配使用前一页剩余的空闲块
+    size_t small_size = 1024;
+    auto* small = static_cast<uint8_t*>(old_space_->Allocate(&small_size));
+    EXPECT_EQ(small, old_space_->pages().front().start() + first_size);
+    EXPECT_EQ(old_space_->free_size(), 0u);
 }
 
 /**
@@ -403,166 +455,147 @@ TEST_F(OldSpaceTest, IterateLiveObjectsNoneMarked) {
     EXPECT_EQ(call_count, 0);
 }
 
-// ==================== 压缩计算测试 ====================
+// ==================== 压缩测试 ====================
 
 /**
- * @test 测试计算压缩后的top（空空间）
+ * @test 测试计算转发地址（空空间）
  */
-TEST_F(OldSpaceTest, ComputeCompactTopEmpty) {
-    uint8_t* new_top = old_space_->ComputeCompactTop();
-    EXPECT_EQ(new_top, old_space_->space_start());
+TEST_F(OldSpaceTest, CompactEmpty) {
+    old_space_->ComputeForwardingAddresses();
+    old_space_->Compact();
+    EXPECT_TRUE(old_space_->pages().empty());
+    EXPECT_EQ(old_space_->used_size(), 0u);
 }
 
 /**
- * @test 测试计算压缩后的top（全部存活）
+ * @test 测试压缩（全部存活）：对象不移动
  */
-TEST_F(OldSpaceTest, ComputeCompactTopAllLive) {
-    const int kNumObjects = 5;
+TEST_F(OldSpaceTest, CompactAllLive) {
+    auto objects = AllocateObjects(5, [](int) { return true; });
+    uint8_t* top = old_space_->pages().back().top();
 
-    for (int i = 0; i < kNumObjects; i++) {
-        size_t size = sizeof(TestGCObject);
-        void* ptr = old_space_->Allocate(&size);
-        ASSERT_NE(ptr, nullptr);
-        TestGCObject* obj = new (ptr) TestGCObject(i);
-        obj->header()->set_size(size);
-        obj->header()->set_type(GCObjectType::kObject);
-        obj->header()->SetMarked(true);
+    old_space_->ComputeForwardingAddresses();
+    for (auto* obj : objects) {
+        EXPECT_EQ(obj->header()->GetForwardingAddress(), obj);
+    }
+    old_space_->Compact();
+    EXPECT_EQ(old_space_->pages().back().top(), top);
+    for (auto* obj : objects) {
+        EXPECT_FALSE(obj->header()->IsForwarded());
     }
-
-    uint8_t* new_top = old_space_->ComputeCompactTop();
-    // 全部存活，压缩后top应该不变
-    EXPECT_EQ(new_top, old_space_->top());
 }
 
 /**
- * @test 测试计算压缩后的top（部分存活）
+ * @test 测试压缩（部分存活）：存活对象按原顺序紧凑排列
  */
-TEST_F(OldSpaceTest, ComputeCompactTopPartialLive) {
+TEST_F(OldSpaceTest, CompactPartialLive) {
     const int kNumObjects = 10;
     size_t aligned_size = AlignGCObjectSize(sizeof(TestGCObject));
+    auto objects = AllocateObjects(kNumObjects, [](int i) { return i % 2 == 0; });
+    uint8_t* start = old_space_->pages().front().start();
 
-    for (int i = 0; i < kNumObjects; i++) {
-        size_t size = sizeof(TestGCObject);
-        void* ptr = old_space_->Allocate(&size);
-        ASSERT_NE(ptr, nullptr);
-        TestGCObject* obj = new (ptr) TestGCObject(i);
-        obj->header()->set_size(size);
-        obj->header()->set_type(GCObjectType::kObject);
-
-        // 只标记偶数索引的对象
-        if (i % 2 == 0) {
-            obj->header()->SetMarked(true);
-        }
+    old_space_->ComputeForwardingAddresses();
+    for (int i = 0; i < kNumObjects; i += 2) {
+        EXPECT_EQ(reinterpret_cast<uint8_t*>(objects[i]->header()->GetForwardingAddress()),
+            start + (i / 2) * aligned_size);
     }
 
-    uint8_t* new_top = old_space_->ComputeCompactTop();
-    // 一半存活，压缩后top应该是原来的一半
-    size_t expected_offset = (kNumObjects / 2) * aligned_size;
-    EXPECT_EQ(new_top, old_space_->space_start() + expected_offset);
+    old_space_->Compact();
+    EXPECT_EQ(old_space_->pages().front().top(), start + (kNumObjects / 2) * aligned_size);
+    EXPECT_EQ(old_space_->used_size(), (kNumObjects / 2) * aligned_size);
+    for (int i = 0; i < kNumObjects / 2; ++i) {
+        auto* obj = reinterpret_cast<TestGCObject*>(start + i * aligned_size);
+        EXPECT_EQ(obj->data(), i * 2);
+        EXPECT_FALSE(obj->header()->IsForwarded());
+    }
 }
 
-// ==================== set_top 测试 ====================
-
 /**
- * @test 测试设置新的top指针
+ * @test 跨页压缩：存活对象移动到前面的页，空出的页归还
  */
-TEST_F(OldSpaceTest, SetTop) {
-    // 分配一些对象
-    size_t size1 = sizeof(TestGCObject);
-    old_space_->Allocate(&size1);
-    size_t size2 = sizeof(TestGCObject);
-    old_space_->Allocate(&size2);
+TEST_F(OldSpaceTest, CompactAcrossPages) {
+    size_t aligned_size = AlignGCObjectSize(sizeof(TestGCObject));
+    int per_page = static_cast<int>(kOldSpacePageSize / aligned_size);
+    int count = per_page * 3;
+    int live = (count + 3) / 4;
+    AllocateObjects(count, [](int i) { return i % 4 == 0; });
+    ASSERT_EQ(old_space_->pages().size(), 3u);
+    size_t empty_pages = old_space_->empty_page_count();
+
+    old_space_->ComputeForwardingAddresses();
+    old_space_->Compact();
+    ASSERT_EQ(old_space_->pages().size(), 1u);
+    EXPECT_EQ(old_space_->empty_page_count(), empty_pages + 2);
+    EXPECT_EQ(old_space_->used_size(), live * aligned_size);
+
+    int index = 0;
+    old_space_->IterateObjects([](GCObject* obj, void* data) {
+        int* index = static_cast<int*>(data);
+        EXPECT_EQ(static_cast<TestGCObject*>(obj)->data(), *index * 4);
+        ++*index;
+    }, &index);
+    EXPECT_EQ(index, live);
+}
 
-    EXPECT_GT(old_space_->used_size(), 0);
+/**
+ * @test 压缩会丢弃所有空闲块
+ */
+TEST_F(OldSpaceTest, CompactResetsFreeLists) {
+    auto objects = AllocateObjects(10, [](int i) { return i % 2 == 0; });
+    old_space_->StartSweeping(0);
+    old_space_->FinishSweeping();
+    EXPECT_GT(old_space_->free_size(), 0u);
 
-    // 设置新的top（模拟压缩后）
-    old_space_->set_top(old_space_->space_start());
-    EXPECT_EQ(old_space_->top(), old_space_->space_start());
+    for (auto* obj : objects) {
+        obj->header()->SetMarked(false);
+    }
+    old_space_->ComputeForwardingAddresses();
+    old_space_->Compact();
+    EXPECT_EQ(old_space_->free_size(), 0u);
+    EXPECT_EQ(old_space_->used_size(), 0u);
+    size_t size = sizeof(TestGCObject);
+    EXPECT_EQ(old_space_->Allocate(&size), old_space_->pages().front().start());
 }
 
 // ==================== 扩容测试 ====================
 
 /**
- * @test 测试空间扩容
+ * @test 测试按页扩容：只增加空页，已有对象不移动
  */
 TEST_F(OldSpaceTest, ExpandSpace) {
-    // 分配一些对象
-    const int kNumObjects = 10;
-    for (int i = 0; i < kNumObjects; i++) {
-        size_t size = sizeof(TestGCObject);
-        void* ptr = old_space_->Allocate(&size);
-        ASSERT_NE(ptr, nullptr);
-        TestGCObject* obj = new (ptr) TestGCObject(i);
-        obj->header()->set_size(size);
-        obj->header()->set_type(GCObjectType::kObject);
-    }
-
+    auto objects = AllocateObjects(10, [](int) { return false; });
     size_t old_capacity = old_space_->capacity();
-    uint8_t* old_start = old_space_->space_start();
-
-    // 扩容
-    bool result = old_space_->Expand(sizeof(TestGCObject));
-    EXPECT_TRUE(result);
+    size_t empty_pages = old_space_->empty_page_count();
 
-    // 验证容量增加
-    EXPECT_GT(old_space_->capacity(), old_capacity);
-
-    // 验证旧内存地址保存
-    EXPECT_EQ(old_space_->old_space_start(), old_start);
+    ASSERT_TRUE(old_space_->Expand(sizeof(TestGCObject)));
+    EXPECT_EQ(old_space_->capacity(), old_capacity + kOldSpacePageSize);
+    EXPECT_EQ(old_space_->empty_page_count(), empty_pages + 1);
 
-    // 完成扩容
-    old_space_->FinishExpand();
+    ASSERT_TRUE(old_space_->Expand(kOldSpacePageSize * 2 + 1));
+    EXPECT_EQ(old_space_->capacity(), old_capacity + kOldSpacePageSize * 4);
 
-    // 验证旧内存已释放
-    EXPECT_EQ(old_space_->old_space_start(), nullptr);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_FALSE(objects[i]->header()->IsForwarded());
+        EXPECT_EQ(objects[i]->data(), i);
+    }
 }
 
 /**
- * @test 测试扩容后对象转发地址设置
+ * @test 扩容后空闲链表保持不变
  */
-TEST_F(OldSpaceTest, ExpandWithForwardingAddresses) {
-    std::vector<TestGCObject*> old_objects;
-    const int kNumObjects = 5;
-
-    for (int i = 0; i < kNumObjects; i++) {
-        size_t size = sizeof(TestGCObject);
-        void* ptr = old_space_->Allocate(&size);
-        ASSERT_NE(ptr, nullptr);
-
-        // 先创建一个临时对象来初始化 data 成员
-        TestGCObject temp_obj(i);
-
-        // 将整个对象（包括 vtable 和 header）复制到分配的内存
-        std::memcpy(ptr, &temp_obj, size);
+TEST_F(OldSpaceTest, ExpandKeepsFreeLists) {
+    AllocateObjects(10, [](int i) { return i % 2 == 0; });
+    old_space_->StartSweeping(0);
+    old_space_->FinishSweeping();
+    size_t free_size = old_space_->free_size();
 
-        // 然后初始化 header 字段
-        TestGCObject* obj = reinterpret_cast<TestGCObject*>(ptr);
-        obj->header()->set_size(size);
-        obj->header()->set_type(GCObjectType::kObject);
-        obj->header()->set_generation(GCGeneration::kOld);
-        obj->header()->SetMarked(false);
-        obj->header()->SetDestructed(false);
-
-        old_objects.push_back(obj);
-    }
-
-    // 扩容
     ASSERT_TRUE(old_space_->Expand(sizeof(TestGCObject)));
+    EXPECT_EQ(old_space_->free_size(), free_size);
 
-    // 验证所有旧对象都有转发地址
-    for (auto* old_obj : old_objects) {
-        EXPECT_TRUE(old_obj->header()->IsForwarded());
-        EXPECT_NE(old_obj->header()->GetForwardingAddress(), nullptr);
-    }
-
-    // 完成扩容
-    old_space_->FinishExpand();
-
-    // 验证转发地址已清除，已经被释放，无法访问
-    //for (auto* old_obj : old_objects) {
-    //    EXPECT_FALSE(old_obj->header()->IsForwarded());
-    //    EXPECT_EQ(old_obj->header()->GetForwardingAddress(), nullptr);
-    //}
+    size_t size = sizeof(TestGCObject);
+    auto* ptr = static_cast<uint8_t*>(old_space_->Allocate(&size));
+    EXPECT_GE(ptr, old_space_->pages().front().start());
+    EXPECT_LT(ptr, old_space_->pages().front().top());
 }
 
 // ==================== 边界条件测试 ====================
@@ -597,5 +630,126 @@ TEST_F(OldSpaceTest, SizeAlignment) {
     EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr2) % kGCObjectAlignment, 0);
 }
 
+// ==================== 清除与空闲链表测试 ====================
+
+/**
+ * @test 测试大小类别的划分
+ */
+TEST(OldSpaceSizeClassTest, SizeClass) {
+    EXPECT_EQ(OldSpaceSizeClass(24), 3);
+    EXPECT_EQ(OldSpaceSizeClass(kOldSpaceExactSizeLimit), kOldSpaceExactSizeLimit / kGCObjectAlignment);
+    EXPECT_EQ(OldSpaceSizeClass(kOldSpaceExactSizeLimit + 8), OldSpaceSizeClass(kOldSpaceExactSizeLimit * 2));
+    EXPECT_EQ(OldSpaceSizeClass(kOldSpaceExactSizeLimit * 2 + 8), OldSpaceSizeClass(kOldSpaceExactSizeLimit) + 2);
+    EXPECT_EQ(OldSpaceSizeClass(SIZE_MAX / 2), kOldSpaceSizeClassCount - 1);
+}
+
+/**
+ * @test 清除后死亡对象进入空闲链表，末尾的死亡对象归还给顺序分配
+ */
+TEST_F(OldSpaceTest, SweepBuildsFreeLists) {
+    const int kNumObjects = 10;
+    size_t aligned_size = AlignGCObjectSize(sizeof(TestGCObject));
+    auto objects = AllocateObjects(kNumObjects, [](int i) { return i % 2 == 0; });
+
+    old_space_->StartSweeping(aligned_size * kNumObjects / 2);
+    EXPECT_TRUE(old_space_->sweeping());
+    EXPECT_EQ(old_space_->used_size(), aligned_size * kNumObjects / 2);
+    old_space_->FinishSweeping();
+    EXPECT_FALSE(old_space_->sweeping());
+
+    // 最后一个对象已死亡，top 回退到它的起始位置
+    EXPECT_EQ(old_space_->pages().back().top(), reinterpret_cast<uint8_t*>(objects.back()));
+    EXPECT_EQ(old_space_->free_size(), aligned_size * (kNumObjects / 2 - 1));
+    EXPECT_TRUE(objects[1]->header()->IsDestructed());
+    EXPECT_EQ(objects[1]->header()->size_class(), OldSpaceSizeClass(aligned_size));
+    EXPECT_FALSE(objects[2]->header()->IsDestructed());
+    EXPECT_EQ(objects[2]->data(), 2);
+
+    // 相同大小的分配优先使用空闲块
+    size_t size = sizeof(TestGCObject);
+    void* ptr = old_space_->Allocate(&size);
+    EXPECT_LT(static_cast<uint8_t*>(ptr), old_space_->pages().back().top());
+    EXPECT_EQ(size, aligned_size);
+    EXPECT_EQ(old_space_->free_size(), aligned_size * (kNumObjects / 2 - 2));
+    EXPECT_EQ(old_space_->used_size(), aligned_size * (kNumObjects / 2 + 1));
+}
+
+/**
+ * @test 相邻的死亡对象合并为一个空闲块，较小的分配拆分空闲块
+ */
+TEST_F(OldSpaceTest, SweepCoalescesDeadObjects) {
+    const int kNumObjects = 6;
+    size_t aligned_size = AlignGCObjectSize(sizeof(TestGCObject));
+    auto objects = AllocateObjects(kNumObjects, [](int i) { return i == 0 || i == kNumObjects - 1; });
+
+    old_space_->StartSweeping(aligned_size * 2);
+    old_space_->FinishSweeping();
+    EXPECT_EQ(old_space_->free_size(), aligned_size * (kNumObjects - 2));
+    EXPECT_EQ(objects[1]->header()->size(), aligned_size * (kNumObjects - 2));
+
+    size_t size = sizeof(TestGCObject);
+    void* ptr = old_space_->Allocate(&size);
+    EXPECT_EQ(ptr, objects[1]);
+    EXPECT_EQ(old_space_->free_size(), aligned_size * (kNumObjects - 3));
+    auto* obj = new (ptr) TestGCObject(42);
+    obj->header()->set_size(size);
+
+    // 剩余部分仍是一个空闲块
+    int free_blocks = 0;
+    old_space_->IterateObjects([](GCObject* obj, void* data) {
+        if (obj->header()->IsDestructed()) {
+            ++*static_cast<int*>(data);
+        }
+    }, &free_blocks);
+    EXPECT_EQ(free_blocks, 1);
+}
+
+/**
+ * @test 惰性清除按字节数分段进行，清除期间新分配的对象不会被清除
+ */
+TEST_F(OldSpaceTest, SweepInSteps) {
+    const int kNumObjects = 100;
+    size_t aligned_size = AlignGCObjectSize(sizeof(TestGCObject));
+    AllocateObjects(kNumObjects, [](int i) { return i % 3 == 0; });
+
+    old_space_->StartSweeping(0);
+    EXPECT_FALSE(old_space_->Sweep(aligned_size * 10));
+    EXPECT_TRUE(old_space_->sweeping());
+
+    // 清除期间分配的对象位于原来的 top 之后或已清除的空闲块中，没有标记
+    auto late = AllocateObjects(1, [](int) { return false; });
+    int steps = 1;
+    while (!old_space_->Sweep(aligned_size * 10)) {
+        ++steps;
+    }
+    EXPECT_GT(steps, 1);
+    EXPECT_FALSE(late[0]->header()->IsDestructed());
+    EXPECT_EQ(late[0]->data(), 0);
+}
+
+/**
+ * @test 整页都是死亡对象时归还该页
+ */
+TEST_F(OldSpaceTest, SweepReleasesEmptyPages) {
+    size_t aligned_size = AlignGCObjectSize(sizeof(TestGCObject));
+    int per_page = static_cast<int>(kOldSpacePageSize / aligned_size);
+    // 中间一页全部死亡
+    auto objects = AllocateObjects(per_page * 3, [per_page](int i) { return i / per_page != 1; });
+    ASSERT_EQ(old_space_->pages().size(), 3u);
+    size_t empty_pages = old_space_->empty_page_count();
+
+    old_space_->StartSweeping(per_page * 2 * aligned_size);
+    old_space_->FinishSweeping();
+    ASSERT_EQ(old_space_->pages().size(), 2u);
+    EXPECT_EQ(old_space_->empty_page_count(), empty_pages + 1);
+    EXPECT_EQ(old_space_->free_size(), 0u);
+    EXPECT_EQ(old_space_->pages().back().start(), reinterpret_cast<uint8_t*>(objects[per_page * 2]));
+    EXPECT_EQ(objects.back()->data(), per_page * 3 - 1);
+
+    // 归还的页之后重新使用
+    size_t page_size = kOldSpacePageSize;
+    EXPECT_NE(old_space_->Allocate(&page_size), nullptr);
+}
+
 } // namespace test
 } // namespace mjs
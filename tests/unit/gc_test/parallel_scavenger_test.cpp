@@ -0,0 +1,195 @@
+/**
+ * @file parallel_scavenger_test.cpp
+ * @brief 并行Scavenge单元测试
+ *
+ * 测试并行Scavenge的功能：
+ * - 工作窃取队列
+ * - 对象图复制后引用正确，共享对象只复制一次
+ * - 晋升及记忆集
+ * - 运行时切换线程数
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/gc/handle.h>
+#include <mjs/gc/parallel_scavenger.h>
+#include <mjs/value/object/array_object.h>
+
+namespace mjs {
+namespace test {
+
+class ParallelScavengerTest : public ::testing::Test {
+protected:
+    static constexpr size_t kChildCount = 3000;
+
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+        GCHeapConfig config;
+        config.new_space_size = 4 * 1024 * 1024;   // 构造对象图期间不触发GC
+        config.scavenge_threads = 4;
+        config.adaptive_new_space = false;
+        context_ = std::make_unique<Context>(runtime_.get(), config);
+    }
+
+    void TearDown() override {
+        context_.reset();
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 构造 holder -> [child_i] 的对象图，每个 child 为 [i, shared]，holder 添加为根
+     */
+    void BuildGraph(Value* holder) {
+        GCHandleScope<2> scope(context_.get());
+        auto shared = scope.New<ArrayObject>(std::initializer_list<Value>{ Value(int64_t(-1)) });
+        *holder = scope.New<ArrayObject>(0).ToValue();
+        context_->gc_manager().AddRoot(holder);
+        for (size_t i = 0; i < kChildCount; ++i) {
+            GCHandleScope<1> inner(context_.get());
+            auto child = inner.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(i)), shared.ToValue() });
+            holder->array().Push(context_.get(), child.ToValue());
+        }
+    }
+
+    void VerifyGraph(Value& holder) {
+        ASSERT_EQ(holder.array().GetLength(), kChildCount);
+        Object* shared_obj = nullptr;
+        for (size_t i = 0; i < kChildCount; ++i) {
+            Value child;
+            ASSERT_TRUE(holder.array().GetElement(context_.get(), i, &child));
+            ASSERT_TRUE(child.IsArrayObject());
+            Value index;
+            ASSERT_TRUE(child.array().GetElement(context_.get(), 0, &index));
+            EXPECT_EQ(index.i64(), static_cast<int64_t>(i));
+            Value shared;
+            ASSERT_TRUE(child.array().GetElement(context_.get(), 1, &shared));
+            ASSERT_TRUE(shared.IsArrayObject());
+            if (!shared_obj) {
+                shared_obj = &shared.object();
+            }
+            // 多个线程同时遇到共享对象时只能有一个线程复制
+            EXPECT_EQ(&shared.object(), shared_obj);
+        }
+        Value element;
+        ASSERT_TRUE(static_cast<ArrayObject*>(shared_obj)->GetElement(context_.get(), 0, &element));
+        EXPECT_EQ(element.i64(), -1);
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+    std::unique_ptr<Context> context_;
+};
+
+/**
+ * @test 所属线程后进先出，窃取者从另一端取
+ */
+TEST(GCWorkStealingDequeTest, PopAndSteal) {
+    GCWorkStealingDeque deque;
+    GCObject a, b, c;
+    deque.Push(&a);
+    deque.Push(&b);
+    deque.Push(&c);
+
+    GCObject* obj = nullptr;
+    ASSERT_TRUE(deque.Pop(&obj));
+    EXPECT_EQ(obj, &c);
+    ASSERT_TRUE(deque.Steal(&obj));
+    EXPECT_EQ(obj, &a);
+    ASSERT_TRUE(deque.Pop(&obj));
+    EXPECT_EQ(obj, &b);
+    EXPECT_TRUE(deque.empty());
+    EXPECT_FALSE(deque.Pop(&obj));
+    EXPECT_FALSE(deque.Steal(&obj));
+}
+
+/**
+ * @test 配置的线程数生效
+ */
+TEST_F(ParallelScavengerTest, ThreadCount) {
+    EXPECT_EQ(context_->gc_manager().heap()->scavenge_threads(), 4u);
+    context_->gc_manager().SetScavengeThreads(1);
+    EXPECT_EQ(context_->gc_manager().heap()->scavenge_threads(), 1u);
+    context_->gc_manager().SetScavengeThreads(8);
+    EXPECT_EQ(context_->gc_manager().heap()->scavenge_threads(), 8u);
+}
+
+/**
+ * @test 对象图经过多次并行Scavenge（包括晋升）后保持不变
+ */
+TEST_F(ParallelScavengerTest, PreservesObjectGraph) {
+    auto& gc = context_->gc_manager();
+    Value holder;
+    BuildGraph(&holder);
+
+    for (int i = 0; i <= kTenureAgeThreshold; ++i) {
+        gc.CollectGarbage(false);
+        VerifyGraph(holder);
+    }
+    EXPECT_EQ(holder.object().header()->generation(), GCGeneration::kOld);
+
+    gc.RemoveRoot(&holder);
+}
+
+/**
+ * @test 老年代对象引用的新生代对象通过记忆集被并行复制
+ */
+TEST_F(ParallelScavengerTest, RememberedSet) {
+    auto& gc = context_->gc_manager();
+    Value holder;
+    {
+        GCHandleScope<1> scope(context_.get());
+        holder = scope.New<ArrayObject>(0).ToValue();
+    }
+    gc.AddRoot(&holder);
+    for (int i = 0; i <= kTenureAgeThreshold; ++i) {
+        gc.CollectGarbage(false);
+    }
+    ASSERT_EQ(holder.object().header()->generation(), GCGeneration::kOld);
+
+    for (size_t i = 0; i < kChildCount; ++i) {
+        GCHandleScope<1> scope(context_.get());
+        auto child = scope.New<ArrayObject>(std::initializer_list<Value>{ Value(static_cast<int64_t>(i)) });
+        holder.array().Push(context_.get(), child.ToValue());
+    }
+    EXPECT_TRUE(holder.object().header()->IsRemembered());
+
+    gc.CollectGarbage(false);
+    EXPECT_TRUE(holder.object().header()->IsRemembered());
+    for (size_t i = 0; i < kChildCount; ++i) {
+        Value child;
+        ASSERT_TRUE(holder.array().GetElement(context_.get(), i, &child));
+        EXPECT_EQ(child.object().header()->generation(), GCGeneration::kNew);
+        Value element;
+        ASSERT_TRUE(child.array().GetElement(context_.get(), 0, &element));
+        EXPECT_EQ(element.i64(), static_cast<int64_t>(i));
+    }
+
+    gc.RemoveRoot(&holder);
+}
+
+/**
+ * @test 在串行和并行之间切换不影响对象图
+ */
+TEST_F(ParallelScavengerTest, SwitchThreadCount) {
+    auto& gc = context_->gc_manager();
+    Value holder;
+    BuildGraph(&holder);
+
+    gc.CollectGarbage(false);
+    VerifyGraph(holder);
+    gc.SetScavengeThreads(1);
+    gc.CollectGarbage(false);
+    VerifyGraph(holder);
+    gc.SetScavengeThreads(3);
+    gc.CollectGarbage(false);
+    VerifyGraph(holder);
+
+    gc.RemoveRoot(&holder);
+}
+
+} // namespace test
+} // namespace mjs
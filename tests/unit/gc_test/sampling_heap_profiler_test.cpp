@@ -0,0 +1,222 @@
+/**
+ * @file sampling_heap_profiler_test.cpp
+ * @brief 采样分配分析器单元测试
+ *
+ * 测试采样分配分析器：
+ * - 采样次数符合平均采样间隔
+ * - 采集 JS 调用栈并映射到源代码行号
+ * - 采样随GC更新：死亡对象移除，移动对象更新地址
+ * - 导出 .heapprofile 格式
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/gc/handle.h>
+#include <mjs/value/object/object.h>
+
+namespace mjs {
+namespace test {
+
+/**
+ * @class SamplingHeapProfilerTest
+ * @brief 采样分配分析器测试
+ */
+class SamplingHeapProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+        context_ = std::make_unique<Context>(runtime_.get());
+        heap_ = context_->gc_manager().heap();
+    }
+
+    void TearDown() override {
+        context_.reset();
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 查找函数名称和行号对应的子节点
+     */
+    static const SamplingHeapProfileNode* FindChild(const SamplingHeapProfileNode& node,
+        const std::string& name, SourceLine line) {
+        for (auto& child : node.children) {
+            if (child->function_name == name && child->line == line) {
+                return child.get();
+            }
+        }
+        return nullptr;
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+    std::unique_ptr<Context> context_;
+    GCHeap* heap_ = nullptr;
+};
+
+/**
+ * @test 未开始分析时不采样
+ */
+TEST_F(SamplingHeapProfilerTest, DisabledByDefault) {
+    EXPECT_EQ(heap_->sampling_heap_profiler(), nullptr);
+    std::stringstream out;
+    EXPECT_FALSE(context_->gc_manager().WriteSamplingHeapProfile(out));
+}
+
+/**
+ * @test 采样次数接近分配字节数除以平均采样间隔
+ */
+TEST_F(SamplingHeapProfilerTest, SampleCountMatchesInterval) {
+    constexpr uint64_t kInterval = 4096;
+    heap_->StartSamplingHeapProfiler(kInterval, kDefaultHeapSampleStackDepth, 1);
+
+    size_t allocated = 0;
+    for (int i = 0; i < 20000; ++i) {
+        GCHandleScope<1> scope(context_.get());
+        auto obj = scope.New<Object>();
+        allocated += obj->header()->size();
+    }
+
+    auto* profiler = heap_->sampling_heap_profiler();
+    ASSERT_NE(profiler, nullptr);
+    double expected = static_cast<double>(allocated) / kInterval;
+    EXPECT_GT(profiler->sample_count(), expected * 0.7);
+    EXPECT_LT(profiler->sample_count(), expected * 1.3);
+
+    // 小对象的采样代表约一个采样间隔的字节数
+    EXPECT_NEAR(static_cast<double>(profiler->ScaledSize(64)), kInterval + 32.0, 2.0);
+
+    heap_->StopSamplingHeapProfiler();
+    EXPECT_EQ(heap_->sampling_heap_profiler(), nullptr);
+}
+
+/**
+ * @test 采样时采集 JS 调用栈，按函数和行号组成调用树
+ */
+TEST_F(SamplingHeapProfilerTest, CapturesJsStack) {
+    heap_->StartSamplingHeapProfiler(1, kDefaultHeapSampleStackDepth, 1);
+
+    auto result = context_->Eval("profile.js",
+        "function makeEntry(i) {\n"
+        "    return { id: i };\n"
+        "}\n"
+        "function fill() {\n"
+        "    let list = [];\n"
+        "    for (let i = 0; i < 100; i++) {\n"
+        "        list.push(makeEntry(i));\n"
+        "    }\n"
+        "    return list.length;\n"
+        "}\n"
+        "let count = fill();\n"
+        "count;\n");
+    ASSERT_FALSE(result.IsException()) << result.ToString(context_.get()).string_view();
+
+    auto& root = heap_->sampling_heap_profiler()->root();
+    EXPECT_EQ(root.function_name, "(root)");
+
+    // (root) -> 模块顶层第11行 -> fill 第6行 -> makeEntry 第2行
+    // 调试表按函数体的顶层语句记录行号，循环体中的调用归到循环语句所在的行
+    auto* module = FindChild(root, "profile.js", 11);
+    ASSERT_NE(module, nullptr);
+    auto* fill = FindChild(*module, "fill", 6);
+    ASSERT_NE(fill, nullptr);
+    auto* make_entry = FindChild(*fill, "makeEntry", 2);
+    ASSERT_NE(make_entry, nullptr);
+    EXPECT_EQ(make_entry->url, "profile.js");
+    EXPECT_TRUE(make_entry->children.empty());
+
+    // fill 第5行分配的数组是单独的节点
+    EXPECT_NE(FindChild(*module, "fill", 5), nullptr);
+}
+
+/**
+ * @test 采样随GC更新：死亡对象的采样被移除，存活对象的采样跟随移动
+ */
+TEST_F(SamplingHeapProfilerTest, TracksRetainedObjects) {
+    heap_->StartSamplingHeapProfiler(1, kDefaultHeapSampleStackDepth, 1);
+    auto* profiler = heap_->sampling_heap_profiler();
+
+    constexpr size_t kCount = 64;
+    std::vector<Value> retained(kCount / 2);
+    for (size_t i = 0; i < kCount; ++i) {
+        GCHandleScope<1> scope(context_.get());
+        auto obj = scope.New<Object>();
+        if (i % 2 == 0) {
+            retained[i / 2] = obj.ToValue();
+        }
+    }
+    for (auto& value : retained) {
+        context_->gc_manager().AddRoot(&value);
+    }
+    EXPECT_EQ(profiler->samples().size(), kCount);
+
+    auto check = [&]() {
+        std::set<GCObject*> live;
+        for (auto& value : retained) {
+            live.insert(static_cast<GCObject*>(&value.object()));
+        }
+        std::set<GCObject*> sampled;
+        for (auto& sample : profiler->samples()) {
+            sampled.insert(sample.object);
+        }
+        EXPECT_EQ(sampled, live);
+    };
+
+    // Scavenge：新生代对象被复制
+    heap_->CollectGarbage(false);
+    check();
+
+    // 晋升到老年代后执行完整GC
+    heap_->CollectGarbage(false);
+    heap_->CollectGarbage(true);
+    check();
+
+    for (auto& value : retained) {
+        context_->gc_manager().RemoveRoot(&value);
+    }
+    heap_->CollectGarbage(true);
+    EXPECT_TRUE(profiler->samples().empty());
+    EXPECT_EQ(profiler->sample_count(), kCount);
+}
+
+/**
+ * @test 导出 .heapprofile 格式，包含调用树和存活的采样
+ */
+TEST_F(SamplingHeapProfilerTest, WriteHeapProfile) {
+    context_->gc_manager().StartSamplingHeapProfiler(1);
+
+    auto result = context_->Eval("profile_json.js",
+        "function grow() {\n"
+        "    let list = [];\n"
+        "    for (let i = 0; i < 10; i++) {\n"
+        "        list.push({ id: i });\n"
+        "    }\n"
+        "    return list.length;\n"
+        "}\n"
+        "let count = grow();\n"
+        "count;\n");
+    ASSERT_FALSE(result.IsException()) << result.ToString(context_.get()).string_view();
+
+    std::stringstream out;
+    ASSERT_TRUE(context_->gc_manager().WriteSamplingHeapProfile(out));
+    auto json = out.str();
+    EXPECT_EQ(json.rfind("{\"head\":{\"callFrame\":{\"functionName\":\"(root)\"", 0), 0u);
+    EXPECT_NE(json.find("\"functionName\":\"grow\""), std::string::npos);
+    EXPECT_NE(json.find("\"url\":\"profile_json.js\""), std::string::npos);
+    // 第3行的循环语句（从0开始为2）中分配了对象
+    EXPECT_NE(json.find("\"lineNumber\":2"), std::string::npos);
+    EXPECT_NE(json.find("\"samples\":[{\"size\":"), std::string::npos);
+
+    context_->gc_manager().StopSamplingHeapProfiler();
+}
+
+} // namespace test
+} // namespace mjs
@@ -0,0 +1,217 @@
+/**
+ * @file young_finalization_test.cpp
+ * @brief 新生代析构登记单元测试
+ *
+ * 测试 Scavenge 只为登记了析构的死亡对象调用析构函数：
+ * - 不持有堆外资源的普通对象不登记，属性槽存放在对象内
+ * - 派生类型在分配时登记，死亡时调用析构函数
+ * - 普通对象写入引用计数的值或属性槽超出对象内容量时登记
+ * - 新生代对象的形状由GC堆持有引用，只被死亡对象使用的形状随Scavenge释放
+ *
+ * @copyright Copyright (c) 2025 yuyuaqwq
+ * @license MIT License
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <mjs/runtime.h>
+#include <mjs/context.h>
+#include <mjs/gc/handle.h>
+#include <mjs/shape/shape.h>
+#include <mjs/value/string.h>
+#include <mjs/value/object/object.h>
+
+namespace mjs {
+namespace test {
+
+// 测试用的派生对象，析构时计数
+class CountingObject : public Object {
+public:
+    explicit CountingObject(Context* context, int* counter)
+        : Object(context)
+        , counter_(counter) {}
+
+    ~CountingObject() override { ++*counter_; }
+
+private:
+    int* counter_;
+};
+
+/**
+ * @class YoungFinalizationTest
+ * @brief 新生代析构登记测试
+ */
+class YoungFinalizationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        runtime_ = std::make_unique<Runtime>();
+        context_ = std::make_unique<Context>(runtime_.get());
+        heap_ = context_->gc_manager().heap();
+        // 清空上下文初始化时分配的对象
+        heap_->CollectGarbage(false);
+    }
+
+    void TearDown() override {
+        context_.reset();
+        runtime_.reset();
+    }
+
+    /**
+     * @brief 获取属性名对应的常量索引
+     */
+    ConstIndex Key(const std::string& name) {
+        return context_->FindConstOrInsertToLocal(Value(String::New(name)));
+    }
+
+    std::unique_ptr<Runtime> runtime_;
+    std::unique_ptr<Context> context_;
+    GCHeap* heap_ = nullptr;
+};
+
+/**
+ * @test 只持有数字属性的普通对象不登记析构，属性存放在对象内
+ */
+TEST_F(YoungFinalizationTest, PlainObjectsNotRegistered) {
+    auto key = Key("value");
+    size_t before = heap_->young_finalizer_count();
+    for (int i = 0; i < 1000; ++i) {
+        GCHandleScope<1> scope(context_.get());
+        auto obj = scope.New<Object>();
+        obj->SetProperty(context_.get(), key, Value(i));
+        EXPECT_EQ(obj->header()->size(), sizeof(Object) + GCObjectTraits<Object>::kInObjectSize);
+    }
+    EXPECT_EQ(heap_->young_finalizer_count(), before);
+
+    ASSERT_TRUE(heap_->CollectGarbage(false));
+    EXPECT_LE(heap_->young_finalizer_count(), before);
+}
+
+/**
+ * @test 派生类型在分配时登记，死亡时调用析构函数，存活的对象晋升前保持登记
+ */
+TEST_F(YoungFinalizationTest, DerivedObjectsFinalized) {
+    int destructed = 0;
+    Value retained;
+    for (int i = 0; i < 100; ++i) {
+        GCHandleScope<1> scope(context_.get());
+        auto obj = scope.New<CountingObject>(&destructed);
+        EXPECT_TRUE(obj->header()->IsFinalizable());
+        if (i == 0) {
+            retained = obj.ToValue();
+        }
+    }
+    context_->gc_manager().AddRoot(&retained);
+
+    ASSERT_TRUE(heap_->CollectGarbage(false));
+    EXPECT_EQ(destructed, 99);
+    ASSERT_EQ(retained.object().header()->generation(), GCGeneration::kNew);
+    EXPECT_TRUE(retained.object().header()->IsFinalizable());
+
+    // 晋升后由老年代的清除负责析构
+    for (uint8_t i = 0; i <= kTenureAgeThreshold; ++i) {
+        ASSERT_TRUE(heap_->CollectGarbage(false));
+    }
+    ASSERT_EQ(retained.object().header()->generation(), GCGeneration::kOld);
+    EXPECT_EQ(destructed, 99);
+
+    context_->gc_manager().RemoveRoot(&retained);
+    retained = Value();
+    ASSERT_TRUE(heap_->CollectGarbage(true));
+    EXPECT_EQ(destructed, 100);
+}
+
+/**
+ * @test 写入引用计数的值时登记，死亡时释放引用
+ */
+TEST_F(YoungFinalizationTest, ReferenceCountedValueRegisters) {
+    auto key = Key("name");
+    String* str = String::New("young finalization");
+    Value holder(str);
+    uint32_t ref_count = str->ref_count();
+
+    {
+        GCHandleScope<1> scope(context_.get());
+        auto obj = scope.New<Object>();
+        obj->SetProperty(context_.get(), key, Value(1));
+        EXPECT_FALSE(obj->header()->IsFinalizable());
+        obj->SetProperty(context_.get(), key, Value(holder));
+        EXPECT_TRUE(obj->header()->IsFinalizable());
+        EXPECT_EQ(str->ref_count(), ref_count + 1);
+    }
+
+    ASSERT_TRUE(heap_->CollectGarbage(false));
+    EXPECT_EQ(str->ref_count(), ref_count);
+}
+
+/**
+ * @test 属性槽超出对象内容量时转移到对象外并登记
+ */
+TEST_F(YoungFinalizationTest, OutOfLinePropertiesRegister) {
+    GCHandleScope<1> scope(context_.get());
+    auto obj = scope.New<Object>();
+    for (uint32_t i = 0; i < kInObjectPropertySlots; ++i) {
+        obj->SetProperty(context_.get(), Key("p" + std::to_string(i)), Value(static_cast<int>(i)));
+    }
+    EXPECT_FALSE(obj->header()->IsFinalizable());
+
+    obj->SetProperty(context_.get(), Key("overflow"), Value(100));
+    EXPECT_TRUE(obj->header()->IsFinalizable());
+    EXPECT_EQ(obj->property_slot_count(), kInObjectPropertySlots + 1);
+
+    // 复制后属性值保持不变
+    ASSERT_TRUE(heap_->CollectGarbage(false));
+    for (uint32_t i = 0; i < kInObjectPropertySlots; ++i) {
+        Value value;
+        ASSERT_TRUE(obj->GetProperty(context_.get(), Key("p" + std::to_string(i)), &value));
+        EXPECT_EQ(value.i64(), i);
+    }
+    Value value;
+    ASSERT_TRUE(obj->GetProperty(context_.get(), Key("overflow"), &value));
+    EXPECT_EQ(value.i64(), 100);
+}
+
+/**
+ * @test 只被死亡的新生代对象使用的形状随Scavenge释放，存活对象的形状保持有效
+ */
+TEST_F(YoungFinalizationTest, YoungShapesReleased) {
+    auto dead_key = Key("dead_only");
+    auto live_key = Key("live_only");
+    auto& empty_shape = context_->shape_manager().empty_shape();
+
+    Value retained;
+    {
+        GCHandleScope<2> scope(context_.get());
+        auto dead = scope.New<Object>();
+        dead->SetProperty(context_.get(), dead_key, Value(1));
+        auto live = scope.New<Object>();
+        live->SetProperty(context_.get(), live_key, Value(2));
+        retained = live.ToValue();
+    }
+    context_->gc_manager().AddRoot(&retained);
+    ASSERT_NE(empty_shape.transtion_table().Find(dead_key), nullptr);
+
+    ASSERT_TRUE(heap_->CollectGarbage(false));
+    EXPECT_EQ(empty_shape.transtion_table().Find(dead_key), nullptr);
+    auto* live_shape = empty_shape.transtion_table().Find(live_key);
+    ASSERT_NE(live_shape, nullptr);
+    EXPECT_EQ(retained.object().shape(), live_shape);
+    EXPECT_TRUE(live_shape->young_pinned());
+
+    // 晋升后改为持有形状的引用计数
+    for (uint8_t i = 0; i <= kTenureAgeThreshold; ++i) {
+        ASSERT_TRUE(heap_->CollectGarbage(false));
+    }
+    ASSERT_EQ(retained.object().header()->generation(), GCGeneration::kOld);
+    EXPECT_FALSE(live_shape->young_pinned());
+    EXPECT_EQ(live_shape->ref_count(), 1u);
+    Value value;
+    ASSERT_TRUE(retained.object().GetProperty(context_.get(), live_key, &value));
+    EXPECT_EQ(value.i64(), 2);
+
+    context_->gc_manager().RemoveRoot(&retained);
+}
+
+} // namespace test
+} // namespace mjs
@@ -471,4 +471,112 @@ TEST_F(ArrayObjectTest, LengthPropertyNotEnumerable) {
     EXPECT_EQ(length_val.i64(), 2);
 }
 
+// ==================== 元素种类测试 ====================
+
+TEST_F(ArrayObjectTest, PackedInt64Elements) {
+    GCHandleScope<1> scope(context.get());
+    auto arr = scope.New<ArrayObject>(std::initializer_list<Value>{Value(1), Value(2), Value(3)});
+    EXPECT_EQ(arr->elements().kind(), ElementsKind::kPackedInt64);
+
+    arr->Push(context.get(), Value(4));
+    EXPECT_EQ(arr->elements().kind(), ElementsKind::kPackedInt64);
+
+    // 连续的 int64_t 缓冲区
+    const int64_t* data = arr->elements().int64_data();
+    int64_t sum = 0;
+    for (uint32_t i = 0; i < arr->elements().size(); ++i) {
+        sum += data[i];
+    }
+    EXPECT_EQ(sum, 10);
+}
+
+TEST_F(ArrayObjectTest, PackedFloat64Elements) {
+    GCHandleScope<1> scope(context.get());
+    auto arr = scope.New<ArrayObject>(std::initializer_list<Value>{Value(1.5), Value(2.5)});
+    EXPECT_EQ(arr->elements().kind(), ElementsKind::kPackedFloat64);
+    EXPECT_DOUBLE_EQ(arr->elements().float64_data()[1], 2.5);
+
+    Value val;
+    arr->GetComputedProperty(context.get(), Value(static_cast<int64_t>(0)), &val);
+    EXPECT_TRUE(val.IsFloat());
+    EXPECT_DOUBLE_EQ(val.f64(), 1.5);
+}
+
+TEST_F(ArrayObjectTest, ElementsKindTransitionToValue) {
+    GCHandleScope<1> scope(context.get());
+    auto arr = scope.New<ArrayObject>(std::initializer_list<Value>{Value(1), Value(2)});
+
+    // int64 与 float64 是不同的值类型，混合后过渡为通用 Value 缓冲区
+    arr->Push(context.get(), Value(3.5));
+    EXPECT_EQ(arr->elements().kind(), ElementsKind::kPackedValue);
+
+    arr->Push(context.get(), Value("str"));
+    EXPECT_EQ(arr->elements().kind(), ElementsKind::kPackedValue);
+
+    Value val;
+    arr->GetComputedProperty(context.get(), Value(static_cast<int64_t>(0)), &val);
+    EXPECT_TRUE(val.IsInt64());
+    EXPECT_EQ(val.i64(), 1);
+    arr->GetComputedProperty(context.get(), Value(static_cast<int64_t>(2)), &val);
+    EXPECT_DOUBLE_EQ(val.f64(), 3.5);
+    arr->GetComputedProperty(context.get(), Value(static_cast<int64_t>(3)), &val);
+    EXPECT_EQ(std::string_view(val.string_view()), "str");
+}
+
+TEST_F(ArrayObjectTest, HoleyElements) {
+    GCHandleScope<1> scope(context.get());
+    auto arr = scope.New<ArrayObject>(std::initializer_list<Value>{Value(1), Value(2), Value(3)});
+
+    Value val;
+    EXPECT_TRUE(arr->DelComputedProperty(context.get(), Value(static_cast<int64_t>(1)), &val));
+    EXPECT_EQ(val.i64(), 2);
+    EXPECT_EQ(arr->elements().kind(), ElementsKind::kHoleyInt64);
+    EXPECT_TRUE(arr->elements().IsHole(1));
+    EXPECT_FALSE(arr->GetComputedProperty(context.get(), Value(static_cast<int64_t>(1)), &val));
+    EXPECT_TRUE(val.IsUndefined());
+
+    // 填回空洞后仍保持 holey 种类，但该位置不再是空洞
+    arr->SetComputedProperty(context.get(), Value(static_cast<int64_t>(1)), Value(20));
+    EXPECT_EQ(arr->elements().kind(), ElementsKind::kHoleyInt64);
+    EXPECT_FALSE(arr->elements().IsHole(1));
+    EXPECT_TRUE(arr->GetComputedProperty(context.get(), Value(static_cast<int64_t>(1)), &val));
+    EXPECT_EQ(val.i64(), 20);
+
+    // 在末尾之后写入，中间位置成为空洞
+    arr->SetComputedProperty(context.get(), Value(static_cast<int64_t>(6)), Value(7));
+    EXPECT_EQ(arr->GetLength(), 7);
+    EXPECT_EQ(arr->elements().CountHoles(), 3);
+}
+
+TEST_F(ArrayObjectTest, HoleyArrayTakesKindOfFirstElement) {
+    GCHandleScope<1> scope(context.get());
+    auto arr = scope.New<ArrayObject>(3);
+    EXPECT_TRUE(arr->elements().is_holey());
+
+    // 全部为空洞时，首次写入决定数值表示
+    arr->SetComputedProperty(context.get(), Value(static_cast<int64_t>(0)), Value(1.25));
+    EXPECT_EQ(arr->elements().kind(), ElementsKind::kHoleyFloat64);
+}
+
+TEST_F(ArrayObjectTest, NamedPropertiesSeparateFromElements) {
+    GCHandleScope<1> scope(context.get());
+    auto arr = scope.New<ArrayObject>(std::initializer_list<Value>{Value(1), Value(2)});
+
+    arr->SetComputedProperty(context.get(), Value("foo"), Value(100));
+    arr->SetComputedProperty(context.get(), Value("bar"), Value(200));
+    arr->Push(context.get(), Value(3));
+
+    Value val;
+    EXPECT_TRUE(arr->GetComputedProperty(context.get(), Value("foo"), &val));
+    EXPECT_EQ(val.i64(), 100);
+    EXPECT_TRUE(arr->GetComputedProperty(context.get(), Value("bar"), &val));
+    EXPECT_EQ(val.i64(), 200);
+    for (int64_t i = 0; i < 3; ++i) {
+        EXPECT_TRUE(arr->GetComputedProperty(context.get(), Value(i), &val));
+        EXPECT_EQ(val.i64(), i + 1);
+    }
+    EXPECT_EQ(arr->GetLength(), 3);
+    EXPECT_EQ(arr->elements().kind(), ElementsKind::kPackedInt64);
+}
+
 } // namespace mjs::test
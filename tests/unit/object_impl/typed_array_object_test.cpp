@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <mjs/context.h>
+#include <mjs/runtime.h>
+#include <mjs/gc/handle.h>
+#include <mjs/value/value.h>
+#include <mjs/value/object/array_buffer_object.h>
+#include <mjs/value/object/typed_array_object.h>
+#include <mjs/value/object/data_view_object.h>
+#include "tests/unit/test_helpers.h"
+
+namespace mjs::test {
+
+class TypedArrayObjectTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_env = std::make_unique<TestEnvironment>();
+        context = std::make_unique<Context>(test_env->runtime());
+    }
+
+    void TearDown() override {
+        context.reset();
+        test_env.reset();
+    }
+
+    std::unique_ptr<TestEnvironment> test_env;
+    std::unique_ptr<Context> context;
+};
+
+TEST_F(TypedArrayObjectTest, ExternalBufferIsZeroCopy) {
+    // 宿主内存直接作为 ArrayBuffer 的存储，双方写入互相可见
+    uint8_t host_data[16] = { 0 };
+    int release_count = 0;
+    {
+        GCHandleScope<2> scope(context.get());
+        auto buffer = scope.New<ArrayBufferObject>(host_data, sizeof(host_data),
+            [](void* data, size_t byte_length, void* opaque) {
+                ++*static_cast<int*>(opaque);
+            }, &release_count);
+        EXPECT_TRUE(buffer->is_external());
+        EXPECT_EQ(buffer->data(), host_data);
+
+        auto view = scope.New<TypedArrayObject>(TypedArrayKind::kInt32, buffer.ToValue(), 4, 3);
+        host_data[4] = 7;
+        Value element;
+        ASSERT_TRUE(view->GetElement(0, &element));
+        EXPECT_EQ(element.i64(), 7);
+
+        view->SetElement(2, Value(-1));
+        EXPECT_EQ(host_data[12], 0xff);
+        EXPECT_EQ(host_data[15], 0xff);
+
+        // 越界访问不影响宿主内存
+        EXPECT_FALSE(view->GetElement(3, &element));
+        view->SetElement(3, Value(1));
+        EXPECT_EQ(host_data[0], 0);
+    }
+    EXPECT_EQ(release_count, 0);
+
+    // Context 销毁时回收缓冲区并回调宿主
+    context.reset();
+    EXPECT_EQ(release_count, 1);
+}
+
+TEST_F(TypedArrayObjectTest, Uint8ConversionWraps) {
+    GCHandleScope<2> scope(context.get());
+    auto buffer = scope.New<ArrayBufferObject>(4);
+    auto view = scope.New<TypedArrayObject>(TypedArrayKind::kUint8, buffer.ToValue(), 0, 4);
+
+    view->SetElement(0, Value(300));
+    view->SetElement(1, Value(-1));
+    view->SetElement(2, Value(3.9));
+
+    Value element;
+    view->GetElement(0, &element);
+    EXPECT_EQ(element.i64(), 44);
+    view->GetElement(1, &element);
+    EXPECT_EQ(element.i64(), 255);
+    view->GetElement(2, &element);
+    EXPECT_EQ(element.i64(), 3);
+}
+
+TEST_F(TypedArrayObjectTest, DataViewEndianness) {
+    GCHandleScope<2> scope(context.get());
+    auto buffer = scope.New<ArrayBufferObject>(8);
+    auto data_view = scope.New<DataViewObject>(buffer.ToValue(), 0, 8);
+
+    ASSERT_TRUE(data_view->Store<int32_t>(0, false, 0x01020304));
+    EXPECT_EQ(buffer->data()[0], 0x01);
+    EXPECT_EQ(buffer->data()[3], 0x04);
+
+    ASSERT_TRUE(data_view->Store<int32_t>(4, true, 0x01020304));
+    EXPECT_EQ(buffer->data()[4], 0x04);
+    EXPECT_EQ(buffer->data()[7], 0x01);
+
+    int32_t element;
+    ASSERT_TRUE(data_view->Load(4, true, &element));
+    EXPECT_EQ(element, 0x01020304);
+    EXPECT_FALSE(data_view->Load(5, true, &element));
+}
+
+} // namespace mjs::test